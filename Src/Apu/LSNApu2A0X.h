@@ -75,6 +75,7 @@
 														m_tTriangle.TickSequencer( LSN_TRIANGLE_ENABLED( this ) );
 
 #define LSN_4017_DELAY									(3+1)
+#define LSN_APU_SAMPLE_BLOCK							1024								/**< The number of samples the APU collects before sending them to the audio system. */
 
 
 namespace lsn {
@@ -144,12 +145,18 @@ namespace lsn {
 			m_fHpf0( 194.0f ),
 			m_fHpf1( 37.0f ),
 			m_fHpf2( 37.0f ),
+			m_ui32FilterHz( 0 ),
+			m_sOutputPoles( 0 ),
+			m_sSamples( 0 ),
+			m_bDelaysPending( false ),
 			m_bEnabled( true ) {
 
 			m_pfLpf.CreateLpf( 20000.0f, HzAsFloat() );
-			CAudio::SampleBox().SetOutputCallback( PostHpf, this );
+			CAudio::SetSampleBoxOutputCallback( PostHpf, this );
 		}
 		~CApu2A0X() {
+			// The audio thread must not call PostHpf() once this object is gone.
+			CAudio::RemoveSampleBoxOutputCallback( this );
 		}
 
 
@@ -162,105 +169,30 @@ namespace lsn {
 		 * Performs a single cycle update.
 		 */
 		virtual void									Tick() {
-			m_dvRegisters3_4017.Tick();
-
-			m_dvPulse1LengthCounter.Tick();
-			m_dvPulse2LengthCounter.Tick();
-			m_dvTriangleLengthCounter.Tick();
-			m_dvNoiseLengthCounter.Tick();
-
-			m_dvPulse1LengthCounterHalt.Tick();
-			m_dvPulse2LengthCounterHalt.Tick();
-			m_dvTriangleLengthCounterHalt.Tick();
-			m_dvNoiseLengthCounterHalt.Tick();
+			if LSN_UNLIKELY( m_bDelaysPending ) {
+				TickDelays();
+			}
 
 			(this->*m_pftTick)();
 			m_pPulse1.UpdateSweeperState();
 			m_pPulse2.UpdateSweeperState();
 			
 			if LSN_LIKELY( m_bEnabled ) {
-				// US-NES-FL-N34169630: 296.0f/90.0f
-				// JP-TwinFami-475711-NESRGB-RCA-stock: 194.0f/37.0f/37.0f.
-				CAudio::InitSampleBox( m_fSampleBoxLpf, m_fHpf0, CSampleBox::TransitionRangeToBandwidth( CSampleBox::TransitionRange( CAudio::GetOutputFrequency() ), CAudio::GetOutputFrequency() ) * 3, Hz(), CAudio::GetOutputFrequency() );
-			
+				if LSN_UNLIKELY( CAudio::GetOutputFrequency() != m_ui32FilterHz ) { UpdateOutputFilters(); }
 
-				float fPulse1 = (m_pPulse1.ProducingSound( LSN_PULSE1_ENABLED( this ) )) ? m_pPulse1.GetEnvelopeOutput( LSN_PULSE1_USE_VOLUME ) : 0.0f;
-				// DEBUG.
-				//fPulse1 = 0.0f;
-				float fPulse2 = (m_pPulse2.ProducingSound( LSN_PULSE2_ENABLED( this ) )) ? m_pPulse2.GetEnvelopeOutput( LSN_PULSE2_USE_VOLUME ) : 0.0f;
-				//fPulse2 = 0.0f;
-				float fFinalPulse = fPulse1 + fPulse2;
-				if ( fFinalPulse ) {
-					fFinalPulse = 95.88f / ((8128.0f / fFinalPulse) + 100.0f);
-				}
-				float fNoise = (m_nNoise.ProducingSound( LSN_NOISE_ENABLED( this ) )) ? m_nNoise.GetEnvelopeOutput( LSN_NOISE_USE_VOLUME ) : 0.0f;
-				float fTriangle = m_tTriangle.Output();
-				float fDmc = 0.0f;
-
-				//fFinalPulse = fNoise = fTriangle = 0.0f;
-
-				// DEBUG.
-				//fFinalPulse = fNoise = 0.0f;
-				//fNoise = fTriangle = 0.0f;
-				//fFinalPulse = fTriangle = 0.0f;
-
-				//static uint64_t ui64CycleCnt = 0;
-				//static bool bMadeSound = false;
-				//static bool bWasJustMakingSound = false;
-				//static uint32_t ui32OnOffCnt = 0;
-				//static uint32_t ui32PrintSilenceCnt = 0;
-				//if ( m_pPulse2.ProducingSound( LSN_PULSE2_ENABLED( this ) ) ) {
-				//	if ( ui32PrintSilenceCnt >= 43520 && !fPulse2 ) {
-				//		m_pPulse2.ProducingSound( LSN_PULSE2_ENABLED( this ) );
-				//	}
-				//	else if ( ui32PrintSilenceCnt >= 44880 && fPulse2 ) {
-				//		m_pPulse2.ProducingSound( LSN_PULSE2_ENABLED( this ) );
-				//	}
-				//	ui32OnOffCnt += (bWasJustMakingSound == false) ? 1 : 0;
-				//	bMadeSound = true;
-				//	++ui64CycleCnt;
-				//	bWasJustMakingSound = true;
-
-				//	if ( ui32OnOffCnt > 120 /*&& (ui64CycleCnt % 1000) == 0*/ ) {
-				//		::OutputDebugStringA( (std::string( "Noise: " ) + std::to_string( ui64CycleCnt ) + " " + std::to_string( ui32OnOffCnt ) + " " + std::to_string( fPulse2 ) + "\r\n").c_str() );
-				//		//::OutputDebugStringA( "." );
-				//	}
-				//}
-				//if ( bMadeSound && !m_pPulse2.ProducingSound( LSN_PULSE2_ENABLED( this ) ) ) {
-				//	ui32OnOffCnt += (bWasJustMakingSound == true) ? 1 : 0;
-				//	if ( ui32OnOffCnt > 120 ) {
-				//		//::OutputDebugStringA( (std::string( "Silence: " ) + std::to_string( ui64CycleCnt ) + " " + std::to_string( ui32OnOffCnt ) + "\r\n").c_str() );
-				//		//::OutputDebugStringA( " " );
-				//		++ui32PrintSilenceCnt;
-				//		if ( ui32PrintSilenceCnt >= 43520 ) {
-				//		}
-				//	}
-				//	bWasJustMakingSound = false;
-				//}
+				uint8_t ui8Pulse1 = (m_pPulse1.ProducingSound( LSN_PULSE1_ENABLED( this ) )) ? m_pPulse1.GetEnvelopeOutput( LSN_PULSE1_USE_VOLUME ) : 0;
+				uint8_t ui8Pulse2 = (m_pPulse2.ProducingSound( LSN_PULSE2_ENABLED( this ) )) ? m_pPulse2.GetEnvelopeOutput( LSN_PULSE2_USE_VOLUME ) : 0;
+				uint8_t ui8Noise = (m_nNoise.ProducingSound( LSN_NOISE_ENABLED( this ) )) ? m_nNoise.GetEnvelopeOutput( LSN_NOISE_USE_VOLUME ) : 0;
+				uint8_t ui8Triangle = m_tTriangle.Output();
 
-
-				fNoise /= 12241.0f;
-				fTriangle /= 8227.0f;
-				fDmc /= 22638.0f;
-				float fFinalTnd = 0.0f;
-				if ( fNoise != 0.0f || fTriangle != 0.0f || fDmc != 0.0f ) {
-					fFinalTnd = 159.79f / (1.0f / (fNoise + fTriangle + fDmc) + 100.0f);
-				}
-			
-				double dFinal = fFinalPulse + fFinalTnd;
+				double dFinal = m_mtMixer.fPulse[(ui8Pulse1+ui8Pulse2)&0x1F] + m_mtMixer.fTnd[ui8Triangle&0x0F][ui8Noise&0x0F];
 				dFinal = m_pfLpf.Process( dFinal );
-				{
-					const float fMinLpf = HzAsFloat() / 2.0f;
-					for ( auto I = LSN_ELEMENTS( m_pfOutputPole ); I--; ) {
-						float fLpf = (std::min( CAudio::GetOutputFrequency() / 2.0f, 20000.0f ) + I * 10.0f);
-						if ( fLpf < fMinLpf ) {
-							m_pfOutputPole[I].CreateLpf( fLpf, HzAsFloat() );
-							dFinal = m_pfOutputPole[I].Process( dFinal );
-						}
-					}
+				for ( auto I = m_sOutputPoles; I--; ) {
+					dFinal = m_pfOutputPole[I].Process( dFinal );
 				}
 
-				CAudio::AddSample( static_cast<float>(dFinal * m_fVolume) );
+				m_fSamples[m_sSamples++] = static_cast<float>(dFinal * m_fVolume);
+				if LSN_UNLIKELY( m_sSamples == LSN_APU_SAMPLE_BLOCK ) { FlushSamples(); }
 			}
 
 
@@ -268,6 +200,16 @@ namespace lsn {
 			++m_ui64Cycles;
 		}
 
+		/**
+		 * Sends the samples collected so far to the audio system.  Called automatically every LSN_APU_SAMPLE_BLOCK cycles.
+		 */
+		void											FlushSamples() {
+			if ( m_sSamples ) {
+				CAudio::AddSamples( m_fSamples, m_sSamples );
+				m_sSamples = 0;
+			}
+		}
+
 		/**
 		 * Performs an "analog" reset, allowing previous data to remain.
 		 */
@@ -277,6 +219,9 @@ namespace lsn {
 			m_ui64StepCycles = 0;
 			m_ui64LastBucketCycle = 0;
 			CAudio::BeginEmulation();
+			// The sample box is shared, so another system might have reconfigured it.
+			m_ui32FilterHz = 0;
+			m_sSamples = 0;
 			m_pftTick = &CApu2A0X::Tick_Mode0_Step0<false, false>;
 			m_bModeSwitch = false;
 			m_pPulse1.SetSeq( GetDuty( 0 ) );
@@ -308,6 +253,79 @@ namespace lsn {
 			ResetAnalog();
 		}
 
+		/**
+		 * Writes the APU state to a stream.  The output filters and volume belong to the audio options rather than the emulated
+		 *	hardware and are not written.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		bool											SaveState( CStream &_sStream ) const {
+			size_t stTotal;
+			const PfTicks * pptTicks = TickFuncs( stTotal );
+			size_t stTick = 0;
+			while ( stTick < stTotal && pptTicks[stTick] != m_pftTick ) { ++stTick; }
+			if ( stTick == stTotal ) { return false; }
+
+			if ( !_sStream.WriteUi64( m_ui64Cycles ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_ui64StepCycles ) ) { return false; }
+			if ( !_sStream.WriteI64( m_i64TicksToLenCntr ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_ui64LastBucketCycle ) ) { return false; }
+			if ( !_sStream.WriteUi8( uint8_t( stTick ) ) ) { return false; }
+			_sStream.Write( m_ui8Registers, sizeof( m_ui8Registers ) );
+			if ( !_sStream.WriteBool( m_bModeSwitch ) ) { return false; }
+			if ( !m_pPulse1.SaveState( _sStream ) ) { return false; }
+			if ( !m_pPulse2.SaveState( _sStream ) ) { return false; }
+			if ( !m_nNoise.SaveState( _sStream ) ) { return false; }
+			if ( !m_tTriangle.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvRegisters3_4017.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvPulse1LengthCounter.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvPulse2LengthCounter.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvTriangleLengthCounter.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvNoiseLengthCounter.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvPulse1LengthCounterHalt.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvPulse2LengthCounterHalt.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvTriangleLengthCounterHalt.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvNoiseLengthCounterHalt.SaveState( _sStream ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the APU state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		bool											LoadState( CStream &_sStream ) {
+			size_t stTotal;
+			const PfTicks * pptTicks = TickFuncs( stTotal );
+			uint8_t ui8Tick;
+
+			if ( !_sStream.ReadUi64( m_ui64Cycles ) ) { return false; }
+			if ( !_sStream.ReadUi64( m_ui64StepCycles ) ) { return false; }
+			if ( !_sStream.ReadI64( m_i64TicksToLenCntr ) ) { return false; }
+			if ( !_sStream.ReadUi64( m_ui64LastBucketCycle ) ) { return false; }
+			if ( !_sStream.ReadUi8( ui8Tick ) || ui8Tick >= stTotal ) { return false; }
+			if ( _sStream.Read( m_ui8Registers, sizeof( m_ui8Registers ) ) != sizeof( m_ui8Registers ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bModeSwitch ) ) { return false; }
+			if ( !m_pPulse1.LoadState( _sStream ) ) { return false; }
+			if ( !m_pPulse2.LoadState( _sStream ) ) { return false; }
+			if ( !m_nNoise.LoadState( _sStream ) ) { return false; }
+			if ( !m_tTriangle.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvRegisters3_4017.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvPulse1LengthCounter.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvPulse2LengthCounter.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvTriangleLengthCounter.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvNoiseLengthCounter.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvPulse1LengthCounterHalt.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvPulse2LengthCounterHalt.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvTriangleLengthCounterHalt.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvNoiseLengthCounterHalt.LoadState( _sStream ) ) { return false; }
+			m_bDelaysPending = true;
+			m_pftTick = pptTicks[ui8Tick];
+			return true;
+		}
+
 		/**
 		 * Applies the APU's memory mapping t the bus.
 		 */
@@ -395,6 +413,7 @@ namespace lsn {
 			m_hfHpfFilter1.SetEnabled( _aoOptions.apCharacteristics.bHpf1Enable );
 			m_hfHpfFilter2.SetEnabled( _aoOptions.apCharacteristics.bHpf2Enable );
 			m_fSampleBoxLpf = _aoOptions.ui32OutputHz / 2.0f - 50.0f;
+			m_ui32FilterHz = 0;
 		}
 
 
@@ -405,6 +424,31 @@ namespace lsn {
 		typedef CPoleFilter								CPoleFilterLpf;
 		typedef CHpfFilter								CPoleFilterHpf;
 
+		/** The nonlinear mixer output for every combination of channel outputs. */
+		struct LSN_MIXER {
+			LSN_MIXER() {
+				fPulse[0] = 0.0f;
+				for ( size_t I = 1; I < LSN_ELEMENTS( fPulse ); ++I ) {
+					fPulse[I] = 95.88f / ((8128.0f / float( I )) + 100.0f);
+				}
+				for ( size_t T = 0; T < LSN_ELEMENTS( fTnd ); ++T ) {
+					for ( size_t N = 0; N < LSN_ELEMENTS( fTnd[T] ); ++N ) {
+						float fNoise = float( N ) / 12241.0f;
+						float fTriangle = float( T ) / 8227.0f;
+						float fDmc = 0.0f / 22638.0f;
+						fTnd[T][N] = 0.0f;
+						if ( fNoise != 0.0f || fTriangle != 0.0f || fDmc != 0.0f ) {
+							fTnd[T][N] = 159.79f / (1.0f / (fNoise + fTriangle + fDmc) + 100.0f);
+						}
+					}
+				}
+			}
+
+
+			float										fPulse[32];							/**< Indexed by the sum of the pulse outputs. */
+			float										fTnd[16][16];						/**< Indexed by the triangle output and then the noise output.  There is no DMC output yet. */
+		};
+
 
 		// == Members.
 		/** The cycle counter. */
@@ -443,6 +487,17 @@ namespace lsn {
 		float											m_fHpf1;
 		/** The HPF2 frequency. */
 		float											m_fHpf2;
+		/** The output frequency for which the sample box and output poles were last configured, or 0 if they need to be configured. */
+		uint32_t										m_ui32FilterHz;
+		/** The number of output poles in use. */
+		size_t											m_sOutputPoles;
+		/** The mixer tables. */
+		static inline const LSN_MIXER					m_mtMixer;
+		/** Samples waiting to be sent to the audio system. */
+		LSN_ALN
+		float											m_fSamples[LSN_APU_SAMPLE_BLOCK];
+		/** The number of samples in m_fSamples. */
+		size_t											m_sSamples;
 		/** Pulse 1. */
 		CPulse											m_pPulse1;
 		/** Pulse 2. */
@@ -457,6 +512,8 @@ namespace lsn {
 		uint8_t											m_ui8Registers[0x15+1];
 		/** Set to true upon a write to $4017. */
 		bool											m_bModeSwitch;
+		/** Set to true when a delayed register is written and cleared once all of them have settled. */
+		bool											m_bDelaysPending;
 		/** Audio setting: Enabled. */
 		bool											m_bEnabled;
 		
@@ -481,6 +538,47 @@ namespace lsn {
 
 
 		// == Functions.
+		/**
+		 * Gets every function to which m_pftTick can point, indexed by save states.
+		 *
+		 * \param _stTotal Holds the returned number of functions.
+		 * \return Returns a pointer to the table of tick functions.
+		 */
+		static const PfTicks *							TickFuncs( size_t &_stTotal ) {
+#define LSN_TICKS( FUNC )								&CApu2A0X::FUNC<false, false>, &CApu2A0X::FUNC<true, false>, &CApu2A0X::FUNC<false, true>, &CApu2A0X::FUNC<true, true>
+			static const PfTicks ptTicks[] = {
+				LSN_TICKS( Tick_Mode0_Step0 ), LSN_TICKS( Tick_Mode0_Step1 ), LSN_TICKS( Tick_Mode0_Step2 ), LSN_TICKS( Tick_Mode0_Step3 ),
+				LSN_TICKS( Tick_Mode1_Step0 ), LSN_TICKS( Tick_Mode1_Step1 ), LSN_TICKS( Tick_Mode1_Step2 ), LSN_TICKS( Tick_Mode1_Step3 ), LSN_TICKS( Tick_Mode1_Step4 ),
+			};
+#undef LSN_TICKS
+			_stTotal = LSN_ELEMENTS( ptTicks );
+			return ptTicks;
+		}
+
+		/**
+		 * Advances the delayed register writes.  Only called while m_bDelaysPending is set, which is cleared once every write has
+		 *	reached its register.
+		 */
+		inline void										TickDelays() {
+			m_dvRegisters3_4017.Tick();
+
+			m_dvPulse1LengthCounter.Tick();
+			m_dvPulse2LengthCounter.Tick();
+			m_dvTriangleLengthCounter.Tick();
+			m_dvNoiseLengthCounter.Tick();
+
+			m_dvPulse1LengthCounterHalt.Tick();
+			m_dvPulse2LengthCounterHalt.Tick();
+			m_dvTriangleLengthCounterHalt.Tick();
+			m_dvNoiseLengthCounterHalt.Tick();
+
+			m_bDelaysPending = !(m_dvRegisters3_4017.Settled() &&
+				m_dvPulse1LengthCounter.Settled() && m_dvPulse2LengthCounter.Settled() &&
+				m_dvTriangleLengthCounter.Settled() && m_dvNoiseLengthCounter.Settled() &&
+				m_dvPulse1LengthCounterHalt.Settled() && m_dvPulse2LengthCounterHalt.Settled() &&
+				m_dvTriangleLengthCounterHalt.Settled() && m_dvNoiseLengthCounterHalt.Settled());
+		}
+
 		/** Mode-0 step-0 tick function. */
 		template <bool _bEven, bool _bMode>
 		void											Tick_Mode0_Step0() {
@@ -698,6 +796,28 @@ namespace lsn {
 		}
 
 
+		/**
+		 * Configures the sample box and the output poles for the current output frequency.  Called only when the output frequency or
+		 *	the audio options change rather than on every cycle.
+		 */
+		void											UpdateOutputFilters() {
+			uint32_t ui32Hz = CAudio::GetOutputFrequency();
+			// US-NES-FL-N34169630: 296.0f/90.0f
+			// JP-TwinFami-475711-NESRGB-RCA-stock: 194.0f/37.0f/37.0f.
+			if ( !CAudio::InitSampleBox( m_fSampleBoxLpf, m_fHpf0, CSampleBox::TransitionRangeToBandwidth( CSampleBox::TransitionRange( ui32Hz ), ui32Hz ) * 3, Hz(), ui32Hz ) ) { return; }
+
+			// The poles go up in frequency, so the ones in use are always the first m_sOutputPoles.
+			const float fMinLpf = HzAsFloat() / 2.0f;
+			m_sOutputPoles = 0;
+			for ( size_t I = 0; I < LSN_ELEMENTS( m_pfOutputPole ); ++I ) {
+				float fLpf = (std::min( ui32Hz / 2.0f, 20000.0f ) + I * 10.0f);
+				if ( fLpf >= fMinLpf ) { break; }
+				m_pfOutputPole[I].CreateLpf( fLpf, HzAsFloat() );
+				m_sOutputPoles = I + 1;
+			}
+			m_ui32FilterHz = ui32Hz;
+		}
+
 		/**
 		 * Determines the next CPU cycle that corresponds to a new WAV sample and returns the CPU cycle index that corresponds to
 		 *	that sample as well as the fraction between that sample and the next to interpolate when sampling.
@@ -765,6 +885,7 @@ namespace lsn {
 			//paApu->m_ui8Registers[0x00] = _ui8Val;
 			paApu->m_ui8Registers[0x00] = (_ui8Val & ~LSN_PULSE1_HALT_MASK) | (paApu->m_ui8Registers[0x00] & LSN_PULSE1_HALT_MASK);
 			paApu->m_dvPulse1LengthCounterHalt.WriteWithDelay( _ui8Val & LSN_PULSE1_HALT_MASK );
+			paApu->m_bDelaysPending = true;
 			paApu->m_pPulse1.SetSeq( GetDuty( _ui8Val >> 6 ) );
 			paApu->m_pPulse1.SetEnvelopeVolume( _ui8Val & 0b1111 );
 		}
@@ -818,6 +939,7 @@ namespace lsn {
 				//	paApu->m_pPulse1.SetLengthCounter( CApuUnit::LenTable( (_ui8Val /*& 0b11111000*/) >> 3 ) );
 				//}
 				paApu->m_dvPulse1LengthCounter.WriteWithDelay( CApuUnit::LenTable( (_ui8Val /*& 0b11111000*/) >> 3 ) );
+				paApu->m_bDelaysPending = true;
 			}
 			paApu->m_pPulse1.RestartEnvelope();
 		}
@@ -835,6 +957,7 @@ namespace lsn {
 			//paApu->m_ui8Registers[0x04] = _ui8Val;
 			paApu->m_ui8Registers[0x04] = (_ui8Val & ~LSN_PULSE2_HALT_MASK) | (paApu->m_ui8Registers[0x04] & LSN_PULSE2_HALT_MASK);
 			paApu->m_dvPulse2LengthCounterHalt.WriteWithDelay( _ui8Val & LSN_PULSE2_HALT_MASK );
+			paApu->m_bDelaysPending = true;
 			paApu->m_pPulse2.SetSeq( GetDuty( _ui8Val >> 6 ) );
 			paApu->m_pPulse2.SetEnvelopeVolume( _ui8Val & 0b1111 );
 		}
@@ -888,6 +1011,7 @@ namespace lsn {
 				//	paApu->m_pPulse2.SetLengthCounter( CApuUnit::LenTable( (_ui8Val /*& 0b11111000*/) >> 3 ) );
 				//}
 				paApu->m_dvPulse2LengthCounter.WriteWithDelay( CApuUnit::LenTable( (_ui8Val /*& 0b11111000*/) >> 3 ) );
+				paApu->m_bDelaysPending = true;
 			}
 			paApu->m_pPulse2.RestartEnvelope();
 		}
@@ -905,6 +1029,7 @@ namespace lsn {
 			//paApu->m_ui8Registers[0x08] = _ui8Val;
 			paApu->m_ui8Registers[0x08] = (_ui8Val & ~LSN_TRIANGLE_HALT_MASK) | (paApu->m_ui8Registers[0x08] & LSN_TRIANGLE_HALT_MASK);
 			paApu->m_dvTriangleLengthCounterHalt.WriteWithDelay( _ui8Val & LSN_TRIANGLE_HALT_MASK );
+			paApu->m_bDelaysPending = true;
 			paApu->m_tTriangle.SetLinearCounter( _ui8Val & 0b01111111 );
 		}
 
@@ -939,6 +1064,7 @@ namespace lsn {
 				//	paApu->m_tTriangle.SetLengthCounter( CApuUnit::LenTable( (_ui8Val /*& 0b11111000*/) >> 3 ) );
 				//}
 				paApu->m_dvTriangleLengthCounter.WriteWithDelay( CApuUnit::LenTable( (_ui8Val /*& 0b11111000*/) >> 3 ) );
+				paApu->m_bDelaysPending = true;
 			}
 			paApu->m_tTriangle.SetLinearReload();
 		}
@@ -956,6 +1082,7 @@ namespace lsn {
 			//paApu->m_ui8Registers[0x0C] = _ui8Val;
 			paApu->m_ui8Registers[0x0C] = (_ui8Val & ~LSN_NOISE_HALT_MASK) | (paApu->m_ui8Registers[0x0C] & LSN_NOISE_HALT_MASK);
 			paApu->m_dvNoiseLengthCounterHalt.WriteWithDelay( _ui8Val & LSN_NOISE_HALT_MASK );
+			paApu->m_bDelaysPending = true;
 			paApu->m_nNoise.SetEnvelopeVolume( _ui8Val & 0b1111 );
 		}
 
@@ -990,6 +1117,7 @@ namespace lsn {
 				//	paApu->m_nNoise.SetLengthCounter( CApuUnit::LenTable( (_ui8Val /*& 0b11111000*/) >> 3 ) );
 				//}
 				paApu->m_dvNoiseLengthCounter.WriteWithDelay( CApuUnit::LenTable( (_ui8Val /*& 0b11111000*/) >> 3 ) );
+				paApu->m_bDelaysPending = true;
 			}
 			paApu->m_nNoise.RestartEnvelope();
 		}
@@ -1069,6 +1197,7 @@ namespace lsn {
 			// "During" an APU cycle means every even CPU cycle.  "Between" APU cycles means every odd CPU cycle.
 			// This is handled by having Set4017() set m_bModeSwitch, which will then be seen only on even ticks.
 			paApu->m_dvRegisters3_4017.WriteWithDelay( _ui8Val );
+			paApu->m_bDelaysPending = true;
 		}
 
 		/**
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include "../Utilities/LSNStream.h"
 
 namespace lsn {
 
@@ -60,6 +61,22 @@ namespace lsn {
 		 **/
 		inline void									ResetToKnown();
 
+		/**
+		 * Writes the unit state to a stream.
+		 * 
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 **/
+		inline bool									SaveState( CStream &_sStream ) const;
+
+		/**
+		 * Reads the unit state from a stream.
+		 * 
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 **/
+		inline bool									LoadState( CStream &_sStream );
+
 
 	protected :
 		// == Members.
@@ -162,4 +179,32 @@ namespace lsn {
 		m_bRestart					= true;
 	}
 
+	/**
+	 * Writes the unit state to a stream.
+	 * 
+	 * \param _sStream The stream to which to write the state.
+	 * \return Returns true if the state was written.
+	 **/
+	inline bool CEnvelope::SaveState( CStream &_sStream ) const {
+		if ( !_sStream.WriteUi8( m_ui8Output ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8DecayCounter ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8DividerCounter ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8Volume ) ) { return false; }
+		return _sStream.WriteBool( m_bRestart );
+	}
+
+	/**
+	 * Reads the unit state from a stream.
+	 * 
+	 * \param _sStream The stream from which to read the state.
+	 * \return Returns true if the state was read.
+	 **/
+	inline bool CEnvelope::LoadState( CStream &_sStream ) {
+		if ( !_sStream.ReadUi8( m_ui8Output ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8DecayCounter ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8DividerCounter ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8Volume ) ) { return false; }
+		return _sStream.ReadBool( m_bRestart );
+	}
+
 }	// namespace lsn
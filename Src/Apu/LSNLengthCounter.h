@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include "../Utilities/LSNStream.h"
 
 namespace lsn {
 
@@ -54,6 +55,22 @@ namespace lsn {
 		 **/
 		inline void									ResetToKnown();
 
+		/**
+		 * Writes the unit state to a stream.
+		 * 
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 **/
+		inline bool									SaveState( CStream &_sStream ) const;
+
+		/**
+		 * Reads the unit state from a stream.
+		 * 
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 **/
+		inline bool									LoadState( CStream &_sStream );
+
 
 	protected :
 		// == Members.
@@ -115,4 +132,24 @@ namespace lsn {
 		m_ui8Counter = 0;
 	}
 
+	/**
+	 * Writes the unit state to a stream.
+	 * 
+	 * \param _sStream The stream to which to write the state.
+	 * \return Returns true if the state was written.
+	 **/
+	inline bool CLengthCounter::SaveState( CStream &_sStream ) const {
+		return _sStream.WriteUi8( m_ui8Counter );
+	}
+
+	/**
+	 * Reads the unit state from a stream.
+	 * 
+	 * \param _sStream The stream from which to read the state.
+	 * \return Returns true if the state was read.
+	 **/
+	inline bool CLengthCounter::LoadState( CStream &_sStream ) {
+		return _sStream.ReadUi8( m_ui8Counter );
+	}
+
 }	// namespace lsn
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include "../Utilities/LSNStream.h"
 
 namespace lsn {
 
@@ -58,6 +59,22 @@ namespace lsn {
 		 **/
 		inline void									ResetToKnown();
 
+		/**
+		 * Writes the unit state to a stream.
+		 * 
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 **/
+		inline bool									SaveState( CStream &_sStream ) const;
+
+		/**
+		 * Reads the unit state from a stream.
+		 * 
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 **/
+		inline bool									LoadState( CStream &_sStream );
+
 
 	protected :
 		// == Members.
@@ -128,4 +145,28 @@ namespace lsn {
 		m_bReloadLinear = true;
 	}
 
+	/**
+	 * Writes the unit state to a stream.
+	 * 
+	 * \param _sStream The stream to which to write the state.
+	 * \return Returns true if the state was written.
+	 **/
+	inline bool CLinearCounter::SaveState( CStream &_sStream ) const {
+		if ( !_sStream.WriteUi8( m_ui8LinearCounter ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8LinearReload ) ) { return false; }
+		return _sStream.WriteBool( m_bReloadLinear );
+	}
+
+	/**
+	 * Reads the unit state from a stream.
+	 * 
+	 * \param _sStream The stream from which to read the state.
+	 * \return Returns true if the state was read.
+	 **/
+	inline bool CLinearCounter::LoadState( CStream &_sStream ) {
+		if ( !_sStream.ReadUi8( m_ui8LinearCounter ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8LinearReload ) ) { return false; }
+		return _sStream.ReadBool( m_bReloadLinear );
+	}
+
 }	// namespace lsn
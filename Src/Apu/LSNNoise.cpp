@@ -28,6 +28,32 @@ namespace lsn {
 		m_ui32Sequence = 1;
 	}
 
+	/**
+	 * Writes the unit state to a stream.
+	 * 
+	 * \param _sStream The stream to which to write the state.
+	 * \return Returns true if the state was written.
+	 **/
+	bool CNoise::SaveState( CStream &_sStream ) const {
+		if ( !CLengthCounter::SaveState( _sStream ) ) { return false; }
+		if ( !CEnvelope::SaveState( _sStream ) ) { return false; }
+		if ( !CSequencer::SaveState( _sStream ) ) { return false; }
+		return _sStream.WriteBool( m_bMode );
+	}
+
+	/**
+	 * Reads the unit state from a stream.
+	 * 
+	 * \param _sStream The stream from which to read the state.
+	 * \return Returns true if the state was read.
+	 **/
+	bool CNoise::LoadState( CStream &_sStream ) {
+		if ( !CLengthCounter::LoadState( _sStream ) ) { return false; }
+		if ( !CEnvelope::LoadState( _sStream ) ) { return false; }
+		if ( !CSequencer::LoadState( _sStream ) ) { return false; }
+		return _sStream.ReadBool( m_bMode );
+	}
+
 	/**
 	 * Handles the tick work.
 	 * 
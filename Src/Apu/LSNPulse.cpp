@@ -28,6 +28,32 @@ namespace lsn {
 		CSweeper::ResetToKnown();
 	}
 
+	/**
+	 * Writes the unit state to a stream.
+	 * 
+	 * \param _sStream The stream to which to write the state.
+	 * \return Returns true if the state was written.
+	 **/
+	bool CPulse::SaveState( CStream &_sStream ) const {
+		if ( !CLengthCounter::SaveState( _sStream ) ) { return false; }
+		if ( !CEnvelope::SaveState( _sStream ) ) { return false; }
+		if ( !CSequencer::SaveState( _sStream ) ) { return false; }
+		return CSweeper::SaveState( _sStream );
+	}
+
+	/**
+	 * Reads the unit state from a stream.
+	 * 
+	 * \param _sStream The stream from which to read the state.
+	 * \return Returns true if the state was read.
+	 **/
+	bool CPulse::LoadState( CStream &_sStream ) {
+		if ( !CLengthCounter::LoadState( _sStream ) ) { return false; }
+		if ( !CEnvelope::LoadState( _sStream ) ) { return false; }
+		if ( !CSequencer::LoadState( _sStream ) ) { return false; }
+		return CSweeper::LoadState( _sStream );
+	}
+
 	/**
 	 * Handles the tick work.
 	 * 
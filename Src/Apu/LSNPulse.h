@@ -37,6 +37,22 @@ namespace lsn {
 		 **/
 		void									ResetToKnown();
 
+		/**
+		 * Writes the unit state to a stream.
+		 * 
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 **/
+		bool									SaveState( CStream &_sStream ) const;
+
+		/**
+		 * Reads the unit state from a stream.
+		 * 
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 **/
+		bool									LoadState( CStream &_sStream );
+
 		/**
 		 * Determines if the pulse channel should produce sound.
 		 * 
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include "../Utilities/LSNStream.h"
 
 namespace lsn {
 
@@ -92,6 +93,22 @@ namespace lsn {
 		 **/
 		inline void								ResetToKnown();
 
+		/**
+		 * Writes the unit state to a stream.
+		 * 
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 **/
+		inline bool								SaveState( CStream &_sStream ) const;
+
+		/**
+		 * Reads the unit state from a stream.
+		 * 
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 **/
+		inline bool								LoadState( CStream &_sStream );
+
 
 	protected :
 		// == Members.
@@ -231,4 +248,32 @@ namespace lsn {
 		m_ui8SeqOff			= 0;
 	}
 
+	/**
+	 * Writes the unit state to a stream.
+	 * 
+	 * \param _sStream The stream to which to write the state.
+	 * \return Returns true if the state was written.
+	 **/
+	inline bool CSequencer::SaveState( CStream &_sStream ) const {
+		if ( !_sStream.WriteUi32( m_ui32Sequence ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16Timer ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16Reload ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8Out ) ) { return false; }
+		return _sStream.WriteUi8( m_ui8SeqOff );
+	}
+
+	/**
+	 * Reads the unit state from a stream.
+	 * 
+	 * \param _sStream The stream from which to read the state.
+	 * \return Returns true if the state was read.
+	 **/
+	inline bool CSequencer::LoadState( CStream &_sStream ) {
+		if ( !_sStream.ReadUi32( m_ui32Sequence ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16Timer ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16Reload ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8Out ) ) { return false; }
+		return _sStream.ReadUi8( m_ui8SeqOff );
+	}
+
 }	// namespace lsn
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include "../Utilities/LSNStream.h"
 
 namespace lsn {
 
@@ -137,6 +138,38 @@ namespace lsn {
 			m_bNeedReload	= true;
 		}
 
+		/**
+		 * Writes the unit state to a stream.  The reload reference belongs to the owning sequencer and is not written.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 **/
+		inline bool									SaveState( CStream &_sStream ) const {
+			if ( !_sStream.WriteUi8( m_ui8Shift ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Timer ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Period ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bEnabled ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bMuted ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bNegated ) ) { return false; }
+			return _sStream.WriteBool( m_bNeedReload );
+		}
+
+		/**
+		 * Reads the unit state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 **/
+		inline bool									LoadState( CStream &_sStream ) {
+			if ( !_sStream.ReadUi8( m_ui8Shift ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Timer ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Period ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bEnabled ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bMuted ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bNegated ) ) { return false; }
+			return _sStream.ReadBool( m_bNeedReload );
+		}
+
 
 	protected :
 		// == Members.
@@ -33,6 +33,30 @@ namespace lsn {
 		CSequencer::ResetToKnown();
 	}
 
+	/**
+	 * Writes the unit state to a stream.
+	 * 
+	 * \param _sStream The stream to which to write the state.
+	 * \return Returns true if the state was written.
+	 **/
+	bool CTriangle::SaveState( CStream &_sStream ) const {
+		if ( !CLengthCounter::SaveState( _sStream ) ) { return false; }
+		if ( !CLinearCounter::SaveState( _sStream ) ) { return false; }
+		return CSequencer::SaveState( _sStream );
+	}
+
+	/**
+	 * Reads the unit state from a stream.
+	 * 
+	 * \param _sStream The stream from which to read the state.
+	 * \return Returns true if the state was read.
+	 **/
+	bool CTriangle::LoadState( CStream &_sStream ) {
+		if ( !CLengthCounter::LoadState( _sStream ) ) { return false; }
+		if ( !CLinearCounter::LoadState( _sStream ) ) { return false; }
+		return CSequencer::LoadState( _sStream );
+	}
+
 	/**
 	 * Handles the tick work.
 	 * 
@@ -8,6 +8,7 @@
  */
 
 #include "LSNAudio.h"
+#include "../Utilities/LSNProfiler.h"
 #include "../Utilities/LSNUtilities.h"
 
 namespace lsn {
@@ -17,13 +18,25 @@ namespace lsn {
 	CAudio::CAudioDevice CAudio::m_adAudioDevice;
 
 	/** The audio thread. */
-	//std::unique_ptr<std::thread> CAudio::m_ptAudioThread;
+	std::unique_ptr<std::thread> CAudio::m_ptAudioThread;
 
 	/** Boolean to stop the audio thread. */
-	//std::atomic<bool> CAudio::m_bRunThread = true;
+	std::atomic<bool> CAudio::m_bRunThread = false;
 
-	/** The signal that the thread has finished. */
-	//CEvent CAudio::m_eThreadClosed;
+	/** The signal that there are samples in m_srSamples. */
+	CEvent CAudio::m_eSamplesReady;
+
+	/** Samples waiting to be filtered by the audio thread. */
+	CSpscRing<float> CAudio::m_srSamples;
+
+	/** Set by the one thread currently pushing into m_srSamples. */
+	std::atomic<bool> CAudio::m_bPushing = false;
+
+	/** Held by whichever thread is popping from m_srSamples and using the sample box. */
+	std::mutex CAudio::m_mSampleBoxLock;
+
+	/** Held while BeginEmulation() restarts the audio thread. */
+	std::mutex CAudio::m_mBeginLock;
 
 	/** The sample box for band-passed output. */
 	CSampleBox CAudio::m_sbSampleBox;
@@ -69,6 +82,50 @@ namespace lsn {
 		return m_adAudioDevice.ShutdownAudio();
 	}
 
+	/**
+	 * Initializes the sample box, preparing to deliver nice clean band-limited samples as fast as alien technology can deliver.
+	 * 
+	 * \param _dLpf The LPF frequency.
+	 * \param _dHpf The HPF frequency.
+	 * \param _sM The LPF bandwidth.  Higher numbers result in sharper cut-offs.
+	 * \param _dInputRate The input sample rate.
+	 * \param _ui32OutputRate The output sample rate.
+	 * \return Returns true if the internal buffers could be allocated.
+	 **/
+	bool CAudio::InitSampleBox( double _dLpf, double _dHpf, size_t _sM, double _dInputRate, uint32_t _ui32OutputRate ) {
+		std::lock_guard<std::mutex> lgLock( m_mSampleBoxLock );
+		// Samples queued before the change are filtered with the settings that were current when they were added.
+		ProcessQueuedSamples();
+		return m_sbSampleBox.Init( _dLpf, _dHpf, _sM, _dInputRate, _ui32OutputRate );
+	}
+
+	/**
+	 * Sets the function that makes the final changes to each sample coming out of the sample box.  The function is called on the
+	 *	audio thread.
+	 * 
+	 * \param _pfFunc The function to call, or nullptr to pass samples through unchanged.
+	 * \param _pvParm The parameter to pass to _pfFunc.
+	 **/
+	void CAudio::SetSampleBoxOutputCallback( CSampleBox::PfFinalCallback _pfFunc, void * _pvParm ) {
+		std::lock_guard<std::mutex> lgLock( m_mSampleBoxLock );
+		ProcessQueuedSamples();
+		m_sbSampleBox.SetOutputCallback( _pfFunc, _pvParm );
+	}
+
+	/**
+	 * Removes the sample-box output callback if it was set with the given parameter.  Queued samples are filtered first, so the
+	 *	callback is not called again after this returns.
+	 * 
+	 * \param _pvParm The parameter that was passed to SetSampleBoxOutputCallback().
+	 **/
+	void CAudio::RemoveSampleBoxOutputCallback( void * _pvParm ) {
+		std::lock_guard<std::mutex> lgLock( m_mSampleBoxLock );
+		ProcessQueuedSamples();
+		if ( m_sbSampleBox.OutputCallbackParm() == _pvParm ) {
+			m_sbSampleBox.SetOutputCallback( nullptr, nullptr );
+		}
+	}
+
 	/**
 	 * Sets all output settings.
 	 * 
@@ -80,9 +137,11 @@ namespace lsn {
 	}
 
 	/**
-	 * Called when emulation begins.  Resets the ring buffer of buckets.
+	 * Called when emulation begins.  Resets the ring buffer of buckets.  Safe to call from systems resetting on several threads
+	 *	at once.
 	 **/
 	void CAudio::BeginEmulation() {
+		std::lock_guard<std::mutex> lgLock( m_mBeginLock );
 		StopThread();
 
 		m_adAudioDevice.BeginEmulation();
@@ -96,12 +155,42 @@ namespace lsn {
 	 * \param _fSample The audio sample to be added.
 	 **/
 	void CAudio::AddSample( float _fSample ) {
-		m_sbSampleBox.AddSample( _fSample );
-		std::vector<float> & vOut = m_sbSampleBox.Output();
-		for ( size_t I = 0; I < vOut.size(); ++I ) {
-			m_adAudioDevice.AddSample( vOut[I] );
+		AddSamples( &_fSample, 1 );
+	}
+
+	/**
+	 * Adds a block of samples to all buckets that need them.  Cheaper than calling AddSample() on each sample.  The samples are
+	 *	queued for the audio thread, which does the filtering and format conversion.  If the audio thread is not running or has
+	 *	fallen too far behind, they are filtered on the calling thread instead.
+	 * The queue has a single producer.  If another thread is already pushing (several systems with audio enabled on different
+	 *	threads), the samples are filtered on the calling thread, so this is always safe to call, but only one system should have
+	 *	audio enabled or their output is mixed.
+	 *
+	 * \param _pfSamples The audio samples to be added.
+	 * \param _sTotal The number of samples to which _pfSamples points.
+	 **/
+	void CAudio::AddSamples( const float * _pfSamples, size_t _sTotal ) {
+		// Only one thread at a time may push; the acquire/release pair hands the write side of the ring from one producer to the next.
+		if LSN_LIKELY( m_bRunThread && !m_bPushing.exchange( true, std::memory_order_acquire ) ) {
+			size_t sPushed = m_srSamples.Push( _pfSamples, _sTotal );
+			m_bPushing.store( false, std::memory_order_release );
+			m_eSamplesReady.Signal();
+			if LSN_LIKELY( sPushed == _sTotal ) { return; }
+			_pfSamples += sPushed;
+			_sTotal -= sPushed;
 		}
-		vOut.clear();
+		std::lock_guard<std::mutex> lgLock( m_mSampleBoxLock );
+		// Everything already queued has to go first to keep the samples in order.
+		ProcessQueuedSamples();
+		FilterSamples( _pfSamples, _sTotal );
+	}
+
+	/**
+	 * Filters every sample queued so far and sends it to the audio device before returning.
+	 **/
+	void CAudio::Flush() {
+		std::lock_guard<std::mutex> lgLock( m_mSampleBoxLock );
+		ProcessQueuedSamples();
 	}
 
 	/**
@@ -110,22 +199,32 @@ namespace lsn {
 	 * \return Returns true if the audio thread is started.
 	 **/
 	bool CAudio::StartThread() {
-		return true;	// No audio thread yet.
-		/*StopThread();
+		StopThread();
+		if ( m_srSamples.Capacity() == 0 ) {
+			if ( !m_srSamples.Resize( LSN_AUDIO_RING_SIZE ) ) { return false; }
+		}
 		m_bRunThread = true;
-		m_ptAudioThread = std::make_unique<std::thread>( AudioThread, nullptr );
-		return m_ptAudioThread.get() != nullptr;*/
+		try {
+			m_ptAudioThread = std::make_unique<std::thread>( AudioThread, nullptr );
+		}
+		catch ( ... ) {
+			m_bRunThread = false;
+			return false;
+		}
+		return true;
 	}
 
 	/**
 	 * Stops the audio thread.
 	 **/
 	void CAudio::StopThread() {
-		/*if ( nullptr == m_ptAudioThread.get() ) { return; }
+		if ( nullptr == m_ptAudioThread.get() ) { return; }
 		m_bRunThread = false;
-		m_eThreadClosed.WaitForSignal();
+		m_eSamplesReady.Signal();
 		m_ptAudioThread->join();
-		m_ptAudioThread.reset();*/
+		m_ptAudioThread.reset();
+		// Nothing that was queued is lost.
+		Flush();
 	}
 
 	/**
@@ -134,9 +233,39 @@ namespace lsn {
 	 * \param _pvParm Unused.
 	 */
 	void CAudio::AudioThread( void * /*_pvParm*/ ) {
-		/*while ( m_bRunThread ) {
+		LSN_PROFILE_THREAD_NAME( "Audio" );
+		while ( m_bRunThread ) {
+			m_eSamplesReady.WaitForSignal( 10 );
+			std::lock_guard<std::mutex> lgLock( m_mSampleBoxLock );
+			ProcessQueuedSamples();
+		}
+	}
+
+	/**
+	 * Filters every sample in m_srSamples.  m_mSampleBoxLock must be held.
+	 **/
+	void CAudio::ProcessQueuedSamples() {
+		float fBlock[4096];
+		size_t sTotal;
+		while ( (sTotal = m_srSamples.Pop( fBlock, LSN_ELEMENTS( fBlock ) )) != 0 ) {
+			FilterSamples( fBlock, sTotal );
 		}
-		m_eThreadClosed.Signal();*/
+	}
+
+	/**
+	 * Sends samples through the sample box and the results to the audio device.  m_mSampleBoxLock must be held.
+	 *
+	 * \param _pfSamples The audio samples to be filtered.
+	 * \param _sTotal The number of samples to which _pfSamples points.
+	 **/
+	void CAudio::FilterSamples( const float * _pfSamples, size_t _sTotal ) {
+		LSN_PROFILE_SCOPE( "Sample Box" );
+		m_sbSampleBox.AddSamples( _pfSamples, _sTotal );
+		std::vector<float> & vOut = m_sbSampleBox.Output();
+		for ( size_t I = 0; I < vOut.size(); ++I ) {
+			m_adAudioDevice.AddSample( vOut[I] );
+		}
+		vOut.clear();
 	}
 
 }	// namespace lsn
@@ -14,12 +14,20 @@
 #include "../Event/LSNEvent.h"
 #include "LSNAudioBase.h"
 #include "LSNAudioCoreAudio.h"
+#include "LSNAudioNull.h"
 #include "LSNAudioOpenAl.h"
 #include "LSNAudioOptions.h"
 #include "LSNSampleBox.h"
+#include "../Utilities/LSNSpscRing.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <thread>
 
+
+#define LSN_AUDIO_RING_SIZE									(64 * 1024)							/**< The number of unfiltered samples that can be queued for the audio thread.  About 36 milliseconds of NTSC APU output. */
+
 namespace lsn {
 
 	/**
@@ -57,9 +65,24 @@ namespace lsn {
 		 * \param _ui32OutputRate The output sample rate.
 		 * \return Returns true if the internal buffers could be allocated.
 		 **/
-		static inline bool									InitSampleBox( double _dLpf, double _dHpf, size_t _sM, double _dInputRate, uint32_t _ui32OutputRate ) {
-			return m_sbSampleBox.Init( _dLpf, _dHpf, _sM, _dInputRate, _ui32OutputRate );
-		}
+		static bool											InitSampleBox( double _dLpf, double _dHpf, size_t _sM, double _dInputRate, uint32_t _ui32OutputRate );
+
+		/**
+		 * Sets the function that makes the final changes to each sample coming out of the sample box.  The function is called on the
+		 *	audio thread.
+		 * 
+		 * \param _pfFunc The function to call, or nullptr to pass samples through unchanged.
+		 * \param _pvParm The parameter to pass to _pfFunc.
+		 **/
+		static void											SetSampleBoxOutputCallback( CSampleBox::PfFinalCallback _pfFunc, void * _pvParm );
+
+		/**
+		 * Removes the sample-box output callback if it was set with the given parameter.  Queued samples are filtered first, so the
+		 *	callback is not called again after this returns.
+		 * 
+		 * \param _pvParm The parameter that was passed to SetSampleBoxOutputCallback().
+		 **/
+		static void											RemoveSampleBoxOutputCallback( void * _pvParm );
 
 		/**
 		 * Gets the sample box.
@@ -249,7 +272,8 @@ namespace lsn {
 		static inline float									Sample_6Point_5thOrder_32X_Z( const float * _pfsSamples, float _fFrac );
 
 		/**
-		 * Called when emulation begins.  Resets the ring buffer of buckets.
+		 * Called when emulation begins.  Resets the ring buffer of buckets.  Safe to call from systems resetting on several threads
+		 *	at once.
 		 **/
 		static void											BeginEmulation();
 
@@ -260,6 +284,24 @@ namespace lsn {
 		 **/
 		static void											AddSample( float _fSample );
 
+		/**
+		 * Adds a block of samples to all buckets that need them.  Cheaper than calling AddSample() on each sample.  The samples are
+		 *	queued for the audio thread, which does the filtering and format conversion.  If the audio thread is not running or has
+		 *	fallen too far behind, they are filtered on the calling thread instead.
+		 * The queue has a single producer.  If another thread is already pushing (several systems with audio enabled on different
+		 *	threads), the samples are filtered on the calling thread, so this is always safe to call, but only one system should have
+		 *	audio enabled or their output is mixed.
+		 *
+		 * \param _pfSamples The audio samples to be added.
+		 * \param _sTotal The number of samples to which _pfSamples points.
+		 **/
+		static void											AddSamples( const float * _pfSamples, size_t _sTotal );
+
+		/**
+		 * Filters every sample queued so far and sends it to the audio device before returning.
+		 **/
+		static void											Flush();
+
 		/**
 		 * Gets the current audio device.
 		 * 
@@ -274,17 +316,27 @@ namespace lsn {
         typedef CAudioOpenAl                                CAudioDevice;
 #elif defined( LSN_APPLE )
         typedef CAudioCoreAudio                             CAudioDevice;
+#else
+        typedef CAudioNull                                  CAudioDevice;
 #endif  // #ifdef LSN_WINDOWS
         
 		// == Members.
 		/** The audio interface object. */
 		static CAudioDevice									m_adAudioDevice;
 		/** The audio thread. */
-		//static std::unique_ptr<std::thread>					m_ptAudioThread;
+		static std::unique_ptr<std::thread>					m_ptAudioThread;
 		/** Boolean to stop the audio thread. */
-		//static std::atomic<bool>							m_bRunThread;
-		/** The signal that the thread has finished. */
-		//static CEvent										m_eThreadClosed;
+		static std::atomic<bool>							m_bRunThread;
+		/** The signal that there are samples in m_srSamples. */
+		static CEvent										m_eSamplesReady;
+		/** Samples waiting to be filtered by the audio thread. */
+		static CSpscRing<float>								m_srSamples;
+		/** Set by the one thread currently pushing into m_srSamples. */
+		static std::atomic<bool>							m_bPushing;
+		/** Held by whichever thread is popping from m_srSamples and using the sample box. */
+		static std::mutex									m_mSampleBoxLock;
+		/** Held while BeginEmulation() restarts the audio thread. */
+		static std::mutex									m_mBeginLock;
 		/** The sample box for band-passed output. */
 		static CSampleBox									m_sbSampleBox;
 		/** The index of the audio device being used. */
@@ -315,6 +367,19 @@ namespace lsn {
 		 */
 		static void											AudioThread( void * _pvParm );
 
+		/**
+		 * Filters every sample in m_srSamples.  m_mSampleBoxLock must be held.
+		 **/
+		static void											ProcessQueuedSamples();
+
+		/**
+		 * Sends samples through the sample box and the results to the audio device.  m_mSampleBoxLock must be held.
+		 *
+		 * \param _pfSamples The audio samples to be filtered.
+		 * \param _sTotal The number of samples to which _pfSamples points.
+		 **/
+		static void											FilterSamples( const float * _pfSamples, size_t _sTotal );
+
 	};
 	
 
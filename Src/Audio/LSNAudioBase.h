@@ -16,6 +16,7 @@
 #include "OpenAL/LSNOpenAlDevice.h"
 #include "OpenAL/LSNOpenAlSource.h"
 
+#include <atomic>
 #include <vector>
 
 #define LSN_AUDIO_BUFFERS									288
@@ -120,8 +121,8 @@ namespace lsn {
 		std::vector<float>									m_vTmpBuffer;
 		/** The position within the temporary buffer of the current sample. */
 		size_t												m_sTmpBufferIdx = 0;
-		/** The frequency of the current buffer.  Flush to set (flushing copies from the "Next" value into this one). */
-		uint32_t											m_ui32Frequency = 44100;
+		/** The frequency of the current buffer.  Flush to set (flushing copies from the "Next" value into this one).  Set on the audio thread and read by the APU. */
+		std::atomic<uint32_t>								m_ui32Frequency = 44100;
 		/** The frequency to set after the next flush. */
 		uint32_t											m_ui32NextFrequency = 44100;
 		/** The size of each buffer in samples. */
@@ -0,0 +1,51 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: An audio "device" that discards all samples.  Used by headless builds that have no audio device.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+
+#if !defined( LSN_WINDOWS ) && !defined( LSN_APPLE )
+
+#include "LSNAudioBase.h"
+
+namespace lsn {
+
+	/**
+	 * Class CAudioNull
+	 * \brief An audio "device" that discards all samples.
+	 *
+	 * Description: An audio "device" that discards all samples.  Used by headless builds that have no audio device.
+	 */
+	class CAudioNull : public CAudioBase {
+	public :
+		// == Functions.
+		/**
+		 * Shuts down the audio.
+		 * 
+		 * \return Returns true if shutdown was successful.
+		 **/
+		virtual bool										ShutdownAudio() { return true; }
+
+		/**
+		 * Called when emulation begins.  Nothing is buffered, so there is nothing to reset.
+		 **/
+		virtual void										BeginEmulation() {}
+
+		/**
+		 * Adds a sample to the audio device.  The sample is discarded.
+		 *
+		 * \param _fSample The audio sample to be added.
+		 **/
+		virtual void										AddSample( float /*_fSample*/ ) {}
+	};
+
+}	// namespace lsn
+
+#endif  // #if !defined( LSN_WINDOWS ) && !defined( LSN_APPLE )
@@ -14,13 +14,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <numbers>
 #include <vector>
 
 
+#ifdef _WIN32
 #include <format>	// TMP
+#endif	// #ifdef _WIN32
 
 #if defined( _MSC_VER )
     // Microsoft Visual Studio Compiler.
@@ -68,6 +71,7 @@ namespace lsn {
 			m_gGen.ui64SrcSampleCnt = 0ULL;
 			m_gGen.ui64SampleCnt = 0ULL;
 			m_gGen.ui64SamplesBuffered = 0ULL;
+			m_gGen.ui64NextStoreCnt = 4ULL;
 			m_gGen.fLpf = 0.0f;
 			m_gGen.fHpf = 0.0f;
 			m_gGen.dInputHz = 0.0;
@@ -75,6 +79,7 @@ namespace lsn {
 			m_gGen.pfStoreSample = &CSampleBox::StoreSample;
 			m_gGen.pfConvolve = &CSampleBox::Convolve;
 			m_gGen.pfFinalCallback = &CSampleBox::PassThrough;
+			m_gGen.pvFinalParm = nullptr;
 
 			m_sSinc.sM = 0;
 
@@ -197,6 +202,7 @@ namespace lsn {
 			m_gGen.ui64SrcSampleCnt = 0ULL;
 			m_gGen.ui64SampleCnt = 0ULL;
 			m_gGen.ui64SamplesBuffered = 0ULL;
+			m_gGen.ui64NextStoreCnt = 4ULL;
 			m_gGen.dInputHz = _dInputRate;
 			m_gGen.fLpf = float( _dLpf );
 			m_gGen.fHpf = float( _dHpf );
@@ -214,17 +220,34 @@ namespace lsn {
 		 * \param _fSample The sample to add.
 		 **/
 		inline void											AddSample( float _fSample ) {
-			m_gGen.vBuffer[(m_gGen.ui64SrcSampleCnt++)%m_gGen.vBuffer.size()] = ProcessLpf( _fSample );
-			//m_gGen.vBuffer[(m_gGen.ui64SrcSampleCnt++)%m_gGen.vBuffer.size()] = _fSample;
-			if LSN_LIKELY( m_gGen.ui64SrcSampleCnt >= 4 ) {
-				// How many samples should we have processed until now?
-				uint64_t ui64SamplesUntilNow = uint64_t( (m_gGen.ui64SrcSampleCnt - 4.0) * (m_gGen.ui32OutputHz * 3.0) / m_gGen.dInputHz );
-				// Process as many as needed to catch up to where we should be.
-				while ( m_gGen.ui64SamplesBuffered <= ui64SamplesUntilNow ) {
-					double dIdx = m_gGen.ui64SamplesBuffered / (m_gGen.ui32OutputHz * 3.0) * m_gGen.dInputHz;
-					double dFrac = std::fmod( dIdx, 1.0 );
-					size_t sIdx = size_t( dIdx );
-					(this->*m_gGen.pfStoreSample)( sIdx, float( dFrac ) );
+			AddSamples( &_fSample, 1 );
+		}
+
+		/**
+		 * Adds a block of samples. Called at the input Hz.  The result is the same as calling AddSample() on each sample in order.
+		 * 
+		 * \param _pfSamples The samples to add.
+		 * \param _sTotal The number of samples to which _pfSamples points.
+		 **/
+		inline void											AddSamples( const float * _pfSamples, size_t _sTotal ) {
+			float * pfBuffer = m_gGen.vBuffer.data();
+			size_t sSize = m_gGen.vBuffer.size();
+			size_t sPos = size_t( m_gGen.ui64SrcSampleCnt % sSize );
+			for ( size_t I = 0; I < _sTotal; ++I ) {
+				pfBuffer[sPos] = ProcessLpf( _pfSamples[I] );
+				if ( ++sPos == sSize ) { sPos = 0; }
+				// Only the input samples that complete at least one intermediate sample need to do any more work.
+				if LSN_UNLIKELY( ++m_gGen.ui64SrcSampleCnt >= m_gGen.ui64NextStoreCnt ) {
+					// How many samples should we have processed until now?
+					uint64_t ui64SamplesUntilNow = SamplesUntil( m_gGen.ui64SrcSampleCnt );
+					// Process as many as needed to catch up to where we should be.
+					while ( m_gGen.ui64SamplesBuffered <= ui64SamplesUntilNow ) {
+						double dIdx = m_gGen.ui64SamplesBuffered / (m_gGen.ui32OutputHz * 3.0) * m_gGen.dInputHz;
+						double dFrac = std::fmod( dIdx, 1.0 );
+						size_t sIdx = size_t( dIdx );
+						(this->*m_gGen.pfStoreSample)( sIdx, float( dFrac ) );
+					}
+					m_gGen.ui64NextStoreCnt = NextStoreCount();
 				}
 			}
 		}
@@ -316,6 +339,13 @@ namespace lsn {
 			m_gGen.pvFinalParm = _pfParm;
 		}
 
+		/**
+		 * Gets the parameter passed to the output callback.
+		 * 
+		 * \return Returns the parameter last passed to SetOutputCallback().
+		 **/
+		inline void *										OutputCallbackParm() const { return m_gGen.pvFinalParm; }
+
 		/**
 		 * Calculates the _sM parameter for Init() given a transition bandwidth (the range of frequencies to transition from max volume to silence).
 		 * 
@@ -441,6 +471,7 @@ namespace lsn {
 		struct LSN_GENERAL {
 			uint64_t										ui64SrcSampleCnt;							/**< Total samples submitted so far. */
 			uint64_t										ui64SampleCnt;								/**< Total samples sent to the (ui32OutputHz * 3) buffer. */
+			uint64_t										ui64NextStoreCnt;							/**< The value of ui64SrcSampleCnt at which the next intermediate sample can be interpolated. */
 			uint64_t										ui64SamplesBuffered;						/**< Similar to ui64SampleCnt, but it counts how many samples have been interpolated.  Samples sent from the input buffer to the (ui32OutputHz * 3) buffer might temporarily be hold in a buffer in order to perform batch interpolations, so this number is always equal to or higher than ui64SampleCnt. */
 			double											dInputHz;									/**< The source frequency. */
 			PfStoreSample									pfStoreSample;								/**< The function for stoing a sample from the main input buffer to the intermediate buffer. */
@@ -505,6 +536,32 @@ namespace lsn {
 
 
 		// == Functions.
+		/**
+		 * Gets the number of intermediate samples, minus 1, that can be interpolated once a given number of input samples have been
+		 *	submitted.
+		 * 
+		 * \param _ui64SrcSampleCnt The number of input samples submitted.  Must be at least 4.
+		 * \return Returns the index of the last intermediate sample that can be interpolated.
+		 **/
+		inline uint64_t										SamplesUntil( uint64_t _ui64SrcSampleCnt ) const {
+			return uint64_t( (_ui64SrcSampleCnt - 4.0) * (m_gGen.ui32OutputHz * 3.0) / m_gGen.dInputHz );
+		}
+
+		/**
+		 * Finds the lowest input-sample count at which SamplesUntil() reaches the next intermediate sample.  SamplesUntil() never
+		 *	decreases, so the estimate is walked to the exact count using the same expression AddSamples() uses.
+		 * 
+		 * \return Returns the input-sample count at which the next intermediate sample can be interpolated.
+		 **/
+		uint64_t											NextStoreCount() const {
+			uint64_t ui64Min = std::max<uint64_t>( m_gGen.ui64SrcSampleCnt + 1, 4 );
+			uint64_t ui64Cnt = uint64_t( m_gGen.ui64SamplesBuffered * m_gGen.dInputHz / (m_gGen.ui32OutputHz * 3.0) ) + 4;
+			ui64Cnt = std::max( ui64Cnt, ui64Min );
+			while ( ui64Cnt > ui64Min && SamplesUntil( ui64Cnt - 1 ) >= m_gGen.ui64SamplesBuffered ) { --ui64Cnt; }
+			while ( SamplesUntil( ui64Cnt ) < m_gGen.ui64SamplesBuffered ) { ++ui64Cnt; }
+			return ui64Cnt;
+		}
+
 		/**
 		 * Interpolates and stores a single sample.  Called at (Output Hz * 3).  Samples get stored into the intermediate buffer
 		 *	where sinc filtering will happen.  Every 3rd of these samples gets pushed to the final output.
@@ -3,7 +3,7 @@
 #if defined( __APPLE__ )
 #include <OpenAL/al.h>
 #include <OpenAL/alc.h>
-#else
+#elif defined( _WIN32 ) || defined( _WIN64 )
 #include "al.h"
 #include "alc.h"
 #endif	// #if defined( __APPLE__ )
@@ -8,6 +8,7 @@
 
 #include "LSNBeesNes.h"
 #include "../File/LSNStdFile.h"
+#include "../Utilities/LSNProfiler.h"
 #include <filesystem>
 
 
@@ -307,6 +308,7 @@ namespace lsn {
 	 */
 	void CBeesNes::Render( uint32_t _ui32FinalW, uint32_t _ui32FinalH ) {
 		if ( m_cfartCurFilterAndTargets.bDirty && m_cfartCurFilterAndTargets.pfbPrevFilter ) {
+			LSN_PROFILE_SCOPE( "Render" );
 			m_cfartCurFilterAndTargets.bDirty = false;
 			m_cfartCurFilterAndTargets.pui8LastFilteredResult = m_cfartCurFilterAndTargets.pfbPrevFilter->ApplyFilter( m_cfartCurFilterAndTargets.pui8CurRenderTarget,
 				m_cfartCurFilterAndTargets.ui32Width, m_cfartCurFilterAndTargets.ui32Height, m_cfartCurFilterAndTargets.ui16Bits, m_cfartCurFilterAndTargets.ui32Stride,
@@ -352,12 +354,26 @@ namespace lsn {
 	 * \return Returns true if the ROM was loaded successfully.
 	 */
 	bool CBeesNes::LoadRom( const std::vector<uint8_t> &_vRom, const std::u16string &_s16Path, LSN_PPU_METRICS _pmRegion ) {
+		CRomBuffer rbRom;
+		if ( !rbRom.Copy( _vRom.data(), _vRom.size() ) ) { return false; }
+		return LoadRom( rbRom, _s16Path, _pmRegion );
+	}
+
+	/**
+	 * Loads a ROM from a mapped file or owned image.  The loaded ROM points into _rbRom rather than copying it.
+	 *
+	 * \param _rbRom The ROM file.
+	 * \param _s16Path The full path to the ROM.
+	 * \param _pmRegion The region to use when loading the ROM.  If LSN_PM_UNKNOWN, the ROM data is used to determine the region.
+	 * \return Returns true if the ROM was loaded successfully.
+	 */
+	bool CBeesNes::LoadRom( const CRomBuffer &_rbRom, const std::u16string &_s16Path, LSN_PPU_METRICS _pmRegion ) {
 		LSN_ROM rTmp;
 		if ( m_u16PerGameSettings.size() ) {
 			SavePerGameSettings( m_u16PerGameSettings );
 			m_u16PerGameSettings.clear();
 		}
-		if ( CSystemBase::LoadRom( _vRom, rTmp, _s16Path ) ) {
+		if ( CSystemBase::LoadRom( _rbRom, rTmp, _s16Path ) ) {
 			//m_pnsSystem.reset();
 			LSN_PPU_METRICS pmReg = _pmRegion;
 			m_pmSystem = pmReg;
@@ -244,6 +244,16 @@ namespace lsn {
 		 */
 		bool									LoadRom( const std::vector<uint8_t> &_vRom, const std::u16string &_s16Path, LSN_PPU_METRICS _pmRegion = LSN_PM_UNKNOWN );
 
+		/**
+		 * Loads a ROM from a mapped file or owned image.  The loaded ROM points into _rbRom rather than copying it.
+		 *
+		 * \param _rbRom The ROM file.
+		 * \param _s16Path The full path to the ROM.
+		 * \param _pmRegion The region to use when loading the ROM.  If LSN_PM_UNKNOWN, the ROM data is used to determine the region.
+		 * \return Returns true if the ROM was loaded successfully.
+		 */
+		bool									LoadRom( const CRomBuffer &_rbRom, const std::u16string &_s16Path, LSN_PPU_METRICS _pmRegion = LSN_PM_UNKNOWN );
+
 		/**
 		 * Gets the rapid-fire patterns.
 		 *
@@ -31,6 +31,13 @@
  * An outward-facing design decision is to have the entire block of system RAM contiguous in memory
  *	here to make it easier to parse by external readers (IE an external debugger).
  *
+ * In front of the per-address accessors sits a table with one entry per 256-byte page.  A page whose
+ *	every address is a plain StdRead()/StdWrite() of a linear run of RAM (which includes mirrored RAM)
+ *	gets a direct pointer, and accesses to it are a single indexed load or store.  Only pages that
+ *	contain I/O or other special-case handlers go through the function pointers.  Changing any accessor
+ *	or open-bus mask on a page drops it back to the accessors until the page is re-examined.  Mappers
+ *	use SetPagePointers() to publish their PGM/CHR bank windows the same way.
+ *
  * Since the memory is contiguous and directly part of this class, allocating this on the stack
  *	may cause a stack overflow.
  */
@@ -39,6 +46,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include "../Utilities/LSNStream.h"
 
 #ifdef LSN_CPU_VERIFY
 #include <vector>
@@ -78,6 +86,13 @@ namespace lsn {
 	 * An outward-facing design decision is to have the entire block of system RAM contiguous in memory
 	 *	here to make it easier to parse by external readers (IE an external debugger).
 	 *
+	 * In front of the per-address accessors sits a table with one entry per 256-byte page.  A page whose
+	 *	every address is a plain StdRead()/StdWrite() of a linear run of RAM (which includes mirrored RAM)
+	 *	gets a direct pointer, and accesses to it are a single indexed load or store.  Only pages that
+	 *	contain I/O or other special-case handlers go through the function pointers.  Changing any accessor
+	 *	or open-bus mask on a page drops it back to the accessors until the page is re-examined.  Mappers
+	 *	use SetPagePointers() to publish their PGM/CHR bank windows the same way.
+	 *
 	 * Since the memory is contiguous and directly part of this class, allocating this on the stack
 	 *	may cause a stack overflow.
 	 */
@@ -87,6 +102,18 @@ namespace lsn {
 		// == Various constructors.
 		CBus() :
 			m_ui8LastRead( 0 ) {
+			for ( auto I = LSN_ELEMENTS( m_pgPages ); I--; ) {
+				m_pgPages[I].pui8Read = nullptr;
+				m_pgPages[I].pui8Write = nullptr;
+				m_piPageInfo[I].pfWriteNotify = nullptr;
+				m_piPageInfo[I].pvWriteNotifyParm0 = nullptr;
+				m_piPageInfo[I].pfReadSync = nullptr;
+				m_piPageInfo[I].pfWriteSync = nullptr;
+				m_piPageInfo[I].pvSyncParm0 = nullptr;
+				m_piPageInfo[I].ui32Generation = 0;
+				m_piPageInfo[I].bDirty = false;
+			}
+			std::memset( m_ui8Ram, 0, sizeof( m_ui8Ram ) );
 		}
 		~CBus() {
 			ResetToKnown();
@@ -117,6 +144,20 @@ namespace lsn {
 			LSN_ADDR_ACCESSOR				aaOriginalFuncs;				/**< The original read/write functions and parameters so that the trampoline can call them if needed. */
 		};
 
+		/** A function called after a write to a page has gone through its accessor. */
+		typedef void (LSN_FASTCALL *		PfNotifyFunc)( void * _pvParm0 );
+
+		/** Describes a page whose accessors all share one function and parameter and whose second parameters form a linear run. */
+		struct LSN_LINEAR_PAGE {
+			PfReadFunc						pfReader;						/**< The function shared by every reader on the page, or nullptr if the readers are not linear. */
+			void *							pvReaderParm0;					/**< The readers' shared first parameter. */
+			PfWriteFunc						pfWriter;						/**< The function shared by every writer on the page, or nullptr if the writers are not linear. */
+			void *							pvWriterParm0;					/**< The writers' shared first parameter. */
+			uint32_t						ui32Generation;					/**< The generation of the page when it was examined. */
+			uint16_t						ui16ReaderParm1;				/**< The first reader's second parameter. */
+			uint16_t						ui16WriterParm1;				/**< The first writer's second parameter. */
+		};
+
 
 		// == Functions.
 		/**
@@ -133,6 +174,7 @@ namespace lsn {
 		 */
 		void								ResetAnalog() {
 			std::memset( m_ui8OpenBusMask, 0xFF, sizeof( m_ui8OpenBusMask ) );
+			InvalidateAllPages();
 		}
 
 		/**
@@ -144,6 +186,14 @@ namespace lsn {
 				SetWriteFunc( uint16_t( I ), StdWrite, nullptr, uint16_t( I ) );
 			}
 			std::memset( m_ui8OpenBusMask, 0xFF, sizeof( m_ui8OpenBusMask ) );
+			InvalidateAllPages();
+			for ( auto I = LSN_ELEMENTS( m_piPageInfo ); I--; ) {
+				m_piPageInfo[I].pfWriteNotify = nullptr;
+				m_piPageInfo[I].pvWriteNotifyParm0 = nullptr;
+				m_piPageInfo[I].pfReadSync = nullptr;
+				m_piPageInfo[I].pfWriteSync = nullptr;
+				m_piPageInfo[I].pvSyncParm0 = nullptr;
+			}
 #ifdef LSN_CPU_VERIFY
 			m_vReadWriteLog.clear();
 #endif	// #ifdef LSN_CPU_VERIFY
@@ -156,24 +206,22 @@ namespace lsn {
 		 * \return Returns the requested value.
 		 */
 		inline uint8_t						Read( uint16_t _ui16Addr ) {
-			uint8_t ui8Ret = m_ui8LastRead;
-			uint8_t ui8Mask;
+			uint8_t ui8Ret;
+			uint16_t ui16Addr;
 			if constexpr ( _uSize == 0x10000 ) {
-				const LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[_ui16Addr];
-				aaAcc.pfReader( aaAcc.pvReaderParm0,
-					aaAcc.ui16ReaderParm1,
-					m_ui8Ram, ui8Ret );
-				ui8Mask = m_ui8OpenBusMask[_ui16Addr];
+				ui16Addr = _ui16Addr;
 			}
 			else {
-				uint16_t ui16Addr = _ui16Addr & (_uSize - 1);
-				const LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[ui16Addr];
-				aaAcc.pfReader( aaAcc.pvReaderParm0,
-					aaAcc.ui16ReaderParm1,
-					m_ui8Ram, ui8Ret );
-				ui8Mask = m_ui8OpenBusMask[ui16Addr];
+				ui16Addr = _ui16Addr & (_uSize - 1);
+			}
+			const uint8_t * pui8Page = m_pgPages[ui16Addr>>8].pui8Read;
+			if LSN_LIKELY( pui8Page ) {
+				ui8Ret = pui8Page[ui16Addr&0xFF];
+				m_ui8LastRead = ui8Ret;
+			}
+			else {
+				ui8Ret = ReadAccessor( ui16Addr );
 			}
-			m_ui8LastRead = (m_ui8LastRead & ~ui8Mask) | (ui8Ret & ui8Mask);
 
 #ifdef LSN_CPU_VERIFY
 			m_vReadWriteLog.push_back( { .ui16Address = _ui16Addr, .ui8Value = ui8Ret, .bRead = true } );
@@ -188,23 +236,21 @@ namespace lsn {
 		 * \param _ui8Val The value to write.
 		 */
 		inline void							Write( uint16_t _ui16Addr, uint8_t _ui8Val ) {
-			uint8_t ui8Mask;
+			uint16_t ui16Addr;
 			if constexpr ( _uSize == 0x10000 ) {
-				const LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[_ui16Addr];
-				aaAcc.pfWriter( aaAcc.pvWriterParm0,
-					aaAcc.ui16WriterParm1,
-					m_ui8Ram, _ui8Val );
-				ui8Mask = m_ui8OpenBusMask[_ui16Addr];
+				ui16Addr = _ui16Addr;
 			}
 			else {
-				uint16_t ui16Addr = _ui16Addr & (_uSize - 1);
-				const LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[ui16Addr];
-				aaAcc.pfWriter( aaAcc.pvWriterParm0,
-					aaAcc.ui16WriterParm1,
-					m_ui8Ram, _ui8Val );
-				ui8Mask = m_ui8OpenBusMask[ui16Addr];
+				ui16Addr = _ui16Addr & (_uSize - 1);
+			}
+			uint8_t * pui8Page = m_pgPages[ui16Addr>>8].pui8Write;
+			if LSN_LIKELY( pui8Page ) {
+				pui8Page[ui16Addr&0xFF] = _ui8Val;
+				m_ui8LastRead = _ui8Val;
+			}
+			else {
+				WriteAccessor( ui16Addr, _ui8Val );
 			}
-			m_ui8LastRead = (m_ui8LastRead & ~ui8Mask) | (_ui8Val & ui8Mask);
 
 #ifdef LSN_CPU_VERIFY
 			m_vReadWriteLog.push_back( { .ui16Address = _ui16Addr, .ui8Value = _ui8Val, .bRead = false } );
@@ -237,6 +283,7 @@ namespace lsn {
 		inline void							SetFloatMask( uint16_t _ui16Addr, uint8_t _ui8Mask ) {
 			uint16_t ui16Addr = _ui16Addr & (_uSize - 1);
 			m_ui8OpenBusMask[ui16Addr] = _ui8Mask;
+			InvalidatePage( ui16Addr );
 		}
 
 		/**
@@ -259,6 +306,7 @@ namespace lsn {
 				m_aaAccessors[_ui16Address].pfReader = _pfReadFunc;
 				m_aaAccessors[_ui16Address].pvReaderParm0 = _pvParm0;
 				m_aaAccessors[_ui16Address].ui16ReaderParm1 = _ui16Parm1;
+				InvalidatePage( _ui16Address );
 			}
 		}
 
@@ -275,6 +323,7 @@ namespace lsn {
 				m_aaAccessors[_ui16Address].pfWriter = _pfWriteFunc;
 				m_aaAccessors[_ui16Address].pvWriterParm0 = _pvParm0;
 				m_aaAccessors[_ui16Address].ui16WriterParm1 = _ui16Parm1;
+				InvalidatePage( _ui16Address );
 			}
 		}
 
@@ -296,6 +345,7 @@ namespace lsn {
 				m_aaAccessors[_ui16Address].pfReader = _pfReadFunc;
 				m_aaAccessors[_ui16Address].pvReaderParm0 = _ptTrampoline;
 				m_aaAccessors[_ui16Address].ui16ReaderParm1 = _ui16Parm1;
+				InvalidatePage( _ui16Address );
 			}
 		}
 
@@ -317,9 +367,114 @@ namespace lsn {
 				m_aaAccessors[_ui16Address].pfWriter = _pfWriteFunc;
 				m_aaAccessors[_ui16Address].pvWriterParm0 = _ptTrampoline;
 				m_aaAccessors[_ui16Address].ui16WriterParm1 = _ui16Parm1;
+				InvalidatePage( _ui16Address );
 			}
 		}
 
+		/**
+		 * Gives a page direct read and/or write pointers.  The pointers stay in place until an accessor or open-bus mask on the page
+		 *	changes or they are replaced by another call.  Callers are responsible for keeping them in sync with the accessors they
+		 *	stand in for.
+		 *
+		 * \param _ui16Address An address inside the page.
+		 * \param _pui8Read The 256 bytes to read, or nullptr to read through the accessors.
+		 * \param _pui8Write The 256 bytes to write, or nullptr to write through the accessors.
+		 */
+		void								SetPagePointers( uint16_t _ui16Address, const uint8_t * _pui8Read, uint8_t * _pui8Write ) {
+			size_t sPage = (_ui16Address & (_uSize - 1)) >> 8;
+			m_pgPages[sPage].pui8Read = _pui8Read;
+			m_pgPages[sPage].pui8Write = _pui8Write;
+			m_piPageInfo[sPage].bDirty = false;
+		}
+
+		/**
+		 * Sets a function to call after every write to a page that goes through the page's accessors.  Cleared by ApplyMap().
+		 *
+		 * \param _ui16Address An address inside the page.
+		 * \param _pfNotify The function to call, or nullptr.
+		 * \param _pvParm0 The parameter to pass to _pfNotify.
+		 */
+		void								SetWriteNotify( uint16_t _ui16Address, PfNotifyFunc _pfNotify, void * _pvParm0 ) {
+			size_t sPage = (_ui16Address & (_uSize - 1)) >> 8;
+			m_piPageInfo[sPage].pfWriteNotify = _pfNotify;
+			m_piPageInfo[sPage].pvWriteNotifyParm0 = _pvParm0;
+		}
+
+		/**
+		 * Sets functions to call before every read or write of a page that goes through the page's accessors.  Pages with direct
+		 *	pointers are plain memory and are never synchronized.  Cleared by ApplyMap().
+		 *
+		 * \param _ui16Address An address inside the page.
+		 * \param _pfReadSync The function to call before a read, or nullptr.
+		 * \param _pfWriteSync The function to call before a write, or nullptr.
+		 * \param _pvParm0 The parameter to pass to _pfReadSync and _pfWriteSync.
+		 */
+		void								SetAccessSync( uint16_t _ui16Address, PfNotifyFunc _pfReadSync, PfNotifyFunc _pfWriteSync, void * _pvParm0 ) {
+			size_t sPage = (_ui16Address & (_uSize - 1)) >> 8;
+			m_piPageInfo[sPage].pfReadSync = _pfReadSync;
+			m_piPageInfo[sPage].pfWriteSync = _pfWriteSync;
+			m_piPageInfo[sPage].pvSyncParm0 = _pvParm0;
+		}
+
+		/**
+		 * Gets the generation of a page.  The generation changes every time an accessor or open-bus mask on the page changes.
+		 *
+		 * \param _ui16Address An address inside the page.
+		 * \return Returns the generation of the page.
+		 */
+		inline uint32_t						PageGeneration( uint16_t _ui16Address ) const {
+			return m_piPageInfo[(_ui16Address&(_uSize-1))>>8].ui32Generation;
+		}
+
+		/**
+		 * Examines the accessors of a page.  A side is reported as linear if every address on the page uses the same function and first
+		 *	parameter, the second parameters increase by 1 from address to address, and every open-bus mask on the page is 0xFF.
+		 *
+		 * \param _ui16Address An address inside the page.
+		 * \param _lpRet Holds the description of the page.  pfReader and/or pfWriter are nullptr for a side that is not linear.
+		 */
+		void								GetLinearPage( uint16_t _ui16Address, LSN_LINEAR_PAGE &_lpRet ) const {
+			const size_t sStart = size_t( _ui16Address & (_uSize - 1) ) & ~size_t( 0xFF );
+			const LSN_ADDR_ACCESSOR * paaPage = &m_aaAccessors[sStart];
+			_lpRet.pfReader = nullptr;
+			_lpRet.pvReaderParm0 = paaPage[0].pvReaderParm0;
+			_lpRet.pfWriter = nullptr;
+			_lpRet.pvWriterParm0 = paaPage[0].pvWriterParm0;
+			_lpRet.ui32Generation = m_piPageInfo[sStart>>8].ui32Generation;
+			_lpRet.ui16ReaderParm1 = paaPage[0].ui16ReaderParm1;
+			_lpRet.ui16WriterParm1 = paaPage[0].ui16WriterParm1;
+
+			for ( size_t I = 0; I < 256; ++I ) {
+				if ( m_ui8OpenBusMask[sStart+I] != 0xFF ) { return; }
+			}
+			bool bRead = true, bWrite = true;
+			for ( size_t I = 1; I < 256 && (bRead || bWrite); ++I ) {
+				bRead = bRead && paaPage[I].pfReader == paaPage[0].pfReader && paaPage[I].pvReaderParm0 == paaPage[0].pvReaderParm0 &&
+					paaPage[I].ui16ReaderParm1 == uint16_t( paaPage[0].ui16ReaderParm1 + I );
+				bWrite = bWrite && paaPage[I].pfWriter == paaPage[0].pfWriter && paaPage[I].pvWriterParm0 == paaPage[0].pvWriterParm0 &&
+					paaPage[I].ui16WriterParm1 == uint16_t( paaPage[0].ui16WriterParm1 + I );
+			}
+			if ( bRead ) { _lpRet.pfReader = paaPage[0].pfReader; }
+			if ( bWrite ) { _lpRet.pfWriter = paaPage[0].pfWriter; }
+		}
+
+		/**
+		 * Gets the accessor assigned to an address.
+		 *
+		 * \param _ui16Address The address whose accessor is to be returned.
+		 * \return Returns a constant reference to the accessor assigned to the address.
+		 */
+		inline const LSN_ADDR_ACCESSOR &	GetAccessor( uint16_t _ui16Address ) const {
+			return m_aaAccessors[_ui16Address&(_uSize-1)];
+		}
+
+		/**
+		 * Gets a pointer to the bus memory, which is passed as _pui8Data to every accessor.
+		 *
+		 * \return Returns a pointer to the bus memory.
+		 */
+		inline uint8_t *					Memory() { return m_ui8Ram; }
+
 		/**
 		 * Copy data to the bus.
 		 *
@@ -356,6 +511,29 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Writes the bus memory and the floating value to a stream.  Accessors and pages are part of the wiring set up by
+		 *	ApplyMap() and the components, not the state, and are not written.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		bool								SaveState( CStream &_sStream ) const {
+			_sStream.Write( m_ui8Ram, sizeof( m_ui8Ram ) );
+			return _sStream.WriteUi8( m_ui8LastRead );
+		}
+
+		/**
+		 * Reads the bus memory and the floating value from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		bool								LoadState( CStream &_sStream ) {
+			if ( _sStream.Read( m_ui8Ram, sizeof( m_ui8Ram ) ) != sizeof( m_ui8Ram ) ) { return false; }
+			return _sStream.ReadUi8( m_ui8LastRead );
+		}
+
 		/**
 		 * A standard read function.
 		 *
@@ -424,13 +602,138 @@ namespace lsn {
 
 
 	protected :
+		// == Types.
+		/** A 256-byte page of the address space. */
+		struct LSN_PAGE {
+			const uint8_t *					pui8Read;						/**< Direct pointer for reads from the page, or nullptr to use the per-address accessors. */
+			uint8_t *						pui8Write;						/**< Direct pointer for writes to the page, or nullptr to use the per-address accessors. */
+		};
+
+		/** Bookkeeping for a page, kept apart from LSN_PAGE so that the table used by every access stays small. */
+		struct LSN_PAGE_INFO {
+			PfNotifyFunc					pfWriteNotify;					/**< Called after a write to the page goes through its accessor. */
+			void *							pvWriteNotifyParm0;				/**< The parameter passed to pfWriteNotify. */
+			PfNotifyFunc					pfReadSync;						/**< Called before a read of the page goes through its accessor. */
+			PfNotifyFunc					pfWriteSync;					/**< Called before a write to the page goes through its accessor. */
+			void *							pvSyncParm0;					/**< The parameter passed to pfReadSync and pfWriteSync. */
+			uint32_t						ui32Generation;					/**< Incremented each time the page is invalidated. */
+			bool							bDirty;							/**< An accessor or open-bus mask on the page changed since it was last examined. */
+		};
+
+
 		// == Members.
+		LSN_PAGE							m_pgPages[_uSize/256];			/**< The page table checked before the per-address accessors. */
+		LSN_PAGE_INFO						m_piPageInfo[_uSize/256];		/**< Page bookkeeping. */
 		uint8_t								m_ui8OpenBusMask[_uSize];		/**< The open-bus update mask.  Usually 0xFF to update all bits, but $4015 is set to 0x00 to update no floating-bus bits. */
 		uint8_t								m_ui8Ram[_uSize];				/**< Memory of _uSize bytes. */
 		LSN_ADDR_ACCESSOR					m_aaAccessors[_uSize];			/**< Access functions. */
 		uint8_t								m_ui8LastRead;					/**< The floating value. */
 
 
+		// == Functions.
+		/**
+		 * Reads an address through its accessor function.  Called for pages that have no direct pointer.
+		 *
+		 * \param _ui16Addr The address to read, already masked to the size of the bus.
+		 * \return Returns the requested value.
+		 */
+		uint8_t								ReadAccessor( uint16_t _ui16Addr ) {
+			const LSN_PAGE_INFO & piInfo = m_piPageInfo[_ui16Addr>>8];
+			if LSN_UNLIKELY( piInfo.bDirty ) {
+				UpdatePage( _ui16Addr >> 8 );
+			}
+			if LSN_UNLIKELY( piInfo.pfReadSync ) {
+				piInfo.pfReadSync( piInfo.pvSyncParm0 );
+			}
+			uint8_t ui8Ret = m_ui8LastRead;
+			const LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[_ui16Addr];
+			aaAcc.pfReader( aaAcc.pvReaderParm0,
+				aaAcc.ui16ReaderParm1,
+				m_ui8Ram, ui8Ret );
+			uint8_t ui8Mask = m_ui8OpenBusMask[_ui16Addr];
+			m_ui8LastRead = (m_ui8LastRead & ~ui8Mask) | (ui8Ret & ui8Mask);
+			return ui8Ret;
+		}
+
+		/**
+		 * Writes an address through its accessor function.  Called for pages that have no direct pointer.
+		 *
+		 * \param _ui16Addr The address to write, already masked to the size of the bus.
+		 * \param _ui8Val The value to write.
+		 */
+		void								WriteAccessor( uint16_t _ui16Addr, uint8_t _ui8Val ) {
+			LSN_PAGE_INFO & piInfo = m_piPageInfo[_ui16Addr>>8];
+			if LSN_UNLIKELY( piInfo.bDirty ) {
+				UpdatePage( _ui16Addr >> 8 );
+			}
+			if LSN_UNLIKELY( piInfo.pfWriteSync ) {
+				piInfo.pfWriteSync( piInfo.pvSyncParm0 );
+			}
+			const LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[_ui16Addr];
+			aaAcc.pfWriter( aaAcc.pvWriterParm0,
+				aaAcc.ui16WriterParm1,
+				m_ui8Ram, _ui8Val );
+			uint8_t ui8Mask = m_ui8OpenBusMask[_ui16Addr];
+			m_ui8LastRead = (m_ui8LastRead & ~ui8Mask) | (_ui8Val & ui8Mask);
+			if LSN_UNLIKELY( piInfo.pfWriteNotify ) {
+				piInfo.pfWriteNotify( piInfo.pvWriteNotifyParm0 );
+			}
+		}
+
+		/**
+		 * Drops the page containing the given address back to its per-address accessors and flags it to be re-examined on its next access.
+		 *
+		 * \param _ui16Addr An address inside the page to invalidate.
+		 */
+		inline void							InvalidatePage( uint16_t _ui16Addr ) {
+			size_t sPage = (_ui16Addr & (_uSize - 1)) >> 8;
+			m_pgPages[sPage].pui8Read = nullptr;
+			m_pgPages[sPage].pui8Write = nullptr;
+			++m_piPageInfo[sPage].ui32Generation;
+			m_piPageInfo[sPage].bDirty = true;
+		}
+
+		/**
+		 * Invalidates every page.
+		 */
+		void								InvalidateAllPages() {
+			for ( auto I = LSN_ELEMENTS( m_pgPages ); I--; ) {
+				m_pgPages[I].pui8Read = nullptr;
+				m_pgPages[I].pui8Write = nullptr;
+				++m_piPageInfo[I].ui32Generation;
+				m_piPageInfo[I].bDirty = true;
+			}
+		}
+
+		/**
+		 * Examines a page and gives it direct read and/or write pointers if every address on it is a plain linear access of RAM
+		 *	that updates all bits of the floating bus.
+		 *
+		 * \param _sPage The index of the page to examine.
+		 */
+		void								UpdatePage( size_t _sPage ) {
+			LSN_PAGE & pgPage = m_pgPages[_sPage];
+			m_piPageInfo[_sPage].bDirty = false;
+			pgPage.pui8Read = nullptr;
+			pgPage.pui8Write = nullptr;
+
+			const size_t sStart = _sPage << 8;
+			for ( size_t I = 0; I < 256; ++I ) {
+				if ( m_ui8OpenBusMask[sStart+I] != 0xFF ) { return; }
+			}
+
+			const LSN_ADDR_ACCESSOR * paaPage = &m_aaAccessors[sStart];
+			bool bRead = paaPage[0].pfReader == StdRead && size_t( paaPage[0].ui16ReaderParm1 ) + 255 < _uSize;
+			bool bWrite = paaPage[0].pfWriter == StdWrite && size_t( paaPage[0].ui16WriterParm1 ) + 255 < _uSize;
+			for ( size_t I = 1; I < 256 && (bRead || bWrite); ++I ) {
+				bRead = bRead && paaPage[I].pfReader == StdRead && paaPage[I].ui16ReaderParm1 == paaPage[0].ui16ReaderParm1 + I;
+				bWrite = bWrite && paaPage[I].pfWriter == StdWrite && paaPage[I].ui16WriterParm1 == paaPage[0].ui16WriterParm1 + I;
+			}
+			if ( bRead ) { pgPage.pui8Read = &m_ui8Ram[paaPage[0].ui16ReaderParm1]; }
+			if ( bWrite ) { pgPage.pui8Write = &m_ui8Ram[paaPage[0].ui16WriterParm1]; }
+		}
+
+
 #ifdef LSN_CPU_VERIFY
 		// == Members.
 		std::vector<LSN_READ_WRITE_LOG>		m_vReadWriteLog;
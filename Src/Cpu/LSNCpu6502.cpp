@@ -17,8 +17,11 @@
 #include "LSNCpu6502.h"
 #include "LSNInstMetaData.inl"
 
+#include <cassert>
+
 #ifdef LSN_CPU_VERIFY
-#include "EEExpEval.h"
+#include <cinttypes>
+#include <cstdio>
 #endif	// #ifdef LSN_CPU_VERIFY
 
 namespace lsn {
@@ -26,8 +29,29 @@ namespace lsn {
 	// == Members.
 #include "LSNCycleFuncs.inl"
 
+	/** For each opcode, the index into m_pfCycleFuncs of the function that handles each cycle. */
+	uint16_t CCpu6502::m_ui16CycleFuncs[256][LSN_M_MAX_INSTR_CYCLE_COUNT*2];
+
+	/** Every distinct cycle function in m_iInstructionSet.  Index 0 is nullptr. */
+	CCpu6502::PfCycle CCpu6502::m_pfCycleFuncs[LSN_M_MAX_CYCLE_FUNCS];
+
+	/** Every function to which m_pfTickFunc can point, indexed by save states. */
+	const CCpu6502::PfTicks CCpu6502::m_ptTickFuncs[8] = {
+		&CCpu6502::Tick_NextInstructionStd,
+		&CCpu6502::Tick_InstructionCycleStd,
+		&CCpu6502::Tick_Dma<CCpu6502::LSN_DS_IDLE, false>,
+		&CCpu6502::Tick_Dma<CCpu6502::LSN_DS_IDLE, true>,
+		&CCpu6502::Tick_Dma<CCpu6502::LSN_DS_READ_WRITE, false>,
+		&CCpu6502::Tick_Dma<CCpu6502::LSN_DS_READ_WRITE, true>,
+		&CCpu6502::Tick_Dma<CCpu6502::LSN_DS_END, false>,
+		&CCpu6502::Tick_Dma<CCpu6502::LSN_DS_END, true>,
+	};
+
 	CCpu6502::CCpu6502( CCpuBus * _pbBus ) :
 		CCpuBase( _pbBus ) {
+		static const bool bBuilt = BuildCycleFuncs();
+		assert( bBuilt );
+		static_cast<void>(bBuilt);
 
 		m_pfTickFunc = m_pfTickFuncCopy = &CCpu6502::Tick_NextInstructionStd;
 	}
@@ -46,9 +70,7 @@ namespace lsn {
 		m_bIrqStatusPhi1Flag = m_bIrqSeenLowPhi2;
 		m_bIrqSeenLowPhi2 = false;
 
-#ifndef LSN_CPU_VERIFY
-		m_pmbMapper->Tick();
-#endif	// #ifndef LSN_CPU_VERIFY
+		if LSN_UNLIKELY( m_pfMapperTick ) { m_pfMapperTick( m_pmbMapper ); }
 		(this->*m_pfTickFunc)();
 	}
 
@@ -163,235 +185,270 @@ namespace lsn {
 		return (m_ui8IrqStatusLine & _ui8Source) != 0;
 	}
 
-#ifdef LSN_CPU_VERIFY
 	/**
-	 * Runs a test given a JSON's value representing the test to run.
+	 * Writes the CPU state to a stream.
 	 *
-	 * \param _jJson The JSON file.
-	 * \param _jvTest The test to run.
-	 * \return Returns true if te test succeeds, false otherwise.
-	 */
-	bool CCpu6502::RunJsonTest( lson::CJson &_jJson, const lson::CJsonContainer::LSON_JSON_VALUE &_jvTest ) {
-		LSN_CPU_VERIFY_OBJ cvoVerifyMe;
-		if ( !GetTest( _jJson, _jvTest, cvoVerifyMe ) ) { return false; }
-
-		// Create the initial state.
-		ResetToKnown();
-		m_pbBus->ApplyMap();				// Set default read/write functions.
-		m_ui64CycleCount = 0;
-		m_rRegs.ui8A = cvoVerifyMe.cvsStart.cvrRegisters.ui8A;
-		m_rRegs.ui8S = cvoVerifyMe.cvsStart.cvrRegisters.ui8S;
-		m_rRegs.ui8X = cvoVerifyMe.cvsStart.cvrRegisters.ui8X;
-		m_rRegs.ui8Y = cvoVerifyMe.cvsStart.cvrRegisters.ui8Y;
-		m_rRegs.ui8Status = cvoVerifyMe.cvsStart.cvrRegisters.ui8Status;
-		m_rRegs.ui16Pc = cvoVerifyMe.cvsStart.cvrRegisters.ui16Pc;
-
-		for ( auto I = cvoVerifyMe.cvsStart.vRam.size(); I--; ) {
-			m_pbBus->Write( cvoVerifyMe.cvsStart.vRam[I].ui16Addr, cvoVerifyMe.cvsStart.vRam[I].ui8Value );
-		}
-		m_pbBus->ApplyMap();				// Set default read/write functions.
-
-		/*if ( "10 91 3e" == cvoVerifyMe.sName ) {
-			volatile int ghg = 0;
-		}*/
-		//m_bIsReset = true;
-		for ( auto I = cvoVerifyMe.vCycles.size(); I--; ) {
-			Tick();
-			/*if ( m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_JAM ) {
-				if ( m_bHandleNmi != I < 1 ) {
-					::OutputDebugStringA( "\r\nDouble-check polling.\r\n" );
-				}
-			}*/
-			m_bDetectedNmi = true;
-			TickPhi2();
-			if ( m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_JAM && m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_BRK &&
-				m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_BPL && m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_BNE && m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_BVC && m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_BVS &&
-				m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_BCC && m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_BCS && m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_BEQ && m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_BMI ) {
-				if ( m_bHandleNmi != (I <= 0) ) {
-					::OutputDebugStringA( "\r\nDouble-check polling.\r\n" );
-				}
-			}
-		}
-		Tick();
-		
-		// Verify.
-#define LSN_VURIFFY( REG )																																												\
-	if ( m_rRegs. ## REG != cvoVerifyMe.cvsEnd.cvrRegisters. ## REG ) {																																	\
-		::OutputDebugStringA( cvoVerifyMe.sName.c_str() );																																				\
-		::OutputDebugStringA( "\r\nCPU Failure: " # REG "\r\n" );																																		\
-		::OutputDebugStringA( (std::string( "Expected: ") + std::to_string( cvoVerifyMe.cvsEnd.cvrRegisters. ## REG ) +																					\
-			std::string( " (" ) + ee::CExpEval::ToHex( uint64_t( cvoVerifyMe.cvsEnd.cvrRegisters. ## REG ) ) + std::string( ") Got: " ) + std::to_string( m_rRegs. ## REG ) +							\
-			std::string( " (" ) + ee::CExpEval::ToHex( uint64_t( m_rRegs. ## REG ) ) + std::string( ")" )).c_str() );																					\
-		::OutputDebugStringA( "\r\n\r\n" );																																								\
-	}
-
-		LSN_VURIFFY( ui8A );
-		LSN_VURIFFY( ui8X );
-		LSN_VURIFFY( ui8Y );
-		LSN_VURIFFY( ui8S );
-		LSN_VURIFFY( ui8Status );
-		LSN_VURIFFY( ui16Pc );
-#undef LSN_VURIFFY
-
-		if ( m_ui8FuncIndex != 0 && m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_JAM ) {
-			::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
-			::OutputDebugStringA( "\r\nDidn't read the end of cycle functions.\r\n" );
-			::OutputDebugStringA( "\r\n\r\n" );
-		}
+	 * \param _sStream The stream to which to write the state.
+	 * \return Returns true if the state was written.
+	 **/
+	bool CCpu6502::SaveState( CStream &_sStream ) const {
+		size_t stTick = TickFuncIndex( m_pfTickFunc ), stTickCopy = TickFuncIndex( m_pfTickFuncCopy );
+		if ( stTick == LSN_ELEMENTS( m_ptTickFuncs ) || stTickCopy == LSN_ELEMENTS( m_ptTickFuncs ) ) { return false; }
+		if ( !_sStream.WriteUi64( m_ui64CycleCount ) ) { return false; }
+		if ( !_sStream.WriteUi8( uint8_t( stTick ) ) ) { return false; }
+		if ( !_sStream.WriteUi8( uint8_t( stTickCopy ) ) ) { return false; }
+		if ( !_sStream.Write( m_rRegs ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_vBrkVector ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16Address ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16Pointer ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16Target ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16OpCode ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16PcModify ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16DmaCounter ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16DmaAddress ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16DmaCpuAddress ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8Operand ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8SModify ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8FuncIndex ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8DmaPos ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8DmaValue ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8IrqStatusLine ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bNmiStatusLine ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bLastNmiStatusLine ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bDetectedNmi ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bHandleNmi ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bIrqSeenLowPhi2 ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bIrqStatusPhi1Flag ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bHandleIrq ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bIsReset ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bBoundaryCrossed ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bPushB ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bAllowWritingToPc ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bTakeJump ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bRdyLow ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bDmaGo ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bDmaRead ) ) { return false; }
+		_sStream.Write( m_ui8Inputs, sizeof( m_ui8Inputs ) );
+		_sStream.Write( m_ui8InputsState, sizeof( m_ui8InputsState ) );
+		_sStream.Write( m_ui8InputsPoll, sizeof( m_ui8InputsPoll ) );
+		return true;
+	}
 
-		if ( m_pbBus->ReadWriteLog().size() != cvoVerifyMe.vCycles.size() ) {
-			::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
-			::OutputDebugStringA( "\r\nInternal Error\r\n" );
-			::OutputDebugStringA( "\r\n\r\n" );
-		}
-		else {
-			//if ( m_pbBus->ReadWriteLog().size() != m_iInstructionSet[ui16LastInstr].
-			for ( size_t I = 0; I < m_pbBus->ReadWriteLog().size(); ++I ) {
-				if ( m_pbBus->ReadWriteLog()[I].ui16Address != cvoVerifyMe.vCycles[I].ui16Addr ) {
-					::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
-					::OutputDebugStringA( "\r\nCPU Failure: Cycle Address Wrong\r\n" );
-					::OutputDebugStringA( (std::string( "Expected: ") + std::to_string( cvoVerifyMe.vCycles[I].ui16Addr ) +
-						std::string( " (" ) + ee::CExpEval::ToHex( uint64_t( cvoVerifyMe.vCycles[I].ui16Addr ) ) + std::string( ") Got: " ) + std::to_string( m_pbBus->ReadWriteLog()[I].ui16Address ) +
-						std::string( " (" ) + ee::CExpEval::ToHex( uint64_t( m_pbBus->ReadWriteLog()[I].ui16Address ) ) + std::string( ")" ) ).c_str() );
-					::OutputDebugStringA( "\r\n\r\n" );
-				}
-				if ( m_pbBus->ReadWriteLog()[I].ui8Value != cvoVerifyMe.vCycles[I].ui8Value ) {
-					::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
-					::OutputDebugStringA( "\r\nCPU Failure: Cycle Value Wrong\r\n" );
-					::OutputDebugStringA( (std::string( "Expected: ") + std::to_string( cvoVerifyMe.vCycles[I].ui8Value ) +
-						std::string( " (" ) + ee::CExpEval::ToHex( uint64_t( cvoVerifyMe.vCycles[I].ui8Value ) ) + std::string( ") Got: " ) + std::to_string( m_pbBus->ReadWriteLog()[I].ui8Value ) +
-						std::string( " (" ) + ee::CExpEval::ToHex( uint64_t( m_pbBus->ReadWriteLog()[I].ui8Value ) ) + std::string( ")" ) ).c_str() );
-					::OutputDebugStringA( "\r\n\r\n" );
-				}
-				if ( m_pbBus->ReadWriteLog()[I].bRead != cvoVerifyMe.vCycles[I].bRead ) {
-					::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
-					::OutputDebugStringA( "\r\nCPU Failure: Cycle Read/Write Wrong\r\n" );
-					::OutputDebugStringA( (std::string( "Expected: ") + std::to_string( cvoVerifyMe.vCycles[I].bRead ) + std::string( " Got: " ) + std::to_string( m_pbBus->ReadWriteLog()[I].bRead ) ).c_str() );
-					::OutputDebugStringA( "\r\n\r\n" );
-				}
-			}
-		}
+	/**
+	 * Reads the CPU state from a stream.  The current instruction is restored from the opcode.
+	 *
+	 * \param _sStream The stream from which to read the state.
+	 * \return Returns true if the state was read.
+	 **/
+	bool CCpu6502::LoadState( CStream &_sStream ) {
+		uint8_t ui8Tick, ui8TickCopy;
+		uint16_t ui16Vector;
+		if ( !_sStream.ReadUi64( m_ui64CycleCount ) ) { return false; }
+		if ( !_sStream.ReadUi8( ui8Tick ) || ui8Tick >= LSN_ELEMENTS( m_ptTickFuncs ) ) { return false; }
+		if ( !_sStream.ReadUi8( ui8TickCopy ) || ui8TickCopy >= LSN_ELEMENTS( m_ptTickFuncs ) ) { return false; }
+		if ( !_sStream.Read( m_rRegs ) ) { return false; }
+		if ( !_sStream.ReadUi16( ui16Vector ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16Address ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16Pointer ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16Target ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16OpCode ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16PcModify ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16DmaCounter ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16DmaAddress ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16DmaCpuAddress ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8Operand ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8SModify ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8FuncIndex ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8DmaPos ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8DmaValue ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8IrqStatusLine ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bNmiStatusLine ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bLastNmiStatusLine ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bDetectedNmi ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bHandleNmi ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bIrqSeenLowPhi2 ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bIrqStatusPhi1Flag ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bHandleIrq ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bIsReset ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bBoundaryCrossed ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bPushB ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bAllowWritingToPc ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bTakeJump ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bRdyLow ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bDmaGo ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bDmaRead ) ) { return false; }
+		if ( _sStream.Read( m_ui8Inputs, sizeof( m_ui8Inputs ) ) != sizeof( m_ui8Inputs ) ) { return false; }
+		if ( _sStream.Read( m_ui8InputsState, sizeof( m_ui8InputsState ) ) != sizeof( m_ui8InputsState ) ) { return false; }
+		if ( _sStream.Read( m_ui8InputsPoll, sizeof( m_ui8InputsPoll ) ) != sizeof( m_ui8InputsPoll ) ) { return false; }
+		if ( m_ui16OpCode >= LSN_ELEMENTS( m_iInstructionSet ) ) { return false; }
+
+		m_pfTickFunc = m_ptTickFuncs[ui8Tick];
+		m_pfTickFuncCopy = m_ptTickFuncs[ui8TickCopy];
+		m_vBrkVector = static_cast<LSN_VECTORS>(ui16Vector);
+		m_pui16CurInstruction = m_ui16CycleFuncs[m_ui16OpCode];
 		return true;
 	}
-#endif	// #ifdef LSN_CPU_VERIFY
 
-#ifdef LSN_CPU_VERIFY
 	/**
-	 * Given a JSON object and the value for the test to run, this loads the test and fills a LSN_CPU_VERIFY structure.
+	 * Builds m_ui16CycleFuncs and m_pfCycleFuncs from m_iInstructionSet.  Called once, when the first CPU is created.
 	 *
-	 * \param _jJson The JSON file.
-	 * \param _jvTest The test to run.
-	 * \param _cvoTest The test structure to fill out.
-	 * \return Returns true if the JSON data was successfully extracted and the test created.
+	 * \return Returns true if every distinct cycle function fit into m_pfCycleFuncs.
 	 */
-	bool CCpu6502::GetTest( lson::CJson &_jJson, const lson::CJsonContainer::LSON_JSON_VALUE &_jvTest, LSN_CPU_VERIFY_OBJ &_cvoTest ) {
-		const lson::CJsonContainer::LSON_JSON_VALUE * pjvVal;
-		// The name.
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvTest, "name" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_STRING ) {
-			_cvoTest.sName = _jJson.GetContainer()->GetString( pjvVal->u.stString );
-		}
-		else { return false; }
-
-		// The initial state.
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvTest, "initial" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_OBJECT ) {
-			if ( !LoadState( _jJson, (*pjvVal), _cvoTest.cvsStart ) ) { return false; }
-		}
-		else { return false; }
-
-		// The final state.
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvTest, "final" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_OBJECT ) {
-			if ( !LoadState( _jJson, (*pjvVal), _cvoTest.cvsEnd ) ) { return false; }
-		}
-		else { return false; }
-
-		// The cycles.
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvTest, "cycles" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_ARRAY ) {
-			for ( size_t I = 0; I < pjvVal->vArray.size(); ++I ) {
-				const lson::CJsonContainer::LSON_JSON_VALUE & jvThis = _jJson.GetContainer()->GetValue( pjvVal->vArray[I] );
-				if ( jvThis.vtType == lson::CJsonContainer::LSON_VT_ARRAY && jvThis.vArray.size() == 3 ) {
-					LSN_CPU_VERIFY_CYCLE cvcCycle = {
-						.ui16Addr = uint16_t( _jJson.GetContainer()->GetValue( jvThis.vArray[0] ).u.dDecimal ),
-						.ui8Value = uint8_t( _jJson.GetContainer()->GetValue( jvThis.vArray[1] ).u.dDecimal ),
-						.bRead = _jJson.GetContainer()->GetString( _jJson.GetContainer()->GetValue( jvThis.vArray[2] ).u.stString ) == "read",
-					};
-					_cvoTest.vCycles.push_back( cvcCycle );
+	bool CCpu6502::BuildCycleFuncs() {
+		// Index 0 is for the unused cycles after the end of each instruction.
+		m_pfCycleFuncs[0] = nullptr;
+		size_t sTotal = 1;
+		for ( size_t I = 0; I < LSN_ELEMENTS( m_iInstructionSet ); ++I ) {
+			for ( size_t J = 0; J < LSN_ELEMENTS( m_iInstructionSet[I].pfHandler ); ++J ) {
+				PfCycle pfFunc = m_iInstructionSet[I].pfHandler[J];
+				size_t sIdx = 0;
+				if ( pfFunc ) {
+					for ( sIdx = 1; sIdx < sTotal && m_pfCycleFuncs[sIdx] != pfFunc; ++sIdx ) {}
+					if ( sIdx == sTotal ) {
+						if LSN_UNLIKELY( sTotal == LSN_ELEMENTS( m_pfCycleFuncs ) ) { return false; }
+						m_pfCycleFuncs[sTotal++] = pfFunc;
+					}
 				}
-				else { return false; }
+				m_ui16CycleFuncs[I][J] = uint16_t( sIdx );
 			}
 		}
-		else { return false; }
 		return true;
 	}
 
 	/**
-	 * Fills out a LSN_CPU_VERIFY_STATE structure given a JSON "initial" or "final" member.
+	 * Gets the index of a tick function in m_ptTickFuncs.
+	 *
+	 * \param _ptFunc The tick function to find.
+	 * \return Returns the index of the tick function or LSN_ELEMENTS( m_ptTickFuncs ) if it is not in the table.
+	 **/
+	size_t CCpu6502::TickFuncIndex( PfTicks _ptFunc ) {
+		for ( size_t I = 0; I < LSN_ELEMENTS( m_ptTickFuncs ); ++I ) {
+			if ( m_ptTickFuncs[I] == _ptFunc ) { return I; }
+		}
+		return LSN_ELEMENTS( m_ptTickFuncs );
+	}
+
+#ifdef LSN_CPU_VERIFY
+	/**
+	 * Runs a single-step test.  The CPU's bus must be a flat CCpuBus with nothing mapped over its RAM.
 	 *
-	 * \param _jJson The JSON file.
-	 * \param _jvState The bject member representing the state to load.
-	 * \param _cvsState The state structure to fill.
-	 * \return Returns true if the state was loaded.
+	 * \param _cvoTest The test to run.
+	 * \param _sError Holds a description of the first difference from the expected results if the test fails.
+	 * \return Returns true if the registers, RAM, and bus accesses all match the expected results.
 	 */
-	bool CCpu6502::LoadState( lson::CJson &_jJson, const lson::CJsonContainer::LSON_JSON_VALUE &_jvState, LSN_CPU_VERIFY_STATE &_cvsState ) {
-		const lson::CJsonContainer::LSON_JSON_VALUE * pjvVal;
+	bool CCpu6502::RunTest( const LSN_CPU_VERIFY_OBJ &_cvoTest, std::string &_sError ) {
+		_sError.clear();
 
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvState, "pc" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_DECIMAL ) {
-			_cvsState.cvrRegisters.ui16Pc = uint16_t( pjvVal->u.dDecimal );
-		}
-		else { return false; }
+		// Create the initial state.  Nothing is mapped over the RAM, so the bus only needs its log cleared between tests.
+		ResetToKnown();
+		m_ui64CycleCount = 0;
+		m_rRegs.ui8A = _cvoTest.cvsStart.cvrRegisters.ui8A;
+		m_rRegs.ui8S = _cvoTest.cvsStart.cvrRegisters.ui8S;
+		m_rRegs.ui8X = _cvoTest.cvsStart.cvrRegisters.ui8X;
+		m_rRegs.ui8Y = _cvoTest.cvsStart.cvrRegisters.ui8Y;
+		m_rRegs.ui8Status = _cvoTest.cvsStart.cvrRegisters.ui8Status;
+		m_rRegs.ui16Pc = _cvoTest.cvsStart.cvrRegisters.ui16Pc;
 
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvState, "s" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_DECIMAL ) {
-			_cvsState.cvrRegisters.ui8S = uint8_t( pjvVal->u.dDecimal );
+		for ( auto I = _cvoTest.cvsStart.vRam.size(); I--; ) {
+			m_pbBus->Write( _cvoTest.cvsStart.vRam[I].ui16Addr, _cvoTest.cvsStart.vRam[I].ui8Value );
 		}
-		else { return false; }
+		m_pbBus->ReadWriteLog().clear();	// Clear the log of the writes above.
 
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvState, "a" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_DECIMAL ) {
-			_cvsState.cvrRegisters.ui8A = uint8_t( pjvVal->u.dDecimal );
+		// Polling is only reported if nothing else differs, since running the wrong number of cycles also moves it.
+		std::string sPolling;
+		for ( auto I = _cvoTest.vCycles.size(); I--; ) {
+			Tick();
+			m_bDetectedNmi = true;
+			TickPhi2();
+			// Interrupts should be polled on the last cycle of every instruction but branches, BRK, and JAM.
+			switch ( m_iInstructionSet[m_ui16OpCode].iInstruction ) {
+				case LSN_I_JAM : {}
+				case LSN_I_BRK : {}
+				case LSN_I_BPL : {}
+				case LSN_I_BNE : {}
+				case LSN_I_BVC : {}
+				case LSN_I_BVS : {}
+				case LSN_I_BCC : {}
+				case LSN_I_BCS : {}
+				case LSN_I_BEQ : {}
+				case LSN_I_BMI : { break; }
+				default : {
+					if ( m_bHandleNmi != (I == 0) && sPolling.empty() ) {
+						sPolling = _cvoTest.sName + ": Interrupts polled on cycle " + std::to_string( _cvoTest.vCycles.size() - I ) + " of " + std::to_string( _cvoTest.vCycles.size() ) + ".";
+					}
+				}
+			}
 		}
-		else { return false; }
+		Tick();
 
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvState, "x" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_DECIMAL ) {
-			_cvsState.cvrRegisters.ui8X = uint8_t( pjvVal->u.dDecimal );
+		// Verify.
+#define LSN_VERIFY_REG( REG )																																									\
+		if ( m_rRegs.REG != _cvoTest.cvsEnd.cvrRegisters.REG ) {																																\
+			_sError = VerifyMismatch( _cvoTest.sName, #REG, _cvoTest.cvsEnd.cvrRegisters.REG, m_rRegs.REG );																					\
+			return false;																																										\
 		}
-		else { return false; }
 
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvState, "y" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_DECIMAL ) {
-			_cvsState.cvrRegisters.ui8Y = uint8_t( pjvVal->u.dDecimal );
-		}
-		else { return false; }
+		LSN_VERIFY_REG( ui8A );
+		LSN_VERIFY_REG( ui8X );
+		LSN_VERIFY_REG( ui8Y );
+		LSN_VERIFY_REG( ui8S );
+		LSN_VERIFY_REG( ui8Status );
+		LSN_VERIFY_REG( ui16Pc );
+#undef LSN_VERIFY_REG
 
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvState, "p" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_DECIMAL ) {
-			_cvsState.cvrRegisters.ui8Status = uint8_t( pjvVal->u.dDecimal );
+		if ( m_ui8FuncIndex != 0 && m_iInstructionSet[m_ui16OpCode].iInstruction != LSN_I_JAM ) {
+			_sError = _cvoTest.sName + ": Didn't reach the end of the cycle functions.";
+			return false;
 		}
-		else { return false; }
 
+		for ( size_t I = 0; I < _cvoTest.cvsEnd.vRam.size(); ++I ) {
+			uint8_t ui8Got = m_pbBus->DBG_Inspect( _cvoTest.cvsEnd.vRam[I].ui16Addr );
+			if ( ui8Got != _cvoTest.cvsEnd.vRam[I].ui8Value ) {
+				char szAddr[16];
+				std::snprintf( szAddr, sizeof( szAddr ), "RAM $%.4X", unsigned( _cvoTest.cvsEnd.vRam[I].ui16Addr ) );
+				_sError = VerifyMismatch( _cvoTest.sName, szAddr, _cvoTest.cvsEnd.vRam[I].ui8Value, ui8Got );
+				return false;
+			}
+		}
 
-		pjvVal = _jJson.GetContainer()->GetMemberByName( _jvState, "ram" );
-		if ( pjvVal && pjvVal->vtType == lson::CJsonContainer::LSON_VT_ARRAY ) {
-			for ( size_t I = 0; I < pjvVal->vArray.size(); ++I ) {
-				const lson::CJsonContainer::LSON_JSON_VALUE & jvThis = _jJson.GetContainer()->GetValue( pjvVal->vArray[I] );
-				if ( jvThis.vtType == lson::CJsonContainer::LSON_VT_ARRAY && jvThis.vArray.size() == 2 ) {
-					LSN_CPU_VERIFY_RAM cvrRam = {
-						.ui16Addr = uint16_t( _jJson.GetContainer()->GetValue( jvThis.vArray[0] ).u.dDecimal ),
-						.ui8Value = uint8_t( _jJson.GetContainer()->GetValue( jvThis.vArray[1] ).u.dDecimal ),
-					};
-					_cvsState.vRam.push_back( cvrRam );
-				}
-				else { return false; }
+		const auto & vLog = m_pbBus->ReadWriteLog();
+		if ( vLog.size() != _cvoTest.vCycles.size() ) {
+			_sError = VerifyMismatch( _cvoTest.sName, "Cycle count", _cvoTest.vCycles.size(), vLog.size() );
+			return false;
+		}
+		for ( size_t I = 0; I < vLog.size(); ++I ) {
+			std::string sCycle = "Cycle " + std::to_string( I + 1 );
+			if ( vLog[I].ui16Address != _cvoTest.vCycles[I].ui16Addr ) {
+				_sError = VerifyMismatch( _cvoTest.sName, (sCycle + " address").c_str(), _cvoTest.vCycles[I].ui16Addr, vLog[I].ui16Address );
+				return false;
+			}
+			if ( vLog[I].ui8Value != _cvoTest.vCycles[I].ui8Value ) {
+				_sError = VerifyMismatch( _cvoTest.sName, (sCycle + " value").c_str(), _cvoTest.vCycles[I].ui8Value, vLog[I].ui8Value );
+				return false;
+			}
+			if ( vLog[I].bRead != _cvoTest.vCycles[I].bRead ) {
+				_sError = VerifyMismatch( _cvoTest.sName, (sCycle + " read").c_str(), _cvoTest.vCycles[I].bRead, vLog[I].bRead );
+				return false;
 			}
 		}
-		else { return false; }
+		_sError = sPolling;
+		return _sError.empty();
+	}
 
-		return true;
+	/**
+	 * Describes a value that differs from the expected value in a single-step test.
+	 *
+	 * \param _sTest The name of the test.
+	 * \param _pcWhat What differs.
+	 * \param _ui64Expected The expected value.
+	 * \param _ui64Got The actual value.
+	 * \return Returns the description.
+	 */
+	std::string CCpu6502::VerifyMismatch( const std::string &_sTest, const char * _pcWhat, uint64_t _ui64Expected, uint64_t _ui64Got ) {
+		char szBuffer[128];
+		std::snprintf( szBuffer, sizeof( szBuffer ), ": %s expected %" PRIu64 " ($%.2" PRIX64 "), got %" PRIu64 " ($%.2" PRIX64 ").", _pcWhat,
+			_ui64Expected, _ui64Expected, _ui64Got, _ui64Got );
+		return _sTest + szBuffer;
 	}
 #endif	// #ifdef LSN_CPU_VERIFY
 
@@ -941,7 +998,7 @@ namespace lsn {
 		}
 #endif	// #ifdef LSN_CPU_VERIFY
 		m_ui16OpCode = ui8Op;
-		m_pfCurInstruction = m_iInstructionSet[m_ui16OpCode].pfHandler;
+		m_pui16CurInstruction = m_ui16CycleFuncs[m_ui16OpCode];
 
 #if 0
 		char szBUffer[256];
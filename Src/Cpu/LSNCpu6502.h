@@ -27,7 +27,7 @@
 #include <vector>
 
 #ifdef LSN_CPU_VERIFY
-#include "LSONJson.h"
+#include <string>
 #endif	// #ifdef LSN_CPU_VERIFY
 
 
@@ -127,6 +127,8 @@ namespace lsn {
 		 *	branching etc.
 		 * pfHandler points to an array of functions that can handle all possible cycles for a given instruction, and we use a subtractive process for eliminating optional cycles
 		 *	rather than using the additive approach most commonly found in emulators.
+		 * This table is cold: it is only read to build m_ui16CycleFuncs and m_pfCycleFuncs, and for debugging, disassembling, etc.  At 16 bytes per member-function pointer it
+		 *	is over 64 kilobytes, whereas the table of 16-bit indices into the roughly 160 distinct functions fits in L1 alongside them.
 		 */
 		struct LSN_INSTR {
 			PfCycle											pfHandler[LSN_M_MAX_INSTR_CYCLE_COUNT*2];										/**< Indexed by LSN_CPU_CONTEXT::ui8FuncIdx, these functions handle each cycle of the instruction. */
@@ -191,7 +193,7 @@ namespace lsn {
 			m_bIsReset = true;
 #endif	// #ifdef LSN_CPU_VERIFY
 
-			m_pfCurInstruction = m_iInstructionSet[m_ui16OpCode].pfHandler;
+			m_pui16CurInstruction = m_ui16CycleFuncs[m_ui16OpCode];
 		}
 
 		/**
@@ -248,16 +250,62 @@ namespace lsn {
 		 **/
 		virtual bool										GetIrqStatus( uint8_t _ui8Source ) const;
 
+		/**
+		 * Writes the CPU state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 **/
+		bool												SaveState( CStream &_sStream ) const;
+
+		/**
+		 * Reads the CPU state from a stream.  The current instruction is restored from the opcode.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 **/
+		bool												LoadState( CStream &_sStream );
+
 
 #ifdef LSN_CPU_VERIFY
+		// == Types.
+		/** A RAM value in a single-step test. */
+		struct LSN_CPU_VERIFY_RAM {
+			uint16_t										ui16Addr;																			/**< The address. */
+			uint8_t											ui8Value;																			/**< The value at the address. */
+		};
+
+		/** The registers and RAM before or after a single-step test. */
+		struct LSN_CPU_VERIFY_STATE {
+			LSN_REGISTERS									cvrRegisters;																		/**< The registers. */
+			std::vector<LSN_CPU_VERIFY_RAM>					vRam;																				/**< The RAM values. */
+		};
+
+		/** A bus access in a single-step test. */
+		struct LSN_CPU_VERIFY_CYCLE {
+			uint16_t										ui16Addr;																			/**< The address accessed. */
+			uint8_t											ui8Value;																			/**< The value read or written. */
+			bool											bRead;																				/**< True for a read, false for a write. */
+		};
+
+		/** A single-step test: one instruction from a starting state, with the state and bus accesses it should produce. */
+		struct LSN_CPU_VERIFY_OBJ {
+			std::string										sName;																				/**< The name of the test. */
+			LSN_CPU_VERIFY_STATE							cvsStart;																			/**< The state before the instruction. */
+			LSN_CPU_VERIFY_STATE							cvsEnd;																				/**< The expected state after the instruction. */
+			std::vector<LSN_CPU_VERIFY_CYCLE>				vCycles;																			/**< The expected bus accesses, one per cycle. */
+		};
+
+
+		// == Functions.
 		/**
-		 * Runs a test given a JSON's value representing the test to run.
+		 * Runs a single-step test.  The CPU's bus must be a flat CCpuBus with nothing mapped over its RAM.
 		 *
-		 * \param _jJson The JSON file.
-		 * \param _jvTest The test to run.
-		 * \return Returns true if te test succeeds, false otherwise.
+		 * \param _cvoTest The test to run.
+		 * \param _sError Holds a description of the first difference from the expected results if the test fails.
+		 * \return Returns true if the registers, RAM, and bus accesses all match the expected results.
 		 */
-		bool												RunJsonTest( lson::CJson &_jJson, const lson::CJsonContainer::LSON_JSON_VALUE &_jvTest );
+		bool												RunTest( const LSN_CPU_VERIFY_OBJ &_cvoTest, std::string &_sError );
 #endif	// #ifdef LSN_CPU_VERIFY
 
 		/**
@@ -272,10 +320,13 @@ namespace lsn {
 		/**
 		 * Sets the mapper.
 		 *
-		 * \param _pmbMapper A pointer to the mapper to be ticked with each CPU cycle.
+		 * \param _pmbMapper A pointer to the mapper.
+		 * \param _pfTick The function that ticks the mapper with each CPU cycle, from CMapperBase::TickFunc(), or nullptr if the mapper
+		 *	does not need to be ticked.
 		 */
-		void												SetMapper( CMapperBase * _pmbMapper ) {
+		void												SetMapper( CMapperBase * _pmbMapper, CMapperBase::PfTick _pfTick ) {
 			m_pmbMapper = _pmbMapper;
+			m_pfMapperTick = _pmbMapper ? _pfTick : nullptr;
 		}
 
 
@@ -284,8 +335,9 @@ namespace lsn {
 		PfTicks												m_pfTickFunc = nullptr;																/**< The current tick function (called by Tick()). */
 		PfTicks												m_pfTickFuncCopy = nullptr;															/**< A copy of the current tick, used to restore the intended original tick when control flow is changed by DMA transfers. */
 		CInputPoller *										m_pipPoller = nullptr;																/**< The input poller. */
-		CMapperBase *										m_pmbMapper = nullptr;																/**< The mapper, which gets ticked on each CPU cycle. */
-		const PfCycle *										m_pfCurInstruction = nullptr;														/**< The current instruction being executed. */
+		CMapperBase *										m_pmbMapper = nullptr;																/**< The mapper. */
+		CMapperBase::PfTick									m_pfMapperTick = nullptr;															/**< Ticks the mapper on each CPU cycle, or nullptr if the mapper does not tick. */
+		const uint16_t *									m_pui16CurInstruction = nullptr;													/**< The current instruction being executed, as indices into m_pfCycleFuncs. */
 		LSN_REGISTERS										m_rRegs;																			/**< Registers. */
 
 		LSN_VECTORS											m_vBrkVector = LSN_V_IRQ_BRK;														/**< The vector to use inside BRK and whether to push B with status. */
@@ -336,60 +388,44 @@ namespace lsn {
 		uint8_t												m_ui8InputsState[8];
 		uint8_t												m_ui8InputsPoll[8];
 		
-		static LSN_INSTR									m_iInstructionSet[256];																/**< The instruction set. */
+		static LSN_INSTR									m_iInstructionSet[256];																/**< The instruction set.  Not used for dispatch; see m_ui16CycleFuncs. */
+		static uint16_t										m_ui16CycleFuncs[256][LSN_M_MAX_INSTR_CYCLE_COUNT*2];								/**< For each opcode, the index into m_pfCycleFuncs of the function that handles each cycle. */
+		static PfCycle										m_pfCycleFuncs[LSN_M_MAX_CYCLE_FUNCS];												/**< Every distinct cycle function in m_iInstructionSet.  Index 0 is nullptr. */
 		static const LSN_INSTR_META_DATA					m_smdInstMetaData[LSN_I_TOTAL];														/**< Metadata for the instructions (for assembly and disassembly etc.) */
+		static const PfTicks								m_ptTickFuncs[8];																	/**< Every function to which m_pfTickFunc can point, indexed by save states. */
 
 
 #ifdef LSN_CPU_VERIFY
-		// == Types.
-		struct LSN_CPU_VERIFY_RAM {
-			uint16_t										ui16Addr;
-			uint8_t											ui8Value;
-		};
-
-		struct LSN_CPU_VERIFY_STATE {
-			LSN_REGISTERS									cvrRegisters;
-			std::vector<LSN_CPU_VERIFY_RAM>					vRam;
-		};
-
-		struct LSN_CPU_VERIFY_CYCLE {
-			uint16_t										ui16Addr;
-			uint8_t											ui8Value;
-			bool											bRead;
-		};
-
-		struct LSN_CPU_VERIFY_OBJ {
-			std::string										sName;
-			LSN_CPU_VERIFY_STATE							cvsStart;
-			LSN_CPU_VERIFY_STATE							cvsEnd;
-			std::vector<LSN_CPU_VERIFY_CYCLE>				vCycles;
-		};
-
-
 		// == Functions.
 		/**
-		 * Given a JSON object and the value for the test to run, this loads the test and fills a LSN_CPU_VERIFY structure.
+		 * Describes a value that differs from the expected value in a single-step test.
 		 *
-		 * \param _jJson The JSON file.
-		 * \param _jvTest The test to run.
-		 * \param _cvoTest The test structure to fill out.
-		 * \return Returns true if the JSON data was successfully extracted and the test created.
+		 * \param _sTest The name of the test.
+		 * \param _pcWhat What differs.
+		 * \param _ui64Expected The expected value.
+		 * \param _ui64Got The actual value.
+		 * \return Returns the description.
 		 */
-		bool												GetTest( lson::CJson &_jJson, const lson::CJsonContainer::LSON_JSON_VALUE &_jvTest, LSN_CPU_VERIFY_OBJ &_cvoTest );
+		static std::string									VerifyMismatch( const std::string &_sTest, const char * _pcWhat, uint64_t _ui64Expected, uint64_t _ui64Got );
+#endif	// #ifdef LSN_CPU_VERIFY
+
 
+		// == Functions.
 		/**
-		 * Fills out a LSN_CPU_VERIFY_STATE structure given a JSON "initial" or "final" member.
+		 * Builds m_ui16CycleFuncs and m_pfCycleFuncs from m_iInstructionSet.  Called once, when the first CPU is created.
 		 *
-		 * \param _jJson The JSON file.
-		 * \param _jvState The bject member representing the state to load.
-		 * \param _cvsState The state structure to fill.
-		 * \return Returns true if the state was loaded.
+		 * \return Returns true if every distinct cycle function fit into m_pfCycleFuncs.
 		 */
-		bool												LoadState( lson::CJson &_jJson, const lson::CJsonContainer::LSON_JSON_VALUE &_jvState, LSN_CPU_VERIFY_STATE &_cvsState );
-#endif	// #ifdef LSN_CPU_VERIFY
+		static bool											BuildCycleFuncs();
 
+		/**
+		 * Gets the index of a tick function in m_ptTickFuncs.
+		 *
+		 * \param _ptFunc The tick function to find.
+		 * \return Returns the index of the tick function or LSN_ELEMENTS( m_ptTickFuncs ) if it is not in the table.
+		 **/
+		static size_t										TickFuncIndex( PfTicks _ptFunc );
 
-		// == Functions.
 		/** Fetches the next opcode and begins the next instruction. */
 		inline void											Tick_NextInstructionStd();
 
@@ -1030,7 +1066,7 @@ namespace lsn {
 	/** Performs a cycle inside an instruction. */
 	inline void CCpu6502::Tick_InstructionCycleStd() {
 		//(this->*m_iInstructionSet[m_ui16OpCode].pfHandler[m_ui8FuncIndex])();
-		(this->*m_pfCurInstruction[m_ui8FuncIndex])();
+		(this->*m_pfCycleFuncs[m_pui16CurInstruction[m_ui8FuncIndex]])();
 	}
 
 	/**
@@ -43,6 +43,13 @@ namespace lsn {
 		 */
 		virtual void						Irq( uint8_t /*_ui8Source*/ ) {}
 
+		/**
+		 * Clears the IRQ flag.
+		 *
+		 * \param _ui8Source The source of the IRQ.
+		 */
+		virtual void						ClearIrq( uint8_t /*_ui8Source*/ ) {}
+
 	protected :
 		// == Enumerations.
 		/** Addressing modes. */
@@ -158,6 +165,7 @@ namespace lsn {
 		/** Other parameters. */
 		enum LSN_MISC {
 			LSN_M_MAX_INSTR_CYCLE_COUNT		= 8,
+			LSN_M_MAX_CYCLE_FUNCS			= 512,											/**< The most distinct cycle functions the CPU's dispatch table can hold. */
 		};
 
 
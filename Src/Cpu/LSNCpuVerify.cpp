@@ -0,0 +1,298 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Runs single-step CPU tests (the nes6502 JSON files, one per opcode) without building a JSON DOM.  Each file is mapped
+ *	and its tests are parsed and run one at a time on a CPU with its own flat 64-kilobyte bus, so files can be verified in parallel.
+ */
+
+
+#ifdef LSN_CPU_VERIFY
+
+#include "LSNCpuVerify.h"
+#include "../File/LSNFileMap.h"
+
+#include <memory>
+
+
+namespace lsn {
+
+	// == Functions.
+	/**
+	 * Runs every test in a file.
+	 *
+	 * \param _pcPath The UTF-8 path to the file.
+	 * \param _rResults Holds the results.
+	 * \param _sMaxFailures The maximum number of failures to describe in _rResults.vFailures.
+	 * \return Returns false if the file could not be read or parsed, or if the CPU could not be created.
+	 */
+	bool CCpuVerify::VerifyFile( const char8_t * _pcPath, LSN_RESULTS &_rResults, size_t _sMaxFailures ) {
+		CFileMap fmMap;
+		if ( !fmMap.Open( _pcPath ) ) { return false; }
+		const uint8_t * pui8Data = fmMap.Data();
+		if ( !pui8Data ) { return false; }
+		return VerifyJson( reinterpret_cast<const char *>(pui8Data), size_t( fmMap.Size() ), _rResults, _sMaxFailures );
+	}
+
+	/**
+	 * Runs every test in JSON text.
+	 *
+	 * \param _pcJson The JSON text.
+	 * \param _sLen The length of the JSON text.
+	 * \param _rResults Holds the results.
+	 * \param _sMaxFailures The maximum number of failures to describe in _rResults.vFailures.
+	 * \return Returns false if the text could not be parsed or if the CPU could not be created.
+	 */
+	bool CCpuVerify::VerifyJson( const char * _pcJson, size_t _sLen, LSN_RESULTS &_rResults, size_t _sMaxFailures ) {
+		try {
+			// The bus is 64 kilobytes of RAM and too large for the stack.
+			std::unique_ptr<CCpuBus> pbBus = std::make_unique<CCpuBus>();
+			pbBus->ApplyMap();
+			std::unique_ptr<CCpu6502> pcCpu = std::make_unique<CCpu6502>( pbBus.get() );
+
+			LSN_CURSOR cCur = { _pcJson, _pcJson + _sLen };
+			if ( !Skip( cCur, '[' ) ) { return false; }
+			CCpu6502::LSN_CPU_VERIFY_OBJ cvoTest;
+			std::string sError;
+			for ( bool bFirst = true; ; bFirst = false ) {
+				bool bEnd;
+				if ( !NextTest( cCur, bFirst, cvoTest, bEnd ) ) { return false; }
+				if ( bEnd ) { break; }
+
+				++_rResults.ui64Tests;
+				if ( !pcCpu->RunTest( cvoTest, sError ) ) {
+					++_rResults.ui64Failed;
+					if ( _rResults.vFailures.size() < _sMaxFailures ) {
+						_rResults.vFailures.push_back( sError );
+					}
+				}
+			}
+			return true;
+		}
+		catch ( ... ) { return false; }
+	}
+
+	/**
+	 * Parses the next test in the array of tests.
+	 *
+	 * \param _cCur The cursor, just after the '[' or after the previous test.
+	 * \param _bFirst True if no test has been parsed yet.
+	 * \param _cvoTest Holds the test.  Its vectors are cleared and reused.
+	 * \param _bEnd Set to true if the end of the array was reached instead of a test.
+	 * \return Returns false if the text could not be parsed.
+	 */
+	bool CCpuVerify::NextTest( LSN_CURSOR &_cCur, bool _bFirst, CCpu6502::LSN_CPU_VERIFY_OBJ &_cvoTest, bool &_bEnd ) {
+		_bEnd = Skip( _cCur, ']' );
+		if ( _bEnd ) { return true; }
+		if ( !_bFirst && !Skip( _cCur, ',' ) ) { return false; }
+		if ( !Skip( _cCur, '{' ) ) { return false; }
+
+		_cvoTest.sName.clear();
+		_cvoTest.cvsStart.vRam.clear();
+		_cvoTest.cvsEnd.vRam.clear();
+		_cvoTest.vCycles.clear();
+		// Every test must have all four members.
+		uint32_t ui32Found = 0;
+		if ( Skip( _cCur, '}' ) ) { return false; }
+		std::string sKey;
+		do {
+			if ( !ParseString( _cCur, sKey ) ) { return false; }
+			if ( !Skip( _cCur, ':' ) ) { return false; }
+			if ( sKey == "name" ) {
+				if ( !ParseString( _cCur, _cvoTest.sName ) ) { return false; }
+				ui32Found |= 1 << 0;
+			}
+			else if ( sKey == "initial" ) {
+				if ( !ParseState( _cCur, _cvoTest.cvsStart ) ) { return false; }
+				ui32Found |= 1 << 1;
+			}
+			else if ( sKey == "final" ) {
+				if ( !ParseState( _cCur, _cvoTest.cvsEnd ) ) { return false; }
+				ui32Found |= 1 << 2;
+			}
+			else if ( sKey == "cycles" ) {
+				if ( !ParseCycles( _cCur, _cvoTest.vCycles ) ) { return false; }
+				ui32Found |= 1 << 3;
+			}
+			else if ( !SkipValue( _cCur ) ) { return false; }
+		} while ( Skip( _cCur, ',' ) );
+		return Skip( _cCur, '}' ) && ui32Found == 0xF;
+	}
+
+	/**
+	 * Parses an "initial" or "final" object.
+	 *
+	 * \param _cCur The cursor, at the object.
+	 * \param _cvsState Holds the state.
+	 * \return Returns false if the text could not be parsed.
+	 */
+	bool CCpuVerify::ParseState( LSN_CURSOR &_cCur, CCpu6502::LSN_CPU_VERIFY_STATE &_cvsState ) {
+		if ( !Skip( _cCur, '{' ) ) { return false; }
+		// Every state must have pc, s, a, x, y, p, and ram.
+		uint32_t ui32Found = 0;
+		if ( Skip( _cCur, '}' ) ) { return false; }
+		std::string sKey;
+		do {
+			if ( !ParseString( _cCur, sKey ) ) { return false; }
+			if ( !Skip( _cCur, ':' ) ) { return false; }
+			uint32_t ui32Val;
+			if ( sKey == "ram" ) {
+				if ( !Skip( _cCur, '[' ) ) { return false; }
+				if ( !Skip( _cCur, ']' ) ) {
+					do {
+						uint32_t ui32Addr;
+						if ( !Skip( _cCur, '[' ) || !ParseUInt( _cCur, ui32Addr ) || !Skip( _cCur, ',' ) ||
+							!ParseUInt( _cCur, ui32Val ) || !Skip( _cCur, ']' ) ) { return false; }
+						_cvsState.vRam.push_back( { .ui16Addr = uint16_t( ui32Addr ), .ui8Value = uint8_t( ui32Val ) } );
+					} while ( Skip( _cCur, ',' ) );
+					if ( !Skip( _cCur, ']' ) ) { return false; }
+				}
+				ui32Found |= 1 << 6;
+				continue;
+			}
+
+			static const struct {
+				const char *								pcName;
+				uint32_t									ui32Bit;
+			} sRegs[] = {
+				{ "pc", 0 },
+				{ "s", 1 },
+				{ "a", 2 },
+				{ "x", 3 },
+				{ "y", 4 },
+				{ "p", 5 },
+			};
+			size_t sReg = LSN_ELEMENTS( sRegs );
+			for ( size_t I = 0; I < LSN_ELEMENTS( sRegs ); ++I ) {
+				if ( sKey == sRegs[I].pcName ) {
+					sReg = I;
+					break;
+				}
+			}
+			if ( sReg == LSN_ELEMENTS( sRegs ) ) {
+				if ( !SkipValue( _cCur ) ) { return false; }
+				continue;
+			}
+			if ( !ParseUInt( _cCur, ui32Val ) ) { return false; }
+			switch ( sReg ) {
+				case 0 : { _cvsState.cvrRegisters.ui16Pc = uint16_t( ui32Val ); break; }
+				case 1 : { _cvsState.cvrRegisters.ui8S = uint8_t( ui32Val ); break; }
+				case 2 : { _cvsState.cvrRegisters.ui8A = uint8_t( ui32Val ); break; }
+				case 3 : { _cvsState.cvrRegisters.ui8X = uint8_t( ui32Val ); break; }
+				case 4 : { _cvsState.cvrRegisters.ui8Y = uint8_t( ui32Val ); break; }
+				case 5 : { _cvsState.cvrRegisters.ui8Status = uint8_t( ui32Val ); break; }
+			}
+			ui32Found |= 1 << sRegs[sReg].ui32Bit;
+		} while ( Skip( _cCur, ',' ) );
+		return Skip( _cCur, '}' ) && ui32Found == 0x7F;
+	}
+
+	/**
+	 * Parses a "cycles" array.
+	 *
+	 * \param _cCur The cursor, at the array.
+	 * \param _vCycles Holds the cycles.
+	 * \return Returns false if the text could not be parsed.
+	 */
+	bool CCpuVerify::ParseCycles( LSN_CURSOR &_cCur, std::vector<CCpu6502::LSN_CPU_VERIFY_CYCLE> &_vCycles ) {
+		if ( !Skip( _cCur, '[' ) ) { return false; }
+		if ( Skip( _cCur, ']' ) ) { return true; }
+		std::string sType;
+		do {
+			uint32_t ui32Addr, ui32Val;
+			if ( !Skip( _cCur, '[' ) || !ParseUInt( _cCur, ui32Addr ) || !Skip( _cCur, ',' ) ||
+				!ParseUInt( _cCur, ui32Val ) || !Skip( _cCur, ',' ) ||
+				!ParseString( _cCur, sType ) || !Skip( _cCur, ']' ) ) { return false; }
+			_vCycles.push_back( { .ui16Addr = uint16_t( ui32Addr ), .ui8Value = uint8_t( ui32Val ), .bRead = sType == "read" } );
+		} while ( Skip( _cCur, ',' ) );
+		return Skip( _cCur, ']' );
+	}
+
+	/**
+	 * Parses a string.  Escapes are replaced by the escaped character, except that Unicode escapes are kept as-is.
+	 *
+	 * \param _cCur The cursor, at the string.
+	 * \param _sString Holds the string.
+	 * \return Returns false if the text is not a string.
+	 */
+	bool CCpuVerify::ParseString( LSN_CURSOR &_cCur, std::string &_sString ) {
+		if ( !Skip( _cCur, '"' ) ) { return false; }
+		_sString.clear();
+		while ( _cCur.pcCur < _cCur.pcEnd ) {
+			char cChar = (*_cCur.pcCur++);
+			if ( cChar == '"' ) { return true; }
+			if ( cChar == '\\' ) {
+				if ( _cCur.pcCur == _cCur.pcEnd ) { return false; }
+				cChar = (*_cCur.pcCur++);
+				switch ( cChar ) {
+					case 'n' : { cChar = '\n'; break; }
+					case 'r' : { cChar = '\r'; break; }
+					case 't' : { cChar = '\t'; break; }
+					case 'b' : { cChar = '\b'; break; }
+					case 'f' : { cChar = '\f'; break; }
+					case 'u' : { _sString.push_back( '\\' ); break; }
+				}
+			}
+			_sString.push_back( cChar );
+		}
+		return false;
+	}
+
+	/**
+	 * Parses a non-negative integer.
+	 *
+	 * \param _cCur The cursor, at the number.
+	 * \param _ui32Val Holds the number.
+	 * \return Returns false if the text is not a non-negative integer.
+	 */
+	bool CCpuVerify::ParseUInt( LSN_CURSOR &_cCur, uint32_t &_ui32Val ) {
+		SkipWhitespace( _cCur );
+		const char * pcStart = _cCur.pcCur;
+		_ui32Val = 0;
+		while ( _cCur.pcCur < _cCur.pcEnd && (*_cCur.pcCur) >= '0' && (*_cCur.pcCur) <= '9' ) {
+			_ui32Val = _ui32Val * 10 + uint32_t( (*_cCur.pcCur++) - '0' );
+		}
+		return _cCur.pcCur != pcStart;
+	}
+
+	/**
+	 * Skips any value, including nested objects and arrays.
+	 *
+	 * \param _cCur The cursor, at the value.
+	 * \return Returns false if the text is not a value.
+	 */
+	bool CCpuVerify::SkipValue( LSN_CURSOR &_cCur ) {
+		SkipWhitespace( _cCur );
+		if ( _cCur.pcCur == _cCur.pcEnd ) { return false; }
+		std::string sTmp;
+		switch ( (*_cCur.pcCur) ) {
+			case '"' : { return ParseString( _cCur, sTmp ); }
+			case '{' :
+			case '[' : {
+				char cClose = (*_cCur.pcCur) == '{' ? '}' : ']';
+				++_cCur.pcCur;
+				if ( Skip( _cCur, cClose ) ) { return true; }
+				do {
+					if ( cClose == '}' ) {
+						if ( !ParseString( _cCur, sTmp ) || !Skip( _cCur, ':' ) ) { return false; }
+					}
+					if ( !SkipValue( _cCur ) ) { return false; }
+				} while ( Skip( _cCur, ',' ) );
+				return Skip( _cCur, cClose );
+			}
+			default : {
+				// Numbers, true, false, and null.
+				const char * pcStart = _cCur.pcCur;
+				while ( _cCur.pcCur < _cCur.pcEnd && (*_cCur.pcCur) != ',' && (*_cCur.pcCur) != ']' && (*_cCur.pcCur) != '}' &&
+					(*_cCur.pcCur) != ' ' && (*_cCur.pcCur) != '\t' && (*_cCur.pcCur) != '\r' && (*_cCur.pcCur) != '\n' ) {
+					++_cCur.pcCur;
+				}
+				return _cCur.pcCur != pcStart;
+			}
+		}
+	}
+
+}	// namespace lsn
+
+#endif	// #ifdef LSN_CPU_VERIFY
@@ -0,0 +1,163 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Runs single-step CPU tests (the nes6502 JSON files, one per opcode) without building a JSON DOM.  Each file is mapped
+ *	and its tests are parsed and run one at a time on a CPU with its own flat 64-kilobyte bus, so files can be verified in parallel.
+ */
+
+
+#pragma once
+
+#ifdef LSN_CPU_VERIFY
+
+#include "../LSNLSpiroNes.h"
+#include "LSNCpu6502.h"
+
+#include <string>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CCpuVerify
+	 * \brief Runs single-step CPU tests.
+	 *
+	 * Description: Runs single-step CPU tests (the nes6502 JSON files, one per opcode) without building a JSON DOM.  Each file is mapped
+	 *	and its tests are parsed and run one at a time on a CPU with its own flat 64-kilobyte bus, so files can be verified in parallel.
+	 * A file is a JSON array of objects with "name", "initial", "final", and "cycles" members.  "initial" and "final" hold "pc", "s",
+	 *	"a", "x", "y", and "p", and "ram" as an array of [address, value] pairs.  "cycles" is an array of [address, value, "read" or
+	 *	"write"] triples.  Other members are skipped.
+	 */
+	class CCpuVerify {
+	public :
+		// == Types.
+		/** The results of verifying a file. */
+		struct LSN_RESULTS {
+			uint64_t										ui64Tests = 0;										/**< The number of tests run. */
+			uint64_t										ui64Failed = 0;										/**< The number of tests that failed. */
+			std::vector<std::string>						vFailures;											/**< Descriptions of the first failures. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Runs every test in a file.
+		 *
+		 * \param _pcPath The UTF-8 path to the file.
+		 * \param _rResults Holds the results.
+		 * \param _sMaxFailures The maximum number of failures to describe in _rResults.vFailures.
+		 * \return Returns false if the file could not be read or parsed, or if the CPU could not be created.
+		 */
+		static bool											VerifyFile( const char8_t * _pcPath, LSN_RESULTS &_rResults, size_t _sMaxFailures );
+
+		/**
+		 * Runs every test in JSON text.
+		 *
+		 * \param _pcJson The JSON text.
+		 * \param _sLen The length of the JSON text.
+		 * \param _rResults Holds the results.
+		 * \param _sMaxFailures The maximum number of failures to describe in _rResults.vFailures.
+		 * \return Returns false if the text could not be parsed or if the CPU could not be created.
+		 */
+		static bool											VerifyJson( const char * _pcJson, size_t _sLen, LSN_RESULTS &_rResults, size_t _sMaxFailures );
+
+
+	protected :
+		// == Types.
+		/** A position in JSON text. */
+		struct LSN_CURSOR {
+			const char *									pcCur;												/**< The next character. */
+			const char *									pcEnd;												/**< The end of the text. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Parses the next test in the array of tests.
+		 *
+		 * \param _cCur The cursor, just after the '[' or after the previous test.
+		 * \param _bFirst True if no test has been parsed yet.
+		 * \param _cvoTest Holds the test.  Its vectors are cleared and reused.
+		 * \param _bEnd Set to true if the end of the array was reached instead of a test.
+		 * \return Returns false if the text could not be parsed.
+		 */
+		static bool											NextTest( LSN_CURSOR &_cCur, bool _bFirst, CCpu6502::LSN_CPU_VERIFY_OBJ &_cvoTest, bool &_bEnd );
+
+		/**
+		 * Parses an "initial" or "final" object.
+		 *
+		 * \param _cCur The cursor, at the object.
+		 * \param _cvsState Holds the state.
+		 * \return Returns false if the text could not be parsed.
+		 */
+		static bool											ParseState( LSN_CURSOR &_cCur, CCpu6502::LSN_CPU_VERIFY_STATE &_cvsState );
+
+		/**
+		 * Parses a "cycles" array.
+		 *
+		 * \param _cCur The cursor, at the array.
+		 * \param _vCycles Holds the cycles.
+		 * \return Returns false if the text could not be parsed.
+		 */
+		static bool											ParseCycles( LSN_CURSOR &_cCur, std::vector<CCpu6502::LSN_CPU_VERIFY_CYCLE> &_vCycles );
+
+		/**
+		 * Parses a string.  Escapes are replaced by the escaped character, except that Unicode escapes are kept as-is.
+		 *
+		 * \param _cCur The cursor, at the string.
+		 * \param _sString Holds the string.
+		 * \return Returns false if the text is not a string.
+		 */
+		static bool											ParseString( LSN_CURSOR &_cCur, std::string &_sString );
+
+		/**
+		 * Parses a non-negative integer.
+		 *
+		 * \param _cCur The cursor, at the number.
+		 * \param _ui32Val Holds the number.
+		 * \return Returns false if the text is not a non-negative integer.
+		 */
+		static bool											ParseUInt( LSN_CURSOR &_cCur, uint32_t &_ui32Val );
+
+		/**
+		 * Skips any value, including nested objects and arrays.
+		 *
+		 * \param _cCur The cursor, at the value.
+		 * \return Returns false if the text is not a value.
+		 */
+		static bool											SkipValue( LSN_CURSOR &_cCur );
+
+		/**
+		 * Skips whitespace and then the given character if it is next.
+		 *
+		 * \param _cCur The cursor.
+		 * \param _cChar The character to skip.
+		 * \return Returns true if the character was next and was skipped.
+		 */
+		static inline bool									Skip( LSN_CURSOR &_cCur, char _cChar ) {
+			SkipWhitespace( _cCur );
+			if ( _cCur.pcCur < _cCur.pcEnd && (*_cCur.pcCur) == _cChar ) {
+				++_cCur.pcCur;
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * Skips whitespace.
+		 *
+		 * \param _cCur The cursor.
+		 */
+		static inline void									SkipWhitespace( LSN_CURSOR &_cCur ) {
+			while ( _cCur.pcCur < _cCur.pcEnd && ((*_cCur.pcCur) == ' ' || (*_cCur.pcCur) == '\t' || (*_cCur.pcCur) == '\r' || (*_cCur.pcCur) == '\n') ) {
+				++_cCur.pcCur;
+			}
+		}
+	};
+
+}	// namespace lsn
+
+#endif	// #ifdef LSN_CPU_VERIFY
@@ -13,19 +13,14 @@ namespace lsn {
 
 	// == Members.
 	/**
-	 * Standard table of codes.
+	 * Standard tables of codes.  Table 0 is the byte-at-a-time table and table N advances a byte through N more bytes of zeros.
 	 */
-	uint32_t CCrc::m_ui32StdTable[256] = { 0 };
+	const std::array<CCrc::LSN_TABLE, 8> CCrc::m_aStdTable = CCrc::MakeSliceTables( 0xEDB88320 );
 
 	/**
 	 * Alternative table of codes.
 	 */
-	uint32_t CCrc::m_ui32AltTable[256] = { 0 };
-
-	/**
-	 * Has the table been initialized?
-	 */
-	bool CCrc::m_bInit = false;
+	const CCrc::LSN_TABLE CCrc::m_aAltTable = CCrc::MakeTable( 0x04C11DB7 );
 
 	// == Functions.
 	/**
@@ -36,11 +31,21 @@ namespace lsn {
 	 * \return Returns the standard 32-bit CRC value for the given data
 	 */
 	uint32_t CCrc::GetCrc( const uint8_t * _pui8Data, uintptr_t _uiptrLen ) {
-		Init();
-
 		uint32_t ui32Crc = UINT32_MAX;
-		for ( uintptr_t I = 0; I < _uiptrLen; ++I ) {
-			GetCrc( m_ui32StdTable, (*_pui8Data++), ui32Crc );
+		// 8 bytes at a time.  The bytes are assembled by hand so the result does not depend on the host byte order.
+		for ( ; _uiptrLen >= 8; _uiptrLen -= 8, _pui8Data += 8 ) {
+			uint32_t ui32Lo = ui32Crc ^ (uint32_t( _pui8Data[0] ) | (uint32_t( _pui8Data[1] ) << 8) | (uint32_t( _pui8Data[2] ) << 16) | (uint32_t( _pui8Data[3] ) << 24));
+			ui32Crc = m_aStdTable[7][ui32Lo&0xFF] ^
+				m_aStdTable[6][(ui32Lo>>8)&0xFF] ^
+				m_aStdTable[5][(ui32Lo>>16)&0xFF] ^
+				m_aStdTable[4][ui32Lo>>24] ^
+				m_aStdTable[3][_pui8Data[4]] ^
+				m_aStdTable[2][_pui8Data[5]] ^
+				m_aStdTable[1][_pui8Data[6]] ^
+				m_aStdTable[0][_pui8Data[7]];
+		}
+		while ( _uiptrLen-- ) {
+			GetCrc( m_aStdTable[0], (*_pui8Data++), ui32Crc );
 		}
 
 		return ~ui32Crc;
@@ -54,58 +59,13 @@ namespace lsn {
 	 * \return Returns the alternative 32-bit CRC value for the given data
 	 */
 	uint32_t CCrc::GetAltCrc( const uint8_t * _pui8Data, uintptr_t _uiptrLen ) {
-		Init();
-
 		uint32_t ui32Crc = UINT32_MAX;
 		_pui8Data += _uiptrLen;
 		for ( uintptr_t I = 0; I < _uiptrLen; ++I ) {
-			GetCrc( m_ui32AltTable, (*--_pui8Data), ui32Crc );
+			GetCrc( m_aAltTable, (*--_pui8Data), ui32Crc );
 		}
 
 		return ~ui32Crc;
 	}
 
-	/**
-	 * Initialize the table.
-	 */
-	void CCrc::Init() {
-		if ( !m_bInit ) {
-			Init( m_ui32StdTable, 0xEDB88320 );
-			Init( m_ui32AltTable, 0x04C11DB7 );
-			m_bInit = true;
-		}		
-	}
-
-	/**
-	 * Initialize a table with a key.
-	 *
-	 * \param _pui32Table The table to initialize
-	 * \param _ui32Key The key to use for initialization.
-	 */
-	void CCrc::Init( uint32_t * _pui32Table, uint32_t _ui32Key ) {
-		for ( uint32_t I = 0; I < 256; ++I ) {
-			uint32_t ui32Crc = I;
-			for ( uint32_t J = 8; J--; ) {
-				if ( ui32Crc & 1 ) {
-					ui32Crc = (ui32Crc >> 1) ^ _ui32Key;
-				}
-				else {
-					ui32Crc >>= 1;
-				}
-			}
-			_pui32Table[I] = ui32Crc;
-		}
-	}
-
-	/**
-	 * Calculates the CRC of a given byte, modifying the previous CRC value in-place.
-	 *
-	 * \param _pui32Table The table to use.
-	 * \param _ui8Val The byte to add to the CRC calculation.
-	 * \param _ui32Crc The CRC to update.
-	 */
-	void CCrc::GetCrc( uint32_t * _pui32Table, uint8_t _ui8Val, uint32_t &_ui32Crc ) {
-		_ui32Crc = (_ui32Crc >> 8) ^ _pui32Table[_ui8Val^(_ui32Crc&0xFF)];
-	}
-
 }	// namespace lsn
@@ -8,6 +8,7 @@
 
 
 #pragma once
+#include <array>
 #include <cinttypes>
 
 
@@ -17,6 +18,8 @@ namespace lsn {
 	 * \brief A standard 32-bit cyclic redundancy check calculator.
 	 *
 	 * Description: A standard 32-bit cyclic redundancy check calculator.
+	 * The standard CRC is calculated 8 bytes at a time with slicing-by-8 tables.  The tables are built at compile time, so the class
+	 *	can be used from any number of threads at once.
 	 */
 	class CCrc {
 	public :
@@ -41,44 +44,76 @@ namespace lsn {
 
 
 	protected :
+		// == Types.
+		/** A table of codes. */
+		typedef std::array<uint32_t, 256>
+										LSN_TABLE;
+
+
 		// == Members.
 		/**
-		 * Standard table of codes.
+		 * Standard tables of codes.  Table 0 is the byte-at-a-time table and table N advances a byte through N more bytes of zeros.
 		 */
-		static uint32_t					m_ui32StdTable[256];
+		static const std::array<LSN_TABLE, 8>
+										m_aStdTable;
 
 		/**
 		 * Alternative table of codes.
 		 */
-		static uint32_t					m_ui32AltTable[256];
-
-		/**
-		 * Has the table been initialized?
-		 */
-		static bool						m_bInit;
+		static const LSN_TABLE			m_aAltTable;
 
 
 		// == Functions.
 		/**
-		 * Initialize the tables.
+		 * Creates a table with a key.
+		 *
+		 * \param _ui32Key The key to use for initialization.
+		 * \return Returns the table.
 		 */
-		static void 					Init();
+		static constexpr LSN_TABLE		MakeTable( uint32_t _ui32Key ) {
+			LSN_TABLE tTable {};
+			for ( uint32_t I = 0; I < 256; ++I ) {
+				uint32_t ui32Crc = I;
+				for ( uint32_t J = 8; J--; ) {
+					if ( ui32Crc & 1 ) {
+						ui32Crc = (ui32Crc >> 1) ^ _ui32Key;
+					}
+					else {
+						ui32Crc >>= 1;
+					}
+				}
+				tTable[I] = ui32Crc;
+			}
+			return tTable;
+		}
 
 		/**
-		 * Initialize a table with a key.
+		 * Creates the slicing-by-8 tables with a key.
 		 *
-		 * \param _pui32Table The table to initialize
 		 * \param _ui32Key The key to use for initialization.
+		 * \return Returns the tables.
 		 */
-		static void 					Init( uint32_t * _pui32Table, uint32_t _ui32Key );
+		static constexpr std::array<LSN_TABLE, 8>
+										MakeSliceTables( uint32_t _ui32Key ) {
+			std::array<LSN_TABLE, 8> aTables {};
+			aTables[0] = MakeTable( _ui32Key );
+			for ( uint32_t I = 1; I < 8; ++I ) {
+				for ( uint32_t J = 0; J < 256; ++J ) {
+					aTables[I][J] = (aTables[I-1][J] >> 8) ^ aTables[0][aTables[I-1][J]&0xFF];
+				}
+			}
+			return aTables;
+		}
 
 		/**
 		 * Calculates the CRC of a given byte, modifying the previous CRC value in-place.
 		 *
-		 * \param _pui32Table The table to use.
+		 * \param _tTable The table to use.
 		 * \param _ui8Val The byte to add to the CRC calculation.
 		 * \param _ui32Crc The CRC to update.
 		 */
-		static void 					GetCrc( uint32_t * _pui32Table, uint8_t _ui8Val, uint32_t &_ui32Crc );
+		static inline void 				GetCrc( const LSN_TABLE &_tTable, uint8_t _ui8Val, uint32_t &_ui32Crc ) {
+			_ui32Crc = (_ui32Crc >> 8) ^ _tTable[_ui8Val^(_ui32Crc&0xFF)];
+		}
 	};
 }	// namespace lsn
@@ -0,0 +1,102 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A SHA-1 class, used to hash frames the same way test manifests do.
+ */
+
+
+#include "LSNSha1.h"
+
+#include <cstring>
+
+namespace lsn {
+
+	// == Functions.
+	/**
+	 * Calculates the SHA-1 digest of a given set of bytes.
+	 *
+	 * \param _pui8Data The data for which to calculate a digest.
+	 * \param _sLen Length of the data.
+	 * \return Returns the SHA-1 digest of the given data.
+	 */
+	CSha1::LSN_DIGEST CSha1::GetSha1( const uint8_t * _pui8Data, size_t _sLen ) {
+		uint32_t ui32State[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+		uint64_t ui64Bits = uint64_t( _sLen ) * 8;
+		for ( ; _sLen >= 64; _sLen -= 64, _pui8Data += 64 ) {
+			Block( _pui8Data, ui32State );
+		}
+
+		// The last block holds the rest of the data, a 1 bit, and the length in bits, spilling into a second block if needed.
+		uint8_t ui8Tail[128] = {};
+		if ( _sLen ) { std::memcpy( ui8Tail, _pui8Data, _sLen ); }
+		ui8Tail[_sLen] = 0x80;
+		size_t sTail = _sLen + 1 + 8 <= 64 ? 64 : 128;
+		for ( size_t I = 0; I < 8; ++I ) {
+			ui8Tail[sTail-1-I] = uint8_t( ui64Bits >> (I * 8) );
+		}
+		for ( size_t I = 0; I < sTail; I += 64 ) {
+			Block( &ui8Tail[I], ui32State );
+		}
+
+		LSN_DIGEST dDigest;
+		for ( size_t I = 0; I < 5; ++I ) {
+			dDigest[I*4+0] = uint8_t( ui32State[I] >> 24 );
+			dDigest[I*4+1] = uint8_t( ui32State[I] >> 16 );
+			dDigest[I*4+2] = uint8_t( ui32State[I] >> 8 );
+			dDigest[I*4+3] = uint8_t( ui32State[I] );
+		}
+		return dDigest;
+	}
+
+	/**
+	 * Adds a 64-byte block to the hash state.
+	 *
+	 * \param _pui8Block The block to add.
+	 * \param _pui32State The hash state to update.
+	 */
+	void CSha1::Block( const uint8_t * _pui8Block, uint32_t * _pui32State ) {
+		uint32_t ui32W[80];
+		for ( size_t I = 0; I < 16; ++I ) {
+			ui32W[I] = (uint32_t( _pui8Block[I*4+0] ) << 24) | (uint32_t( _pui8Block[I*4+1] ) << 16) |
+				(uint32_t( _pui8Block[I*4+2] ) << 8) | uint32_t( _pui8Block[I*4+3] );
+		}
+		for ( size_t I = 16; I < 80; ++I ) {
+			ui32W[I] = Rol( ui32W[I-3] ^ ui32W[I-8] ^ ui32W[I-14] ^ ui32W[I-16], 1 );
+		}
+
+		uint32_t ui32A = _pui32State[0], ui32B = _pui32State[1], ui32C = _pui32State[2], ui32D = _pui32State[3], ui32E = _pui32State[4];
+		for ( size_t I = 0; I < 80; ++I ) {
+			uint32_t ui32F, ui32K;
+			if ( I < 20 ) {
+				ui32F = (ui32B & ui32C) | (~ui32B & ui32D);
+				ui32K = 0x5A827999;
+			}
+			else if ( I < 40 ) {
+				ui32F = ui32B ^ ui32C ^ ui32D;
+				ui32K = 0x6ED9EBA1;
+			}
+			else if ( I < 60 ) {
+				ui32F = (ui32B & ui32C) | (ui32B & ui32D) | (ui32C & ui32D);
+				ui32K = 0x8F1BBCDC;
+			}
+			else {
+				ui32F = ui32B ^ ui32C ^ ui32D;
+				ui32K = 0xCA62C1D6;
+			}
+			uint32_t ui32Tmp = Rol( ui32A, 5 ) + ui32F + ui32E + ui32K + ui32W[I];
+			ui32E = ui32D;
+			ui32D = ui32C;
+			ui32C = Rol( ui32B, 30 );
+			ui32B = ui32A;
+			ui32A = ui32Tmp;
+		}
+		_pui32State[0] += ui32A;
+		_pui32State[1] += ui32B;
+		_pui32State[2] += ui32C;
+		_pui32State[3] += ui32D;
+		_pui32State[4] += ui32E;
+	}
+
+}	// namespace lsn
@@ -0,0 +1,62 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A SHA-1 class, used to hash frames the same way test manifests do.
+ */
+
+
+#pragma once
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+
+
+namespace lsn {
+	/**
+	 * Class CSha1
+	 * \brief A SHA-1 calculator.
+	 *
+	 * Description: A SHA-1 calculator.  SHA-1 is only used to compare frames against the hashes in test manifests.
+	 */
+	class CSha1 {
+	public :
+		// == Types.
+		/** A SHA-1 digest. */
+		typedef std::array<uint8_t, 20>	LSN_DIGEST;
+
+
+		// == Functions.
+		/**
+		 * Calculates the SHA-1 digest of a given set of bytes.
+		 *
+		 * \param _pui8Data The data for which to calculate a digest.
+		 * \param _sLen Length of the data.
+		 * \return Returns the SHA-1 digest of the given data.
+		 */
+		static LSN_DIGEST				GetSha1( const uint8_t * _pui8Data, size_t _sLen );
+
+
+	protected :
+		// == Functions.
+		/**
+		 * Adds a 64-byte block to the hash state.
+		 *
+		 * \param _pui8Block The block to add.
+		 * \param _pui32State The hash state to update.
+		 */
+		static void						Block( const uint8_t * _pui8Block, uint32_t * _pui32State );
+
+		/**
+		 * Rotates a 32-bit value left.
+		 *
+		 * \param _ui32Val The value to rotate.
+		 * \param _ui32Bits The number of bits by which to rotate.
+		 * \return Returns the rotated value.
+		 */
+		static inline uint32_t			Rol( uint32_t _ui32Val, uint32_t _ui32Bits ) {
+			return (_ui32Val << _ui32Bits) | (_ui32Val >> (32 - _ui32Bits));
+		}
+	};
+}	// namespace lsn
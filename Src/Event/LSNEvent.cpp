@@ -76,7 +76,7 @@ namespace lsn {
 				tsTime.tv_sec += tsTime.tv_nsec / 1000000000;
 				tsTime.tv_nsec %= 1000000000;
 
-				result = ::pthread_cond_timedwait( &m_cHandle, &m_mLock, &tsTime );
+				iResult = ::pthread_cond_timedwait( &m_cHandle, &m_mLock, &tsTime );
 #else
 				::timespec tsTime;
 				tsTime.tv_sec = _ui32Milliseconds / 1000;
@@ -103,6 +103,11 @@ namespace lsn {
 	void CEvent::Signal() {
 #ifdef LSN_WINDOWS
 		::SetEvent( m_hHandle );
+#elif defined( __GNUC__ )
+		::pthread_mutex_lock( &m_mLock );
+		m_bTriggered = true;
+		::pthread_cond_signal( &m_cHandle );
+		::pthread_mutex_unlock( &m_mLock );
 #else
 #endif	// #ifdef LSN_WINDOWS
 	}
@@ -8,6 +8,15 @@
 
 #include "LSNFileMap.h"
 
+#include <algorithm>
+
+#ifndef LSN_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif	// #ifndef LSN_WINDOWS
+
 
 namespace lsn {
 
@@ -26,12 +35,21 @@ namespace lsn {
 		Close();
 	}
 #else
+	CFileMap::CFileMap() :
+		m_iFile( -1 ),
+		m_pvMapBuffer( nullptr ),
+		m_bWritable( false ),
+		m_ui64Size( 0 ) {
+	}
+	CFileMap::~CFileMap() {
+		Close();
+	}
 #endif	// #ifdef LSN_WINDOWS
 
 	// == Functions.
 #ifdef LSN_WINDOWS
 	/**
-	 * Opens a file.  The path is given in UTF-16.
+	 * Opens a file for reading.  The path is given in UTF-16.
 	 *
 	 * \param _pcPath Path to the file to open.
 	 * \return Returns true if the file was opened, false otherwise.
@@ -39,8 +57,8 @@ namespace lsn {
 	bool CFileMap::Open( const char16_t * _pcFile ) {
 		Close();
 		m_hFile = ::CreateFileW( reinterpret_cast<LPCWSTR>(_pcFile),
-			GENERIC_READ | GENERIC_WRITE,
-			0,
+			GENERIC_READ,
+			FILE_SHARE_READ,
 			NULL,
 			OPEN_EXISTING,
 			FILE_ATTRIBUTE_NORMAL,
@@ -54,12 +72,12 @@ namespace lsn {
 			Close();
 			return false;
 		}
-		m_bWritable = true;
+		m_bWritable = false;
 		return CreateFileMap();
 	}
 
 	/**
-	 * Creates a file.  The path is given in UTF-16.
+	 * Creates a file for reading and writing.  The path is given in UTF-16.
 	 *
 	 * \param _pcPath Path to the file to create.
 	 * \return Returns true if the file was created, false otherwise.
@@ -153,6 +171,28 @@ namespace lsn {
 		return m_ui64Size;
 	}
 
+	/**
+	 * Maps the whole file into memory.  The view stays valid until the file is closed.
+	 * 
+	 * \return Returns a pointer to the mapped bytes, or nullptr if the file is empty or could not be mapped.
+	 **/
+	const uint8_t * CFileMap::Data() const {
+		if ( !m_pbMapBuffer && !m_bIsEmpty ) {
+			m_pbMapBuffer = static_cast<PBYTE>(::MapViewOfFile(
+#ifdef LSN_USE_WINDOWS
+				m_hMap.hHandle
+#else
+				m_hMap
+#endif	// #ifdef LSN_USE_WINDOWS
+				, m_bWritable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0 ));
+			if ( m_pbMapBuffer ) {
+				m_ui64MapStart = 0;
+				m_dwMapSize = DWORD( std::min<uint64_t>( Size(), MAXDWORD ) );
+			}
+		}
+		return m_pbMapBuffer;
+	}
+
 	/**
 	 * Creates the file map.
 	 * 
@@ -196,23 +236,80 @@ namespace lsn {
 	}
 #else
 	/**
-	 * Opens a file.  The path is given in UTF-8.
+	 * Opens a file for reading.  The path is given in UTF-8.
 	 *
 	 * \param _pcFile Path to the file to open.
 	 * \return Returns true if the file was opened, false otherwise.
 	 */
 	bool CFileMap::Open( const char8_t * _pcFile ) {
-		return false;
+		Close();
+		m_iFile = ::open( reinterpret_cast<const char *>(_pcFile), O_RDONLY );
+		if ( m_iFile == -1 ) { return false; }
+		struct stat sStat;
+		if ( ::fstat( m_iFile, &sStat ) != 0 ) {
+			Close();
+			return false;
+		}
+		m_ui64Size = uint64_t( sStat.st_size );
+		m_bWritable = false;
+		return true;
 	}
 
 	/**
-	 * Creates a file.  The path is given in UTF-8.
+	 * Creates a file for reading and writing.  The path is given in UTF-8.
 	 *
 	 * \param _pcFile Path to the file to create.
 	 * \return Returns true if the file was created, false otherwise.
 	 */
 	bool CFileMap::Create( const char8_t * _pcFile ) {
-		return false;
+		Close();
+		m_iFile = ::open( reinterpret_cast<const char *>(_pcFile), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+		if ( m_iFile == -1 ) { return false; }
+		if ( ::ftruncate( m_iFile, 4 * 1024 ) != 0 ) {
+			Close();
+			return false;
+		}
+		m_ui64Size = 4 * 1024;
+		m_bWritable = true;
+		return true;
+	}
+
+	/**
+	 * Closes the opened file.
+	 */
+	void CFileMap::Close() {
+		if ( m_pvMapBuffer ) {
+			::munmap( m_pvMapBuffer, size_t( m_ui64Size ) );
+			m_pvMapBuffer = nullptr;
+		}
+		if ( m_iFile != -1 ) {
+			::close( m_iFile );
+			m_iFile = -1;
+		}
+		m_ui64Size = 0;
+	}
+
+	/**
+	 * Gets the size of the file.
+	 * 
+	 * \return Returns the size of the file.
+	 **/
+	uint64_t CFileMap::Size() const {
+		return m_ui64Size;
+	}
+
+	/**
+	 * Maps the whole file into memory.  The view stays valid until the file is closed.
+	 * 
+	 * \return Returns a pointer to the mapped bytes, or nullptr if the file is empty or could not be mapped.
+	 **/
+	const uint8_t * CFileMap::Data() const {
+		if ( !m_pvMapBuffer && m_iFile != -1 && m_ui64Size ) {
+			void * pvMap = ::mmap( nullptr, size_t( m_ui64Size ), m_bWritable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+				m_bWritable ? MAP_SHARED : MAP_PRIVATE, m_iFile, 0 );
+			if ( pvMap != MAP_FAILED ) { m_pvMapBuffer = pvMap; }
+		}
+		return static_cast<const uint8_t *>(m_pvMapBuffer);
 	}
 #endif	// #ifdef LSN_WINDOWS
 
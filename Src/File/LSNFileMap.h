@@ -26,6 +26,7 @@ namespace lsn {
 	 * \brief A file-mapping.
 	 *
 	 * Description: A file-mapping.
+	 * Open() opens a file read-only and Data() maps all of it, so the bytes can be used in place without being loaded.
 	 */
 	class CFileMap : public CFileBase {
 	public :
@@ -36,7 +37,7 @@ namespace lsn {
 		// == Functions.
 #ifdef LSN_WINDOWS
 		/**
-		 * Opens a file.  The path is given in UTF-8.
+		 * Opens a file for reading.  The path is given in UTF-8.
 		 *
 		 * \param _pcPath Path to the file to open.
 		 * \return Returns true if the file was opened, false otherwise.
@@ -44,7 +45,7 @@ namespace lsn {
 		virtual bool										Open( const char8_t * _pcFile ) { return CFileBase::Open( _pcFile ); }
 
 		/**
-		 * Opens a file.  The path is given in UTF-16.
+		 * Opens a file for reading.  The path is given in UTF-16.
 		 *
 		 * \param _pcPath Path to the file to open.
 		 * \return Returns true if the file was opened, false otherwise.
@@ -52,7 +53,7 @@ namespace lsn {
 		virtual bool										Open( const char16_t * _pcFile );
 
 		/**
-		 * Creates a file.  The path is given in UTF-8.
+		 * Creates a file for reading and writing.  The path is given in UTF-8.
 		 *
 		 * \param _pcPath Path to the file to create.
 		 * \return Returns true if the file was created, false otherwise.
@@ -60,7 +61,7 @@ namespace lsn {
 		virtual bool										Create( const char8_t * _pcFile ) { return CFileBase::Create( _pcFile ); }
 
 		/**
-		 * Creates a file.  The path is given in UTF-16.
+		 * Creates a file for reading and writing.  The path is given in UTF-16.
 		 *
 		 * \param _pcPath Path to the file to create.
 		 * \return Returns true if the file was created, false otherwise.
@@ -68,7 +69,7 @@ namespace lsn {
 		virtual bool										Create( const char16_t * _pcFile );
 #else
 		/**
-		 * Opens a file.  The path is given in UTF-8.
+		 * Opens a file for reading.  The path is given in UTF-8.
 		 *
 		 * \param _pcPath Path to the file to open.
 		 * \return Returns true if the file was opened, false otherwise.
@@ -76,7 +77,7 @@ namespace lsn {
 		virtual bool										Open( const char8_t * _pcFile );
 
 		/**
-		 * Opens a file.  The path is given in UTF-16.
+		 * Opens a file for reading.  The path is given in UTF-16.
 		 *
 		 * \param _pcPath Path to the file to open.
 		 * \return Returns true if the file was opened, false otherwise.
@@ -84,7 +85,7 @@ namespace lsn {
 		virtual bool										Open( const char16_t * _pcFile ) { return CFileBase::Open( _pcFile ); }
 
 		/**
-		 * Creates a file.  The path is given in UTF-8.
+		 * Creates a file for reading and writing.  The path is given in UTF-8.
 		 *
 		 * \param _pcPath Path to the file to create.
 		 * \return Returns true if the file was created, false otherwise.
@@ -92,7 +93,7 @@ namespace lsn {
 		virtual bool										Create( const char8_t * _pcFile );
 
 		/**
-		 * Creates a file.  The path is given in UTF-16.
+		 * Creates a file for reading and writing.  The path is given in UTF-16.
 		 *
 		 * \param _pcPath Path to the file to create.
 		 * \return Returns true if the file was created, false otherwise.
@@ -112,6 +113,13 @@ namespace lsn {
 		 **/
 		virtual uint64_t									Size() const;
 
+		/**
+		 * Maps the whole file into memory.  The view stays valid until the file is closed.
+		 * 
+		 * \return Returns a pointer to the mapped bytes, or nullptr if the file is empty or could not be mapped.
+		 **/
+		const uint8_t *										Data() const;
+
 
 	protected :
 		// == Members.
@@ -130,6 +138,10 @@ namespace lsn {
 		mutable uint64_t									m_ui64MapStart;					/**< Map start. */
 		mutable DWORD										m_dwMapSize;					/**< Mapped size. */
 #else
+		int													m_iFile;						/**< The file descriptor. */
+		mutable void *										m_pvMapBuffer;					/**< Mapped bytes. */
+		bool												m_bWritable;					/**< Read-only or read-write? */
+		uint64_t											m_ui64Size;						/**< Size of the file. */
 #endif	// #ifdef LSN_WINDOWS
 
 
@@ -213,6 +213,40 @@ namespace lsn {
 		return false;
 	}
 
+	/**
+	 * Finds where a file that is stored without compression lies in the archive, so that it can be used in place.
+	 *
+	 * \param _s16File The name of the file to find.
+	 * \param _ui64Offset Holds the offset of the file's data from the start of the archive.
+	 * \param _ui64Size Holds the size of the file.
+	 * \return Returns true if the file exists and is stored without compression or encryption.
+	 */
+	bool CZipFile::FindStoredFile( const std::u16string &_s16File, uint64_t &_ui64Offset, uint64_t &_ui64Size ) const {
+		if ( m_pfFile != nullptr || m_zaArchive.m_archive_size != 0 ) {
+			bool bError;
+			std::u8string sUtf8 = CUtilities::Utf16ToUtf8( _s16File.c_str(), &bError );
+			if ( bError ) { return false; }
+			mz_zip_archive * pzaArchive = const_cast<mz_zip_archive *>(&m_zaArchive);
+			int iIdx = ::mz_zip_reader_locate_file( pzaArchive, reinterpret_cast<const char *>(sUtf8.c_str()), nullptr, 0 );
+			if ( iIdx < 0 ) { return false; }
+			::mz_zip_archive_file_stat zafsStat;
+			if ( !::mz_zip_reader_file_stat( pzaArchive, mz_uint( iIdx ), &zafsStat ) ) { return false; }
+			if ( zafsStat.m_method != 0 || zafsStat.m_is_encrypted || zafsStat.m_comp_size != zafsStat.m_uncomp_size ) { return false; }
+
+			// The data follows the local header, whose name and extra fields can differ from the central directory's.
+			uint8_t ui8Header[30];
+			if ( pzaArchive->m_pRead( pzaArchive->m_pIO_opaque, zafsStat.m_local_header_ofs, ui8Header, sizeof( ui8Header ) ) != sizeof( ui8Header ) ) { return false; }
+			const uint8_t ui8Signature[] = { 0x50, 0x4B, 0x03, 0x04 };
+			if ( std::memcmp( ui8Header, ui8Signature, sizeof( ui8Signature ) ) != 0 ) { return false; }
+			uint64_t ui64NameLen = uint64_t( ui8Header[26] ) | (uint64_t( ui8Header[27] ) << 8);
+			uint64_t ui64ExtraLen = uint64_t( ui8Header[28] ) | (uint64_t( ui8Header[29] ) << 8);
+			_ui64Offset = zafsStat.m_local_header_ofs + sizeof( ui8Header ) + ui64NameLen + ui64ExtraLen;
+			_ui64Size = zafsStat.m_uncomp_size;
+			return _ui64Offset + _ui64Size <= m_zaArchive.m_archive_size;
+		}
+		return false;
+	}
+
 	// == Functions.
 	/**
 	 * Performs post-loading operations after a successful loading of the file.  m_pfFile will be valid when this is called.  Override to perform additional loading operations on m_pfFile.
@@ -99,6 +99,16 @@ namespace lsn {
 		 */
 		virtual bool										ExtractToMemory( const std::u16string &_u16PathTo, const std::u16string &_u16PathAfter, std::vector<std::u16string> &_vResult, std::vector<std::vector<uint8_t>> &_vDataResult, const char16_t * _pcExt, uint32_t * _pui32FailedLoads = nullptr, bool _bExamineZipFiles = true ) const;
 
+		/**
+		 * Finds where a file that is stored without compression lies in the archive, so that it can be used in place.
+		 *
+		 * \param _s16File The name of the file to find.
+		 * \param _ui64Offset Holds the offset of the file's data from the start of the archive.
+		 * \param _ui64Size Holds the size of the file.
+		 * \return Returns true if the file exists and is stored without compression or encryption.
+		 */
+		bool												FindStoredFile( const std::u16string &_s16File, uint64_t &_ui64Offset, uint64_t &_ui64Size ) const;
+
 
 	protected :
 		// == Members.
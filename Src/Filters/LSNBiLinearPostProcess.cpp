@@ -7,6 +7,8 @@
  */
 
 #include "LSNBiLinearPostProcess.h"
+#include "../Utilities/LSNJobPool.h"
+#include "../Utilities/LSNProfiler.h"
 #include "../Utilities/LSNUtilities.h"
 #include "LSNFilterBase.h"
 /*#include "SinCos/EESinCos.h"
@@ -16,20 +18,11 @@
 namespace lsn {
 
 	CBiLinearPostProcess::CBiLinearPostProcess() :
-#ifdef LSN_BILINEAR_POST_PERF
-		m_pMonitor( "CBiLinearPostProcess" ),
-#endif	// #ifdef LSN_BILINEAR_POST_PERF
 		m_ui32SourceFactorX( 0 ),
-		m_ui32SourceFactorY( 0 ),
-		m_bRunThreads( true ) {
-
-#if defined( LSN_WINDOWS )
-		m_tThreadData.pblppThis = this;
-		m_ptResizeThread = std::make_unique<std::thread>( ResizeThread, &m_tThreadData );
-#endif	// #if defined( LSN_WINDOWS )
+		m_ui32SourceFactorY( 0 ) {
+		m_jpJobParms.pblppThis = this;
 	}
 	CBiLinearPostProcess::~CBiLinearPostProcess() {
-		StopResizeThread();
 	}
 
 
@@ -52,6 +45,7 @@ namespace lsn {
 		uint32_t _ui32ScreenWidth, uint32_t _ui32ScreenHeight, bool &/*_bFlipped*/,
 		uint32_t &_ui32Width, uint32_t &_ui32Height, uint16_t &/*_ui16BitDepth*/, uint32_t &_ui32Stride, uint64_t /*_ui64PpuFrame*/,
 		uint64_t /*_ui64RenderStartCycle*/ ) {
+		LSN_PROFILE_SCOPE( "Bilinear Post" );
 		/*double dRatio = double( _ui32ScreenWidth ) / _ui32ScreenHeight;
 		_ui32ScreenWidth = std::min<uint32_t>( _ui32ScreenWidth, uint32_t( std::round( 256 * 3 * dRatio ) ) );
 		_ui32ScreenHeight = std::min<uint32_t>( _ui32ScreenHeight, 240 * 3 );*/
@@ -93,42 +87,21 @@ namespace lsn {
 			m_vRowTmp.resize( ui32Stride * (_ui32Height + 1) );
 		}
 
-#ifdef LSN_BILINEAR_POST_PERF
-		m_pMonitor.Begin();
-#endif	// #ifdef LSN_BILINEAR_POST_PERF
-
-
-		for ( uint32_t Y = 0; Y < _ui32Height; ++Y ) {
-			uint32_t * pui32SrcRow = reinterpret_cast<uint32_t *>(_pui8Input + (Y * _ui32Stride));
-			uint32_t * pui32DstRow = reinterpret_cast<uint32_t *>(m_vRowTmp.data() + (Y * ui32Stride));
-			//LSN_PREFETCH_LINE( m_vRowTmp.data() + ((Y + 1) * ui32Stride) );
-			CUtilities::LinearInterpolateRow_Int( pui32SrcRow, pui32DstRow, m_vFactorsX.data(), _ui32Width, _ui32ScreenWidth );
-		}
 
-		m_tThreadData.ui32ScreenHeight = _ui32ScreenHeight;
-		m_tThreadData.ui32ScreenWidth = _ui32ScreenWidth;
-		m_tThreadData.ui32Stride = ui32Stride;
-		if ( m_ptResizeThread.get() ) {
-			m_eResizeGo.Signal();
-		}
+		m_jpJobParms.pui8Input = _pui8Input;
+		m_jpJobParms.ui32Width = _ui32Width;
+		m_jpJobParms.ui32Height = _ui32Height;
+		m_jpJobParms.ui32InputStride = _ui32Stride;
+		m_jpJobParms.ui32ScreenWidth = _ui32ScreenWidth;
+		m_jpJobParms.ui32ScreenHeight = _ui32ScreenHeight;
+		m_jpJobParms.ui32Stride = ui32Stride;
+		CJobPool & jpPool = CJobPool::Get();
+		// Every band of the vertical pass can read from any row of the horizontal pass, so the passes run one after the other.
+		m_jpJobParms.sBands = jpPool.Bands( _ui32Height );
+		jpPool.ParallelFor( InterpolateRowsBand, &m_jpJobParms, m_jpJobParms.sBands );
+		m_jpJobParms.sBands = jpPool.Bands( _ui32ScreenHeight );
+		jpPool.ParallelFor( CombineRowsBand, &m_jpJobParms, m_jpJobParms.sBands );
 
-		uint32_t ui32FinalH = _ui32ScreenHeight >> 1;
-		for ( uint32_t Y = 0; Y < ui32FinalH; ++Y ) {
-			uint32_t ui32SrcRow = m_vFactorsY[Y] >> 8;
-			uint32_t * pui32SrcRow = reinterpret_cast<uint32_t *>(m_vRowTmp.data() + ((ui32SrcRow) * ui32Stride));
-			uint32_t * pui32SrcNextRow = reinterpret_cast<uint32_t *>(m_vRowTmp.data() + ((ui32SrcRow + 1) * ui32Stride));
-			//LSN_PREFETCH_LINE( m_vRowTmp.data() + ((ui32SrcRow + 2) * ui32Stride) );
-			uint32_t * pui32DstRow = reinterpret_cast<uint32_t *>(m_vFinalBuffer.data() + (Y * ui32Stride));
-			CUtilities::LinearInterpCombineRows_Int( pui32SrcRow, pui32SrcNextRow, pui32DstRow, _ui32ScreenWidth, m_vFactorsY[Y] & 0xFF );
-		}
-
-		if ( m_ptResizeThread.get() ) {
-			m_eResizeDone.WaitForSignal();
-		}
-
-#ifdef LSN_BILINEAR_POST_PERF
-		m_pMonitor.Stop();
-#endif	// #ifdef LSN_BILINEAR_POST_PERF
 		_ui32Width = _ui32ScreenWidth;
 		_ui32Height = _ui32ScreenHeight;
 		_ui32Stride = ui32Stride;
@@ -136,38 +109,42 @@ namespace lsn {
 	}
 
 	/**
-	 * Stops the resizing thread.
+	 * Resizes a band of input rows horizontally into m_vRowTmp.
+	 *
+	 * \param _pvParm Pointer to the LSN_JOB_PARMS structure.
+	 * \param _sBand The index of the band of rows to resize.
 	 */
-	void CBiLinearPostProcess::StopResizeThread() {
-		m_bRunThreads = false;
-		if ( m_ptResizeThread.get() ) {
-			m_eResizeGo.Signal();
-			m_eResizeDone.WaitForSignal();
-			m_ptResizeThread->join();
-			m_ptResizeThread.reset();
+	void CBiLinearPostProcess::InterpolateRowsBand( void * _pvParm, size_t _sBand ) {
+		const LSN_JOB_PARMS * pjpParms = static_cast<const LSN_JOB_PARMS *>(_pvParm);
+		CBiLinearPostProcess * pblppThis = pjpParms->pblppThis;
+		size_t sStart, sEnd;
+		CJobPool::BandRange( _sBand, pjpParms->sBands, pjpParms->ui32Height, sStart, sEnd );
+		for ( size_t Y = sStart; Y < sEnd; ++Y ) {
+			uint32_t * pui32SrcRow = reinterpret_cast<uint32_t *>(pjpParms->pui8Input + (Y * pjpParms->ui32InputStride));
+			uint32_t * pui32DstRow = reinterpret_cast<uint32_t *>(pblppThis->m_vRowTmp.data() + (Y * pjpParms->ui32Stride));
+			//LSN_PREFETCH_LINE( pblppThis->m_vRowTmp.data() + ((Y + 1) * pjpParms->ui32Stride) );
+			CUtilities::LinearInterpolateRow_Int( pui32SrcRow, pui32DstRow, pblppThis->m_vFactorsX.data(), pjpParms->ui32Width, pjpParms->ui32ScreenWidth );
 		}
-		m_bRunThreads = true;
 	}
 
 	/**
-	 * The resizing thread.
+	 * Combines pairs of rows in m_vRowTmp into a band of final rows.
 	 *
-	 * \param _pblppFilter Pointer to this object.
+	 * \param _pvParm Pointer to the LSN_JOB_PARMS structure.
+	 * \param _sBand The index of the band of final rows to create.
 	 */
-	void CBiLinearPostProcess::ResizeThread( LSN_THREAD * _ptThread ) {
-		while ( _ptThread->pblppThis->m_bRunThreads ) {
-			_ptThread->pblppThis->m_eResizeGo.WaitForSignal();
-			if ( _ptThread->pblppThis->m_bRunThreads ) {
-				for ( uint32_t Y = _ptThread->ui32ScreenHeight >> 1; Y < _ptThread->ui32ScreenHeight; ++Y ) {
-					uint32_t ui32SrcRow = _ptThread->pblppThis->m_vFactorsY[Y] >> 8;
-					uint32_t * pui32SrcRow = reinterpret_cast<uint32_t *>(_ptThread->pblppThis->m_vRowTmp.data() + ((ui32SrcRow) * _ptThread->ui32Stride));
-					uint32_t * pui32SrcNextRow = reinterpret_cast<uint32_t *>(_ptThread->pblppThis->m_vRowTmp.data() + ((ui32SrcRow + 1) * _ptThread->ui32Stride));
-					//LSN_PREFETCH_LINE( _ptThread->pblppThis->m_vRowTmp.data() + ((ui32SrcRow + 2) * _ptThread->ui32Stride) );
-					uint32_t * pui32DstRow = reinterpret_cast<uint32_t *>(_ptThread->pblppThis->m_vFinalBuffer.data() + (Y * _ptThread->ui32Stride));
-					CUtilities::LinearInterpCombineRows_Int( pui32SrcRow, pui32SrcNextRow, pui32DstRow, _ptThread->ui32ScreenWidth, _ptThread->pblppThis->m_vFactorsY[Y] & 0xFF );
-				}
-			}
-			_ptThread->pblppThis->m_eResizeDone.Signal();
+	void CBiLinearPostProcess::CombineRowsBand( void * _pvParm, size_t _sBand ) {
+		const LSN_JOB_PARMS * pjpParms = static_cast<const LSN_JOB_PARMS *>(_pvParm);
+		CBiLinearPostProcess * pblppThis = pjpParms->pblppThis;
+		size_t sStart, sEnd;
+		CJobPool::BandRange( _sBand, pjpParms->sBands, pjpParms->ui32ScreenHeight, sStart, sEnd );
+		for ( size_t Y = sStart; Y < sEnd; ++Y ) {
+			uint32_t ui32SrcRow = pblppThis->m_vFactorsY[Y] >> 8;
+			uint32_t * pui32SrcRow = reinterpret_cast<uint32_t *>(pblppThis->m_vRowTmp.data() + ((ui32SrcRow) * pjpParms->ui32Stride));
+			uint32_t * pui32SrcNextRow = reinterpret_cast<uint32_t *>(pblppThis->m_vRowTmp.data() + ((ui32SrcRow + 1) * pjpParms->ui32Stride));
+			//LSN_PREFETCH_LINE( pblppThis->m_vRowTmp.data() + ((ui32SrcRow + 2) * pjpParms->ui32Stride) );
+			uint32_t * pui32DstRow = reinterpret_cast<uint32_t *>(pblppThis->m_vFinalBuffer.data() + (Y * pjpParms->ui32Stride));
+			CUtilities::LinearInterpCombineRows_Int( pui32SrcRow, pui32SrcNextRow, pui32DstRow, pjpParms->ui32ScreenWidth, pblppThis->m_vFactorsY[Y] & 0xFF );
 		}
 	}
 
@@ -7,6 +7,8 @@
  */
 
 #include "LSNBleedPostProcess.h"
+#include "../Utilities/LSNJobPool.h"
+#include "../Utilities/LSNProfiler.h"
 #include "../Utilities/LSNUtilities.h"
 #include "LSNFilterBase.h"
 
@@ -14,18 +16,9 @@
 namespace lsn {
 
 	CBleedPostProcess::CBleedPostProcess() :
-#ifdef LSN_SRGB_POST_PERF
-		m_pMonitor( "CBleedPostProcess" ),
-#endif	// #ifdef LSN_SRGB_POST_PERF
-		m_bRunThreads( true ) {
-
-#if defined( LSN_WINDOWS )
-		m_tThreadData.pblppThis = this;
-		m_ptResizeThread = std::make_unique<std::thread>( Thread, &m_tThreadData );
-#endif	// #if defined( LSN_WINDOWS )
+		m_jpJobParms( { this } ) {
 	}
 	CBleedPostProcess::~CBleedPostProcess() {
-		StopThreads();
 	}
 
 
@@ -48,6 +41,7 @@ namespace lsn {
 		uint32_t /*_ui32ScreenWidth*/, uint32_t /*_ui32ScreenHeight*/, bool &/*_bFlipped*/,
 		uint32_t &_ui32Width, uint32_t &_ui32Height, uint16_t &/*_ui16BitDepth*/, uint32_t &_ui32Stride, uint64_t /*_ui64PpuFrame*/,
 		uint64_t /*_ui64RenderStartCycle*/ ) {
+		LSN_PROFILE_SCOPE( "Bleed Post" );
 		uint32_t ui32Stride = CFilterBase::RowStride( _ui32Width, 32 );
 		
 		uint32_t ui32Size = ui32Stride * _ui32Height;
@@ -56,10 +50,6 @@ namespace lsn {
 			m_vFinalBuffer.resize( ui32Size );
 		}
 
-#ifdef LSN_SRGB_POST_PERF
-		m_pMonitor.Begin();
-#endif	// #ifdef LSN_SRGB_POST_PERF
-
 
 #define LSN_BLEED	ui32Val = /*((ui32Val >> 1) & 0x7F7F7F7F) +*/			\
 						((ui32Val >> 2) & 0x3F3F3F3F) /*+*/						\
@@ -78,34 +68,13 @@ namespace lsn {
 						/*((ui32Val >> 7) & 0x01010101)*/
 
 #if 1
-		m_tThreadData.ui32ScreenHeight = _ui32Height;
-		m_tThreadData.ui32ScreenWidth = _ui32Width;
-		m_tThreadData.ui32Stride = ui32Stride;
-		m_tThreadData.pui8Input = _pui8Input;
-		{
-			if ( m_ptResizeThread.get() ) {
-				m_eResizeGo.Signal();
-			}
-		}
-		uint32_t ui32H = _ui32Height >> 1;
-		for ( uint32_t Y = 0; Y < ui32H; ++Y ) {
-			uint32_t ui32Val = 0;
-			uint32_t * pui32Src = reinterpret_cast<uint32_t *>(_pui8Input + Y * ui32Stride);
-			uint32_t * pui32Dst = reinterpret_cast<uint32_t *>(m_vFinalBuffer.data() + Y * ui32Stride);
-			for ( uint32_t X = 0; X < _ui32Width; ++X ) {
-				LSN_BLEED;
-				pui32Dst[X] = CUtilities::AddArgb( pui32Src[X], ui32Val );
-				ui32Val = CUtilities::AddArgb( CUtilities::ShiftArgbRight_Int<1>( pui32Src[X] ), ui32Val );
-				//pui32Dst[X] = CUtilities::AddArgb( pui32Src[X], ui32Val );
-			}
-		}
-
-
-		{
-			if ( m_ptResizeThread.get() ) {
-				m_eResizeDone.WaitForSignal();
-			}
-		}
+		m_jpJobParms.ui32ScreenHeight = _ui32Height;
+		m_jpJobParms.ui32ScreenWidth = _ui32Width;
+		m_jpJobParms.ui32Stride = ui32Stride;
+		m_jpJobParms.pui8Input = _pui8Input;
+		CJobPool & jpPool = CJobPool::Get();
+		m_jpJobParms.sBands = jpPool.Bands( _ui32Height );
+		jpPool.ParallelFor( BleedBand, &m_jpJobParms, m_jpJobParms.sBands );
 #else
 		for ( auto Y = _ui32Height; Y--; ) {
 			uint32_t ui32Val = 0;
@@ -120,54 +89,32 @@ namespace lsn {
 		}
 #endif
 
-#ifdef LSN_SRGB_POST_PERF
-		m_pMonitor.Stop();
-#endif	// #ifdef LSN_SRGB_POST_PERF
 		_ui32Stride = ui32Stride;
 		return m_vFinalBuffer.data();
 	}
 
 	/**
-	 * Stops the threads.
-	 */
-	void CBleedPostProcess::StopThreads() {
-		m_bRunThreads = false;
-		{
-			if ( m_ptResizeThread.get() ) {
-				m_eResizeGo.Signal();
-				m_eResizeDone.WaitForSignal();
-				m_ptResizeThread->join();
-				m_ptResizeThread.reset();
-			}
-		}
-		m_bRunThreads = true;
-	}
-
-	/**
-	 * The work thread.
+	 * Applies the bleed to a band of rows.
 	 *
-	 * \param _pblppFilter Pointer to this object.
+	 * \param _pvParm Pointer to the LSN_JOB_PARMS structure.
+	 * \param _sBand The index of the band of rows to process.
 	 */
-	void CBleedPostProcess::Thread( LSN_THREAD * _ptThread ) {
-		while ( _ptThread->pblppThis->m_bRunThreads ) {
-			_ptThread->pblppThis->m_eResizeGo.WaitForSignal();
-			if ( _ptThread->pblppThis->m_bRunThreads ) {
-				uint32_t ui32H = _ptThread->ui32ScreenHeight;
-				uint32_t ui32W = _ptThread->ui32ScreenWidth;
-				uint32_t ui32Stride = _ptThread->ui32Stride;
-				for ( uint32_t Y = ui32H >> 1; Y < ui32H; ++Y ) {
-					uint32_t ui32Val = 0;
-					uint32_t * pui32Src = reinterpret_cast<uint32_t *>(_ptThread->pui8Input + Y * ui32Stride);
-					uint32_t * pui32Dst = reinterpret_cast<uint32_t *>(_ptThread->pblppThis->m_vFinalBuffer.data() + Y * ui32Stride);
-					for ( uint32_t X = 0; X < ui32W; ++X ) {
-						LSN_BLEED;
-						pui32Dst[X] = CUtilities::AddArgb( pui32Src[X], ui32Val );
-						ui32Val = CUtilities::AddArgb( CUtilities::ShiftArgbRight_Int<1>( pui32Src[X] ), ui32Val );
-						//pui32Dst[X] = CUtilities::AddArgb( pui32Src[X], ui32Val );
-					}
-				}
+	void CBleedPostProcess::BleedBand( void * _pvParm, size_t _sBand ) {
+		const LSN_JOB_PARMS * pjpParms = static_cast<const LSN_JOB_PARMS *>(_pvParm);
+		size_t sStart, sEnd;
+		CJobPool::BandRange( _sBand, pjpParms->sBands, pjpParms->ui32ScreenHeight, sStart, sEnd );
+		uint32_t ui32W = pjpParms->ui32ScreenWidth;
+		uint32_t ui32Stride = pjpParms->ui32Stride;
+		for ( size_t Y = sStart; Y < sEnd; ++Y ) {
+			uint32_t ui32Val = 0;
+			uint32_t * pui32Src = reinterpret_cast<uint32_t *>(pjpParms->pui8Input + Y * ui32Stride);
+			uint32_t * pui32Dst = reinterpret_cast<uint32_t *>(pjpParms->pblppThis->m_vFinalBuffer.data() + Y * ui32Stride);
+			for ( uint32_t X = 0; X < ui32W; ++X ) {
+				LSN_BLEED;
+				pui32Dst[X] = CUtilities::AddArgb( pui32Src[X], ui32Val );
+				ui32Val = CUtilities::AddArgb( CUtilities::ShiftArgbRight_Int<1>( pui32Src[X] ), ui32Val );
+				//pui32Dst[X] = CUtilities::AddArgb( pui32Src[X], ui32Val );
 			}
-			_ptThread->pblppThis->m_eResizeDone.Signal();
 		}
 	}
 
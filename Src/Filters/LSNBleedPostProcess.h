@@ -10,16 +10,9 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
-#include "../Event/LSNEvent.h"
 #include "LSNPostProcessBase.h"
-#include <thread>
 #include <vector>
 
-//#define LSN_SRGB_POST_PERF
-#ifdef LSN_SRGB_POST_PERF
-#include "../Utilities/LSNPerformance.h"
-#endif	// #ifdef LSN_SRGB_POST_PERF
-
 
 namespace lsn {
 
@@ -58,45 +51,29 @@ namespace lsn {
 
 	protected :
 		// == Types.
-		/** Thread parameters */
-		struct LSN_THREAD {
+		/** Parameters shared by the band jobs of a frame. */
+		struct LSN_JOB_PARMS {
 			CBleedPostProcess *								pblppThis;
 			uint8_t *										pui8Input;
 			uint32_t										ui32ScreenWidth;
 			uint32_t										ui32ScreenHeight;
 			uint32_t										ui32Stride;
+			size_t											sBands;
 		};
 
 		// == Members.
-		/** The resizing thread. */
-		std::unique_ptr<std::thread>						m_ptResizeThread;
-		/** The signal for the phospher-decay thread to go. */
-		CEvent												m_eResizeGo;
-		/** The signal that the phospher-decay thread has finished. */
-		CEvent												m_eResizeDone;
-		/** Boolean to stop all threads. */
-		std::atomic<bool>									m_bRunThreads;
-		/** Thread data. */
-		LSN_THREAD											m_tThreadData;
-
-#ifdef LSN_SRGB_POST_PERF
-		/** The performance monitor. */
-		CPerformance										m_pMonitor;
-#endif	// #ifdef LSN_SRGB_POST_PERF
+		/** Job parameters. */
+		LSN_JOB_PARMS										m_jpJobParms;
 
 
 		// == Functions.
 		/**
-		 * Stops the threads.
-		 */
-		void												StopThreads();
-
-		/**
-		 * The work thread.
+		 * Applies the bleed to a band of rows.
 		 *
-		 * \param _pblppFilter Pointer to this object.
+		 * \param _pvParm Pointer to the LSN_JOB_PARMS structure.
+		 * \param _sBand The index of the band of rows to process.
 		 */
-		static void											Thread( LSN_THREAD * _ptThread );
+		static void											BleedBand( void * _pvParm, size_t _sBand );
 	};
 
 }	// namespace lsn
@@ -7,6 +7,8 @@
  */
 
 #include "LSNNtscBisqwitFilter.h"
+#include "../Utilities/LSNJobPool.h"
+#include "../Utilities/LSNProfiler.h"
 #include "../Utilities/LSNUtilities.h"
 #include <algorithm>
 #include <cmath>
@@ -15,9 +17,6 @@
 namespace lsn {
 
 	CNtscBisqwitFilter::CNtscBisqwitFilter() :
-#ifdef LSN_BISQWIT_PERF
-		m_pMonitor( "CNtscBisqwitFilter" ),
-#endif	// #ifdef LSN_BISQWIT_PERF
 		m_ui32FinalStride( 0 ),
 		m_ui32FinalWidth( 0 ),
 		m_ui32FinalHeight( 0 ),
@@ -27,8 +26,7 @@ namespace lsn {
 		m_fBrightness( -0.106f ),
 		m_fContrast( 0.0f ),
 		m_fSaturation( -0.125f ),
-		m_fHue( 18.0f / 180.0f ),
-		m_bRunThreads( true ) {
+		m_fHue( 18.0f / 180.0f ) {
 
 		// from https ://forums.nesdev.org/viewtopic.php?p=159266#p159266
 		const double signalLumaLow[2][4] = {
@@ -65,11 +63,9 @@ namespace lsn {
 			}
 		}
 
-		m_tThreadData.pblppThis = this;
-		m_ptThread = std::make_unique<std::thread>( Thread, &m_tThreadData );
+		m_jpJobParms.pnbfThis = this;
 	}
 	CNtscBisqwitFilter::~CNtscBisqwitFilter() {
-		StopThread();
 	}
 
 	/**
@@ -145,25 +141,16 @@ namespace lsn {
 	 * \return Returns a pointer to the filtered output buffer.
 	 */
 	uint8_t * CNtscBisqwitFilter::ApplyFilter( uint8_t * _pui8Input, uint32_t &_ui32Width, uint32_t &_ui32Height, uint16_t &/*_ui16BitDepth*/, uint32_t &_ui32Stride, uint64_t /*_ui64PpuFrame*/, uint64_t _ui64RenderStartCycle ) {
-#ifdef LSN_BISQWIT_PERF
-		m_pMonitor.Begin();
-#endif	// #ifdef LSN_BISQWIT_PERF
-
-
-		m_tThreadData.ui32Stride = _ui32Stride;
-		m_tThreadData.ui32ScreenWidth = _ui32Width;
-		m_tThreadData.ui32ScreenHeight = _ui32Height;
-		m_tThreadData.ui64RenderCycle = _ui64RenderStartCycle + 341 * (_ui32Height >> 1);
-		m_tThreadData.pui8Input = _pui8Input;
-		if ( m_ptThread.get() ) {
-			m_eGo.Signal();
-		}
+		LSN_PROFILE_SCOPE( "NTSC Bisqwit" );
 
-		DoFrame( _ui64RenderStartCycle, _pui8Input, 0, _ui32Height >> 1, _ui32Width );
 
-		if ( m_ptThread.get() ) {
-			m_eDone.WaitForSignal();
-		}
+		m_jpJobParms.ui32ScreenWidth = _ui32Width;
+		m_jpJobParms.ui32ScreenHeight = _ui32Height;
+		m_jpJobParms.ui64RenderCycle = _ui64RenderStartCycle;
+		m_jpJobParms.pui8Input = _pui8Input;
+		CJobPool & jpPool = CJobPool::Get();
+		m_jpJobParms.sBands = jpPool.Bands( (_ui32Height + (m_ui32BandAlign - 1)) / m_ui32BandAlign );
+		jpPool.ParallelFor( FrameBand, &m_jpJobParms, m_jpJobParms.sBands );
 
 		//DoFrame( _ui64RenderStartCycle + 341 * (_ui32Height >> 1), _pui8Input, _ui32Height >> 1, _ui32Height, _ui32Width );
 
@@ -187,9 +174,6 @@ namespace lsn {
 		_ui32Height = m_ui32FinalHeight;
 		_ui32Stride = m_ui32FinalStride;
 
-#ifdef LSN_BISQWIT_PERF
-		m_pMonitor.Stop();
-#endif	// #ifdef LSN_BISQWIT_PERF
 		return m_vFilteredOutput.data();
 	}
 
@@ -356,32 +340,18 @@ namespace lsn {
 	}
 
 	/**
-	 * Stops the thread.
-	 */
-	void CNtscBisqwitFilter::StopThread() {
-		m_bRunThreads = false;
-		if ( m_ptThread.get() ) {
-			m_eGo.Signal();
-			m_eDone.WaitForSignal();
-			m_ptThread->join();
-			m_ptThread.reset();
-		}
-		m_bRunThreads = true;
-	}
-
-	/**
-	 * The thread.
+	 * Filters a band of scanlines.
 	 *
-	 * \param _pblppFilter Pointer to this object.
+	 * \param _pvParm Pointer to the LSN_JOB_PARMS structure.
+	 * \param _sBand The index of the band of scanlines to filter.
 	 */
-	void CNtscBisqwitFilter::Thread( LSN_THREAD * _ptThread ) {
-		while ( _ptThread->pblppThis->m_bRunThreads ) {
-			_ptThread->pblppThis->m_eGo.WaitForSignal();
-			if ( _ptThread->pblppThis->m_bRunThreads ) {
-				_ptThread->pblppThis->DoFrame( _ptThread->ui64RenderCycle + 341 * (_ptThread->ui32ScreenHeight >> 1), _ptThread->pui8Input, _ptThread->ui32ScreenHeight >> 1, _ptThread->ui32ScreenHeight, _ptThread->ui32ScreenWidth );
-			}
-			_ptThread->pblppThis->m_eDone.Signal();
-		}
+	void CNtscBisqwitFilter::FrameBand( void * _pvParm, size_t _sBand ) {
+		const LSN_JOB_PARMS * pjpParms = static_cast<const LSN_JOB_PARMS *>(_pvParm);
+		size_t sStart, sEnd;
+		CJobPool::BandRange( _sBand, pjpParms->sBands, (pjpParms->ui32ScreenHeight + (m_ui32BandAlign - 1)) / m_ui32BandAlign, sStart, sEnd );
+		uint32_t ui32From = uint32_t( sStart * m_ui32BandAlign );
+		uint32_t ui32To = std::min( uint32_t( sEnd * m_ui32BandAlign ), pjpParms->ui32ScreenHeight );
+		pjpParms->pnbfThis->DoFrame( pjpParms->ui64RenderCycle + 341 * ui32From, pjpParms->pui8Input, ui32From, ui32To, pjpParms->ui32ScreenWidth );
 	}
 
 }	// namespace lsn
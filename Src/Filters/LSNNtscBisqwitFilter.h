@@ -9,17 +9,10 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
-#include "../Event/LSNEvent.h"
 #include "LSNFilterBase.h"
-#include <thread>
 #include <vector>
 
 
-//#define LSN_BISQWIT_PERF
-#ifdef LSN_BISQWIT_PERF
-#include "../Utilities/LSNPerformance.h"
-#endif	// #ifdef LSN_BISQWIT_PERF
-
 namespace lsn {
 
 	/**
@@ -91,35 +84,27 @@ namespace lsn {
 
 	protected :
 		// == Types.
-		/** Thread parameters */
-		struct LSN_THREAD {
+		/** Parameters shared by the band jobs of a frame. */
+		struct LSN_JOB_PARMS {
 			uint64_t										ui64RenderCycle;
-			CNtscBisqwitFilter *							pblppThis;
+			CNtscBisqwitFilter *							pnbfThis;
 			uint8_t *										pui8Input;
 			uint32_t										ui32ScreenWidth;
 			uint32_t										ui32ScreenHeight;
-			uint32_t										ui32Stride;
+			size_t											sBands;
 		};
 
 		// == Members.
-		/** Thread data. */
-		LSN_THREAD											m_tThreadData;
+		/** Job parameters. */
+		LSN_JOB_PARMS										m_jpJobParms;
 		/** The filtered output buffer. */
 		std::vector<uint8_t>								m_vFilteredOutput;
-		/** The thread. */
-		std::unique_ptr<std::thread>						m_ptThread;
-		/** The signal for the thread to go. */
-		CEvent												m_eGo;
-		/** The signal that the thread has finished. */
-		CEvent												m_eDone;
 		/** The final stride. */
 		uint32_t											m_ui32FinalStride;
 		/** The final width. */
 		uint32_t											m_ui32FinalWidth;
 		/** The final height. */
 		uint32_t											m_ui32FinalHeight;
-		/** Boolean to stop all threads. */
-		std::atomic<bool>									m_bRunThreads;
 		/** Brightness. */
 		float												m_fBrightness;
 		/** Contrast. */
@@ -133,6 +118,8 @@ namespace lsn {
 		const uint16_t										m_ui16BitMaskTable[12] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x100, 0x200, 0x400, 0x800 };
 		/** Signals-per-pixel. */
 		static constexpr int32_t							m_i32SignalsPerPixel = 8;
+		/** Bands of scanlines start on multiples of this so that each band starts on the same color phase as a single pass over the frame. */
+		static constexpr uint32_t							m_ui32BandAlign = 12;
 		/** Signal width. */
 		static constexpr int32_t							m_i32SignalWidth = 258;
 
@@ -162,11 +149,6 @@ namespace lsn {
 		 *	moire[x+y*18] = Y + U*sin(alpha) + V*cos(alpha); // modulated composite signal */
 
 
-#ifdef LSN_BISQWIT_PERF
-		/** The performance monitor. */
-		CPerformance										m_pMonitor;
-#endif	// #ifdef LSN_BISQWIT_PERF
-
 
 
 		// == Functions.
@@ -215,16 +197,12 @@ namespace lsn {
 		void												DoFrame( uint64_t _ui64RenderCycle, uint8_t * _pui8Input, uint32_t _ui32From, uint32_t _ui32To, uint32_t _ui32Width );
 
 		/**
-		 * Stops the thread.
-		 */
-		void												StopThread();
-
-		/**
-		 * The thread.
+		 * Filters a band of scanlines.
 		 *
-		 * \param _pblppFilter Pointer to this object.
+		 * \param _pvParm Pointer to the LSN_JOB_PARMS structure.
+		 * \param _sBand The index of the band of scanlines to filter.
 		 */
-		static void											Thread( LSN_THREAD * _ptThread );
+		static void											FrameBand( void * _pvParm, size_t _sBand );
 	};
 
 }	// namespace lsn
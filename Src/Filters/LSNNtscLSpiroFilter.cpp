@@ -7,6 +7,7 @@
  */
 
 #include "LSNNtscLSpiroFilter.h"
+#include "../Utilities/LSNProfiler.h"
 
 #include <algorithm>
 #include <cmath>
@@ -39,7 +40,6 @@ namespace lsn {
 		SetHeight( 240 );							// Allocate buffers.		
 	}
 	CNtscLSpiroFilter::~CNtscLSpiroFilter() {
-		StopThread();
 	}
 
 	// == Functions.
@@ -66,13 +66,6 @@ namespace lsn {
 		}
 		m_ui32FinalStride = RowStride( m_ui32OutputWidth, OutputBits() );
 
-
-		StopThread();
-		m_tdThreadData.ui16LinesDone = 0;
-		m_tdThreadData.ui16EndLine = 0;
-		m_tdThreadData.bEndThread = false;
-		m_tdThreadData.pnlsfThis = this;
-		m_ptThread = std::make_unique<std::thread>( WorkThread, &m_tdThreadData );
 		return InputFormat();
 	}
 
@@ -90,6 +83,7 @@ namespace lsn {
 	 * \return Returns a pointer to the filtered output buffer.
 	 */
 	uint8_t * CNtscLSpiroFilter::ApplyFilter( uint8_t * _pui8Input, uint32_t &_ui32Width, uint32_t &_ui32Height, uint16_t &_ui16BitDepth, uint32_t &_ui32Stride, uint64_t /*_ui64PpuFrame*/, uint64_t _ui64RenderStartCycle ) {
+		LSN_PROFILE_SCOPE( "NTSC L. Spiro" );
 		FilterFrame( _pui8Input, _ui64RenderStartCycle + 2 );
 
 		_ui16BitDepth = uint16_t( OutputBits() );
@@ -156,6 +150,17 @@ namespace lsn {
 		return true;
 	}
 
+	/**
+	 * Sets the number of workers among which the scanlines of each frame are divided.  Each worker has its own signal buffer.
+	 * 
+	 * \param _sWorkers The number of workers, or 0 to use enough workers to keep every thread in the job pool busy.
+	 * \return Returns true if the memory for the internal buffer(s) was allocated.
+	 **/
+	bool CNtscLSpiroFilter::SetWorkers( size_t _sWorkers ) {
+		m_sWorkers = _sWorkers;
+		return AllocYiqBuffers( m_ui16Width, m_ui16Height, m_ui16WidthScale );
+	}
+
 	/**
 	 * Sets the CRT gamma.
 	 * 
@@ -249,10 +254,10 @@ namespace lsn {
 	 * \param _pfDstQ The destination for where to begin storing the YIQ Q values.  Must be aligned to a 16-byte boundary.
 	 * \param _pui16Pixels The start of the 9-bit PPU output for this scanline.
 	 * \param _ui16Cycle The cycle count at the start of the scanline.
-	 * \param _sRowIdx The scanline index.
+	 * \param _pfSignals The signal buffer of the worker creating the scanline.
 	 **/
-	void CNtscLSpiroFilter::ScanlineToYiq( float * _pfDstY, float * _pfDstI, float * _pfDstQ, const uint16_t * _pui16Pixels, uint16_t _ui16Cycle, size_t _sRowIdx ) {
-		float * pfSignalStart = m_vSignalStart[_sRowIdx];
+	void CNtscLSpiroFilter::ScanlineToYiq( float * _pfDstY, float * _pfDstI, float * _pfDstQ, const uint16_t * _pui16Pixels, uint16_t _ui16Cycle, float * _pfSignals ) {
+		float * pfSignalStart = _pfSignals;
 		float * pfSignals = pfSignalStart;
 		for ( uint16_t I = 0; I < LSN_PM_NTSC_RENDER_WIDTH; ++I ) {
 			PixelToNtscSignals( pfSignals, (*_pui16Pixels++), uint16_t( _ui16Cycle + I * 8 ) );
@@ -367,14 +372,12 @@ namespace lsn {
 	 **/
 	void CNtscLSpiroFilter::FilterFrame( const uint8_t * _pui8Pixels, uint64_t _ui64RenderStartCycle ) {
 		
-		m_tdThreadData.ui16LinesDone = m_ui16Height / 2;
-		m_tdThreadData.ui16EndLine = m_ui16Height;
-		m_tdThreadData.ui64RenderStartCycle = _ui64RenderStartCycle;
-		m_tdThreadData.pui8Pixels = _pui8Pixels;
-		m_eGo.Signal();
-		RenderScanlineRange( _pui8Pixels, 0, m_ui16Height / 2, _ui64RenderStartCycle );
-
-		//m_eDone.WaitForSignal();
+		m_jpJobParms.pnlsfThis = this;
+		m_jpJobParms.ui64RenderStartCycle = _ui64RenderStartCycle;
+		m_jpJobParms.pui8Pixels = _pui8Pixels;
+		// One band per worker.  Each band uses its worker's signal buffer.
+		m_jpJobParms.sBands = std::min( Workers( m_ui16Height ), m_vSignalStart.size() );
+		CJobPool::Get().ParallelFor( RenderBand, &m_jpJobParms, m_jpJobParms.sBands );
 	}
 
 	/**
@@ -384,8 +387,9 @@ namespace lsn {
 	 * \param _ui16Start Index of the first scanline to render.
 	 * \param _ui16End INdex of the end scanline.
 	 * \param _ui64RenderStartCycle The PPU cycle at the start of the frame being rendered.
+	 * \param _sWorker The worker rendering the scanlines.
 	 **/
-	void CNtscLSpiroFilter::RenderScanlineRange( const uint8_t * _pui8Pixels, uint16_t _ui16Start, uint16_t _ui16End, uint64_t _ui64RenderStartCycle ) {
+	void CNtscLSpiroFilter::RenderScanlineRange( const uint8_t * _pui8Pixels, uint16_t _ui16Start, uint16_t _ui16End, uint64_t _ui64RenderStartCycle, size_t _sWorker ) {
 		float * pfY = reinterpret_cast<float *>(m_vY.data());
 		float * pfI = reinterpret_cast<float *>(m_vI.data());
 		float * pfQ = reinterpret_cast<float *>(m_vQ.data());
@@ -395,7 +399,7 @@ namespace lsn {
 		pfQ += sYiqStride * _ui16Start;
 		for ( uint16_t H = _ui16Start; H < _ui16End; ++H ) {
 			const uint16_t * pui6PixelRow = reinterpret_cast<const uint16_t *>(_pui8Pixels + (LSN_PM_NTSC_RENDER_WIDTH * 2) * H);
-			ScanlineToYiq( pfY, pfI, pfQ, pui6PixelRow, uint16_t( ((_ui64RenderStartCycle + LSN_PM_NTSC_DOTS_X * H) * 8) % 12 ), H );
+			ScanlineToYiq( pfY, pfI, pfQ, pui6PixelRow, uint16_t( ((_ui64RenderStartCycle + LSN_PM_NTSC_DOTS_X * H) * 8) % 12 ), m_vSignalStart[_sWorker] );
 			ConvertYiqToBgra( H );
 			pfY += sYiqStride;
 			pfI += sYiqStride;
@@ -527,12 +531,13 @@ namespace lsn {
 			// Buffer size:
 			// [m_ui32FilterKernelSize/2][m_ui16Width*8][m_ui32FilterKernelSize/2][Padding for Alignment to 64 Bytes]
 			size_t sRowSize = LSN_PM_NTSC_RENDER_WIDTH * 8 + m_ui32FilterKernelSize + 16;
-			m_vSignalBuffer.resize( sRowSize * _ui16H );
-			m_vSignalStart.resize( _ui16H );
-			for ( uint16_t H = 0; H < _ui16H; ++H ) {
-				uintptr_t uiptrStart = reinterpret_cast<uintptr_t>(m_vSignalBuffer.data() + (sRowSize * H) + ((m_ui32FilterKernelSize >> 1) + (m_ui32FilterKernelSize & 1)) );
+			size_t sWorkers = Workers( _ui16H );
+			m_vSignalBuffer.resize( sRowSize * sWorkers );
+			m_vSignalStart.resize( sWorkers );
+			for ( size_t I = 0; I < sWorkers; ++I ) {
+				uintptr_t uiptrStart = reinterpret_cast<uintptr_t>(m_vSignalBuffer.data() + (sRowSize * I) + ((m_ui32FilterKernelSize >> 1) + (m_ui32FilterKernelSize & 1)) );
 				uiptrStart = (uiptrStart + 63) / 64 * 64;
-				m_vSignalStart[H] = reinterpret_cast<float *>(uiptrStart);
+				m_vSignalStart[I] = reinterpret_cast<float *>(uiptrStart);
 			}
 
 
@@ -549,6 +554,17 @@ namespace lsn {
 		catch ( ... ) { return false; }
 	}
 
+	/**
+	 * Gets the number of workers among which to divide the scanlines of a frame.
+	 * 
+	 * \param _ui16H The height of the frame.
+	 * \return Returns the number of workers, from 1 to _ui16H (or 1 if _ui16H is 0).
+	 **/
+	size_t CNtscLSpiroFilter::Workers( uint16_t _ui16H ) const {
+		size_t sWorkers = m_sWorkers ? m_sWorkers : CJobPool::Get().Bands( _ui16H );
+		return std::max<size_t>( 1, std::min<size_t>( sWorkers, _ui16H ) );
+	}
+
 	/**
 	 * Converts a single scanline of YIQ values in m_vY/m_vI/m_vQ to BGRA values in the same scanline of m_vRgbBuffer.
 	 * 
@@ -1039,35 +1055,16 @@ namespace lsn {
 	}
 
 	/**
-	 * Stops the worker thread.
-	 **/
-	void CNtscLSpiroFilter::StopThread() {
-		m_tdThreadData.bEndThread = true;
-		if ( m_ptThread.get() ) {
-			m_eGo.Signal();
-			m_eDone.WaitForSignal();
-			m_ptThread->join();
-			m_ptThread.reset();
-		}
-		m_tdThreadData.bEndThread = false;
-	}
-
-	/**
-	 * The worker thread.
+	 * Renders a band of scanlines.
 	 * 
-	 * \param _ptdData Parameters passed to the thread.
+	 * \param _pvParm Pointer to the LSN_JOB_PARMS structure.
+	 * \param _sBand The index of the band of scanlines to render.
 	 **/
-	void CNtscLSpiroFilter::WorkThread( LSN_THREAD_DATA * _ptdData ) {
-		::SetThreadHighPriority();
-		while ( !_ptdData->bEndThread ) {
-			_ptdData->pnlsfThis->m_eDone.Signal();
-			_ptdData->pnlsfThis->m_eGo.WaitForSignal();
-			if ( _ptdData->bEndThread ) { break; }
-
-			_ptdData->pnlsfThis->RenderScanlineRange( _ptdData->pui8Pixels, _ptdData->ui16LinesDone, _ptdData->ui16EndLine, _ptdData->ui64RenderStartCycle );
-		}
-
-		_ptdData->pnlsfThis->m_eDone.Signal();
+	void CNtscLSpiroFilter::RenderBand( void * _pvParm, size_t _sBand ) {
+		const LSN_JOB_PARMS * pjpParms = static_cast<const LSN_JOB_PARMS *>(_pvParm);
+		size_t sStart, sEnd;
+		CJobPool::BandRange( _sBand, pjpParms->sBands, pjpParms->pnlsfThis->m_ui16Height, sStart, sEnd );
+		pjpParms->pnlsfThis->RenderScanlineRange( pjpParms->pui8Pixels, uint16_t( sStart ), uint16_t( sEnd ), pjpParms->ui64RenderStartCycle, _sBand );
 	}
 
 }	// namespace lsn
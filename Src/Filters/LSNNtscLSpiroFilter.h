@@ -9,8 +9,8 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
-#include "../Event/LSNEvent.h"
 #include "../Utilities/LSNAlignmentAllocator.h"
+#include "../Utilities/LSNJobPool.h"
 #include "../Utilities/LSNUtilities.h"
 #include "LSNFilterBase.h"
 
@@ -18,8 +18,6 @@
 #include <arm_neon.h>
 #endif
 
-#include <thread>
-
 #pragma warning( push )
 #pragma warning( disable : 4324 )	// warning C4324: 'lsn::CNtscLSpiroFilter': structure was padded due to alignment specifier
 
@@ -134,6 +132,14 @@ namespace lsn {
 		 **/
 		bool												SetHeight( uint16_t _ui16Height );
 
+		/**
+		 * Sets the number of workers among which the scanlines of each frame are divided.  Each worker has its own signal buffer.
+		 * 
+		 * \param _sWorkers The number of workers, or 0 to use enough workers to keep every thread in the job pool busy.
+		 * \return Returns true if the memory for the internal buffer(s) was allocated.
+		 **/
+		bool												SetWorkers( size_t _sWorkers );
+
 		/**
 		 * Sets the CRT gamma.
 		 * 
@@ -243,14 +249,12 @@ namespace lsn {
 		typedef float32x4_t									simd_4;
 #endif	// #ifdef __SSE4_1__
 		
-		/** Thread data. */
-		struct LSN_THREAD_DATA {
+		/** Parameters shared by the band jobs of a frame. */
+		struct LSN_JOB_PARMS {
 			uint64_t										ui64RenderStartCycle;								/**< The render cycle at the start of the frame. */
 			CNtscLSpiroFilter *								pnlsfThis;											/**< Point to this object. */
 			const uint8_t *									pui8Pixels;											/**< The input 9-bit pixel array. */
-			uint16_t										ui16LinesDone;										/**< How many lines the thread has done. */
-			uint16_t										ui16EndLine;										/**< Line on which to end work. */
-			std::atomic<bool>								bEndThread;											/**< If true, the thread is ended. */
+			size_t											sBands;												/**< The number of bands of scanlines. */
 		};
 
 
@@ -283,8 +287,8 @@ namespace lsn {
 		PfFilterFunc										m_pfFilterFunc = CUtilities::BoxFilterFunc;			/**< The filter function for chroma. */
 		PfFilterFunc										m_pfFilterFuncY = CUtilities::BoxFilterFunc;		/**< The filter function for Y. */
 		uint32_t											m_ui32FilterKernelSize = 12;						/**< The kernel size for the gather during YIQ creation. */
-		std::vector<float, CAlignmentAllocator<float>>		m_vSignalBuffer;									/**< The intermediate signal buffer for a single scanline. */
-		std::vector<float *>								m_vSignalStart;										/**< Points into m_vSignalBuffer.data() at the first location that is both >= to (LSN_MAX_FILTER_SIZE/2) floats and aligned to a 64-byte address. */
+		std::vector<float, CAlignmentAllocator<float>>		m_vSignalBuffer;									/**< The intermediate signal buffers, one scanline for each worker. */
+		std::vector<float *>								m_vSignalStart;										/**< For each worker, points into m_vSignalBuffer.data() at the first location that is both >= to (LSN_MAX_FILTER_SIZE/2) floats and aligned to a 64-byte address. */
 		std::vector<simd_4>									m_vY;												/**< The YIQ Y buffer. */
 		std::vector<simd_4>									m_vI;												/**< The YIQ I buffer. */
 		std::vector<simd_4>									m_vQ;												/**< The YIQ Q buffer. */
@@ -292,11 +296,9 @@ namespace lsn {
 		std::vector<uint8_t>								m_vRgbBuffer;										/**< The output created by calling FilterFrame(). */
 		uint16_t											m_ui16ScaledWidth = 0;								/**< Output width. */
 		uint16_t											m_ui16WidthScale = 8;								/**< Scale factor between input and output width. */
+		size_t												m_sWorkers = 0;										/**< The number of workers set by SetWorkers(). */
 
-		CEvent												m_eGo;												/**< Signal to tell the thread to go. */
-		CEvent												m_eDone;											/**< Thread to tell the main thread that the 2nd thread is done. */
-		std::unique_ptr<std::thread>						m_ptThread;											/**< The 2nd thread. */
-		LSN_THREAD_DATA										m_tdThreadData;										/**< Thread data. */
+		LSN_JOB_PARMS										m_jpJobParms;										/**< Job parameters. */
 
 		uint32_t											m_ui32Gamma[300];									/**< The gamma curve. */
 		uint32_t											m_ui32GammaG[300];									/**< The gamma curve for green. */
@@ -343,9 +345,9 @@ namespace lsn {
 		 * \param _pfDstQ The destination for where to begin storing the YIQ Q values.  Must be aligned to a 16-byte boundary.
 		 * \param _pui16Pixels The start of the 9-bit PPU output for this scanline.
 		 * \param _ui16Cycle The cycle count at the start of the scanline.
-		 * \param _sRowIdx The scanline index.
+		 * \param _pfSignals The signal buffer of the worker creating the scanline.
 		 **/
-		void												ScanlineToYiq( float * _pfDstY, float * _pfDstI, float * _pfDstQ, const uint16_t * _pui16Pixels, uint16_t _ui16Cycle, size_t _sRowIdx );
+		void												ScanlineToYiq( float * _pfDstY, float * _pfDstI, float * _pfDstQ, const uint16_t * _pui16Pixels, uint16_t _ui16Cycle, float * _pfSignals );
 
 		/**
 		 * Renders a full frame of PPU 9-bit (stored in uint16_t's) palette indices to a given 32-bit RGBX buffer.
@@ -362,8 +364,9 @@ namespace lsn {
 		 * \param _ui16Start Index of the first scanline to render.
 		 * \param _ui16End INdex of the end scanline.
 		 * \param _ui64RenderStartCycle The PPU cycle at the start of the frame being rendered.
+		 * \param _sWorker The worker rendering the scanlines.
 		 **/
-		void												RenderScanlineRange( const uint8_t * _pui8Pixels, uint16_t _ui16Start, uint16_t _ui16End, uint64_t _ui64RenderStartCycle );
+		void												RenderScanlineRange( const uint8_t * _pui8Pixels, uint16_t _ui16Start, uint16_t _ui16End, uint64_t _ui64RenderStartCycle, size_t _sWorker );
 
 		/**
 		 * Generates the phase sin/cos tables.
@@ -394,6 +397,14 @@ namespace lsn {
 		 **/
 		bool												AllocYiqBuffers( uint16_t _ui16W, uint16_t _ui16H, uint16_t _ui16Scale );
 
+		/**
+		 * Gets the number of workers among which to divide the scanlines of a frame.
+		 * 
+		 * \param _ui16H The height of the frame.
+		 * \return Returns the number of workers, from 1 to _ui16H (or 1 if _ui16H is 0).
+		 **/
+		size_t												Workers( uint16_t _ui16H ) const;
+
 #ifdef __AVX512F__
 		/**
 		 * Performs convolution on 16 values at a time.
@@ -444,16 +455,12 @@ namespace lsn {
 		void												ConvertYiqToBgra( size_t _sScanline );
 
 		/**
-		 * Stops the worker thread.
-		 **/
-		void												StopThread();
-
-		/**
-		 * The worker thread.
+		 * Renders a band of scanlines.
 		 * 
-		 * \param _ptdData Parameters passed to the thread.
+		 * \param _pvParm Pointer to the LSN_JOB_PARMS structure.
+		 * \param _sBand The index of the band of scanlines to render.
 		 **/
-		static void											WorkThread( LSN_THREAD_DATA * _ptdData );
+		static void											RenderBand( void * _pvParm, size_t _sBand );
 	};
 	
 
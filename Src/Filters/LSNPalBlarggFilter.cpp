@@ -7,6 +7,7 @@
  */
 
 #include "LSNPalBlarggFilter.h"
+#include "../Utilities/LSNProfiler.h"
 
 
 namespace lsn {
@@ -71,6 +72,7 @@ namespace lsn {
 	 * \return Returns a pointer to the filtered output buffer.
 	 */
 	uint8_t * CPalBlarggFilter::ApplyFilter( uint8_t * _pui8Input, uint32_t &_ui32Width, uint32_t &_ui32Height, uint16_t &/*_ui16BitDepth*/, uint32_t &_ui32Stride, uint64_t /*_ui64PpuFrame*/, uint64_t _ui64RenderStartCycle ) {
+		LSN_PROFILE_SCOPE( "PAL Blargg" );
 		::nes_ntsc_blit( &m_nnBlarggNtsc,
 			reinterpret_cast<NES_NTSC_IN_T *>(_pui8Input), _ui32Width, _ui64RenderStartCycle & 0b00, 6,
 			_ui32Width, _ui32Height,
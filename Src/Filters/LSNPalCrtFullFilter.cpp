@@ -7,6 +7,8 @@
  */
 
 #include "LSNPalCrtFullFilter.h"
+#include "../Utilities/LSNJobPool.h"
+#include "../Utilities/LSNProfiler.h"
 #include "../Utilities/LSNUtilities.h"
 #include "PAL-CRT-Full/pal_core.h"
 
@@ -19,23 +21,12 @@ namespace lsn {
 		m_ui32FinalStride( 0 ),
 		m_ui32FinalWidth( PAL_HRES ),
 		m_ui32FinalHeight( 0 ),
-		m_bRunThreads( true ) {
+		m_sPhospherBands( 0 ) {
 
 		m_vSettings.resize( sizeof( PAL_SETTINGS ) );
 		m_vCrtNtsc.resize( sizeof( PAL_CRT ) );
-
-#ifdef LSN_CRT_PERF
-		m_ui32Calls = 0;
-		m_ui64AccumTime = 0;
-#endif	// #ifdef LSN_CRT_PERF
 	}
 	CPalCrtFullFilter::~CPalCrtFullFilter() {
-		StopPhospherDecayThread();
-#ifdef LSN_CRT_PERF
-		char szBuffer[128];
-		std::sprintf( szBuffer, "CRT Time: %.17f\r\n", m_ui64AccumTime / double( m_ui32Calls ) / m_cPerfClock.GetResolution() * 1000.0 );
-		::OutputDebugStringA( szBuffer );
-#endif	// #ifdef LSN_CRT_PERF
 	}
 
 
@@ -117,11 +108,6 @@ namespace lsn {
 				blend	1	int
 		*/
 
-		StopPhospherDecayThread();
-#if defined( LSN_WINDOWS )
-		m_ptPhospherThread = std::make_unique<std::thread>( PhospherDecayThread, this );
-#endif	// #if defined( LSN_WINDOWS )
-
 		return InputFormat();
 	}
 
@@ -139,14 +125,12 @@ namespace lsn {
 	 * \return Returns a pointer to the filtered output buffer.
 	 */
 	uint8_t * CPalCrtFullFilter::ApplyFilter( uint8_t * _pui8Input, uint32_t &_ui32Width, uint32_t &_ui32Height, uint16_t &/*_ui16BitDepth*/, uint32_t &_ui32Stride, uint64_t /*_ui64PpuFrame*/, uint64_t /*_ui64RenderStartCycle*/ ) {
-#ifdef LSN_CRT_PERF
-		uint64_t ui64TimeNow = m_cPerfClock.GetRealTick();
-#endif	// #ifdef LSN_CRT_PERF
+		LSN_PROFILE_SCOPE( "PAL CRT Full" );
+		CJobPool & jpPool = CJobPool::Get();
 		// Fade the phosphers.
 		if ( m_nnCrtPal.blend ) {
-			if LSN_LIKELY( m_ptPhospherThread.get() ) {
-				m_ePhospherGo.Signal();
-			}
+			m_sPhospherBands = jpPool.Bands( m_ui32FinalHeight );
+			jpPool.Submit( m_jgPhospher, PhospherDecayBand, this, m_sPhospherBands );
 		}
 
 		m_nsSettings.data = reinterpret_cast<unsigned short *>(_pui8Input);
@@ -157,9 +141,7 @@ namespace lsn {
 		::pal_modulate( &m_nnCrtPal, &m_nsSettings );
 
 		if ( m_nnCrtPal.blend ) {
-			if LSN_LIKELY( m_ptPhospherThread.get() ) {
-				m_ePhospherDone.WaitForSignal();
-			}
+			jpPool.Wait( m_jgPhospher );
 		}
 
 		::pal_demodulate( &m_nnCrtPal, 3 );
@@ -167,10 +149,6 @@ namespace lsn {
 		_ui32Height = m_ui32FinalHeight;
 		_ui32Stride = m_ui32FinalStride;
 
-#ifdef LSN_CRT_PERF
-		m_ui32Calls++;
-		m_ui64AccumTime += m_cPerfClock.GetRealTick() - ui64TimeNow;
-#endif	// #ifdef LSN_CRT_PERF
 		return m_vFilteredOutput.data();
 	}
 
@@ -182,54 +160,38 @@ namespace lsn {
 	}
 
 	/**
-	 * Stops the phospher-decay thread.
-	 */
-	void CPalCrtFullFilter::StopPhospherDecayThread() {
-		m_bRunThreads = false;
-		if ( m_ptPhospherThread.get() ) {
-			m_ePhospherGo.Signal();
-			m_ePhospherDone.WaitForSignal();
-			m_ptPhospherThread->join();
-			m_ptPhospherThread.reset();
-		}
-		m_bRunThreads = true;
-	}
-
-	/**
-	 * The phospher-decay thread.
+	 * Fades the phosphers in a band of rows of the previous frame.
 	 *
-	 * \param _pncfFilter Pointer to this object.
+	 * \param _pvParm Pointer to this object.
+	 * \param _sBand The index of the band of rows to fade.
 	 */
-	void CPalCrtFullFilter::PhospherDecayThread( CPalCrtFullFilter * _pncfFilter ) {
-		while ( _pncfFilter->m_bRunThreads ) {
-			_pncfFilter->m_ePhospherGo.WaitForSignal();
-			if ( _pncfFilter->m_bRunThreads ) {
-				// Apply smear.
+	void CPalCrtFullFilter::PhospherDecayBand( void * _pvParm, size_t _sBand ) {
+		CPalCrtFullFilter * pncfFilter = static_cast<CPalCrtFullFilter *>(_pvParm);
+		size_t sStart, sEnd;
+		CJobPool::BandRange( _sBand, pncfFilter->m_sPhospherBands, pncfFilter->m_ui32FinalHeight, sStart, sEnd );
+		// Apply smear.
 #if 0
-				for ( auto Y = _pncfFilter->m_ui32FinalHeight; Y--; ) {
-					uint32_t ui32Val = 0;
-					uint32_t * pui32Src = reinterpret_cast<uint32_t *>(_pncfFilter->m_vFilteredOutput.data() + Y * _pncfFilter->m_ui32FinalStride);
-					for ( uint32_t X = 0; X < _pncfFilter->m_ui32FinalWidth; ++X ) {
-						ui32Val = /*((ui32Val >> 1) & 0x7F7F7F7F) +*/
-							((ui32Val >> 2) & 0x3F3F3F3F) +
-							((ui32Val >> 3) & 0x1F1F1F1F) +
-							((ui32Val >> 6) & 0x03030303) +
-							((ui32Val >> 7) & 0x01010101) +
-
-							((ui32Val >> 4) & 0x0F0F0F0F) +
-							((ui32Val >> 5) & 0x07070707) +
-							((ui32Val >> 6) & 0x03030303) +
-							((ui32Val >> 7) & 0x01010101);
-						ui32Val = pui32Src[X] = CUtilities::AddArgb( pui32Src[X], ui32Val );
-					}
-				}
+		for ( size_t Y = sStart; Y < sEnd; ++Y ) {
+			uint32_t ui32Val = 0;
+			uint32_t * pui32Src = reinterpret_cast<uint32_t *>(pncfFilter->m_vFilteredOutput.data() + Y * pncfFilter->m_ui32FinalStride);
+			for ( uint32_t X = 0; X < pncfFilter->m_ui32FinalWidth; ++X ) {
+				ui32Val = /*((ui32Val >> 1) & 0x7F7F7F7F) +*/
+					((ui32Val >> 2) & 0x3F3F3F3F) +
+					((ui32Val >> 3) & 0x1F1F1F1F) +
+					((ui32Val >> 6) & 0x03030303) +
+					((ui32Val >> 7) & 0x01010101) +
+
+					((ui32Val >> 4) & 0x0F0F0F0F) +
+					((ui32Val >> 5) & 0x07070707) +
+					((ui32Val >> 6) & 0x03030303) +
+					((ui32Val >> 7) & 0x01010101);
+				ui32Val = pui32Src[X] = CUtilities::AddArgb( pui32Src[X], ui32Val );
+			}
+		}
 #endif
 #if 0
-				CUtilities::DecayArgb( reinterpret_cast<uint32_t *>(_pncfFilter->m_vFilteredOutput.data()), _pncfFilter->m_ui32FinalWidth, _pncfFilter->m_ui32FinalHeight );
+		CUtilities::DecayArgb( reinterpret_cast<uint32_t *>(pncfFilter->m_vFilteredOutput.data() + sStart * pncfFilter->m_ui32FinalStride), pncfFilter->m_ui32FinalWidth, uint32_t( sEnd - sStart ) );
 #endif
-			}
-			_pncfFilter->m_ePhospherDone.Signal();
-		}
 	}
 
 }	// namespace lsn
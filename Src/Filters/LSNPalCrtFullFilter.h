@@ -9,16 +9,10 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
-#include "../Event/LSNEvent.h"
+#include "../Utilities/LSNJobPool.h"
 #include "LSNFilterBase.h"
-#include <thread>
 #include <vector>
 
-//#define LSN_CRT_PERF
-#ifdef LSN_CRT_PERF
-#include "../Time/LSNClock.h"
-#endif	// #ifdef LSN_CRT_PERF
-
 /*line 117
 crt_nes
 then line 125 
@@ -112,12 +106,8 @@ namespace lsn {
 		std::vector<uint8_t>								m_vCrtNtsc;
 		/** The filtered output buffer. */
 		std::vector<uint8_t>								m_vFilteredOutput;
-		/** The phospher-decay thread. */
-		std::unique_ptr<std::thread>						m_ptPhospherThread;
-		/** The signal for the phospher-decay thread to go. */
-		CEvent												m_ePhospherGo;
-		/** The signal that the phospher-decay thread has finished. */
-		CEvent												m_ePhospherDone;
+		/** The phospher-decay jobs. */
+		CJobPool::LSN_JOB_GROUP								m_jgPhospher;
 		/** The final stride. */
 		uint32_t											m_ui32FinalStride;
 		/** The phase table. */
@@ -126,27 +116,17 @@ namespace lsn {
 		uint32_t											m_ui32FinalWidth;
 		/** The final height. */
 		uint32_t											m_ui32FinalHeight;
-		/** Boolean to stop all threads. */
-		std::atomic<bool>									m_bRunThreads;
-
-#ifdef LSN_CRT_PERF
-		CClock												m_cPerfClock;
-		uint64_t											m_ui64AccumTime;
-		uint32_t											m_ui32Calls;
-#endif	// #ifdef LSN_CRT_PERF
+		/** The number of bands of rows in the phospher-decay jobs. */
+		size_t												m_sPhospherBands;
 
 		// == Functions.
 		/**
-		 * Stops the phospher-decay thread.
-		 */
-		void												StopPhospherDecayThread();
-
-		/**
-		 * The phospher-decay thread.
+		 * Fades the phosphers in a band of rows of the previous frame.
 		 *
-		 * \param _pncfFilter Pointer to this object.
+		 * \param _pvParm Pointer to this object.
+		 * \param _sBand The index of the band of rows to fade.
 		 */
-		static void											PhospherDecayThread( CPalCrtFullFilter * _pncfFilter );
+		static void											PhospherDecayBand( void * _pvParm, size_t _sBand );
 	};
 
 }	// namespace lsn
@@ -7,6 +7,7 @@
  */
 
 #include "LSNRgb24Filter.h"
+#include "../Utilities/LSNProfiler.h"
 #include "../Utilities/LSNUtilities.h"
 
 
@@ -70,6 +71,7 @@ namespace lsn {
 	 * \return Returns a pointer to the filtered output buffer.
 	 */
 	uint8_t * CRgb24Filter::ApplyFilter( uint8_t * _pui8Input, uint32_t &/*_ui32Width*/, uint32_t &/*_ui32Height*/, uint16_t &/*_ui16BitDepth*/, uint32_t &/*_ui32Stride*/, uint64_t /*_ui64PpuFrame*/, uint64_t /*_ui64RenderStartCycle*/ ) {
+		LSN_PROFILE_SCOPE( "RGB24" );
 		// This is a pass-through filter.
 		return _pui8Input;
 	}
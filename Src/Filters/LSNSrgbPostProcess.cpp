@@ -7,6 +7,8 @@
  */
 
 #include "LSNSrgbPostProcess.h"
+#include "../Utilities/LSNJobPool.h"
+#include "../Utilities/LSNProfiler.h"
 #include "../Utilities/LSNUtilities.h"
 #include "LSNFilterBase.h"
 #include <cmath>
@@ -15,10 +17,7 @@
 namespace lsn {
 
 	CSrgbPostProcess::CSrgbPostProcess() :
-#ifdef LSN_SRGB_POST_PERF
-		m_pMonitor( "CSrgbPostProcess" ),
-#endif	// #ifdef LSN_SRGB_POST_PERF
-		m_bRunThreads( true ) {
+		m_jpJobParms( { this } ) {
 
 
 		auto LinearTosRGB = [&]( double _dVal ) {
@@ -30,16 +29,8 @@ namespace lsn {
 			double dFract = LinearTosRGB( double( I ) / (LSN_ELEMENTS( m_ui8Table ) - 1) );
 			m_ui8Table[I] = uint8_t( std::round( dFract * 255.0 ) );
 		}
-
-#if defined( LSN_WINDOWS )
-		m_tThreadData.pblppThis = this;
-		m_tThreadData.pui8Table = m_ui8Table;
-		m_ptResizeThread[0] = std::make_unique<std::thread>( Thread<0>, &m_tThreadData );
-		m_ptResizeThread[1] = std::make_unique<std::thread>( Thread<1>, &m_tThreadData );
-#endif	// #if defined( LSN_WINDOWS )
 	}
 	CSrgbPostProcess::~CSrgbPostProcess() {
-		StopThreads();
 	}
 
 
@@ -62,6 +53,7 @@ namespace lsn {
 		uint32_t /*_ui32ScreenWidth*/, uint32_t /*_ui32ScreenHeight*/, bool &/*_bFlipped*/,
 		uint32_t &_ui32Width, uint32_t &_ui32Height, uint16_t &/*_ui16BitDepth*/, uint32_t &_ui32Stride, uint64_t /*_ui64PpuFrame*/,
 		uint64_t /*_ui64RenderStartCycle*/ ) {
+		LSN_PROFILE_SCOPE( "sRGB Post" );
 		uint32_t ui32Stride = CFilterBase::RowStride( _ui32Width, 32 );
 		
 		uint32_t ui32Size = ui32Stride * _ui32Height;
@@ -70,44 +62,17 @@ namespace lsn {
 			m_vFinalBuffer.resize( ui32Size );
 		}
 
-#ifdef LSN_SRGB_POST_PERF
-		m_pMonitor.Begin();
-#endif	// #ifdef LSN_SRGB_POST_PERF
-
 
 		
 
 #if 1
-		m_tThreadData.ui32ScreenHeight = _ui32Height;
-		m_tThreadData.ui32ScreenWidth = _ui32Width;
-		m_tThreadData.ui32Stride = ui32Stride;
-		m_tThreadData.pui8Input = _pui8Input;
-		for ( size_t I = 0; I < 2; ++I ) {
-			if ( m_ptResizeThread[I].get() ) {
-				m_eResizeGo[I].Signal();
-			}
-		}
-
-		for ( uint32_t Y = 0; Y < _ui32Height; ++Y ) {
-			uint8_t * pui8Src = _pui8Input + Y * ui32Stride;
-			uint8_t * pui8Dst = m_vFinalBuffer.data() + Y * ui32Stride;
-			for ( uint32_t X = 0; X < _ui32Width; ++X ) {
-				pui8Dst[3] = pui8Src[3];
-				/*pui8Dst[0] = m_ui8Table[pui8Src[0]];
-				pui8Dst[1] = m_ui8Table[pui8Src[1]];*/
-				pui8Dst[2] = m_ui8Table[pui8Src[2]];
-
-				pui8Src += 4;
-				pui8Dst += 4;
-			}
-		}
-
-
-		for ( size_t I = 0; I < 2; ++I ) {
-			if ( m_ptResizeThread[I].get() ) {
-				m_eResizeDone[I].WaitForSignal();
-			}
-		}
+		m_jpJobParms.ui32ScreenHeight = _ui32Height;
+		m_jpJobParms.ui32ScreenWidth = _ui32Width;
+		m_jpJobParms.ui32Stride = ui32Stride;
+		m_jpJobParms.pui8Input = _pui8Input;
+		CJobPool & jpPool = CJobPool::Get();
+		m_jpJobParms.sBands = jpPool.Bands( _ui32Height );
+		jpPool.ParallelFor( SrgbBand, &m_jpJobParms, m_jpJobParms.sBands );
 #else
 		for ( uint32_t Y = 0; Y < _ui32Height; ++Y ) {
 			uint8_t * pui8Src = _pui8Input + Y * ui32Stride;
@@ -124,9 +89,6 @@ namespace lsn {
 		}
 #endif
 
-#ifdef LSN_SRGB_POST_PERF
-		m_pMonitor.Stop();
-#endif	// #ifdef LSN_SRGB_POST_PERF
 		/*_ui32Width = _ui32ScreenWidth;
 		_ui32Height = _ui32ScreenHeight;*/
 		_ui32Stride = ui32Stride;
@@ -134,20 +96,29 @@ namespace lsn {
 	}
 
 	/**
-	 * Stops the threads.
+	 * Converts a band of rows to sRGB.
+	 *
+	 * \param _pvParm Pointer to the LSN_JOB_PARMS structure.
+	 * \param _sBand The index of the band of rows to convert.
 	 */
-	void CSrgbPostProcess::StopThreads() {
-		m_bRunThreads = false;
-		for ( size_t I = 0; I < 2; ++I ) {
-			if ( m_ptResizeThread[I].get() ) {
-				m_eResizeGo[I].Signal();
-				m_eResizeDone[I].WaitForSignal();
-				m_ptResizeThread[I]->join();
-				m_ptResizeThread[I].reset();
+	void CSrgbPostProcess::SrgbBand( void * _pvParm, size_t _sBand ) {
+		const LSN_JOB_PARMS * pjpParms = static_cast<const LSN_JOB_PARMS *>(_pvParm);
+		const uint8_t * pui8Table = pjpParms->pspThis->m_ui8Table;
+		size_t sStart, sEnd;
+		CJobPool::BandRange( _sBand, pjpParms->sBands, pjpParms->ui32ScreenHeight, sStart, sEnd );
+		for ( size_t Y = sStart; Y < sEnd; ++Y ) {
+			const uint8_t * pui8Src = pjpParms->pui8Input + Y * pjpParms->ui32Stride;
+			uint8_t * pui8Dst = pjpParms->pspThis->m_vFinalBuffer.data() + Y * pjpParms->ui32Stride;
+			for ( uint32_t X = 0; X < pjpParms->ui32ScreenWidth; ++X ) {
+				pui8Dst[3] = pui8Src[3];
+				pui8Dst[0] = pui8Table[pui8Src[0]];
+				pui8Dst[1] = pui8Table[pui8Src[1]];
+				pui8Dst[2] = pui8Table[pui8Src[2]];
+
+				pui8Src += 4;
+				pui8Dst += 4;
 			}
 		}
-		m_bRunThreads = true;
 	}
 
-
 }	// namespace lsn
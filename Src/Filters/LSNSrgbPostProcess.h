@@ -10,16 +10,9 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
-#include "../Event/LSNEvent.h"
 #include "LSNPostProcessBase.h"
-#include <thread>
 #include <vector>
 
-#define LSN_SRGB_POST_PERF
-#ifdef LSN_SRGB_POST_PERF
-#include "../Utilities/LSNPerformance.h"
-#endif	// #ifdef LSN_SRGB_POST_PERF
-
 
 namespace lsn {
 
@@ -58,72 +51,31 @@ namespace lsn {
 
 	protected :
 		// == Types.
-		/** Thread parameters */
-		struct LSN_THREAD {
-			CSrgbPostProcess *								pblppThis;
-			uint8_t *										pui8Table;
+		/** Parameters shared by the band jobs of a frame. */
+		struct LSN_JOB_PARMS {
+			CSrgbPostProcess *								pspThis;
 			uint8_t *										pui8Input;
 			uint32_t										ui32ScreenWidth;
 			uint32_t										ui32ScreenHeight;
 			uint32_t										ui32Stride;
+			size_t											sBands;
 		};
 
 		// == Members.
-		/** The resizing thread. */
-		std::unique_ptr<std::thread>						m_ptResizeThread[2];
-		/** The signal for the phospher-decay thread to go. */
-		CEvent												m_eResizeGo[2];
-		/** The signal that the phospher-decay thread has finished. */
-		CEvent												m_eResizeDone[2];
-		/** Boolean to stop all threads. */
-		std::atomic<bool>									m_bRunThreads;
-		/** Thread data. */
-		LSN_THREAD											m_tThreadData;
+		/** Job parameters. */
+		LSN_JOB_PARMS										m_jpJobParms;
 		/** The sRGB table. */
 		uint8_t												m_ui8Table[256];
 
-#ifdef LSN_SRGB_POST_PERF
-		/** The performance monitor. */
-		CPerformance										m_pMonitor;
-#endif	// #ifdef LSN_SRGB_POST_PERF
-
 
 		// == Functions.
 		/**
-		 * Stops the threads.
-		 */
-		void												StopThreads();
-
-		/**
-		 * The X component thread.
+		 * Converts a band of rows to sRGB.
 		 *
-		 * \param _pblppFilter Pointer to this object.
+		 * \param _pvParm Pointer to the LSN_JOB_PARMS structure.
+		 * \param _sBand The index of the band of rows to convert.
 		 */
-		template<unsigned _uIdx>
-		static void											Thread( LSN_THREAD * _ptThread ) {
-			while ( _ptThread->pblppThis->m_bRunThreads ) {
-				_ptThread->pblppThis->m_eResizeGo[_uIdx].WaitForSignal();
-				if ( _ptThread->pblppThis->m_bRunThreads ) {
-					uint32_t ui32Stride = _ptThread->ui32Stride;
-					uint32_t ui32Height = _ptThread->ui32ScreenHeight;
-					uint32_t ui32Width = _ptThread->ui32ScreenWidth;
-					uint8_t * pui8Data = _ptThread->pblppThis->m_vFinalBuffer.data();
-					uint8_t * pui8Input = _ptThread->pui8Input;
-					uint8_t * pui8Table = _ptThread->pui8Table;
-					for ( uint32_t Y = 0; Y < ui32Height; ++Y ) {
-						uint8_t * pui8Src = pui8Input + Y * ui32Stride;
-						uint8_t * pui8Dst = pui8Data + Y * ui32Stride;
-						for ( uint32_t X = 0; X < ui32Width; ++X ) {
-							pui8Dst[_uIdx] = pui8Table[pui8Src[_uIdx]];
-
-							pui8Src += 4;
-							pui8Dst += 4;
-						}
-					}
-				}
-				_ptThread->pblppThis->m_eResizeDone[_uIdx].Signal();
-			}
-		}
+		static void											SrgbBand( void * _pvParm, size_t _sBand );
 	};
 
 }	// namespace lsn
@@ -9,6 +9,7 @@
  */
 /*****************************************************************************/
 #include "crt_core.h"
+#include "../../Utilities/LSNJobPool.h"
 #include "../../Utilities/LSNUtilities.h"
 
 #include <immintrin.h>
@@ -279,197 +280,67 @@ crt_init_full(struct CRT *v, int w, int h, int f, unsigned char *out)
 #define HSYNC_WINDOW 6
 #define VSYNC_WINDOW 6
 
-extern void
-crt_demodulate_full(struct CRT *v, int noise)
+/* the results of the serial part of demodulating one scan line */
+struct CRT_LINE {
+	int beg, end; /* output rows */
+	unsigned sig; /* start of the active video in v->inp */
+	int wave[4]; /* decoded I/Q carrier */
+	int scanL, scanR, dx;
+	int L, R;
+};
+
+/* shared by the bands of one call to crt_demodulate_full() */
+struct CRT_DEMOD {
+	struct CRT *v;
+	struct CRT_LINE lines[CRT_LINES];
+	int total; /* lines in use */
+	size_t bands;
+	int bright;
+	int pitch;
+};
+
+/* Demodulates a band of the lines found by crt_demodulate_full().
+ * Bands only share the signal they read; each writes its own output rows.
+ *   parm - the CRT_DEMOD
+ *   band - the band to demodulate
+ */
+static void
+crt_demodulate_band(void *parm, size_t band)
 {
+	struct CRT_DEMOD *d = (struct CRT_DEMOD *)parm;
+	struct CRT *v = d->v;
 	struct {
 		int y, i, q;
 	} out[AV_LEN + 1], *yiqA, *yiqB;
-	int i, j = 0, line = 0, rn;
+	/* the filter settings are shared, the filter history is per band */
+	struct EQF y_eq = eqY, i_eq = eqI, q_eq = eqQ;
+	int i, s;
 	signed char *sig;
-	int s = 0;
-	int field, ratio;
-	int *ccr; /* color carrier signal */
-	int huesn, huecs;
-	int xnudge = -3, ynudge = 3;
-	int bright = v->brightness - (BLACK_LEVEL + v->black_point);
+	int bright = d->bright;
 	constexpr int bpp = 4;
-	int  pitch;
-#if CRT_DO_BLOOM
-	int prev_e; /* filtered beam energy per scan line */
-	int max_e; /* approx maximum energy in a scan line */
-#endif
-    
-	//bpp = 4;//crt_bpp4fmt(v->out_format);
-	/*if (bpp == 0) {
-		return;
-	}*/
-	pitch = v->outw * bpp;
-    
-	crt_sincos14_full(&huesn, &huecs, ((v->hue % 360) + 33) * 8192 / 180);
-	huesn >>= 11; /* make 4-bit */
-	huecs >>= 11;
-
-	rn = v->rn;
-	for (i = 0; i < CRT_INPUT_SIZE; i++) {
-		rn = (214019 * rn + 140327895);
-
-		/* signal + noise */
-		s = v->analog[i] + (((((rn >> 16) & 0xff) - 0x7f) * noise) >> 8);
-		if LSN_UNLIKELY(s >  127) { s =  127; }
-		if LSN_UNLIKELY(s < -127) { s = -127; }
-		v->inp[i] = (signed char)s;
-	}
-	v->rn = rn;
-
-    /* Look for vertical sync.
-     * 
-     * This is done by integrating the signal and
-     * seeing if it exceeds a threshold. The threshold of
-     * the vertical sync pulse is much higher because the
-     * vsync pulse is a lot longer than the hsync pulse.
-     * The signal needs to be integrated to lessen
-     * the noise in the signal.
-     */
-	for (i = -VSYNC_WINDOW; i < VSYNC_WINDOW; i++) {
-		line = POSMOD(v->vsync + i, CRT_VRES);
-		sig = v->inp + line * CRT_HRES;
-		s = 0;
-		for (j = 0; j < CRT_HRES; j++) {
-			s += sig[j];
-			/* increase the multiplier to make the vsync
-				* more stable when there is a lot of noise
-				*/
-			if (s <= (94 * SYNC_LEVEL)) {
-				goto vsync_found;
-			}
-		}
-	}
-vsync_found:
-	if LSN_LIKELY( v->do_vsync ) {
-		v->vsync = line; /* vsync found (or gave up) at this line */
-	}
-	else {
-		v->vsync = -3;
-	}
-//#if CRT_DO_VSYNC
-//    v->vsync = line; /* vsync found (or gave up) at this line */
-//#else
-//    v->vsync = -3;
-//#endif
-	/* if vsync signal was in second half of line, odd field */
-	field = (j > (CRT_HRES / 2));
-#if CRT_DO_BLOOM
-	max_e = (128 + (noise / 2)) * AV_LEN;
-	prev_e = (16384 / 8);
-#endif
-	/* ratio of output height to active video lines in the signal */
-	ratio = (v->outh << 16) / CRT_LINES;
-	ratio = (ratio + 32768) >> 16;
-    
-	field = (field * (ratio / 2));
-
-	for (line = CRT_TOP; line < CRT_BOT; line++) {
-		unsigned pos, ln;
-		int scanL, scanR, dx;
-		int L, R;
+	int pitch = d->pitch;
+	size_t first, last;
+
+	lsn::CJobPool::BandRange(band, d->bands, size_t(d->total), first, last);
+	for (size_t n = first; n < last; n++) {
+		const struct CRT_LINE *cl = &d->lines[n];
+		unsigned pos;
+		int scanL = cl->scanL, scanR = cl->scanR, dx = cl->dx;
+		int L = cl->L, R = cl->R;
 		unsigned char *cL, *cR;
-		int wave[4];
-		int dci, dcq; /* decoded I, Q */
-		int xpos, ypos;
-		int beg, end;
-		int phasealign;
-#if CRT_DO_BLOOM
-		int line_w;
-#endif
-  
-		beg = (line - CRT_TOP + 0) * (v->outh + v->v_fac) / CRT_LINES + field;
-		end = (line - CRT_TOP + 1) * (v->outh + v->v_fac) / CRT_LINES + field;
-
-		if LSN_UNLIKELY(beg >= v->outh) { continue; }
-		if LSN_UNLIKELY(end > v->outh) { end = v->outh; }
-
-		/* Look for horizontal sync.
-			* See comment above regarding vertical sync.
-			*/
-		ln = (POSMOD(line + v->vsync, CRT_VRES)) * CRT_HRES;
-		sig = v->inp + ln + v->hsync;
-		s = 0;
-		for (i = -HSYNC_WINDOW; i < HSYNC_WINDOW; i++) {
-			s += sig[SYNC_BEG + i];
-			if LSN_UNLIKELY(s <= (4 * SYNC_LEVEL)) {
-				break;
-			}
-		}
-
-		if LSN_LIKELY( v->do_hsync ) {
-			v->hsync = POSMOD(i + v->hsync, CRT_HRES);
-		}
-		else {
-			v->hsync = 0;
-		}
-//#if CRT_DO_HSYNC
-//        v->hsync = POSMOD(i + v->hsync, CRT_HRES);
-//#else
-//        v->hsync = 0;
-//#endif
-        
-		xpos = POSMOD(AV_BEG + v->hsync + xnudge, CRT_HRES);
-		ypos = POSMOD(line + v->vsync + ynudge, CRT_VRES);
-		pos = xpos + ypos * CRT_HRES;
-        
-		ccr = v->ccf[ypos % v->cc_period];
-		sig = v->inp + ln + (v->hsync & ~3); /* burst @ 1/CB_FREQ sample rate */
-		for (i = CB_BEG; i < CB_BEG + (CB_CYCLES * CRT_CB_FREQ); i++) {
-			int p, n;
-			p = ccr[i & 3] * 127 / 128; /* fraction of the previous */
-			n = sig[i];                 /* mixed with the new sample */
-			ccr[i & 3] = p + n;
-		}
- 
-		phasealign = POSMOD(v->hsync, 4);
+		const int *wave = cl->wave;
+		int beg = cl->beg, end = cl->end;
 
-		/* amplitude of carrier = saturation, phase difference = hue */
-		dci = ccr[(phasealign + 1) & 3] - ccr[(phasealign + 3) & 3];
-		dcq = ccr[(phasealign + 2) & 3] - ccr[(phasealign + 0) & 3];
+		sig = v->inp + cl->sig;
 
-		/* rotate them by the hue adjustment angle */
-		wave[0] = ((dci * huecs - dcq * huesn) >> 4) * v->saturation;
-		wave[1] = ((dcq * huecs + dci * huesn) >> 4) * v->saturation;
-		wave[2] = -wave[0];
-		wave[3] = -wave[1];
-        
-		sig = v->inp + pos;
-#if CRT_DO_BLOOM
-		s = 0;
-		for (i = 0; i < AV_LEN; i++) {
-			s += sig[i]; /* sum up the scan line */
-		}
-		/* bloom emulation */
-		prev_e = (prev_e * 123 / 128) + ((((max_e >> 1) - s) << 10) / max_e);
-		line_w = (AV_LEN * 112 / 128) + (prev_e >> 9);
-
-		dx = (line_w << 12) / v->outw;
-		scanL = ((AV_LEN / 2) - (line_w >> 1) + 8) << 12;
-		scanR = (AV_LEN - 1) << 12;
-        
-		L = (scanL >> 12);
-		R = (scanR >> 12);
-#else
-		dx = ((AV_LEN - 1) << 12) / v->outw;
-		scanL = 0;
-		scanR = (AV_LEN - 1) << 12;
-		L = 0;
-		R = AV_LEN;
-#endif
-		reset_eq(&eqY);
-		reset_eq(&eqI);
-		reset_eq(&eqQ);
+		reset_eq(&y_eq);
+		reset_eq(&i_eq);
+		reset_eq(&q_eq);
         
 		for (i = L; i < R; i++) {
-			out[i].y = eqf(&eqY, sig[i] + bright) << 4;
-			out[i].i = eqf(&eqI, sig[i] * wave[(i + 0) & 3] >> 9) >> 3;
-			out[i].q = eqf(&eqQ, sig[i] * wave[(i + 3) & 3] >> 9) >> 3;
+			out[i].y = eqf(&y_eq, sig[i] + bright) << 4;
+			out[i].i = eqf(&i_eq, sig[i] * wave[(i + 0) & 3] >> 9) >> 3;
+			out[i].q = eqf(&q_eq, sig[i] * wave[(i + 3) & 3] >> 9) >> 3;
 		}
 
 		cL = v->out + (beg * pitch);
@@ -896,5 +767,209 @@ vsync_found:
 		for (s = beg + 1; s < (end - v->scanlines); s++) {
 			memcpy(v->out + s * pitch, v->out + (s - 1) * pitch, pitch);
 		}
-    }
+	}
+}
+
+extern void
+crt_demodulate_full(struct CRT *v, int noise)
+{
+	struct CRT_DEMOD d;
+	int i, j = 0, line = 0, rn;
+	signed char *sig;
+	int s = 0;
+	int field, ratio;
+	int *ccr; /* color carrier signal */
+	int huesn, huecs;
+	int xnudge = -3, ynudge = 3;
+	constexpr int bpp = 4;
+#if CRT_DO_BLOOM
+	int prev_e; /* filtered beam energy per scan line */
+	int max_e; /* approx maximum energy in a scan line */
+#endif
+    
+	//bpp = 4;//crt_bpp4fmt(v->out_format);
+	/*if (bpp == 0) {
+		return;
+	}*/
+	d.v = v;
+	d.total = 0;
+	d.bright = v->brightness - (BLACK_LEVEL + v->black_point);
+	d.pitch = v->outw * bpp;
+    
+	crt_sincos14_full(&huesn, &huecs, ((v->hue % 360) + 33) * 8192 / 180);
+	huesn >>= 11; /* make 4-bit */
+	huecs >>= 11;
+
+	rn = v->rn;
+	for (i = 0; i < CRT_INPUT_SIZE; i++) {
+		rn = (214019 * rn + 140327895);
+
+		/* signal + noise */
+		s = v->analog[i] + (((((rn >> 16) & 0xff) - 0x7f) * noise) >> 8);
+		if LSN_UNLIKELY(s >  127) { s =  127; }
+		if LSN_UNLIKELY(s < -127) { s = -127; }
+		v->inp[i] = (signed char)s;
+	}
+	v->rn = rn;
+
+    /* Look for vertical sync.
+     * 
+     * This is done by integrating the signal and
+     * seeing if it exceeds a threshold. The threshold of
+     * the vertical sync pulse is much higher because the
+     * vsync pulse is a lot longer than the hsync pulse.
+     * The signal needs to be integrated to lessen
+     * the noise in the signal.
+     */
+	for (i = -VSYNC_WINDOW; i < VSYNC_WINDOW; i++) {
+		line = POSMOD(v->vsync + i, CRT_VRES);
+		sig = v->inp + line * CRT_HRES;
+		s = 0;
+		for (j = 0; j < CRT_HRES; j++) {
+			s += sig[j];
+			/* increase the multiplier to make the vsync
+				* more stable when there is a lot of noise
+				*/
+			if (s <= (94 * SYNC_LEVEL)) {
+				goto vsync_found;
+			}
+		}
+	}
+vsync_found:
+	if LSN_LIKELY( v->do_vsync ) {
+		v->vsync = line; /* vsync found (or gave up) at this line */
+	}
+	else {
+		v->vsync = -3;
+	}
+//#if CRT_DO_VSYNC
+//    v->vsync = line; /* vsync found (or gave up) at this line */
+//#else
+//    v->vsync = -3;
+//#endif
+	/* if vsync signal was in second half of line, odd field */
+	field = (j > (CRT_HRES / 2));
+#if CRT_DO_BLOOM
+	max_e = (128 + (noise / 2)) * AV_LEN;
+	prev_e = (16384 / 8);
+#endif
+	/* ratio of output height to active video lines in the signal */
+	ratio = (v->outh << 16) / CRT_LINES;
+	ratio = (ratio + 32768) >> 16;
+    
+	field = (field * (ratio / 2));
+
+	for (line = CRT_TOP; line < CRT_BOT; line++) {
+		unsigned pos, ln;
+		int scanL, scanR, dx;
+		int L, R;
+		int wave[4];
+		struct CRT_LINE *cl;
+		int dci, dcq; /* decoded I, Q */
+		int xpos, ypos;
+		int beg, end;
+		int phasealign;
+#if CRT_DO_BLOOM
+		int line_w;
+#endif
+  
+		beg = (line - CRT_TOP + 0) * (v->outh + v->v_fac) / CRT_LINES + field;
+		end = (line - CRT_TOP + 1) * (v->outh + v->v_fac) / CRT_LINES + field;
+
+		if LSN_UNLIKELY(beg >= v->outh) { continue; }
+		if LSN_UNLIKELY(end > v->outh) { end = v->outh; }
+
+		/* Look for horizontal sync.
+			* See comment above regarding vertical sync.
+			*/
+		ln = (POSMOD(line + v->vsync, CRT_VRES)) * CRT_HRES;
+		sig = v->inp + ln + v->hsync;
+		s = 0;
+		for (i = -HSYNC_WINDOW; i < HSYNC_WINDOW; i++) {
+			s += sig[SYNC_BEG + i];
+			if LSN_UNLIKELY(s <= (4 * SYNC_LEVEL)) {
+				break;
+			}
+		}
+
+		if LSN_LIKELY( v->do_hsync ) {
+			v->hsync = POSMOD(i + v->hsync, CRT_HRES);
+		}
+		else {
+			v->hsync = 0;
+		}
+//#if CRT_DO_HSYNC
+//        v->hsync = POSMOD(i + v->hsync, CRT_HRES);
+//#else
+//        v->hsync = 0;
+//#endif
+        
+		xpos = POSMOD(AV_BEG + v->hsync + xnudge, CRT_HRES);
+		ypos = POSMOD(line + v->vsync + ynudge, CRT_VRES);
+		pos = xpos + ypos * CRT_HRES;
+        
+		ccr = v->ccf[ypos % v->cc_period];
+		sig = v->inp + ln + (v->hsync & ~3); /* burst @ 1/CB_FREQ sample rate */
+		for (i = CB_BEG; i < CB_BEG + (CB_CYCLES * CRT_CB_FREQ); i++) {
+			int p, n;
+			p = ccr[i & 3] * 127 / 128; /* fraction of the previous */
+			n = sig[i];                 /* mixed with the new sample */
+			ccr[i & 3] = p + n;
+		}
+ 
+		phasealign = POSMOD(v->hsync, 4);
+
+		/* amplitude of carrier = saturation, phase difference = hue */
+		dci = ccr[(phasealign + 1) & 3] - ccr[(phasealign + 3) & 3];
+		dcq = ccr[(phasealign + 2) & 3] - ccr[(phasealign + 0) & 3];
+
+		/* rotate them by the hue adjustment angle */
+		wave[0] = ((dci * huecs - dcq * huesn) >> 4) * v->saturation;
+		wave[1] = ((dcq * huecs + dci * huesn) >> 4) * v->saturation;
+		wave[2] = -wave[0];
+		wave[3] = -wave[1];
+        
+		sig = v->inp + pos;
+#if CRT_DO_BLOOM
+		s = 0;
+		for (i = 0; i < AV_LEN; i++) {
+			s += sig[i]; /* sum up the scan line */
+		}
+		/* bloom emulation */
+		prev_e = (prev_e * 123 / 128) + ((((max_e >> 1) - s) << 10) / max_e);
+		line_w = (AV_LEN * 112 / 128) + (prev_e >> 9);
+
+		dx = (line_w << 12) / v->outw;
+		scanL = ((AV_LEN / 2) - (line_w >> 1) + 8) << 12;
+		scanR = (AV_LEN - 1) << 12;
+        
+		L = (scanL >> 12);
+		R = (scanR >> 12);
+#else
+		dx = ((AV_LEN - 1) << 12) / v->outw;
+		scanL = 0;
+		scanR = (AV_LEN - 1) << 12;
+		L = 0;
+		R = AV_LEN;
+#endif
+
+		/* the rest of the line does not depend on the lines before it */
+		cl = &d.lines[d.total++];
+		cl->beg = beg;
+		cl->end = end;
+		cl->sig = pos;
+		memcpy(cl->wave, wave, sizeof(wave));
+		cl->scanL = scanL;
+		cl->scanR = scanR;
+		cl->dx = dx;
+		cl->L = L;
+		cl->R = R;
+	}
+
+	/* hsync and the color burst carry over from line to line so they were
+	 * tracked above, one line after another; the lines are demodulated in bands
+	 */
+	lsn::CJobPool &jpPool = lsn::CJobPool::Get();
+	d.bands = jpPool.Bands(size_t(d.total));
+	jpPool.ParallelFor(crt_demodulate_band, &d, d.bands);
 }
@@ -11,6 +11,7 @@
 /*****************************************************************************/
 
 #include "pal_core.h"
+#include "../../Utilities/LSNJobPool.h"
 #include "../../Utilities/LSNUtilities.h"
 
 #include <immintrin.h>
@@ -280,196 +281,98 @@ pal_init(struct PAL_CRT *v, int w, int h, int f, unsigned char *out)
 #define HSYNC_WINDOW 6
 #define VSYNC_WINDOW 6
 
-extern void
-pal_demodulate(struct PAL_CRT *c, int noise)
+/* the results of the serial part of demodulating one scan line */
+struct PAL_LINE {
+    int beg, end; /* output rows */
+    unsigned sig; /* start of the active video in c->inp */
+    int wave[4]; /* decoded U/V carrier */
+    int odd; /* PAL switch, -1 or 1 */
+    int scanL, scanR, dx;
+    int L, R;
+};
+
+/* shared by the bands of one call to pal_demodulate() */
+struct PAL_DEMOD {
+    struct PAL_CRT *c;
+    struct PAL_LINE lines[PAL_LINES];
+    int total; /* lines in use */
+    size_t bands;
+    int bright;
+    int pitch;
+};
+
+/* Hanover bar correction delay line */
+static struct PAL_DELAY {
+    int u, v;
+} pal_delay_line[AV_LEN + 1]; /* as left by the last line of the last field */
+
+/* Fills a delay line with the chroma of a line, as the Hanover bar
+ * correction leaves it after demodulating that line.
+ *   pl - the line
+ *   dl - the delay line to fill
+ */
+static void
+pal_delay(const struct PAL_CRT *c, const struct PAL_LINE *pl, struct PAL_DELAY *dl)
+{
+    const signed char *sig = c->inp + pl->sig;
+    int i;
+
+    for (i = pl->L; i < pl->R; i++) {
+        dl[i].u = sig[i] * pl->wave[(i + 0) & 3];
+        dl[i].v = sig[i] * pl->wave[(i + 3) & 3] * pl->odd;
+    }
+}
+
+/* Demodulates a band of the lines found by pal_demodulate().
+ * Bands only share the signal they read; each writes its own output rows.
+ * The delay line is seeded from the line before the band.
+ *   parm - the PAL_DEMOD
+ *   band - the band to demodulate
+ */
+static void
+pal_demodulate_band(void *parm, size_t band)
 {
+    struct PAL_DEMOD *d = (struct PAL_DEMOD *)parm;
+    struct PAL_CRT *c = d->c;
     struct {
         int y, u, v;
     } outbuf[AV_LEN + 16], *out = outbuf + 8, *yuvA, *yuvB;
-    int i, j = 0, line = 0, rn;
+    struct PAL_DELAY delay_line[AV_LEN + 1];
+    /* the filter settings are shared, the filter history is per band */
+    struct EQF y_eq = eqY, u_eq = eqU, v_eq = eqV;
+    int i, s;
     signed char *sig;
-    int s = 0;
-    int field, ratio;
-    int *ccr; /* color carrier signal */
-    int huesn, huecs;
-    int xnudge = -3, ynudge = 3;
-    int bright = c->brightness - (BLACK_LEVEL + c->black_point);
+    int bright = d->bright;
     constexpr int bpp = 4;
-	int pitch;
-#if PAL_DO_BLOOM
-    int prev_e; /* filtered beam energy per scan line */
-    int max_e; /* approx maximum energy in a scan line */
-#endif
-    
-    //bpp = pal_bpp4fmt(c->out_format);
-    /*if LSN_UNLIKELY(bpp == 0) {
-        return;
-    }*/
-    pitch = c->outw * bpp;
-    
-    rn = c->rn;
-    for (i = 0; i < PAL_INPUT_SIZE; i++) {
-        rn = (214019 * rn + 140327895);
-
-        /* signal + noise */
-        s = c->analog[i] + (((((rn >> 16) & 0xff) - 0x7f) * noise) >> 8);
-        if LSN_UNLIKELY(s >  127) { s =  127; }
-        if LSN_UNLIKELY(s < -127) { s = -127; }
-        c->inp[i] = (signed char)s;
-    }
-    c->rn = rn;
-
-    /* Look for vertical sync.
-     * 
-     * This is done by integrating the signal and
-     * seeing if it exceeds a threshold. The threshold of
-     * the vertical sync pulse is much higher because the
-     * vsync pulse is a lot longer than the hsync pulse.
-     * The signal needs to be integrated to lessen
-     * the noise in the signal.
-     */
-    for (i = -VSYNC_WINDOW; i < VSYNC_WINDOW; i++) {
-        line = POSMOD(c->vsync + i, PAL_VRES);
-        sig = c->inp + line * PAL_HRES;
-        s = 0;
-        for (j = 0; j < PAL_HRES; j++) {
-            s += sig[j];
-            /* increase the multiplier to make the vsync
-             * more stable when there is a lot of noise
-             */
-            if LSN_UNLIKELY(s <= (125 * SYNC_LEVEL)) {
-                goto vsync_found;
-            }
+    int pitch = d->pitch;
+    size_t first, last;
+
+    lsn::CJobPool::BandRange(band, d->bands, size_t(d->total), first, last);
+    if (first == last) { return; }
+    /* chroma_lag leaves a few samples at either end unwritten */
+    memset(outbuf, 0, sizeof(outbuf));
+    if (c->chroma_correction) {
+        if (first == 0) {
+            memcpy(delay_line, pal_delay_line, sizeof(delay_line));
+        } else {
+            pal_delay(c, &d->lines[first - 1], delay_line);
         }
     }
-vsync_found:
-#if PAL_DO_VSYNC
-    c->vsync = line; /* vsync found (or gave up) at this line */
-#else
-    c->vsync = -3;
-#endif
-    /* if vsync signal was in second half of line, odd field */
-    field = (j > (PAL_HRES / 2));
-
-#if PAL_DO_BLOOM
-    max_e = (128 + (noise / 2)) * AV_LEN;
-    prev_e = (16384 / 8);
-#endif
-    /* ratio of output height to active video lines in the signal */
-    ratio = (c->outh << 16) / PAL_LINES;
-    ratio = (ratio + 32768) >> 16;
-    
-    field = (field * (ratio / 2));
-
-    for (line = PAL_TOP; line < PAL_BOT; line++) {
-        unsigned pos, ln;
-        int scanL, scanR, dx;
-        int L, R;
+    for (size_t n = first; n < last; n++) {
+        const struct PAL_LINE *pl = &d->lines[n];
+        unsigned pos;
+        int scanL = pl->scanL, scanR = pl->scanR, dx = pl->dx;
+        int L = pl->L, R = pl->R;
         unsigned char *cL, *cR;
-        int wave[4];
-        int dcu, dcv; /* decoded U, V */
-        int xpos, ypos;
-        int beg, end;
-        int phasealign;
-        int odd;
-#if PAL_DO_BLOOM
-        int line_w;
-#endif
-  
-        beg = (line - PAL_TOP + 0) * (c->outh + c->v_fac) / PAL_LINES + field;
-        end = (line - PAL_TOP + 1) * (c->outh + c->v_fac) / PAL_LINES + field;
-
-        if LSN_UNLIKELY(beg >= c->outh) { continue; }
-        if LSN_UNLIKELY(end > c->outh) { end = c->outh; }
-
-        /* Look for horizontal sync.
-         * See comment above regarding vertical sync.
-         */
-        ln = (POSMOD(line + c->vsync, PAL_VRES)) * PAL_HRES;
-        sig = c->inp + ln + c->hsync;
-
-        s = 0;
-        for (i = -HSYNC_WINDOW; i < HSYNC_WINDOW; i++) {
-            s += sig[SYNC_BEG + i];
-            if LSN_UNLIKELY(s <= (4 * SYNC_LEVEL)) {
-                break;
-            }
-        }
-#if PAL_DO_HSYNC
-        c->hsync = POSMOD(i + c->hsync, PAL_HRES);
-#else
-        c->hsync = 0;
-#endif
-        
-        xpos = POSMOD(AV_BEG + c->hsync + xnudge, PAL_HRES);
-        ypos = POSMOD(line + c->vsync + ynudge, PAL_VRES);
-        pos = xpos + ypos * PAL_HRES;
-        
-        sig = c->inp + ln + c->hsync;
-        odd = 0; /* PAL switch, odd line has SYNC in breezeway, even is blank */
-        s = 0;
-        for (i = 0; i < 8; i++) {
-            s += sig[BW_BEG + i];
-            if (s <= (4 * SYNC_LEVEL)) {
-                odd = 1;
-                break;
-            }
-        }
-        ccr = c->ccf[ypos % c->cc_period];
-        sig = c->inp + ln + (c->hsync & ~3);
-        for (i = CB_BEG; i < CB_BEG + (CB_CYCLES * PAL_CB_FREQ); i++) {
-            int p, n;
-            p = ccr[i & 3] * 127 / 128; /* fraction of the previous */
-            n = sig[i];                 /* mixed with the new sample */
-            ccr[i & 3] = p + n;
-        }
- 
-        phasealign = POSMOD(c->hsync, 4);
-
-        if (!odd) {
-            phasealign -= 1;
-        }
-        odd = odd ? -1 : 1;
+        const int *wave = pl->wave;
+        int odd = pl->odd;
+        int beg = pl->beg, end = pl->end;
 
-        pal_sincos14(&huesn, &huecs, 90 * 8192 / 180 - OFFSET_25Hz(line));
-        huesn >>= 7; /* make 8-bit */
-        huecs >>= 7;
-        
-        /* amplitude of carrier = saturation, phase difference = hue */
-        dcu = ccr[(phasealign + 1) & 3] - ccr[(phasealign + 3) & 3];
-        dcv = ccr[(phasealign + 2) & 3] - ccr[(phasealign + 0) & 3];
+        sig = c->inp + pl->sig;
 
-        wave[0] = ((dcu * huecs - dcv * huesn) >> 8) * c->saturation;
-        wave[1] = ((dcv * huecs + dcu * huesn) >> 8) * c->saturation;
-        wave[2] = -wave[0];
-        wave[3] = -wave[1];
-       
-        sig = c->inp + pos;
-#if PAL_DO_BLOOM
-        s = 0;
-        for (i = 0; i < AV_LEN; i++) {
-            s += sig[i]; /* sum up the scan line */
-        }
-        /* bloom emulation */
-        prev_e = (prev_e * 123 / 128) + ((((max_e >> 1) - s) << 10) / max_e);
-        line_w = (AV_LEN * 112 / 128) + (prev_e >> 9);
-
-        dx = (line_w << 12) / c->outw;
-        scanL = ((AV_LEN / 2) - (line_w >> 1) + 8) << 12;
-        scanR = (AV_LEN - 1) << 12;
-        
-        L = (scanL >> 12);
-        R = (scanR >> 12);
-#else
-        dx = ((AV_LEN - 1) << 12) / c->outw;
-        scanL = 0;
-        scanR = (AV_LEN - 1) << 12;
-        L = 0;
-        R = AV_LEN;
-#endif
-        reset_eq(&eqY);
-        reset_eq(&eqU);
-        reset_eq(&eqV);
+        reset_eq(&y_eq);
+        reset_eq(&u_eq);
+        reset_eq(&v_eq);
         
         for (i = L; i < R; i++) {
             int dmU, dmV;
@@ -478,7 +381,6 @@ vsync_found:
             dmU = sig[i] * wave[(i + 0) & 3];
             dmV = sig[i] * wave[(i + 3) & 3] * odd;
             if LSN_LIKELY(c->chroma_correction) {
-                static struct { int u, v; } delay_line[AV_LEN + 1];
                 ou = dmU;
                 ov = dmV;
                 dmU = (delay_line[i].u + dmU) / 2;
@@ -486,9 +388,9 @@ vsync_found:
                 delay_line[i].u = ou;
                 delay_line[i].v = ov;
             }
-            out[i].y = eqf(&eqY, sig[i] + bright) << 4;
-            out[i + c->chroma_lag].u = eqf(&eqU, dmU >> 9) >> 3;
-            out[i + c->chroma_lag].v = eqf(&eqV, dmV >> 9) >> 3;
+            out[i].y = eqf(&y_eq, sig[i] + bright) << 4;
+            out[i + c->chroma_lag].u = eqf(&u_eq, dmU >> 9) >> 3;
+            out[i + c->chroma_lag].v = eqf(&v_eq, dmV >> 9) >> 3;
         }
 
         cL = c->out + (beg * pitch);
@@ -882,3 +784,216 @@ vsync_found:
         }
     }
 }
+
+extern void
+pal_demodulate(struct PAL_CRT *c, int noise)
+{
+    struct PAL_DEMOD d;
+    int i, j = 0, line = 0, rn;
+    signed char *sig;
+    int s = 0;
+    int field, ratio;
+    int *ccr; /* color carrier signal */
+    int huesn, huecs;
+    int xnudge = -3, ynudge = 3;
+    constexpr int bpp = 4;
+#if PAL_DO_BLOOM
+    int prev_e; /* filtered beam energy per scan line */
+    int max_e; /* approx maximum energy in a scan line */
+#endif
+    
+    //bpp = pal_bpp4fmt(c->out_format);
+    /*if LSN_UNLIKELY(bpp == 0) {
+        return;
+    }*/
+    d.c = c;
+    d.total = 0;
+    d.bright = c->brightness - (BLACK_LEVEL + c->black_point);
+    d.pitch = c->outw * bpp;
+    
+    rn = c->rn;
+    for (i = 0; i < PAL_INPUT_SIZE; i++) {
+        rn = (214019 * rn + 140327895);
+
+        /* signal + noise */
+        s = c->analog[i] + (((((rn >> 16) & 0xff) - 0x7f) * noise) >> 8);
+        if LSN_UNLIKELY(s >  127) { s =  127; }
+        if LSN_UNLIKELY(s < -127) { s = -127; }
+        c->inp[i] = (signed char)s;
+    }
+    c->rn = rn;
+
+    /* Look for vertical sync.
+     * 
+     * This is done by integrating the signal and
+     * seeing if it exceeds a threshold. The threshold of
+     * the vertical sync pulse is much higher because the
+     * vsync pulse is a lot longer than the hsync pulse.
+     * The signal needs to be integrated to lessen
+     * the noise in the signal.
+     */
+    for (i = -VSYNC_WINDOW; i < VSYNC_WINDOW; i++) {
+        line = POSMOD(c->vsync + i, PAL_VRES);
+        sig = c->inp + line * PAL_HRES;
+        s = 0;
+        for (j = 0; j < PAL_HRES; j++) {
+            s += sig[j];
+            /* increase the multiplier to make the vsync
+             * more stable when there is a lot of noise
+             */
+            if LSN_UNLIKELY(s <= (125 * SYNC_LEVEL)) {
+                goto vsync_found;
+            }
+        }
+    }
+vsync_found:
+#if PAL_DO_VSYNC
+    c->vsync = line; /* vsync found (or gave up) at this line */
+#else
+    c->vsync = -3;
+#endif
+    /* if vsync signal was in second half of line, odd field */
+    field = (j > (PAL_HRES / 2));
+
+#if PAL_DO_BLOOM
+    max_e = (128 + (noise / 2)) * AV_LEN;
+    prev_e = (16384 / 8);
+#endif
+    /* ratio of output height to active video lines in the signal */
+    ratio = (c->outh << 16) / PAL_LINES;
+    ratio = (ratio + 32768) >> 16;
+    
+    field = (field * (ratio / 2));
+
+    for (line = PAL_TOP; line < PAL_BOT; line++) {
+        unsigned pos, ln;
+        int scanL, scanR, dx;
+        int L, R;
+        int wave[4];
+        struct PAL_LINE *pl;
+        int dcu, dcv; /* decoded U, V */
+        int xpos, ypos;
+        int beg, end;
+        int phasealign;
+        int odd;
+#if PAL_DO_BLOOM
+        int line_w;
+#endif
+  
+        beg = (line - PAL_TOP + 0) * (c->outh + c->v_fac) / PAL_LINES + field;
+        end = (line - PAL_TOP + 1) * (c->outh + c->v_fac) / PAL_LINES + field;
+
+        if LSN_UNLIKELY(beg >= c->outh) { continue; }
+        if LSN_UNLIKELY(end > c->outh) { end = c->outh; }
+
+        /* Look for horizontal sync.
+         * See comment above regarding vertical sync.
+         */
+        ln = (POSMOD(line + c->vsync, PAL_VRES)) * PAL_HRES;
+        sig = c->inp + ln + c->hsync;
+
+        s = 0;
+        for (i = -HSYNC_WINDOW; i < HSYNC_WINDOW; i++) {
+            s += sig[SYNC_BEG + i];
+            if LSN_UNLIKELY(s <= (4 * SYNC_LEVEL)) {
+                break;
+            }
+        }
+#if PAL_DO_HSYNC
+        c->hsync = POSMOD(i + c->hsync, PAL_HRES);
+#else
+        c->hsync = 0;
+#endif
+        
+        xpos = POSMOD(AV_BEG + c->hsync + xnudge, PAL_HRES);
+        ypos = POSMOD(line + c->vsync + ynudge, PAL_VRES);
+        pos = xpos + ypos * PAL_HRES;
+        
+        sig = c->inp + ln + c->hsync;
+        odd = 0; /* PAL switch, odd line has SYNC in breezeway, even is blank */
+        s = 0;
+        for (i = 0; i < 8; i++) {
+            s += sig[BW_BEG + i];
+            if (s <= (4 * SYNC_LEVEL)) {
+                odd = 1;
+                break;
+            }
+        }
+        ccr = c->ccf[ypos % c->cc_period];
+        sig = c->inp + ln + (c->hsync & ~3);
+        for (i = CB_BEG; i < CB_BEG + (CB_CYCLES * PAL_CB_FREQ); i++) {
+            int p, n;
+            p = ccr[i & 3] * 127 / 128; /* fraction of the previous */
+            n = sig[i];                 /* mixed with the new sample */
+            ccr[i & 3] = p + n;
+        }
+ 
+        phasealign = POSMOD(c->hsync, 4);
+
+        if (!odd) {
+            phasealign -= 1;
+        }
+        odd = odd ? -1 : 1;
+
+        pal_sincos14(&huesn, &huecs, 90 * 8192 / 180 - OFFSET_25Hz(line));
+        huesn >>= 7; /* make 8-bit */
+        huecs >>= 7;
+        
+        /* amplitude of carrier = saturation, phase difference = hue */
+        dcu = ccr[(phasealign + 1) & 3] - ccr[(phasealign + 3) & 3];
+        dcv = ccr[(phasealign + 2) & 3] - ccr[(phasealign + 0) & 3];
+
+        wave[0] = ((dcu * huecs - dcv * huesn) >> 8) * c->saturation;
+        wave[1] = ((dcv * huecs + dcu * huesn) >> 8) * c->saturation;
+        wave[2] = -wave[0];
+        wave[3] = -wave[1];
+       
+        sig = c->inp + pos;
+#if PAL_DO_BLOOM
+        s = 0;
+        for (i = 0; i < AV_LEN; i++) {
+            s += sig[i]; /* sum up the scan line */
+        }
+        /* bloom emulation */
+        prev_e = (prev_e * 123 / 128) + ((((max_e >> 1) - s) << 10) / max_e);
+        line_w = (AV_LEN * 112 / 128) + (prev_e >> 9);
+
+        dx = (line_w << 12) / c->outw;
+        scanL = ((AV_LEN / 2) - (line_w >> 1) + 8) << 12;
+        scanR = (AV_LEN - 1) << 12;
+        
+        L = (scanL >> 12);
+        R = (scanR >> 12);
+#else
+        dx = ((AV_LEN - 1) << 12) / c->outw;
+        scanL = 0;
+        scanR = (AV_LEN - 1) << 12;
+        L = 0;
+        R = AV_LEN;
+#endif
+
+        /* the rest of the line does not depend on the lines before it */
+        pl = &d.lines[d.total++];
+        pl->beg = beg;
+        pl->end = end;
+        pl->sig = pos;
+        memcpy(pl->wave, wave, sizeof(wave));
+        pl->odd = odd;
+        pl->scanL = scanL;
+        pl->scanR = scanR;
+        pl->dx = dx;
+        pl->L = L;
+        pl->R = R;
+    }
+
+    /* hsync, the color burst, and the delay line carry over from line to line
+     * so the first two were tracked above, one line after another, and each
+     * band rebuilds the delay line from the line before it
+     */
+    lsn::CJobPool &jpPool = lsn::CJobPool::Get();
+    d.bands = jpPool.Bands(size_t(d.total));
+    jpPool.ParallelFor(pal_demodulate_band, &d, d.bands);
+    if (c->chroma_correction && d.total) {
+        pal_delay(c, &d.lines[d.total - 1], pal_delay_line);
+    }
+}
@@ -0,0 +1,171 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: APU microbenchmark.  Runs a stand-alone NTSC APU through a fixed pseudo-random register script with no CPU, PPU, or
+ *	cartridge and reports the time and CPU cycles spent per APU tick, along with a hash of the generated samples so that changes to
+ *	the APU can be checked for identical output.
+ *
+ * Usage: BeesNESApuBench [-seconds N] [-runs N]
+ * -seconds is the number of emulated seconds per run (default 10).  -runs is the number of timed runs (default 5); the fastest is
+ *	reported.
+ */
+
+
+#include "LSNHeadless.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#define LSN_APU_BENCH_TSC()								__builtin_ia32_rdtsc()
+#elif defined( _M_X64 ) || defined( _M_IX86 )
+#include <intrin.h>
+#define LSN_APU_BENCH_TSC()								__rdtsc()
+#endif	// #if defined( __x86_64__ ) || defined( __i386__ )
+
+
+namespace lsn {
+
+	/** The APU under test. */
+	typedef CApu2A0X<LSN_APU_TYPE( NTSC ), LSN_CS_NTSC_MASTER, LSN_CS_NTSC_MASTER_DIVISOR, LSN_CS_NTSC_APU_DIVISOR, false>
+																							CBenchApu;
+
+	/**
+	 * Hashes each sample that comes out of the sample box.
+	 *
+	 * \param _pvParm Points to the uint32_t hash.
+	 * \param _fSample The sample.
+	 * \return Returns _fSample.
+	 */
+	static float										HashSample( void * _pvParm, float _fSample, uint32_t /*_ui32Hz*/ ) {
+		uint32_t * pui32Hash = static_cast<uint32_t *>(_pvParm);
+		uint32_t ui32Bits;
+		std::memcpy( &ui32Bits, &_fSample, sizeof( ui32Bits ) );
+		(*pui32Hash) = ((*pui32Hash) ^ ui32Bits) * 16777619U;
+		return _fSample;
+	}
+
+	/**
+	 * Runs the APU for the given number of ticks, writing a new pseudo-random note to every channel each quarter frame.
+	 *
+	 * \param _aApu The APU to run.
+	 * \param _bBus The bus to which the APU is mapped.
+	 * \param _ui64Ticks The number of APU ticks to run.
+	 */
+	static void											RunScript( CBenchApu &_aApu, CCpuBus &_bBus, uint64_t _ui64Ticks ) {
+		uint32_t ui32Rand = 0x1234567;
+		_bBus.Write( 0x4015, 0x0F );
+		_bBus.Write( 0x4017, 0x40 );
+		for ( uint64_t I = 0; I < _ui64Ticks; ++I ) {
+			if ( I % 7457 == 0 ) {
+				// Pulse 1 and 2: random duty, envelope or constant volume, and period.
+				for ( uint16_t ui16Reg = 0x4000; ui16Reg <= 0x4004; ui16Reg += 4 ) {
+					ui32Rand = ui32Rand * 1664525U + 1013904223U;
+					_bBus.Write( ui16Reg + 0, uint8_t( ui32Rand >> 24 ) | 0x20 );
+					_bBus.Write( ui16Reg + 2, uint8_t( ui32Rand >> 8 ) );
+					_bBus.Write( ui16Reg + 3, uint8_t( (ui32Rand >> 16) & 0x07 ) | 0x08 );
+				}
+				// Triangle.
+				ui32Rand = ui32Rand * 1664525U + 1013904223U;
+				_bBus.Write( 0x4008, 0xFF );
+				_bBus.Write( 0x400A, uint8_t( ui32Rand >> 8 ) );
+				_bBus.Write( 0x400B, uint8_t( (ui32Rand >> 16) & 0x07 ) | 0x08 );
+				// Noise.
+				ui32Rand = ui32Rand * 1664525U + 1013904223U;
+				_bBus.Write( 0x400C, uint8_t( ui32Rand >> 24 ) | 0x20 );
+				_bBus.Write( 0x400E, uint8_t( ui32Rand >> 8 ) & 0x8F );
+				_bBus.Write( 0x400F, 0x08 );
+			}
+			_aApu.Tick();
+		}
+	}
+
+}	// namespace lsn
+
+int main( int _iArgC, char * _pcArgV[] ) {
+	using namespace lsn;
+
+	double dSeconds = 10.0;
+	uint32_t ui32Runs = 5;
+	for ( int I = 1; I < _iArgC; ++I ) {
+		if ( std::strcmp( _pcArgV[I], "-seconds" ) == 0 && I + 1 < _iArgC ) {
+			dSeconds = std::strtod( _pcArgV[++I], nullptr );
+		}
+		else if ( std::strcmp( _pcArgV[I], "-runs" ) == 0 && I + 1 < _iArgC ) {
+			ui32Runs = uint32_t( std::strtoul( _pcArgV[++I], nullptr, 10 ) );
+		}
+		else {
+			std::fprintf( stderr, "Usage: %s [-seconds N] [-runs N]\n", _iArgC ? _pcArgV[0] : "BeesNESApuBench" );
+			return 1;
+		}
+	}
+	if ( ui32Runs == 0 ) { ui32Runs = 1; }
+
+	if ( !CHeadless::Initialize() ) {
+		std::fprintf( stderr, "Failed to initialize.\n" );
+		return 1;
+	}
+
+	std::unique_ptr<CCpuBus> pbBus;
+	std::unique_ptr<CInterruptable> piIrq;
+	try {
+		pbBus = std::make_unique<CCpuBus>();
+		piIrq = std::make_unique<CInterruptable>();
+	}
+	catch ( ... ) {
+		std::fprintf( stderr, "Out of memory.\n" );
+		return 1;
+	}
+
+	CClock cClock;
+	uint64_t ui64Ticks = uint64_t( dSeconds * double( LSN_CS_NTSC_MASTER ) / double( LSN_CS_NTSC_MASTER_DIVISOR ) / double( LSN_CS_NTSC_APU_DIVISOR ) );
+	double dBestSeconds = 0.0;
+	uint64_t ui64BestTsc = 0;
+	// The sample box is global and keeps its history between runs, so the hash covers all runs.
+	uint32_t ui32Hash = 2166136261U;
+	for ( uint32_t I = 0; I < ui32Runs; ++I ) {
+		std::unique_ptr<CBenchApu> paApu;
+		try {
+			paApu = std::make_unique<CBenchApu>( pbBus.get(), piIrq.get() );
+		}
+		catch ( ... ) {
+			std::fprintf( stderr, "Out of memory.\n" );
+			return 1;
+		}
+		pbBus->ApplyMap();
+		paApu->ApplyMemoryMap();
+		paApu->ResetToKnown();
+		// The APU's constructor points the sample box at its own output callback.
+		CAudio::SetSampleBoxOutputCallback( HashSample, &ui32Hash );
+
+		uint64_t ui64Start = cClock.GetRealTick();
+#ifdef LSN_APU_BENCH_TSC
+		uint64_t ui64TscStart = LSN_APU_BENCH_TSC();
+#endif	// #ifdef LSN_APU_BENCH_TSC
+		RunScript( (*paApu), (*pbBus), ui64Ticks );
+		paApu->FlushSamples();
+		CAudio::Flush();
+#ifdef LSN_APU_BENCH_TSC
+		uint64_t ui64Tsc = LSN_APU_BENCH_TSC() - ui64TscStart;
+#else
+		uint64_t ui64Tsc = 0;
+#endif	// #ifdef LSN_APU_BENCH_TSC
+		double dThis = double( cClock.GetRealTick() - ui64Start ) / double( cClock.GetResolution() );
+
+		if ( I == 0 || dThis < dBestSeconds ) {
+			dBestSeconds = dThis;
+			ui64BestTsc = ui64Tsc;
+		}
+	}
+
+	double dTicks = double( ui64Ticks ? ui64Ticks : 1 );
+	std::printf( "APU ticks: %llu\n", static_cast<unsigned long long>(ui64Ticks) );
+	std::printf( "Best run: %.6f seconds, %.2f ns/tick, %.1f TSC cycles/tick\n", dBestSeconds, dBestSeconds * 1000000000.0 / dTicks, double( ui64BestTsc ) / dTicks );
+	std::printf( "Sample hash: %.8X\n", ui32Hash );
+
+	CHeadless::Shutdown();
+	return 0;
+}
@@ -0,0 +1,301 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Whole-system benchmark.  Runs a fixed corpus of test ROMs on each region's system, once with no filter and once with each
+ *	filter, and prints one tab-separated result line per ROM, region, and filter, plus a TOTAL line for each region and filter.
+ *
+ * Usage: BeesNESBench [-frames N] [-runs N] [-root <dir>] [-region <name>] [-filter <name>] [-catchup] [-fastlines] [<rom> ...]
+ * -frames is the number of frames per run (default 60).  -runs is the number of timed runs of each ROM (default 1); the fastest is
+ *	reported.  -root is the directory containing the default corpus (default Research/nes-test-roms-master).  ROMs given on the
+ *	command line replace the default corpus.  -region and -filter may each be given more than once to limit the runs; the default
+ *	regions are ntsc, pal, and dendy, and the filters are none, rgb24, ntsc-blargg, pal-blargg, ntsc-crt-full, and pal-crt-full.
+ *	-catchup and -fastlines select the scheduling, as with BeesNESHeadless.
+ * Output columns: status, region, filter, frames, master cycles, seconds, master cycles/s, frames/s, speed relative to real time,
+ *	ns per CPU tick, ns per PPU tick, ns per APU tick, path.  The time per tick is the whole run (emulation and filtering) divided by
+ *	the number of ticks of that unit, since the units run interleaved and cannot be timed separately.
+ */
+
+
+#include "LSNHeadless.h"
+#include "../Filters/LSNNtscBlarggFilter.h"
+#include "../Filters/LSNNtscCrtFullFilter.h"
+#include "../Filters/LSNPalBlarggFilter.h"
+#include "../Filters/LSNPalCrtFullFilter.h"
+#include "../Filters/LSNRgb24Filter.h"
+#include "../Time/LSNClock.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+
+namespace lsn {
+
+	/** The default corpus, relative to -root. */
+	static const char *									s_pcCorpus[] = {
+		"ppu_vbl_nmi/ppu_vbl_nmi.nes",
+		"spritecans-2011/spritecans.nes",
+		"stress/NEStress.NES",
+		"nes15-1.0.0/nes15-NTSC.nes",
+		"ny2011/ny2011.nes",
+		"other/RasterDemo.NES",
+		"other/Streemerz_bundle.nes",
+		"apu_test/apu_test.nes",
+		"oam_stress/oam_stress.nes",
+		"mmc3_irq_tests/1.Clocking.nes",
+	};
+
+	/** A filter under test. */
+	struct LSN_BENCH_FILTER {
+		const char *									pcName;												/**< The name used on the command line and in the output. */
+		std::unique_ptr<CFilterBase>					pfbFilter;											/**< The filter, or nullptr to render 6-bit palette indices with no filter. */
+	};
+
+	/** The totals for one region and filter. */
+	struct LSN_BENCH_TOTAL {
+		uint64_t										ui64Frames = 0;										/**< The frames run. */
+		uint64_t										ui64Master = 0;										/**< The master cycles run. */
+		uint64_t										ui64Cpu = 0;										/**< The CPU ticks run. */
+		uint64_t										ui64Ppu = 0;										/**< The PPU ticks run. */
+		uint64_t										ui64Apu = 0;										/**< The APU ticks run. */
+		double											dSeconds = 0.0;										/**< The time taken. */
+		double											dRealSeconds = 0.0;									/**< The emulated time. */
+		uint32_t										ui32Failures = 0;									/**< The ROMs that failed to load. */
+	};
+
+	/**
+	 * Determines whether a name is in a list, or the list is empty.
+	 *
+	 * \param _vList The list.
+	 * \param _pcName The name to find.
+	 * \return Returns true if _vList is empty or contains _pcName.
+	 */
+	static bool											Selected( const std::vector<const char *> &_vList, const char * _pcName ) {
+		if ( _vList.empty() ) { return true; }
+		for ( size_t I = 0; I < _vList.size(); ++I ) {
+			if ( std::strcmp( _vList[I], _pcName ) == 0 ) { return true; }
+		}
+		return false;
+	}
+
+	/**
+	 * Prints a result line.
+	 *
+	 * \param _pcStatus The status column.
+	 * \param _pcRegion The region name.
+	 * \param _pcFilter The filter name.
+	 * \param _btTotal The counts and times to print.
+	 * \param _pcPath The path column.
+	 */
+	static void											PrintLine( const char * _pcStatus, const char * _pcRegion, const char * _pcFilter, const LSN_BENCH_TOTAL &_btTotal, const char * _pcPath ) {
+		double dSeconds = _btTotal.dSeconds > 0.0 ? _btTotal.dSeconds : 1.0e-9;
+		double dNs = dSeconds * 1000000000.0;
+		std::printf( "%s\t%s\t%s\t%llu\t%llu\t%.6f\t%.0f\t%.2f\t%.3f\t%.3f\t%.3f\t%.3f\t%s\n", _pcStatus, _pcRegion, _pcFilter,
+			static_cast<unsigned long long>(_btTotal.ui64Frames), static_cast<unsigned long long>(_btTotal.ui64Master), _btTotal.dSeconds,
+			double( _btTotal.ui64Master ) / dSeconds, double( _btTotal.ui64Frames ) / dSeconds, _btTotal.dRealSeconds / dSeconds,
+			_btTotal.ui64Cpu ? dNs / double( _btTotal.ui64Cpu ) : 0.0, _btTotal.ui64Ppu ? dNs / double( _btTotal.ui64Ppu ) : 0.0,
+			_btTotal.ui64Apu ? dNs / double( _btTotal.ui64Apu ) : 0.0, _pcPath );
+		std::fflush( stdout );
+	}
+
+	/**
+	 * Runs a ROM for a number of frames on a new system, filtering each frame if a filter is given.
+	 *
+	 * \param _rRom The ROM to run.  Copied into the system.
+	 * \param _pmRegion The region of the system to create.
+	 * \param _pfbFilter The filter, or nullptr.
+	 * \param _ui64Frames The number of frames to run.
+	 * \param _bCatchUp If true, catch-up scheduling is used.
+	 * \param _bFastLines If true, whole scanlines are run at once during catch-up.
+	 * \param _btResult Holds the counts and time of the run.
+	 * \return Returns false if the system could not be created or the ROM could not be loaded.
+	 */
+	static bool											RunOne( const LSN_ROM &_rRom, LSN_PPU_METRICS _pmRegion, CFilterBase * _pfbFilter, uint64_t _ui64Frames,
+		bool _bCatchUp, bool _bFastLines, LSN_BENCH_TOTAL &_btResult ) {
+		std::unique_ptr<CSystemBase> psbSystem = CHeadless::CreateSystem( _pmRegion );
+		if ( !psbSystem ) { return false; }
+		LSN_ROM rRom = _rRom;
+		if ( !psbSystem->LoadRom( rRom ) ) { return false; }
+
+		CDisplayClient * pdcClient = psbSystem->GetDisplayClient();
+		std::vector<uint8_t> vFrame;
+		if ( _pfbFilter ) {
+			pdcClient->SetRenderTarget( _pfbFilter->CurTarget(), _pfbFilter->OutputStride(), _pfbFilter->InputFormat(), _pfbFilter->FlipInput() );
+		}
+		else {
+			try {
+				vFrame.resize( size_t( pdcClient->DisplayWidth() ) * pdcClient->DisplayHeight() );
+			}
+			catch ( ... ) { return false; }
+			pdcClient->SetRenderTarget( vFrame.data(), pdcClient->DisplayWidth(), CDisplayClient::LSN_POF_6BIT_PALETTE, false );
+		}
+		psbSystem->SetCatchUp( _bCatchUp );
+		psbSystem->SetFastScanlines( _bFastLines );
+		psbSystem->ResetState( false );
+
+		CClock cClock;
+		uint64_t ui64Start = cClock.GetRealTick();
+		while ( psbSystem->GetPpuFrameCount() < _ui64Frames ) {
+			psbSystem->RunFrame();
+			if ( _pfbFilter ) {
+				// The same hand-off CBeesNes::Swap() and CBeesNes::Render() make, done on one thread.
+				uint8_t * pui8Input = _pfbFilter->OutputBuffer();
+				uint32_t ui32Width = _pfbFilter->OutputWidth();
+				uint32_t ui32Height = _pfbFilter->OutputHeight();
+				uint16_t ui16Bits = uint16_t( _pfbFilter->OutputBits() );
+				uint32_t ui32Stride = uint32_t( _pfbFilter->OutputStride() );
+				_pfbFilter->Swap();
+				pdcClient->SetRenderTarget( _pfbFilter->CurTarget(), _pfbFilter->OutputStride(), _pfbFilter->InputFormat(), _pfbFilter->FlipInput() );
+				_pfbFilter->ApplyFilter( pui8Input, ui32Width, ui32Height, ui16Bits, ui32Stride, pdcClient->FrameCount(), pdcClient->GetRenderStartCycle() );
+			}
+		}
+		_btResult.dSeconds = double( cClock.GetRealTick() - ui64Start ) / double( cClock.GetResolution() );
+		_btResult.ui64Frames = psbSystem->GetPpuFrameCount();
+		_btResult.ui64Master = psbSystem->GetMasterCounter();
+		_btResult.ui64Cpu = _btResult.ui64Master / psbSystem->GetCpuDiv();
+		_btResult.ui64Ppu = _btResult.ui64Master / psbSystem->GetPpuDiv();
+		_btResult.ui64Apu = _btResult.ui64Master / psbSystem->GetApuDiv();
+		_btResult.dRealSeconds = double( _btResult.ui64Master ) * double( psbSystem->GetMasterDiv() ) / double( psbSystem->GetMasterHz() );
+		return true;
+	}
+
+}	// namespace lsn
+
+int main( int _iArgC, char * _pcArgV[] ) {
+	using namespace lsn;
+
+	uint64_t ui64Frames = 60;
+	uint32_t ui32Runs = 1;
+	std::string sRoot = "Research/nes-test-roms-master";
+	std::vector<const char *> vRegions;
+	std::vector<const char *> vFilterNames;
+	bool bCatchUp = false;
+	bool bFastLines = false;
+	std::vector<std::string> vRoms;
+	for ( int I = 1; I < _iArgC; ++I ) {
+		if ( std::strcmp( _pcArgV[I], "-frames" ) == 0 && I + 1 < _iArgC ) {
+			ui64Frames = std::strtoull( _pcArgV[++I], nullptr, 10 );
+		}
+		else if ( std::strcmp( _pcArgV[I], "-runs" ) == 0 && I + 1 < _iArgC ) {
+			ui32Runs = uint32_t( std::strtoul( _pcArgV[++I], nullptr, 10 ) );
+		}
+		else if ( std::strcmp( _pcArgV[I], "-root" ) == 0 && I + 1 < _iArgC ) {
+			sRoot = _pcArgV[++I];
+		}
+		else if ( std::strcmp( _pcArgV[I], "-region" ) == 0 && I + 1 < _iArgC ) {
+			vRegions.push_back( _pcArgV[++I] );
+			if ( CHeadless::RegionFromName( vRegions.back() ) == LSN_PM_UNKNOWN ) {
+				std::fprintf( stderr, "Unknown region: %s\n", vRegions.back() );
+				return 1;
+			}
+		}
+		else if ( std::strcmp( _pcArgV[I], "-filter" ) == 0 && I + 1 < _iArgC ) {
+			vFilterNames.push_back( _pcArgV[++I] );
+		}
+		else if ( std::strcmp( _pcArgV[I], "-catchup" ) == 0 ) {
+			bCatchUp = true;
+		}
+		else if ( std::strcmp( _pcArgV[I], "-fastlines" ) == 0 ) {
+			bCatchUp = true;
+			bFastLines = true;
+		}
+		else if ( _pcArgV[I][0] == '-' ) {
+			std::fprintf( stderr, "Usage: %s [-frames N] [-runs N] [-root <dir>] [-region <name>] [-filter <name>] [-catchup] [-fastlines] [<rom> ...]\n", _iArgC ? _pcArgV[0] : "BeesNESBench" );
+			return 1;
+		}
+		else {
+			vRoms.push_back( _pcArgV[I] );
+		}
+	}
+	if ( ui32Runs == 0 ) { ui32Runs = 1; }
+	if ( vRoms.empty() ) {
+		for ( size_t I = 0; I < LSN_ELEMENTS( s_pcCorpus ); ++I ) {
+			vRoms.push_back( sRoot + "/" + s_pcCorpus[I] );
+		}
+	}
+	if ( vRegions.empty() ) {
+		vRegions = { "ntsc", "pal", "dendy" };
+	}
+
+	if ( !CHeadless::Initialize() ) {
+		std::fprintf( stderr, "Failed to initialize.\n" );
+		return 1;
+	}
+
+	std::vector<LSN_BENCH_FILTER> vFilters;
+	try {
+		vFilters.push_back( { "none", nullptr } );
+		vFilters.push_back( { "rgb24", std::make_unique<CRgb24Filter>() } );
+		vFilters.push_back( { "ntsc-blargg", std::make_unique<CNtscBlarggFilter>() } );
+		vFilters.push_back( { "pal-blargg", std::make_unique<CPalBlarggFilter>() } );
+		vFilters.push_back( { "ntsc-crt-full", std::make_unique<CNtscCrtFullFilter>() } );
+		vFilters.push_back( { "pal-crt-full", std::make_unique<CPalCrtFullFilter>() } );
+	}
+	catch ( ... ) {
+		std::fprintf( stderr, "Out of memory.\n" );
+		return 1;
+	}
+	for ( size_t I = 0; I < vFilterNames.size(); ++I ) {
+		bool bFound = false;
+		for ( size_t J = 0; J < vFilters.size() && !bFound; ++J ) {
+			bFound = std::strcmp( vFilterNames[I], vFilters[J].pcName ) == 0;
+		}
+		if ( !bFound ) {
+			std::fprintf( stderr, "Unknown filter: %s\n", vFilterNames[I] );
+			return 1;
+		}
+	}
+
+	std::vector<LSN_ROM> vLoaded( vRoms.size() );
+	std::vector<bool> vLoadedOk( vRoms.size() );
+	for ( size_t I = 0; I < vRoms.size(); ++I ) {
+		vLoadedOk[I] = CHeadless::LoadRomFile( reinterpret_cast<const char8_t *>(vRoms[I].c_str()), vLoaded[I] );
+	}
+
+	std::printf( "status\tregion\tfilter\tframes\tmaster_cycles\tseconds\tmaster_cycles_per_s\tframes_per_s\tspeed\tns_per_cpu_tick\tns_per_ppu_tick\tns_per_apu_tick\tpath\n" );
+	int iFailures = 0;
+	for ( size_t R = 0; R < vRegions.size(); ++R ) {
+		LSN_PPU_METRICS pmRegion = CHeadless::RegionFromName( vRegions[R] );
+		const char * pcRegion = CHeadless::RegionName( pmRegion );
+		for ( size_t F = 0; F < vFilters.size(); ++F ) {
+			if ( !Selected( vFilterNames, vFilters[F].pcName ) ) { continue; }
+			CFilterBase * pfbFilter = vFilters[F].pfbFilter.get();
+			if ( pfbFilter ) {
+				pfbFilter->Init( 3, 256, 240 );
+				pfbFilter->Activate();
+			}
+
+			LSN_BENCH_TOTAL btTotal;
+			for ( size_t I = 0; I < vRoms.size(); ++I ) {
+				LSN_BENCH_TOTAL btBest;
+				bool bOk = vLoadedOk[I];
+				for ( uint32_t J = 0; J < ui32Runs && bOk; ++J ) {
+					LSN_BENCH_TOTAL btRun;
+					bOk = RunOne( vLoaded[I], pmRegion, pfbFilter, ui64Frames, bCatchUp, bFastLines, btRun );
+					if ( bOk && (J == 0 || btRun.dSeconds < btBest.dSeconds) ) { btBest = btRun; }
+				}
+				if ( !bOk ) {
+					PrintLine( "FAIL", pcRegion, vFilters[F].pcName, LSN_BENCH_TOTAL(), vRoms[I].c_str() );
+					++btTotal.ui32Failures;
+					++iFailures;
+					continue;
+				}
+				PrintLine( "OK", pcRegion, vFilters[F].pcName, btBest, vRoms[I].c_str() );
+				btTotal.ui64Frames += btBest.ui64Frames;
+				btTotal.ui64Master += btBest.ui64Master;
+				btTotal.ui64Cpu += btBest.ui64Cpu;
+				btTotal.ui64Ppu += btBest.ui64Ppu;
+				btTotal.ui64Apu += btBest.ui64Apu;
+				btTotal.dSeconds += btBest.dSeconds;
+				btTotal.dRealSeconds += btBest.dRealSeconds;
+			}
+			PrintLine( "TOTAL", pcRegion, vFilters[F].pcName, btTotal, "*" );
+		}
+	}
+
+	CHeadless::Shutdown();
+	return iFailures ? 2 : 0;
+}
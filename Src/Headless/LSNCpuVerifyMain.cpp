@@ -0,0 +1,133 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Command-line entry point for single-step CPU verification.  Runs the nes6502 JSON tests (one file per opcode) across
+ *	the job pool, each file on its own CPU and flat bus, and prints one tab-separated result line per file in name order.
+ *
+ * Usage: BeesNESCpuVerify [-max <failures>] <folder or .json file>...
+ * Folders are searched (not recursively) for .json files.
+ * Output columns: status (PASS, FAIL, or READFAIL), tests, failures, seconds, path.  Each failing file is followed by descriptions of
+ *	its first failures (-max per file, 4 by default), indented by a tab.
+ * The totals (files, tests, failures, unreadable files, threads, and wall seconds) are printed to stderr.  Returns 2 if any test failed or
+ *	any file could not be read.
+ * Must be built with LSN_CPU_VERIFY, under which the CPU logs every bus access and does not tick a mapper.
+ */
+
+
+#include "../Cpu/LSNCpuVerify.h"
+#include "../Time/LSNClock.h"
+#include "../Utilities/LSNJobPool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+
+namespace lsn {
+
+	/** The result of a file. */
+	struct LSN_VERIFY_RUN {
+		std::filesystem::path							pPath;												/**< The file. */
+		CCpuVerify::LSN_RESULTS							rResults;											/**< The results. */
+		double											dSeconds = 0.0;										/**< The time taken. */
+		bool											bRead = false;										/**< If false, the file could not be read or parsed. */
+	};
+
+	/** The files shared by the jobs. */
+	struct LSN_VERIFY_JOBS {
+		std::vector<LSN_VERIFY_RUN>						vRuns;												/**< The files to verify. */
+		size_t											sMaxFailures = 4;									/**< The most failures to describe per file. */
+	};
+
+	/**
+	 * Verifies one file.  Run on the job pool.
+	 *
+	 * \param _pvParm A pointer to the LSN_VERIFY_JOBS.
+	 * \param _sIdx The index into LSN_VERIFY_JOBS::vRuns of the file to verify.
+	 */
+	static void											VerifyFile( void * _pvParm, size_t _sIdx ) {
+		LSN_VERIFY_JOBS * pvjJobs = static_cast<LSN_VERIFY_JOBS *>(_pvParm);
+		LSN_VERIFY_RUN & vrRun = pvjJobs->vRuns[_sIdx];
+		CClock cClock;
+		uint64_t ui64Start = cClock.GetRealTick();
+		try {
+			vrRun.bRead = CCpuVerify::VerifyFile( vrRun.pPath.u8string().c_str(), vrRun.rResults, pvjJobs->sMaxFailures );
+		}
+		catch ( ... ) {
+			vrRun.bRead = false;
+		}
+		vrRun.dSeconds = double( cClock.GetRealTick() - ui64Start ) / double( cClock.GetResolution() );
+	}
+
+}	// namespace lsn
+
+int main( int _iArgC, char * _pcArgV[] ) {
+	using namespace lsn;
+
+	LSN_VERIFY_JOBS vjJobs;
+	std::vector<std::filesystem::path> vPaths;
+	try {
+		for ( int I = 1; I < _iArgC; ++I ) {
+			if ( std::strcmp( _pcArgV[I], "-max" ) == 0 && I + 1 < _iArgC ) {
+				vjJobs.sMaxFailures = size_t( std::strtoull( _pcArgV[++I], nullptr, 10 ) );
+			}
+			else {
+				std::filesystem::path pPath( reinterpret_cast<const char8_t *>(_pcArgV[I]) );
+				std::error_code ecErr;
+				if ( std::filesystem::is_directory( pPath, ecErr ) ) {
+					for ( const auto & deEntry : std::filesystem::directory_iterator( pPath, ecErr ) ) {
+						if ( deEntry.is_regular_file( ecErr ) && deEntry.path().extension() == ".json" ) {
+							vPaths.push_back( deEntry.path() );
+						}
+					}
+				}
+				else {
+					vPaths.push_back( pPath );
+				}
+			}
+		}
+		if ( vPaths.empty() ) {
+			std::fprintf( stderr, "Usage: %s [-max <failures>] <folder or .json file>...\n", _iArgC ? _pcArgV[0] : "BeesNESCpuVerify" );
+			return 1;
+		}
+		std::sort( vPaths.begin(), vPaths.end() );
+		for ( const auto & pPath : vPaths ) {
+			LSN_VERIFY_RUN vrRun;
+			vrRun.pPath = pPath;
+			vjJobs.vRuns.push_back( std::move( vrRun ) );
+		}
+	}
+	catch ( ... ) {
+		std::fprintf( stderr, "Failed to gather the files.\n" );
+		return 1;
+	}
+
+	CClock cClock;
+	uint64_t ui64Start = cClock.GetRealTick();
+	CJobPool::Get().ParallelFor( VerifyFile, &vjJobs, vjJobs.vRuns.size() );
+	double dWall = double( cClock.GetRealTick() - ui64Start ) / double( cClock.GetResolution() );
+
+	uint64_t ui64Tests = 0, ui64Failed = 0;
+	size_t sUnread = 0;
+	for ( const auto & vrRun : vjJobs.vRuns ) {
+		const char * pcStatus = !vrRun.bRead ? "READFAIL" : (vrRun.rResults.ui64Failed ? "FAIL" : "PASS");
+		if ( !vrRun.bRead ) { ++sUnread; }
+		ui64Tests += vrRun.rResults.ui64Tests;
+		ui64Failed += vrRun.rResults.ui64Failed;
+		std::printf( "%s\t%llu\t%llu\t%.6f\t%s\n", pcStatus, static_cast<unsigned long long>(vrRun.rResults.ui64Tests),
+			static_cast<unsigned long long>(vrRun.rResults.ui64Failed), vrRun.dSeconds, reinterpret_cast<const char *>(vrRun.pPath.u8string().c_str()) );
+		for ( const auto & sFailure : vrRun.rResults.vFailures ) {
+			std::printf( "\t%s\n", sFailure.c_str() );
+		}
+	}
+	std::fprintf( stderr, "Files: %zu\tTests: %llu\tFailed: %llu\tUnreadable: %zu\tThreads: %zu\tSeconds: %.6f\n",
+		vjJobs.vRuns.size(), static_cast<unsigned long long>(ui64Tests), static_cast<unsigned long long>(ui64Failed), sUnread,
+		CJobPool::Get().Threads(), dWall );
+
+	return (ui64Failed || sUnread) ? 2 : 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Helpers for running emulated systems without any windowing, audio device, or GPU.  Used by batch tools.
+ */
+
+
+#include "LSNHeadless.h"
+#include "../Audio/LSNAudio.h"
+#include "../Database/LSNDatabase.h"
+#include "../Utilities/LSNUtilities.h"
+
+#include <cctype>
+
+namespace lsn {
+
+	// == Functions.
+	/**
+	 * Initializes the global state shared by all systems (the ROM database and the null audio device).  Call once before creating systems.
+	 * 
+	 * \return Returns true if initialization succeeded.
+	 **/
+	bool CHeadless::Initialize() {
+		CDatabase::Init();
+		return CAudio::InitializeAudio();
+	}
+
+	/**
+	 * Shuts down the global state.
+	 **/
+	void CHeadless::Shutdown() {
+		CAudio::ShutdownAudio();
+	}
+
+	/**
+	 * Creates a system for the given region.
+	 * 
+	 * \param _pmRegion The region of the system to create.
+	 * \return Returns the created system or an empty pointer if the region is not supported or memory could not be allocated.
+	 **/
+	std::unique_ptr<CSystemBase> CHeadless::CreateSystem( LSN_PPU_METRICS _pmRegion ) {
+		try {
+			switch ( _pmRegion ) {
+				case LSN_PM_NTSC : { return std::make_unique<CNtscSystem>(); }
+				case LSN_PM_PAL : { return std::make_unique<CPalSystem>(); }
+				case LSN_PM_DENDY : { return std::make_unique<CDendySystem>(); }
+				case LSN_PM_PALM : { return std::make_unique<CPalMSystem>(); }
+				case LSN_PM_PALN : { return std::make_unique<CPalNSystem>(); }
+				default : { return std::unique_ptr<CSystemBase>(); }
+			}
+		}
+		catch ( ... ) { return std::unique_ptr<CSystemBase>(); }
+	}
+
+	/**
+	 * Loads a ROM file from disk into an LSN_ROM object.
+	 * 
+	 * \param _pcPath The UTF-8 path to the ROM file.
+	 * \param _rRom The returned ROM.
+	 * \return Returns true if the file was loaded and parsed.
+	 **/
+	bool CHeadless::LoadRomFile( const char8_t * _pcPath, LSN_ROM &_rRom ) {
+		std::u16string u16Path = CUtilities::Utf8ToUtf16( _pcPath );
+		CRomBuffer rbFile;
+		if ( !rbFile.MapFile( u16Path.c_str() ) ) { return false; }
+		return CSystemBase::LoadRom( rbFile, _rRom, u16Path );
+	}
+
+	/**
+	 * Converts a region name ("ntsc", "pal", "dendy", "palm", or "paln") to its LSN_PPU_METRICS value.
+	 * 
+	 * \param _pcName The name to convert.  Case-insensitive.
+	 * \return Returns the region or LSN_PM_UNKNOWN.
+	 **/
+	LSN_PPU_METRICS CHeadless::RegionFromName( const char * _pcName ) {
+		std::string sName;
+		for ( ; _pcName && (*_pcName); ++_pcName ) {
+			sName.push_back( char( std::tolower( static_cast<unsigned char>(*_pcName) ) ) );
+		}
+		if ( sName == "ntsc" ) { return LSN_PM_NTSC; }
+		if ( sName == "pal" ) { return LSN_PM_PAL; }
+		if ( sName == "dendy" ) { return LSN_PM_DENDY; }
+		if ( sName == "palm" || sName == "pal-m" ) { return LSN_PM_PALM; }
+		if ( sName == "paln" || sName == "pal-n" ) { return LSN_PM_PALN; }
+		return LSN_PM_UNKNOWN;
+	}
+
+	/**
+	 * Gets the name of a region.
+	 * 
+	 * \param _pmRegion The region whose name is to be returned.
+	 * \return Returns the name of the given region.
+	 **/
+	const char * CHeadless::RegionName( LSN_PPU_METRICS _pmRegion ) {
+		switch ( _pmRegion ) {
+			case LSN_PM_NTSC : { return "ntsc"; }
+			case LSN_PM_PAL : { return "pal"; }
+			case LSN_PM_DENDY : { return "dendy"; }
+			case LSN_PM_PALM : { return "palm"; }
+			case LSN_PM_PALN : { return "paln"; }
+			default : { return "unknown"; }
+		}
+	}
+
+}	// namespace lsn
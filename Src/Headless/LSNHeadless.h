@@ -0,0 +1,76 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Helpers for running emulated systems without any windowing, audio device, or GPU.  Used by batch tools.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "../System/LSNSystem.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lsn {
+
+	/**
+	 * Class CHeadless
+	 * \brief Helpers for running emulated systems without any windowing, audio device, or GPU.
+	 *
+	 * Description: Helpers for running emulated systems without any windowing, audio device, or GPU.  Used by batch tools.
+	 */
+	class CHeadless {
+	public :
+		// == Functions.
+		/**
+		 * Initializes the global state shared by all systems (the ROM database and the null audio device).  Call once before creating systems.
+		 * 
+		 * \return Returns true if initialization succeeded.
+		 **/
+		static bool											Initialize();
+
+		/**
+		 * Shuts down the global state.
+		 **/
+		static void											Shutdown();
+
+		/**
+		 * Creates a system for the given region.
+		 * 
+		 * \param _pmRegion The region of the system to create.
+		 * \return Returns the created system or an empty pointer if the region is not supported or memory could not be allocated.
+		 **/
+		static std::unique_ptr<CSystemBase>					CreateSystem( LSN_PPU_METRICS _pmRegion );
+
+		/**
+		 * Loads a ROM file from disk into an LSN_ROM object.
+		 * 
+		 * \param _pcPath The UTF-8 path to the ROM file.
+		 * \param _rRom The returned ROM.
+		 * \return Returns true if the file was loaded and parsed.
+		 **/
+		static bool											LoadRomFile( const char8_t * _pcPath, LSN_ROM &_rRom );
+
+		/**
+		 * Converts a region name ("ntsc", "pal", "dendy", "palm", or "paln") to its LSN_PPU_METRICS value.
+		 * 
+		 * \param _pcName The name to convert.  Case-insensitive.
+		 * \return Returns the region or LSN_PM_UNKNOWN.
+		 **/
+		static LSN_PPU_METRICS								RegionFromName( const char * _pcName );
+
+		/**
+		 * Gets the name of a region.
+		 * 
+		 * \param _pmRegion The region whose name is to be returned.
+		 * \return Returns the name of the given region.
+		 **/
+		static const char *									RegionName( LSN_PPU_METRICS _pmRegion );
+	};
+
+}	// namespace lsn
@@ -0,0 +1,245 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Command-line entry point for headless batch runs.  Loads each ROM given on the command line, runs it for a number of
+ *	frames as fast as the host allows with no window, audio device, or GPU, and prints one tab-separated result line per ROM.
+ *
+ * Usage: BeesNESHeadless [-region ntsc|pal|dendy|palm|paln] [-frames N] [-catchup] [-fastlines] [-linecheck] [-statecheck] [-rewindcheck] [-trace <file>] <rom> [<rom> ...]
+ * Output columns: status, region, mapper, frames, PRG CRC, final-frame CRC, seconds, path.
+ * -catchup runs with catch-up scheduling, which must produce the same results as the default scheduling.
+ * -fastlines also runs whole PPU scanlines at once during catch-up where no write can land inside them, which must produce the same
+ *	results again.  Implies -catchup.
+ * -linecheck runs each ROM with -fastlines and, next to it, a second copy with the default scheduling, and compares every frame.  The
+ *	status is LINEDIFF if any frame differs, and the first frame that differs is printed to stderr.  Implies -fastlines.
+ * -statecheck saves the machine state halfway through the run, finishes the run, loads the state, and runs the second half again.
+ *	The status is STATEDIFF if the second run does not end on the same frame, and the state size and save/load times are printed
+ *	to stderr.
+ * -rewindcheck captures a rewind state after every frame, rewinds a third of the run at the end, and runs it again.  The status is
+ *	REWINDDIFF if the second run does not end on the same frame, and the rewind memory use and capture times are printed to stderr.
+ * -trace profiles every run, writes the timeline of all of them to the given file as a Chrome trace, and prints a summary of each
+ *	profiled scope to stderr.  Scopes are only compiled in when the core is built with LSN_PROFILE defined.
+ */
+
+
+#include "LSNHeadless.h"
+#include "../Crc/LSNCrc.h"
+#include "../System/LSNRewind.h"
+#include "../Time/LSNClock.h"
+#include "../Utilities/LSNProfiler.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+int main( int _iArgC, char * _pcArgV[] ) {
+	using namespace lsn;
+
+	LSN_PPU_METRICS pmRegion = LSN_PM_UNKNOWN;
+	uint64_t ui64Frames = 60;
+	bool bCatchUp = false;
+	bool bFastLines = false;
+	bool bLineCheck = false;
+	bool bStateCheck = false;
+	bool bRewindCheck = false;
+	const char * pcTrace = nullptr;
+	std::vector<const char *> vRoms;
+	for ( int I = 1; I < _iArgC; ++I ) {
+		if ( std::strcmp( _pcArgV[I], "-region" ) == 0 && I + 1 < _iArgC ) {
+			pmRegion = CHeadless::RegionFromName( _pcArgV[++I] );
+			if ( pmRegion == LSN_PM_UNKNOWN ) {
+				std::fprintf( stderr, "Unknown region: %s\n", _pcArgV[I] );
+				return 1;
+			}
+		}
+		else if ( std::strcmp( _pcArgV[I], "-frames" ) == 0 && I + 1 < _iArgC ) {
+			ui64Frames = std::strtoull( _pcArgV[++I], nullptr, 10 );
+		}
+		else if ( std::strcmp( _pcArgV[I], "-catchup" ) == 0 ) {
+			bCatchUp = true;
+		}
+		else if ( std::strcmp( _pcArgV[I], "-fastlines" ) == 0 ) {
+			bCatchUp = true;
+			bFastLines = true;
+		}
+		else if ( std::strcmp( _pcArgV[I], "-linecheck" ) == 0 ) {
+			bCatchUp = true;
+			bFastLines = true;
+			bLineCheck = true;
+		}
+		else if ( std::strcmp( _pcArgV[I], "-statecheck" ) == 0 ) {
+			bStateCheck = true;
+		}
+		else if ( std::strcmp( _pcArgV[I], "-rewindcheck" ) == 0 ) {
+			bRewindCheck = true;
+		}
+		else if ( std::strcmp( _pcArgV[I], "-trace" ) == 0 && I + 1 < _iArgC ) {
+			pcTrace = _pcArgV[++I];
+		}
+		else {
+			vRoms.push_back( _pcArgV[I] );
+		}
+	}
+	if ( vRoms.empty() ) {
+		std::fprintf( stderr, "Usage: %s [-region ntsc|pal|dendy|palm|paln] [-frames N] [-catchup] [-fastlines] [-linecheck] [-statecheck] [-rewindcheck] [-trace <file>] <rom> [<rom> ...]\n", _iArgC ? _pcArgV[0] : "BeesNESHeadless" );
+		return 1;
+	}
+
+	if ( !CHeadless::Initialize() ) {
+		std::fprintf( stderr, "Failed to initialize.\n" );
+		return 1;
+	}
+
+	if ( pcTrace ) {
+		if ( !CProfiler::Compiled() ) {
+			std::fprintf( stderr, "Built without LSN_PROFILE; the trace will be empty.\n" );
+		}
+		CProfiler::Start();
+	}
+
+	int iFailures = 0;
+	CClock cClock;
+	for ( size_t I = 0; I < vRoms.size(); ++I ) {
+		LSN_ROM rRom;
+		if ( !CHeadless::LoadRomFile( reinterpret_cast<const char8_t *>(vRoms[I]), rRom ) ) {
+			std::printf( "LOADFAIL\t-\t-\t0\t00000000\t00000000\t0.000000\t%s\n", vRoms[I] );
+			++iFailures;
+			continue;
+		}
+		LSN_PPU_METRICS pmThisRegion = pmRegion;
+		if ( pmThisRegion == LSN_PM_UNKNOWN ) { pmThisRegion = rRom.riInfo.pmConsoleRegion; }
+		if ( pmThisRegion == LSN_PM_UNKNOWN ) { pmThisRegion = LSN_PM_NTSC; }
+
+		std::unique_ptr<CSystemBase> psbSystem = CHeadless::CreateSystem( pmThisRegion );
+		if ( !psbSystem ) {
+			std::printf( "SYSFAIL\t%s\t-\t0\t00000000\t00000000\t0.000000\t%s\n", CHeadless::RegionName( pmThisRegion ), vRoms[I] );
+			++iFailures;
+			continue;
+		}
+		uint32_t ui32PrgCrc = rRom.riInfo.ui32Crc;
+		uint16_t ui16Mapper = rRom.riInfo.ui16Mapper;
+		if ( !psbSystem->LoadRom( rRom ) ) {
+			std::printf( "ROMFAIL\t%s\t%u\t0\t%.8X\t00000000\t0.000000\t%s\n", CHeadless::RegionName( pmThisRegion ), ui16Mapper, ui32PrgCrc, vRoms[I] );
+			++iFailures;
+			continue;
+		}
+
+		// Render 6-bit palette indices so the frame hash does not depend on the palette.
+		CDisplayClient * pdcClient = psbSystem->GetDisplayClient();
+		std::vector<uint8_t> vFrame( size_t( pdcClient->DisplayWidth() ) * pdcClient->DisplayHeight() );
+		pdcClient->SetRenderTarget( vFrame.data(), pdcClient->DisplayWidth(), CDisplayClient::LSN_POF_6BIT_PALETTE, false );
+		psbSystem->SetCatchUp( bCatchUp );
+		psbSystem->SetFastScanlines( bFastLines );
+		psbSystem->ResetState( false );
+
+		// The -linecheck reference runs the same ROM with the default scheduling.
+		std::unique_ptr<CSystemBase> psbCheck;
+		std::vector<uint8_t> vCheckFrame;
+		uint64_t ui64LineDiff = 0;
+		if ( bLineCheck ) {
+			LSN_ROM rCheckRom;
+			psbCheck = CHeadless::CreateSystem( pmThisRegion );
+			if ( !psbCheck || !CHeadless::LoadRomFile( reinterpret_cast<const char8_t *>(vRoms[I]), rCheckRom ) || !psbCheck->LoadRom( rCheckRom ) ) {
+				std::printf( "SYSFAIL\t%s\t%u\t0\t%.8X\t00000000\t0.000000\t%s\n", CHeadless::RegionName( pmThisRegion ), ui16Mapper, ui32PrgCrc, vRoms[I] );
+				++iFailures;
+				continue;
+			}
+			CDisplayClient * pdcCheck = psbCheck->GetDisplayClient();
+			vCheckFrame.resize( vFrame.size() );
+			pdcCheck->SetRenderTarget( vCheckFrame.data(), pdcCheck->DisplayWidth(), CDisplayClient::LSN_POF_6BIT_PALETTE, false );
+			psbCheck->ResetState( false );
+		}
+
+		std::vector<uint8_t> vState;
+		CStream sState( vState );
+		double dSaveSeconds = 0.0;
+		CRewind rRewind;
+		uint64_t ui64CaptureTicks = 0, ui64CaptureMax = 0;
+		// Collecting after every frame keeps the profiler's per-thread rings from filling up.
+		auto RunFrame = [&]() {
+			psbSystem->RunFrame();
+			if ( psbCheck ) {
+				psbCheck->RunFrame();
+				if ( !ui64LineDiff && std::memcmp( vFrame.data(), vCheckFrame.data(), vFrame.size() ) != 0 ) {
+					ui64LineDiff = psbSystem->GetPpuFrameCount();
+				}
+			}
+			if ( pcTrace ) { CProfiler::Collect(); }
+		};
+		uint64_t ui64Start = cClock.GetRealTick();
+		while ( psbSystem->GetPpuFrameCount() < ui64Frames ) {
+			if ( bStateCheck && vState.empty() && psbSystem->GetPpuFrameCount() >= ui64Frames / 2 ) {
+				uint64_t ui64SaveStart = cClock.GetRealTick();
+				psbSystem->SaveState( sState );
+				dSaveSeconds = double( cClock.GetRealTick() - ui64SaveStart ) / double( cClock.GetResolution() );
+			}
+			RunFrame();
+			if ( bRewindCheck ) {
+				uint64_t ui64CaptureStart = cClock.GetRealTick();
+				rRewind.Capture( *psbSystem );
+				uint64_t ui64CaptureTime = cClock.GetRealTick() - ui64CaptureStart;
+				ui64CaptureTicks += ui64CaptureTime;
+				ui64CaptureMax = std::max( ui64CaptureMax, ui64CaptureTime );
+			}
+		}
+		double dSeconds = double( cClock.GetRealTick() - ui64Start ) / double( cClock.GetResolution() );
+		uint32_t ui32FrameCrc = CCrc::GetCrc( vFrame.data(), vFrame.size() );
+
+		psbCheck.reset();				// -statecheck and -rewindcheck rerun frames that the reference has already run.
+
+		const char * pcStatus = "OK";
+		if ( ui64LineDiff ) {
+			pcStatus = "LINEDIFF";
+			++iFailures;
+			std::fprintf( stderr, "Frame %llu differs from the default scheduling: %s\n", static_cast<unsigned long long>(ui64LineDiff), vRoms[I] );
+		}
+		if ( bStateCheck ) {
+			CStream sLoad( vState );
+			uint64_t ui64LoadStart = cClock.GetRealTick();
+			bool bLoaded = psbSystem->LoadState( sLoad );
+			double dLoadSeconds = double( cClock.GetRealTick() - ui64LoadStart ) / double( cClock.GetResolution() );
+			if ( bLoaded ) {
+				while ( psbSystem->GetPpuFrameCount() < ui64Frames ) {
+					RunFrame();
+				}
+			}
+			if ( !bLoaded || CCrc::GetCrc( vFrame.data(), vFrame.size() ) != ui32FrameCrc ) { pcStatus = "STATEDIFF"; }
+			std::fprintf( stderr, "State: %zu bytes, save %.1f us, load %.1f us: %s\n", vState.size(), dSaveSeconds * 1000000.0, dLoadSeconds * 1000000.0, vRoms[I] );
+		}
+		if ( bRewindCheck && rRewind.Frames() ) {
+			size_t sFrames = rRewind.Frames();
+			size_t sSize = rRewind.Size();
+			uint64_t ui64RewindStart = cClock.GetRealTick();
+			bool bRewound = rRewind.Rewind( *psbSystem, std::min<size_t>( sFrames - 1, size_t( ui64Frames / 3 ) ) );
+			double dRewindSeconds = double( cClock.GetRealTick() - ui64RewindStart ) / double( cClock.GetResolution() );
+			if ( bRewound ) {
+				while ( psbSystem->GetPpuFrameCount() < ui64Frames ) {
+					RunFrame();
+				}
+			}
+			if ( !bRewound || CCrc::GetCrc( vFrame.data(), vFrame.size() ) != ui32FrameCrc ) { pcStatus = "REWINDDIFF"; }
+			double dCaptures = double( ui64Frames ? ui64Frames : 1 );
+			std::fprintf( stderr, "Rewind: %zu frames in %zu bytes, capture avg %.1f us, max %.1f us, rewind %.1f us: %s\n", sFrames, sSize,
+				double( ui64CaptureTicks ) * 1000000.0 / double( cClock.GetResolution() ) / dCaptures,
+				double( ui64CaptureMax ) * 1000000.0 / double( cClock.GetResolution() ), dRewindSeconds * 1000000.0, vRoms[I] );
+		}
+
+		std::printf( "%s\t%s\t%u\t%llu\t%.8X\t%.8X\t%.6f\t%s\n", pcStatus, CHeadless::RegionName( pmThisRegion ), ui16Mapper,
+			static_cast<unsigned long long>(psbSystem->GetPpuFrameCount()), ui32PrgCrc,
+			ui32FrameCrc, dSeconds, vRoms[I] );
+	}
+
+	if ( pcTrace ) {
+		CProfiler::Stop();
+		CProfiler::Collect();
+		if ( !CProfiler::WriteChromeTrace( reinterpret_cast<const char8_t *>(pcTrace) ) ) {
+			std::fprintf( stderr, "Failed to write trace: %s\n", pcTrace );
+			++iFailures;
+		}
+		CProfiler::PrintSummary( stderr );
+	}
+
+	CHeadless::Shutdown();
+	return iFailures ? 2 : 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Command-line entry point for indexing a ROM library.  Scans the given folders (and the ZIP archives in them) for ROMs,
+ *	updates the index file, and prints what the scan did.
+ *
+ * Usage: BeesNESIndex [-index <file>] [-list] <folder> [<folder> ...]
+ * -index names the index file.  It is loaded before the scan, so only new and changed files are opened, and written after it.
+ * -list prints one tab-separated line per indexed ROM: PRG CRC, mapper, region, path.
+ * The scan results (files found, files opened, entries removed, ROMs indexed, seconds) are printed to stderr.
+ */
+
+
+#include "LSNHeadless.h"
+#include "../Roms/LSNRomIndex.h"
+#include "../Time/LSNClock.h"
+
+#include <cstdio>
+#include <cstring>
+
+int main( int _iArgC, char * _pcArgV[] ) {
+	using namespace lsn;
+
+	const char * pcIndex = nullptr;
+	bool bList = false;
+	std::vector<std::u16string> vFolders;
+	for ( int I = 1; I < _iArgC; ++I ) {
+		if ( std::strcmp( _pcArgV[I], "-index" ) == 0 && I + 1 < _iArgC ) {
+			pcIndex = _pcArgV[++I];
+		}
+		else if ( std::strcmp( _pcArgV[I], "-list" ) == 0 ) {
+			bList = true;
+		}
+		else {
+			vFolders.push_back( CUtilities::Utf8ToUtf16( reinterpret_cast<const char8_t *>(_pcArgV[I]) ) );
+		}
+	}
+	if ( vFolders.empty() ) {
+		std::fprintf( stderr, "Usage: %s [-index <file>] [-list] <folder> [<folder> ...]\n", _iArgC ? _pcArgV[0] : "BeesNESIndex" );
+		return 1;
+	}
+
+	if ( !CHeadless::Initialize() ) {
+		std::fprintf( stderr, "Failed to initialize.\n" );
+		return 1;
+	}
+
+	CRomIndex riIndex;
+	std::u16string u16Index;
+	CClock cClock;
+	uint64_t ui64Start = cClock.GetRealTick();
+	if ( pcIndex ) {
+		u16Index = CUtilities::Utf8ToUtf16( reinterpret_cast<const char8_t *>(pcIndex) );
+		// A missing or unreadable index just means every file is opened.
+		riIndex.Load( u16Index.c_str() );
+	}
+	CRomIndex::LSN_SCAN_STATS ssStats;
+	bool bScanned = riIndex.Scan( vFolders, &ssStats );
+	double dSeconds = double( cClock.GetRealTick() - ui64Start ) / double( cClock.GetResolution() );
+	int iRet = 0;
+	if ( !bScanned ) {
+		std::fprintf( stderr, "Scan failed.\n" );
+		iRet = 2;
+	}
+	else if ( pcIndex && !riIndex.Save( u16Index.c_str() ) ) {
+		std::fprintf( stderr, "Failed to write %s.\n", pcIndex );
+		iRet = 2;
+	}
+
+	if ( bList ) {
+		for ( const auto & eEntry : riIndex.Entries() ) {
+			if ( !eEntry.bRom ) { continue; }
+			std::printf( "%.8X\t%u\t%s\t%s\n", eEntry.ui32Crc, eEntry.ui16Mapper, CHeadless::RegionName( eEntry.pmRegion ),
+				reinterpret_cast<const char *>(CUtilities::Utf16ToUtf8( eEntry.u16Path.c_str() ).c_str()) );
+		}
+	}
+	std::fprintf( stderr, "Files: %zu\tOpened: %zu\tRemoved: %zu\tROMs: %zu\tSeconds: %.6f\n",
+		ssStats.sFiles, ssStats.sOpened, ssStats.sRemoved, ssStats.sRoms, dSeconds );
+
+	CHeadless::Shutdown();
+	return iRet;
+}
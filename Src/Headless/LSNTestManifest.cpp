@@ -0,0 +1,224 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A test-ROM manifest in the test_roms.xml format: each test names a ROM, the system and number of frames to run it,
+ *	the input to give it, and the SHA-1 of the frame it should end on.
+ */
+
+
+#include "LSNTestManifest.h"
+#include "../File/LSNStdFile.h"
+#include "../Input/LSNInputPoller.h"
+#include "../Utilities/LSNUtilities.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace lsn {
+
+	// == Functions.
+	/**
+	 * Loads a manifest.
+	 *
+	 * \param _pcPath The UTF-8 path to the manifest.
+	 * \return Returns true if the file was read and every <test> element in it was parsed.
+	 */
+	bool CTestManifest::Load( const char8_t * _pcPath ) {
+		m_vTests.clear();
+		std::vector<uint8_t> vFile;
+		if ( !CStdFile::LoadToMemory( _pcPath, vFile ) ) { return false; }
+		try {
+			std::string sFile( vFile.begin(), vFile.end() );
+			std::vector<LSN_TEST> vTests;
+			size_t sPos = 0;
+			while ( (sPos = sFile.find( "<test ", sPos )) != std::string::npos ) {
+				size_t sTagEnd = sFile.find( '>', sPos );
+				if ( sTagEnd == std::string::npos ) { return false; }
+				size_t sEnd = sFile.find( "</test>", sTagEnd );
+				if ( sEnd == std::string::npos ) { return false; }
+				std::string sTag = sFile.substr( sPos, sTagEnd - sPos + 1 );
+				std::string sBody = sFile.substr( sTagEnd + 1, sEnd - sTagEnd - 1 );
+				sPos = sEnd;
+
+				LSN_TEST tTest;
+				std::string sFrames, sResultAddr;
+				if ( !Attribute( sTag, "filename", tTest.sFile ) ) { return false; }
+				if ( !Attribute( sTag, "runframes", sFrames ) ) { return false; }
+				if ( !Attribute( sTag, "system", tTest.sSystem ) ) { tTest.sSystem = "ntsc"; }
+				Attribute( sTag, "testnotes", tTest.sTestNotes );
+				Attribute( sTag, "failcomment", tTest.sFailComment );
+				Attribute( sTag, "testresult", tTest.sTestResult );
+				tTest.ui32RunFrames = uint32_t( std::strtoul( sFrames.c_str(), nullptr, 10 ) );
+				if ( Attribute( sTag, "resultaddr", sResultAddr ) && sResultAddr.size() > 1 && sResultAddr[0] == '$' ) {
+					tTest.i32ResultAddr = int32_t( std::strtoul( sResultAddr.c_str() + 1, nullptr, 16 ) & 0xFFFF );
+				}
+				ChildText( sBody, "tvsha1", tTest.sTvSha1 );
+				ChildText( sBody, "recordedinput", tTest.sRecordedInput );
+				if ( !DecodeInput( tTest.sRecordedInput, tTest.vInput ) ) { return false; }
+				vTests.push_back( std::move( tTest ) );
+			}
+			m_vTests = std::move( vTests );
+			return true;
+		}
+		catch ( ... ) { return false; }
+	}
+
+	/**
+	 * Writes the manifest.
+	 *
+	 * \param _pcPath The UTF-8 path to which to write the manifest.
+	 * \return Returns true if the file was written.
+	 */
+	bool CTestManifest::Save( const char8_t * _pcPath ) const {
+		try {
+			std::string sFile = "<?xml version='1.0' encoding='UTF-8'?>\n<testsuite>\n";
+			for ( const auto & tTest : m_vTests ) {
+				sFile += " <test testnotes=\"" + Escape( tTest.sTestNotes ) +
+					"\" filename=\"" + Escape( tTest.sFile ) +
+					"\" system=\"" + Escape( tTest.sSystem ) +
+					"\" failcomment=\"" + Escape( tTest.sFailComment ) +
+					"\" runframes=\"" + std::to_string( tTest.ui32RunFrames ) +
+					"\" testresult=\"" + Escape( tTest.sTestResult ) + "\"";
+				if ( tTest.i32ResultAddr >= 0 ) {
+					char szAddr[8];
+					std::snprintf( szAddr, sizeof( szAddr ), "$%.2X", unsigned( tTest.i32ResultAddr ) );
+					sFile += std::string( " resultaddr=\"" ) + szAddr + "\"";
+				}
+				sFile += ">\n";
+				sFile += "  <tvsha1><![CDATA[" + tTest.sTvSha1 + "]]></tvsha1>\n";
+				sFile += "  <recordedinput><![CDATA[" + tTest.sRecordedInput + "]]></recordedinput>\n";
+				sFile += " </test>\n";
+			}
+			sFile += "</testsuite>\n";
+			return CStdFile::WriteToFile( _pcPath, reinterpret_cast<const uint8_t *>(sFile.data()), sFile.size() );
+		}
+		catch ( ... ) { return false; }
+	}
+
+	/**
+	 * Gets an attribute of an element.
+	 *
+	 * \param _sTag The element's start tag, from '<' to '>'.
+	 * \param _pcName The name of the attribute.
+	 * \param _sValue Holds the attribute's value with entities replaced.
+	 * \return Returns true if the tag has the attribute.
+	 */
+	bool CTestManifest::Attribute( const std::string &_sTag, const char * _pcName, std::string &_sValue ) {
+		std::string sKey = std::string( " " ) + _pcName + "=";
+		size_t sPos = _sTag.find( sKey );
+		if ( sPos == std::string::npos ) { return false; }
+		sPos += sKey.size();
+		if ( sPos >= _sTag.size() || (_sTag[sPos] != '"' && _sTag[sPos] != '\'') ) { return false; }
+		size_t sEnd = _sTag.find( _sTag[sPos], sPos + 1 );
+		if ( sEnd == std::string::npos ) { return false; }
+
+		_sValue.clear();
+		static const struct {
+			const char *									pcEntity;
+			char											cChar;
+		} sEntities[] = {
+			{ "&amp;", '&' },
+			{ "&lt;", '<' },
+			{ "&gt;", '>' },
+			{ "&quot;", '"' },
+			{ "&apos;", '\'' },
+		};
+		for ( size_t I = sPos + 1; I < sEnd; ++I ) {
+			char cChar = _sTag[I];
+			if ( cChar == '&' ) {
+				for ( const auto & eEntity : sEntities ) {
+					size_t sLen = std::strlen( eEntity.pcEntity );
+					if ( _sTag.compare( I, sLen, eEntity.pcEntity ) == 0 ) {
+						cChar = eEntity.cChar;
+						I += sLen - 1;
+						break;
+					}
+				}
+			}
+			_sValue.push_back( cChar );
+		}
+		return true;
+	}
+
+	/**
+	 * Gets the text of a child element, unwrapping CDATA.
+	 *
+	 * \param _sBody The body of the parent element.
+	 * \param _pcName The name of the child element.
+	 * \param _sText Holds the text of the child element.
+	 * \return Returns true if the child element was found.
+	 */
+	bool CTestManifest::ChildText( const std::string &_sBody, const char * _pcName, std::string &_sText ) {
+		std::string sOpen = std::string( "<" ) + _pcName + ">";
+		std::string sClose = std::string( "</" ) + _pcName + ">";
+		size_t sPos = _sBody.find( sOpen );
+		if ( sPos == std::string::npos ) { return false; }
+		sPos += sOpen.size();
+		size_t sEnd = _sBody.find( sClose, sPos );
+		if ( sEnd == std::string::npos ) { return false; }
+		_sText = _sBody.substr( sPos, sEnd - sPos );
+
+		const char szCdataOpen[] = "<![CDATA[";
+		const char szCdataClose[] = "]]>";
+		if ( _sText.compare( 0, sizeof( szCdataOpen ) - 1, szCdataOpen ) == 0 && _sText.size() >= sizeof( szCdataOpen ) - 1 + sizeof( szCdataClose ) - 1 &&
+			_sText.compare( _sText.size() - (sizeof( szCdataClose ) - 1), sizeof( szCdataClose ) - 1, szCdataClose ) == 0 ) {
+			_sText = _sText.substr( sizeof( szCdataOpen ) - 1, _sText.size() - (sizeof( szCdataOpen ) - 1) - (sizeof( szCdataClose ) - 1) );
+		}
+		return true;
+	}
+
+	/**
+	 * Replaces characters that cannot appear in attribute values with entities.
+	 *
+	 * \param _sText The text to escape.
+	 * \return Returns the escaped text.
+	 */
+	std::string CTestManifest::Escape( const std::string &_sText ) {
+		std::string sRet;
+		for ( char cChar : _sText ) {
+			switch ( cChar ) {
+				case '&' : { sRet += "&amp;"; break; }
+				case '<' : { sRet += "&lt;"; break; }
+				case '>' : { sRet += "&gt;"; break; }
+				case '"' : { sRet += "&quot;"; break; }
+				default : { sRet.push_back( cChar ); }
+			}
+		}
+		return sRet;
+	}
+
+	/**
+	 * Decodes recorded input.
+	 *
+	 * \param _sText The base-64 recorded input.
+	 * \param _vInput Holds the changes of buttons.
+	 * \return Returns true if the input could be decoded.
+	 */
+	bool CTestManifest::DecodeInput( const std::string &_sText, std::vector<LSN_INPUT_EVENT> &_vInput ) {
+		_vInput.clear();
+		std::vector<uint8_t> vData;
+		if ( !CUtilities::Base64Decode( _sText, vData ) ) { return false; }
+		// Records are 5 bytes after the 4-byte header.  A trailing partial record is ignored.
+		uint8_t ui8Last = 0;
+		for ( size_t I = 4; I + 5 <= vData.size(); I += 5 ) {
+			// The manifest shifts A out first from bit 0; LSN_INPUT_BITS shifts it out first from bit 7.
+			uint8_t ui8Buttons = 0;
+			for ( uint32_t J = 0; J < 8; ++J ) {
+				if ( vData[I] & (1 << J) ) { ui8Buttons |= uint8_t( LSN_IB_A >> J ); }
+			}
+			uint64_t ui64Cycle = uint64_t( vData[I+1] ) | (uint64_t( vData[I+2] ) << 8) | (uint64_t( vData[I+3] ) << 16) | (uint64_t( vData[I+4] ) << 24);
+			// Only changes are kept.
+			if ( !_vInput.empty() && ui8Buttons == ui8Last ) { continue; }
+			_vInput.push_back( { ui64Cycle, ui8Buttons } );
+			ui8Last = ui8Buttons;
+		}
+		std::stable_sort( _vInput.begin(), _vInput.end(), []( const LSN_INPUT_EVENT &_ieA, const LSN_INPUT_EVENT &_ieB ) { return _ieA.ui64Cycle < _ieB.ui64Cycle; } );
+		return true;
+	}
+
+}	// namespace lsn
@@ -0,0 +1,136 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A test-ROM manifest in the test_roms.xml format: each test names a ROM, the system and number of frames to run it,
+ *	the input to give it, and the SHA-1 of the frame it should end on.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+
+#include <string>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CTestManifest
+	 * \brief A test-ROM manifest in the test_roms.xml format.
+	 *
+	 * Description: A test-ROM manifest in the test_roms.xml format: each test names a ROM, the system and number of frames to run it,
+	 *	the input to give it, and the SHA-1 of the frame it should end on.
+	 * Each <test> element has testnotes, filename, system, failcomment, runframes, and testresult attributes, a <tvsha1> element
+	 *	holding the base-64 SHA-1 of the final frame, and a <recordedinput> element holding base-64 controller input.  An optional
+	 *	resultaddr attribute ("$F8") names the CPU address at which a ROM that predates the $6000 status block leaves its result
+	 *	code (1 for passed).  Decoded, the input is a 4-byte header followed by 5-byte records: the controller-1 buttons (A in bit 0
+	 *	through Right in bit 7) and the little-endian CPU cycle from which they are held.
+	 * Only the parts of XML that such manifests use are supported.  Save() writes the same layout back out, so a manifest can be
+	 *	re-recorded with new hashes.
+	 */
+	class CTestManifest {
+	public :
+		// == Types.
+		/** A change of buttons in recorded input. */
+		struct LSN_INPUT_EVENT {
+			uint64_t										ui64Cycle;										/**< The CPU cycle from which the buttons are held. */
+			uint8_t											ui8Buttons;										/**< The held buttons as LSN_INPUT_BITS. */
+		};
+
+		/** A test. */
+		struct LSN_TEST {
+			std::string										sFile;											/**< The ROM path, relative to the manifest. */
+			std::string										sSystem;										/**< The system ("ntsc" or "pal"). */
+			std::string										sTestNotes;										/**< Free-form notes. */
+			std::string										sFailComment;									/**< What the ROM reported when it was recorded. */
+			std::string										sTestResult;									/**< The recorded verdict ("pass" or "fail"). */
+			std::string										sTvSha1;										/**< The base-64 SHA-1 of the final frame. */
+			std::string										sRecordedInput;									/**< The base-64 recorded input, kept so Save() can write it back. */
+			std::vector<LSN_INPUT_EVENT>					vInput;											/**< The decoded input, sorted by cycle. */
+			uint32_t										ui32RunFrames = 0;								/**< The number of frames to run. */
+			int32_t											i32ResultAddr = -1;								/**< The address of the result code, or -1 if the ROM has none there. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Loads a manifest.
+		 *
+		 * \param _pcPath The UTF-8 path to the manifest.
+		 * \return Returns true if the file was read and every <test> element in it was parsed.
+		 */
+		bool												Load( const char8_t * _pcPath );
+
+		/**
+		 * Writes the manifest.
+		 *
+		 * \param _pcPath The UTF-8 path to which to write the manifest.
+		 * \return Returns true if the file was written.
+		 */
+		bool												Save( const char8_t * _pcPath ) const;
+
+		/**
+		 * Gets the tests in the order in which they appear in the manifest.
+		 *
+		 * \return Returns the tests.
+		 */
+		inline std::vector<LSN_TEST> &						Tests() { return m_vTests; }
+
+		/**
+		 * Gets the tests in the order in which they appear in the manifest.
+		 *
+		 * \return Returns the tests.
+		 */
+		inline const std::vector<LSN_TEST> &				Tests() const { return m_vTests; }
+
+
+	protected :
+		// == Members.
+		/** The tests. */
+		std::vector<LSN_TEST>								m_vTests;
+
+
+		// == Functions.
+		/**
+		 * Gets an attribute of an element.
+		 *
+		 * \param _sTag The element's start tag, from '<' to '>'.
+		 * \param _pcName The name of the attribute.
+		 * \param _sValue Holds the attribute's value with entities replaced.
+		 * \return Returns true if the tag has the attribute.
+		 */
+		static bool											Attribute( const std::string &_sTag, const char * _pcName, std::string &_sValue );
+
+		/**
+		 * Gets the text of a child element, unwrapping CDATA.
+		 *
+		 * \param _sBody The body of the parent element.
+		 * \param _pcName The name of the child element.
+		 * \param _sText Holds the text of the child element.
+		 * \return Returns true if the child element was found.
+		 */
+		static bool											ChildText( const std::string &_sBody, const char * _pcName, std::string &_sText );
+
+		/**
+		 * Replaces characters that cannot appear in attribute values with entities.
+		 *
+		 * \param _sText The text to escape.
+		 * \return Returns the escaped text.
+		 */
+		static std::string									Escape( const std::string &_sText );
+
+		/**
+		 * Decodes recorded input.
+		 *
+		 * \param _sText The base-64 recorded input.
+		 * \param _vInput Holds the changes of buttons.
+		 * \return Returns true if the input could be decoded.
+		 */
+		static bool											DecodeInput( const std::string &_sText, std::vector<LSN_INPUT_EVENT> &_vInput );
+	};
+
+}	// namespace lsn
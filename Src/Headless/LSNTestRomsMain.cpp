@@ -0,0 +1,334 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Command-line entry point for test-ROM conformance sweeps.  Loads a test_roms.xml manifest, runs every test in it on its
+ *	own system across the job pool, and prints one tab-separated result line per test in manifest order.
+ *
+ * Usage: BeesNESTestRoms [-catchup] [-fastlines] [-only <text>] [-write <file>] [<test_roms.xml>]
+ * With no manifest, the one named by LSN_TEST_ROMS_MANIFEST is used.  The build points it at
+ *	Research/nes-test-roms-master/test_roms_beesnes.xml, which holds the verdicts this emulator is known to get (the verdicts
+ *	of test_roms.xml where it agrees with them), the result addresses of the older ROMs, and the hashes of this emulator's frames.
+ * ROM paths are relative to the folder holding the manifest.  A ROM that is not found is looked for again ignoring case, since
+ *	manifests recorded on Windows do not always match the case of the files.
+ * Each test runs for its runframes frames with its recorded input on controller 1.  The status comes from the ROM's own verdict:
+ *	the status byte at $6000 for ROMs that write the $6000 status block (pressing reset when the ROM asks for it with $81), or the
+ *	result code at the test's resultaddr for older ROMs (1 for passed).  ROMs that report neither way are NOVERDICT.  The text a
+ *	failing ROM writes at $6004 is printed to stderr.
+ * Separately, the SHA-1 of the final frame (the 6-bit palette index of each pixel, as BeesNESHeadless hashes) is compared against
+ *	the test's tvsha1 as a regression check: MATCH, DIFF, or - when the test has no hash.  It does not affect the status.
+ * Output columns: status (PASS, FAIL, NOVERDICT, LOADFAIL, SYSFAIL, or ROMFAIL), regression, region, frames, recorded verdict,
+ *	final-frame SHA-1, seconds, path.
+ * The exit code is 2 if a test fails that the manifest records as "pass", or if a test could not be run.  Tests that the manifest
+ *	records as "fail" are still reported as FAIL but do not change the exit code.
+ * -catchup and -fastlines select the scheduling, as with BeesNESHeadless.  -only runs just the tests whose paths contain the text.
+ * -write writes the manifest back out with the hashes of this run, keeping the old hashes of tests that did not run.  Manifests
+ *	recorded by other emulators (such as test_roms.xml) hash their own video output, so every test is a DIFF against them.  The
+ *	regression baseline is written by -write, and later sweeps are compared against it.
+ * The totals (tests, passes, failures, tests without a verdict, errors, matches, differences, threads, wall seconds, and summed
+ *	emulation seconds) are printed to stderr.
+ */
+
+
+#include "LSNHeadless.h"
+#include "LSNTestManifest.h"
+#include "../Crc/LSNSha1.h"
+#include "../Time/LSNClock.h"
+#include "../Utilities/LSNJobPool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+
+namespace lsn {
+
+	/**
+	 * Class CRecordedInput
+	 * \brief Plays recorded input into controller 1.
+	 *
+	 * Description: Plays recorded input into controller 1.  Each poll returns the buttons of the last change at or before the CPU
+	 *	cycle the system has reached.
+	 */
+	class CRecordedInput : public CInputPoller {
+	public :
+		CRecordedInput( const std::vector<CTestManifest::LSN_INPUT_EVENT> &_vInput, const CSystemBase &_sbSystem ) :
+			m_vInput( _vInput ),
+			m_sbSystem( _sbSystem ) {
+		}
+
+
+		// == Functions.
+		/**
+		 * Polls the given port and returns a byte containing the result of polling by combining the LSN_INPUT_BITS values.
+		 *
+		 * \param _ui8Port The port being polled (0 or 1).
+		 * \return Returns the result of polling the given port.
+		 */
+		virtual uint8_t									PollPort( uint8_t _ui8Port ) {
+			if ( _ui8Port != 0 ) { return 0; }
+			uint64_t ui64Cycle = m_sbSystem.GetMasterCounter() / m_sbSystem.GetCpuDiv();
+			while ( m_sNext < m_vInput.size() && m_vInput[m_sNext].ui64Cycle <= ui64Cycle ) {
+				m_ui8Buttons = m_vInput[m_sNext++].ui8Buttons;
+			}
+			return m_ui8Buttons;
+		}
+
+
+	protected :
+		// == Members.
+		/** The changes of buttons. */
+		const std::vector<CTestManifest::LSN_INPUT_EVENT> &
+														m_vInput;
+		/** The system being driven. */
+		const CSystemBase &								m_sbSystem;
+		/** The next change to apply. */
+		size_t											m_sNext = 0;
+		/** The held buttons. */
+		uint8_t											m_ui8Buttons = 0;
+	};
+
+	/** The result of a test. */
+	struct LSN_TEST_RUN {
+		CTestManifest::LSN_TEST *						ptTest = nullptr;									/**< The test. */
+		const char *									pcStatus = "SKIPPED";								/**< The status column. */
+		const char *									pcRegression = "-";									/**< The regression column. */
+		std::string										sText;												/**< What a failing ROM reported. */
+		LSN_PPU_METRICS									pmRegion = LSN_PM_NTSC;								/**< The region on which the test ran. */
+		uint64_t										ui64Frames = 0;										/**< The frames run. */
+		std::string										sSha1;												/**< The base-64 SHA-1 of the final frame. */
+		double											dSeconds = 0.0;										/**< The time taken. */
+	};
+
+	/** The tests shared by the jobs. */
+	struct LSN_TEST_JOBS {
+		std::filesystem::path							pRoot;												/**< The folder holding the manifest. */
+		std::vector<LSN_TEST_RUN>						vRuns;												/**< The tests to run. */
+		std::vector<size_t>								vOrder;												/**< The order in which to start the tests, longest first. */
+		bool											bCatchUp = false;									/**< If true, catch-up scheduling is used. */
+		bool											bFastLines = false;									/**< If true, whole scanlines are run at once during catch-up. */
+	};
+
+	/**
+	 * Finds a file, ignoring the case of its name if it is not found as given.
+	 *
+	 * \param _pPath The path to the file.
+	 * \return Returns the path to the file, or _pPath if no file matches.
+	 */
+	static std::filesystem::path						FindFile( const std::filesystem::path &_pPath ) {
+		std::error_code ecError;
+		if ( std::filesystem::exists( _pPath, ecError ) ) { return _pPath; }
+		std::u16string u16Name = CUtilities::ToLower( _pPath.filename().u16string() );
+		for ( const auto & deEntry : std::filesystem::directory_iterator( _pPath.parent_path(), ecError ) ) {
+			if ( CUtilities::ToLower( deEntry.path().filename().u16string() ) == u16Name ) { return deEntry.path(); }
+		}
+		return _pPath;
+	}
+
+	/**
+	 * Determines whether a ROM has written the $6000 status block, whose signature is $DE $B0 $61 at $6001-$6003.
+	 *
+	 * \param _sbSystem The system running the ROM.
+	 * \return Returns true if the signature is at $6001.
+	 */
+	static bool											HasStatusBlock( CSystemBase &_sbSystem ) {
+		return _sbSystem.InspectCpuBus( 0x6001 ) == 0xDE && _sbSystem.InspectCpuBus( 0x6002 ) == 0xB0 && _sbSystem.InspectCpuBus( 0x6003 ) == 0x61;
+	}
+
+	/**
+	 * Runs a test on its own system.  Runs on the job pool.
+	 *
+	 * \param _pvParm A pointer to the LSN_TEST_JOBS.
+	 * \param _sIdx The index into LSN_TEST_JOBS::vOrder of the test to run.
+	 */
+	static void											RunTest( void * _pvParm, size_t _sIdx ) {
+		LSN_TEST_JOBS * ptjJobs = static_cast<LSN_TEST_JOBS *>(_pvParm);
+		LSN_TEST_RUN & trRun = ptjJobs->vRuns[ptjJobs->vOrder[_sIdx]];
+		const CTestManifest::LSN_TEST & tTest = (*trRun.ptTest);
+		try {
+			std::filesystem::path pRom = FindFile( ptjJobs->pRoot / std::filesystem::path( reinterpret_cast<const char8_t *>(tTest.sFile.c_str()) ) );
+			LSN_ROM rRom;
+			if ( !CHeadless::LoadRomFile( pRom.u8string().c_str(), rRom ) ) {
+				trRun.pcStatus = "LOADFAIL";
+				return;
+			}
+			trRun.pmRegion = CHeadless::RegionFromName( tTest.sSystem.c_str() );
+			if ( trRun.pmRegion == LSN_PM_UNKNOWN ) { trRun.pmRegion = LSN_PM_NTSC; }
+			std::unique_ptr<CSystemBase> psbSystem = CHeadless::CreateSystem( trRun.pmRegion );
+			if ( !psbSystem ) {
+				trRun.pcStatus = "SYSFAIL";
+				return;
+			}
+			if ( !psbSystem->LoadRom( rRom ) ) {
+				trRun.pcStatus = "ROMFAIL";
+				return;
+			}
+
+			CDisplayClient * pdcClient = psbSystem->GetDisplayClient();
+			std::vector<uint8_t> vFrame( size_t( pdcClient->DisplayWidth() ) * pdcClient->DisplayHeight() );
+			pdcClient->SetRenderTarget( vFrame.data(), pdcClient->DisplayWidth(), CDisplayClient::LSN_POF_6BIT_PALETTE, false );
+			// Systems on other threads share the audio device, so no system sends it samples.
+			LSN_AUDIO_OPTIONS aoAudio;
+			aoAudio.bEnabled = false;
+			psbSystem->SetAudioOptions( aoAudio );
+			CRecordedInput riInput( tTest.vInput, *psbSystem );
+			psbSystem->SetInputPoller( &riInput );
+			psbSystem->SetCatchUp( ptjJobs->bCatchUp );
+			psbSystem->SetFastScanlines( ptjJobs->bFastLines );
+			psbSystem->ResetState( false );
+
+			CClock cClock;
+			uint64_t ui64Start = cClock.GetRealTick();
+			// Frames are counted here because pressing reset restarts the PPU's count.
+			uint32_t ui32ResetFrame = 0;
+			for ( uint32_t I = 0; I < tTest.ui32RunFrames; ++I ) {
+				psbSystem->RunFrame();
+				// A ROM asks for reset with $81 and wants it at least 100 milliseconds later.
+				if ( HasStatusBlock( (*psbSystem) ) && psbSystem->InspectCpuBus( 0x6000 ) == 0x81 ) {
+					if ( !ui32ResetFrame ) { ui32ResetFrame = I + 7; }
+					else if ( I >= ui32ResetFrame ) {
+						ui32ResetFrame = 0;
+						psbSystem->ResetState( true );
+					}
+				}
+			}
+			trRun.dSeconds = double( cClock.GetRealTick() - ui64Start ) / double( cClock.GetResolution() );
+			trRun.ui64Frames = tTest.ui32RunFrames;
+			psbSystem->SetInputPoller( nullptr );
+
+			CSha1::LSN_DIGEST dDigest = CSha1::GetSha1( vFrame.data(), vFrame.size() );
+			trRun.sSha1 = CUtilities::Base64Encode( dDigest.data(), dDigest.size() );
+			if ( !tTest.sTvSha1.empty() ) {
+				trRun.pcRegression = trRun.sSha1 == tTest.sTvSha1 ? "MATCH" : "DIFF";
+			}
+
+			if ( HasStatusBlock( (*psbSystem) ) ) {
+				uint8_t ui8Status = psbSystem->InspectCpuBus( 0x6000 );
+				for ( uint16_t J = 0x6004; J < 0x8000; ++J ) {
+					char cChar = char( psbSystem->InspectCpuBus( J ) );
+					if ( !cChar ) { break; }
+					trRun.sText.push_back( cChar );
+				}
+				if ( ui8Status >= 0x80 ) {
+					char szStatus[64];
+					std::snprintf( szStatus, sizeof( szStatus ), "Status $%.2X after %u frames.\n", ui8Status, tTest.ui32RunFrames );
+					trRun.sText = szStatus + trRun.sText;
+				}
+				trRun.pcStatus = ui8Status == 0x00 ? "PASS" : "FAIL";
+			}
+			else if ( tTest.i32ResultAddr >= 0 ) {
+				uint8_t ui8Result = psbSystem->InspectCpuBus( uint16_t( tTest.i32ResultAddr ) );
+				trRun.pcStatus = ui8Result == 1 ? "PASS" : "FAIL";
+				trRun.sText = "Result code " + std::to_string( ui8Result ) + ".";
+			}
+			else {
+				trRun.pcStatus = "NOVERDICT";
+			}
+		}
+		catch ( ... ) {
+			trRun.pcStatus = "SYSFAIL";
+		}
+	}
+
+}	// namespace lsn
+
+int main( int _iArgC, char * _pcArgV[] ) {
+	using namespace lsn;
+
+	LSN_TEST_JOBS tjJobs;
+	const char * pcManifest = nullptr;
+	const char * pcWrite = nullptr;
+	const char * pcOnly = nullptr;
+	for ( int I = 1; I < _iArgC; ++I ) {
+		if ( std::strcmp( _pcArgV[I], "-catchup" ) == 0 ) {
+			tjJobs.bCatchUp = true;
+		}
+		else if ( std::strcmp( _pcArgV[I], "-fastlines" ) == 0 ) {
+			tjJobs.bCatchUp = true;
+			tjJobs.bFastLines = true;
+		}
+		else if ( std::strcmp( _pcArgV[I], "-only" ) == 0 && I + 1 < _iArgC ) {
+			pcOnly = _pcArgV[++I];
+		}
+		else if ( std::strcmp( _pcArgV[I], "-write" ) == 0 && I + 1 < _iArgC ) {
+			pcWrite = _pcArgV[++I];
+		}
+		else {
+			pcManifest = _pcArgV[I];
+		}
+	}
+#ifdef LSN_TEST_ROMS_MANIFEST
+	if ( !pcManifest ) {
+		pcManifest = LSN_TEST_ROMS_MANIFEST;
+	}
+#endif	// #ifdef LSN_TEST_ROMS_MANIFEST
+	if ( !pcManifest ) {
+		std::fprintf( stderr, "Usage: %s [-catchup] [-fastlines] [-only <text>] [-write <file>] [<test_roms.xml>]\n", _iArgC ? _pcArgV[0] : "BeesNESTestRoms" );
+		return 1;
+	}
+
+	CTestManifest tmManifest;
+	if ( !tmManifest.Load( reinterpret_cast<const char8_t *>(pcManifest) ) ) {
+		std::fprintf( stderr, "Failed to load %s.\n", pcManifest );
+		return 1;
+	}
+	if ( !CHeadless::Initialize() ) {
+		std::fprintf( stderr, "Failed to initialize.\n" );
+		return 1;
+	}
+
+	tjJobs.pRoot = std::filesystem::path( reinterpret_cast<const char8_t *>(pcManifest) ).parent_path();
+	for ( auto & tTest : tmManifest.Tests() ) {
+		if ( pcOnly && tTest.sFile.find( pcOnly ) == std::string::npos ) { continue; }
+		LSN_TEST_RUN trRun;
+		trRun.ptTest = &tTest;
+		tjJobs.vRuns.push_back( trRun );
+	}
+	// Starting the longest tests first keeps one long test from running alone at the end.
+	for ( size_t I = 0; I < tjJobs.vRuns.size(); ++I ) {
+		tjJobs.vOrder.push_back( I );
+	}
+	std::stable_sort( tjJobs.vOrder.begin(), tjJobs.vOrder.end(), [&]( size_t _sA, size_t _sB ) {
+		return tjJobs.vRuns[_sA].ptTest->ui32RunFrames > tjJobs.vRuns[_sB].ptTest->ui32RunFrames;
+	} );
+
+	CClock cClock;
+	uint64_t ui64Start = cClock.GetRealTick();
+	CJobPool::Get().ParallelFor( RunTest, &tjJobs, tjJobs.vOrder.size() );
+	double dWall = double( cClock.GetRealTick() - ui64Start ) / double( cClock.GetResolution() );
+
+	size_t sPassed = 0, sFailed = 0, sUnexpected = 0, sNoVerdict = 0, sErrors = 0, sMatched = 0, sDiffered = 0;
+	double dEmulation = 0.0;
+	for ( const auto & trRun : tjJobs.vRuns ) {
+		if ( std::strcmp( trRun.pcStatus, "PASS" ) == 0 ) { ++sPassed; }
+		else if ( std::strcmp( trRun.pcStatus, "FAIL" ) == 0 ) {
+			++sFailed;
+			// Only failures of tests recorded as passing are regressions; the others are known.
+			if ( trRun.ptTest->sTestResult == "pass" ) { ++sUnexpected; }
+			std::fprintf( stderr, "%s: %s\n", trRun.ptTest->sFile.c_str(), trRun.sText.c_str() );
+		}
+		else if ( std::strcmp( trRun.pcStatus, "NOVERDICT" ) == 0 ) { ++sNoVerdict; }
+		else { ++sErrors; }
+		if ( std::strcmp( trRun.pcRegression, "MATCH" ) == 0 ) { ++sMatched; }
+		else if ( std::strcmp( trRun.pcRegression, "DIFF" ) == 0 ) { ++sDiffered; }
+		dEmulation += trRun.dSeconds;
+		std::printf( "%s\t%s\t%s\t%llu\t%s\t%s\t%.6f\t%s\n", trRun.pcStatus, trRun.pcRegression, CHeadless::RegionName( trRun.pmRegion ),
+			static_cast<unsigned long long>(trRun.ui64Frames), trRun.ptTest->sTestResult.empty() ? "-" : trRun.ptTest->sTestResult.c_str(),
+			trRun.sSha1.empty() ? "-" : trRun.sSha1.c_str(), trRun.dSeconds, trRun.ptTest->sFile.c_str() );
+		if ( !trRun.sSha1.empty() ) { trRun.ptTest->sTvSha1 = trRun.sSha1; }
+	}
+	std::fprintf( stderr, "Tests: %zu\tPassed: %zu\tFailed: %zu (%zu recorded as passing)\tNo verdict: %zu\tErrors: %zu\tMatched: %zu\tDiffered: %zu\tThreads: %zu\tSeconds: %.6f\tEmulation seconds: %.6f\n",
+		tjJobs.vRuns.size(), sPassed, sFailed, sUnexpected, sNoVerdict, sErrors, sMatched, sDiffered, CJobPool::Get().Threads(), dWall, dEmulation );
+
+	int iRet = (sUnexpected || sErrors) ? 2 : 0;
+	if ( pcWrite && !tmManifest.Save( reinterpret_cast<const char8_t *>(pcWrite) ) ) {
+		std::fprintf( stderr, "Failed to write %s.\n", pcWrite );
+		iRet = 2;
+	}
+
+	CHeadless::Shutdown();
+	return iRet;
+}
@@ -47,6 +47,11 @@ namespace lsn {
 		 */
 		virtual void									ApplyMap( CCpuBus * _pbCpuBus, CPpuBus * _pbPpuBus ) {
 			CMapperBase::ApplyMap( _pbCpuBus, _pbPpuBus );
+			// 8 kilobytes of PGM RAM, as on Family BASIC boards.  Test ROMs report their results there ($6000 status block).
+			for ( uint32_t I = 0x6000; I < 0x8000; ++I ) {
+				_pbCpuBus->SetReadFunc( uint16_t( I ), &CCpuBus::StdRead, nullptr, uint16_t( I ) );
+				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CCpuBus::StdWrite, nullptr, uint16_t( I ) );
+			}
 			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
 				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::StdMapperCpuRead, this, uint16_t( (I - 0x8000) % m_prRom->vPrgRom.size() ) );
 				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CCpuBus::NoWrite, nullptr, uint16_t( I ) );	// Treated as ROM.
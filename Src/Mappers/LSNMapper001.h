@@ -205,6 +205,46 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );			
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_ui64LastWriteCycle ) ) { return false; }
+			_sStream.Write( m_ui8PgmRam, sizeof( m_ui8PgmRam ) );
+			_sStream.Write( m_vChrRam.data(), m_vChrRam.size() );
+			if ( !_sStream.Write( m_crChrBanks[0] ) ) { return false; }
+			if ( !_sStream.Write( m_crChrBanks[1] ) ) { return false; }
+			if ( !_sStream.Write( m_prPgmBank ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Control ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Load ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8LoadCnt ) ) { return false; }
+			return _sStream.WriteBool( m_bRamEnabled );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi64( m_ui64LastWriteCycle ) ) { return false; }
+			if ( _sStream.Read( m_ui8PgmRam, sizeof( m_ui8PgmRam ) ) != sizeof( m_ui8PgmRam ) ) { return false; }
+			if ( _sStream.Read( m_vChrRam.data(), m_vChrRam.size() ) != m_vChrRam.size() ) { return false; }
+			if ( !_sStream.Read( m_crChrBanks[0] ) ) { return false; }
+			if ( !_sStream.Read( m_crChrBanks[1] ) ) { return false; }
+			if ( !_sStream.Read( m_prPgmBank ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Control ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Load ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8LoadCnt ) ) { return false; }
+			return _sStream.ReadBool( m_bRamEnabled );
+		}
+
 
 	protected :
 		// == Types.
@@ -233,7 +273,7 @@ namespace lsn {
 		/** The PGM RAM. */
 		uint8_t											m_ui8PgmRam[32*1024];
 		/** PGM-ROM outer banks. */
-		uint8_t *										m_puiPgmRomOuterBanks[16];
+		const uint8_t *									m_puiPgmRomOuterBanks[16];
 		/** PGM-RAM outer banks. */
 		uint8_t *										m_puiPgmRamOuterBanks[16];
 
@@ -454,7 +494,7 @@ namespace lsn {
 			CMapper001 * pmThis = reinterpret_cast<CMapper001 *>(_pvParm0);
 			
 			
-			uint8_t * pui8Outer;
+			const uint8_t * pui8Outer;
 			if ( pmThis->In8kMode_CHR() ) {
 				pui8Outer = pmThis->m_puiPgmRomOuterBanks[pmThis->m_crChrBanks[0].ui8PgmRomBank];
 			}
@@ -808,6 +848,87 @@ namespace lsn {
 				pmThis->m_vChrRam.data()[sBnk*(ChrBankSize()*2)+(_ui16Parm1/*&0x1FFF*/)] = _ui8Val;
 			}
 		}
+
+		// ================
+		// BANK WINDOWS
+		// ================
+		/**
+		 * Gets the function that resolves the memory read by a read accessor.
+		 *
+		 * \param _pfFunc The read function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory read.
+		 */
+		virtual PfBankPtrFunc							GetReadPtrFunc( CCpuBus::PfReadFunc _pfFunc ) const {
+			if ( _pfFunc == &Mapper001PgmRamRead ) { return &PgmRamPtr; }
+			if ( _pfFunc == &Read_PGM_8000_FFFF ) { return &PgmPtr_8000_FFFF; }
+			if ( _pfFunc == &Read_CHR_0000_1FFF ) { return &ChrPtr_0000_1FFF; }
+			return CMapperBase::GetReadPtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Gets the function that resolves the memory written by a write accessor.
+		 *
+		 * \param _pfFunc The write function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory write.
+		 */
+		virtual PfBankPtrFunc							GetWritePtrFunc( CCpuBus::PfWriteFunc _pfFunc ) const {
+			if ( _pfFunc == &Mapper001PgmRamWrite ) { return &PgmRamPtr; }
+			if ( _pfFunc == &Write_CHR_0000_1FFF ) { return &ChrPtr_0000_1FFF; }
+			return CMapperBase::GetWritePtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Resolves a PGM RAM address.  Mirrors Mapper001PgmRamRead() and Mapper001PgmRamWrite().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into PGM RAM.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM RAM byte or nullptr if PGM RAM is disabled.
+		 */
+		static uint8_t *								PgmRamPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper001 * pmThis = static_cast<CMapper001 *>(_pmbThis);
+			return pmThis->m_bRamEnabled ? &pmThis->m_ui8PgmRam[_ui16Parm1] : nullptr;
+		}
+
+		/**
+		 * Resolves a PGM ROM address.  Mirrors Read_PGM_8000_FFFF().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset from $8000.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM ROM byte.
+		 */
+		static uint8_t *								PgmPtr_8000_FFFF( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper001 * pmThis = static_cast<CMapper001 *>(_pmbThis);
+			if ( !pmThis->In32kMode_PGM() ) {
+				if ( _ui16Parm1 >= (0xC000 - 0x8000) ) {
+					size_t sBnk = pmThis->m_prPgmBank.ui8PgmBank[1];
+					return RomPtr( &pmThis->m_prRom->vPrgRom.data()[sBnk*PgmBankSize()+(_ui16Parm1&0x3FFF)] );
+				}
+				size_t sBnk = pmThis->m_prPgmBank.ui8PgmBank[0];
+				return RomPtr( &pmThis->m_prRom->vPrgRom.data()[sBnk*PgmBankSize()+_ui16Parm1] );
+			}
+			size_t sBnk = pmThis->m_prPgmBank.ui8PgmBank[0] >> 1;
+			return RomPtr( &pmThis->m_prRom->vPrgRom.data()[sBnk*(PgmBankSize()*2)+_ui16Parm1] );
+		}
+
+		/**
+		 * Resolves a CHR address.  Mirrors Read_CHR_0000_1FFF() and Write_CHR_0000_1FFF().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The PPU address.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the CHR byte.
+		 */
+		static uint8_t *								ChrPtr_0000_1FFF( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper001 * pmThis = static_cast<CMapper001 *>(_pmbThis);
+			if ( !pmThis->In8kMode_CHR() ) {
+				size_t sBnk = pmThis->m_crChrBanks[(_ui16Parm1>>12)&1].ui8ChrBank;
+				return &pmThis->m_vChrRam.data()[sBnk*ChrBankSize()+(_ui16Parm1&0x0FFF)];
+			}
+			size_t sBnk = pmThis->m_crChrBanks[0].ui8ChrBank >> 1;
+			return &pmThis->m_vChrRam.data()[sBnk*(ChrBankSize()*2)+_ui16Parm1];
+		}
 	};
 
 }	// namespace lsn
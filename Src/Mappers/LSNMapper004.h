@@ -56,6 +56,14 @@ namespace lsn {
 			SetPgmBank<2, PgmBankSize()>( -2 );
 
 			m_ui8Reg0 = m_ui8Reg1 = 0;
+			m_ui8IrqLatch = m_ui8IrqCounter = 0;
+			m_bIrqReload = m_bIrqEnabled = false;
+			m_ui64A12LowCycle = 0;
+
+			std::memset( m_ui8PrgRam, 0, sizeof( m_ui8PrgRam ) );
+
+			// The scanline counter is clocked by rises of PPU A12 rather than by Tick().
+			_pbPpuBus->SetA12Notify( &A12Changed, this );
 		}
 
 		/**
@@ -151,6 +159,27 @@ namespace lsn {
 			}
 
 
+			// ================
+			// IRQ
+			// ================
+			for ( uint32_t I = 0xC000; I < 0xE000; ++I ) {
+				if ( (I & 1) == 0 ) {
+					_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper004::IrqLatchC000_DFFE, this, 0 );
+				}
+				else {
+					_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper004::IrqReloadC001_DFFF, this, 0 );
+				}
+			}
+			for ( uint32_t I = 0xE000; I < 0x10000; ++I ) {
+				if ( (I & 1) == 0 ) {
+					_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper004::IrqDisableE000_FFFE, this, 0 );
+				}
+				else {
+					_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper004::IrqEnableE001_FFFF, this, 0 );
+				}
+			}
+
+
 			// ================
 			// MIRRORING
 			// ================
@@ -162,6 +191,57 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Determines whether the mapper raises IRQ's in response to PPU activity.
+		 *
+		 * \return Returns true, since the scanline counter is clocked by the PPU.
+		 */
+		virtual bool									HasPpuIrq() const { return true; }
+
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			_sStream.Write( m_ui8PrgRam, sizeof( m_ui8PrgRam ) );
+			if ( !_sStream.WriteUi8( m_ui8Reg0 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg1 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg2 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg3 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8BankMode ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrMode ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8IrqLatch ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8IrqCounter ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bIrqReload ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bIrqEnabled ) ) { return false; }
+			return _sStream.WriteUi64( m_ui64A12LowCycle );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( _sStream.Read( m_ui8PrgRam, sizeof( m_ui8PrgRam ) ) != sizeof( m_ui8PrgRam ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg0 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg1 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg2 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg3 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8BankMode ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrMode ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8IrqLatch ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8IrqCounter ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bIrqReload ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bIrqEnabled ) ) { return false; }
+			return _sStream.ReadUi64( m_ui64A12LowCycle );
+		}
+
 
 	protected :
 		// == Members.
@@ -179,6 +259,16 @@ namespace lsn {
 		uint8_t											m_ui8BankMode;
 		/** CHR mode set on $8000-$9FFE, even. */
 		uint8_t											m_ui8ChrMode;
+		/** The IRQ counter reload value set on $C000-$DFFE, even. */
+		uint8_t											m_ui8IrqLatch;
+		/** The IRQ (scanline) counter. */
+		uint8_t											m_ui8IrqCounter;
+		/** Set on $C001-$DFFF, odd, to reload the counter on the next clock. */
+		bool											m_bIrqReload;
+		/** IRQ's are enabled on $E001-$FFFF, odd, and disabled on $E000-$FFFE, even. */
+		bool											m_bIrqEnabled;
+		/** The CPU cycle on which PPU A12 last fell. */
+		uint64_t										m_ui64A12LowCycle;
 
 
 		// == Functions.
@@ -324,6 +414,91 @@ namespace lsn {
 			pmThis->m_ui8Reg1 = _ui8Val;
 		}
 
+		/**
+		 * IRQ latch ($C000-$DFFE, even).
+		 *
+		 * \param _pvParm0 A data value assigned to this address.
+		 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  Typically this will be the address to write to _pui8Data.
+		 * \param _pui8Data The buffer to which to write.
+		 * \param _ui8Val The value to write.
+		 */
+		static void LSN_FASTCALL						IrqLatchC000_DFFE( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * /*_pui8Data*/, uint8_t _ui8Val ) {
+			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
+			pmThis->m_ui8IrqLatch = _ui8Val;
+		}
+
+		/**
+		 * IRQ reload ($C001-$DFFF, odd).  Clears the counter so that it is reloaded from the latch on the next clock.
+		 *
+		 * \param _pvParm0 A data value assigned to this address.
+		 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  Typically this will be the address to write to _pui8Data.
+		 * \param _pui8Data The buffer to which to write.
+		 * \param _ui8Val The value to write.
+		 */
+		static void LSN_FASTCALL						IrqReloadC001_DFFF( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * /*_pui8Data*/, uint8_t /*_ui8Val*/ ) {
+			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
+			pmThis->m_ui8IrqCounter = 0;
+			pmThis->m_bIrqReload = true;
+		}
+
+		/**
+		 * IRQ disable ($E000-$FFFE, even).  Also acknowledges any pending IRQ.
+		 *
+		 * \param _pvParm0 A data value assigned to this address.
+		 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  Typically this will be the address to write to _pui8Data.
+		 * \param _pui8Data The buffer to which to write.
+		 * \param _ui8Val The value to write.
+		 */
+		static void LSN_FASTCALL						IrqDisableE000_FFFE( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * /*_pui8Data*/, uint8_t /*_ui8Val*/ ) {
+			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
+			pmThis->m_bIrqEnabled = false;
+			pmThis->m_pcbCpu->ClearIrq( LSN_IS_MMC3 );
+		}
+
+		/**
+		 * IRQ enable ($E001-$FFFF, odd).
+		 *
+		 * \param _pvParm0 A data value assigned to this address.
+		 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  Typically this will be the address to write to _pui8Data.
+		 * \param _pui8Data The buffer to which to write.
+		 * \param _ui8Val The value to write.
+		 */
+		static void LSN_FASTCALL						IrqEnableE001_FFFF( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * /*_pui8Data*/, uint8_t /*_ui8Val*/ ) {
+			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
+			pmThis->m_bIrqEnabled = true;
+		}
+
+		/**
+		 * Called by the PPU when its address line A12 rises or falls.  A rise clocks the scanline counter only if A12 has been low
+		 *	for more than 3 CPU cycles (about 10 PPU cycles), which is how the MMC3 filters out the short drops between pattern
+		 *	fetches so that the counter is clocked once per scanline.
+		 *
+		 * \param _pvParm0 The mapper.
+		 * \param _bHigh The new state of A12.
+		 */
+		static void LSN_FASTCALL						A12Changed( void * _pvParm0, bool _bHigh ) {
+			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
+			uint64_t ui64Cycle = pmThis->m_pcbCpu->GetCycleCount();
+			if ( !_bHigh ) {
+				pmThis->m_ui64A12LowCycle = ui64Cycle;
+				return;
+			}
+			if ( ui64Cycle - pmThis->m_ui64A12LowCycle <= 3 ) { return; }
+
+			// If the counter is 0 or a reload was requested it is reloaded, otherwise it is decremented.  Either way, if it is then 0
+			//	the IRQ is raised (MMC3 revision B/MMC6 behavior).
+			if ( pmThis->m_ui8IrqCounter == 0 || pmThis->m_bIrqReload ) {
+				pmThis->m_ui8IrqCounter = pmThis->m_ui8IrqLatch;
+				pmThis->m_bIrqReload = false;
+			}
+			else {
+				--pmThis->m_ui8IrqCounter;
+			}
+			if ( pmThis->m_ui8IrqCounter == 0 && pmThis->m_bIrqEnabled ) {
+				pmThis->m_pcbCpu->Irq( LSN_IS_MMC3 );
+			}
+		}
+
 		/**
 		 * Handles reads fromm 0x8000-0x9FFF.
 		 *
@@ -572,6 +747,94 @@ namespace lsn {
 			}
 			
 		}
+
+		/**
+		 * Gets the function that resolves the memory read by a read accessor.
+		 *
+		 * \param _pfFunc The read function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory read.
+		 */
+		virtual PfBankPtrFunc							GetReadPtrFunc( CCpuBus::PfReadFunc _pfFunc ) const {
+			if ( _pfFunc == &Read_PGM_8000_9FFF ) { return &PgmPtr<2, 0>; }
+			if ( _pfFunc == &Read_PGM_C000_DFFF ) { return &PgmPtr<0, 2>; }
+			if ( _pfFunc == &Read_CHR_0000_03FF ) { return &ChrPtr<4, 0>; }
+			if ( _pfFunc == &Read_CHR_0400_07FF ) { return &ChrPtr<5, 1>; }
+			if ( _pfFunc == &Read_CHR_0800_0BFF ) { return &ChrPtr<6, 2>; }
+			if ( _pfFunc == &Read_CHR_0C00_0FFF ) { return &ChrPtr<7, 3>; }
+			if ( _pfFunc == &Read_CHR_1000_13FF ) { return &ChrPtr<0, 4>; }
+			if ( _pfFunc == &Read_CHR_1400_17FF ) { return &ChrPtr<1, 5>; }
+			if ( _pfFunc == &Read_CHR_1800_1BFF ) { return &ChrPtr<2, 6>; }
+			if ( _pfFunc == &Read_CHR_1C00_1FFF ) { return &ChrPtr<3, 7>; }
+			if ( _pfFunc == &Mapper004PgmRamRead ) { return &PgmRamReadPtr; }
+			return CMapperBase::GetReadPtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Gets the function that resolves the memory written by a write accessor.
+		 *
+		 * \param _pfFunc The write function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory write.
+		 */
+		virtual PfBankPtrFunc							GetWritePtrFunc( CCpuBus::PfWriteFunc _pfFunc ) const {
+			if ( _pfFunc == &Mapper004PgmRamWrite ) { return &PgmRamWritePtr; }
+			return CMapperBase::GetWritePtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Resolves a PGM ROM address in a bank that swaps with $8000.D6.  Mirrors Read_PGM_8000_9FFF() and Read_PGM_C000_DFFF().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM ROM byte.
+		 */
+		template <unsigned _uD6Set, unsigned _uD6Clear>
+		static uint8_t *								PgmPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper004 * pmThis = static_cast<CMapper004 *>(_pmbThis);
+			size_t sBnk = (pmThis->m_ui8Reg0 & 0b01000000) ? pmThis->m_ui8PgmBanks[_uD6Set] : pmThis->m_ui8PgmBanks[_uD6Clear];
+			return RomPtr( &pmThis->m_prRom->vPrgRom.data()[sBnk*PgmBankSize()+_ui16Parm1] );
+		}
+
+		/**
+		 * Resolves a CHR ROM address in a bank that swaps with $8000.D7.  Mirrors Read_CHR_0000_03FF() through Read_CHR_1C00_1FFF().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the CHR ROM byte.
+		 */
+		template <unsigned _uD7Set, unsigned _uD7Clear>
+		static uint8_t *								ChrPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper004 * pmThis = static_cast<CMapper004 *>(_pmbThis);
+			size_t sBnk = (pmThis->m_ui8Reg0 & 0b10000000) ? pmThis->m_ui8ChrBanks[_uD7Set] : pmThis->m_ui8ChrBanks[_uD7Clear];
+			return RomPtr( &pmThis->m_prRom->vChrRom.data()[sBnk*ChrBankSize()+_ui16Parm1] );
+		}
+
+		/**
+		 * Resolves a PGM RAM read.  Mirrors Mapper004PgmRamRead().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into PGM RAM.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM RAM byte or nullptr if PGM RAM is disabled.
+		 */
+		static uint8_t *								PgmRamReadPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper004 * pmThis = static_cast<CMapper004 *>(_pmbThis);
+			return (pmThis->m_ui8Reg1 & 0b10000000) ? &pmThis->m_ui8PrgRam[_ui16Parm1] : nullptr;
+		}
+
+		/**
+		 * Resolves a PGM RAM write.  Mirrors Mapper004PgmRamWrite().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into PGM RAM.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM RAM byte or nullptr if PGM RAM writes are disabled.
+		 */
+		static uint8_t *								PgmRamWritePtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper004 * pmThis = static_cast<CMapper004 *>(_pmbThis);
+			return ((pmThis->m_ui8Reg1 & 0b11000000) == 0b11000000) ? &pmThis->m_ui8PrgRam[_ui16Parm1] : nullptr;
+		}
 	};
 
 }	// namespace lsn
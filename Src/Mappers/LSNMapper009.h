@@ -48,6 +48,8 @@ namespace lsn {
 			m_ui8Latch1 = 0xFD;
 
 			m_ui8ChrBankLatch0_FD = m_ui8ChrBankLatch0_FE = m_ui8ChrBankLatch1_FD = m_ui8ChrBankLatch1_FE = 0;
+
+			std::memset( m_ui8PgmRam, 0, sizeof( m_ui8PgmRam ) );
 		}
 
 		/**
@@ -137,6 +139,40 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			_sStream.Write( m_ui8PgmRam, sizeof( m_ui8PgmRam ) );
+			if ( !_sStream.WriteUi8( m_ui8ChrBankLatch0_FD ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrBankLatch0_FE ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrBankLatch1_FD ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrBankLatch1_FE ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Latch0 ) ) { return false; }
+			return _sStream.WriteUi8( m_ui8Latch1 );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( _sStream.Read( m_ui8PgmRam, sizeof( m_ui8PgmRam ) ) != sizeof( m_ui8PgmRam ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrBankLatch0_FD ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrBankLatch0_FE ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrBankLatch1_FD ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrBankLatch1_FE ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Latch0 ) ) { return false; }
+			return _sStream.ReadUi8( m_ui8Latch1 );
+		}
+
 
 	protected :
 		// == Members.
@@ -382,7 +418,10 @@ namespace lsn {
 			ptTramp->aaOriginalFuncs.pfReader( ptTramp->aaOriginalFuncs.pvReaderParm0,
 				ptTramp->aaOriginalFuncs.ui16ReaderParm1,
 				_pui8Data, _ui8Ret );
-			pmBase->m_ui8Latch0 = 0xFD;
+			if ( pmBase->m_ui8Latch0 != 0xFD ) {
+				pmBase->m_ui8Latch0 = 0xFD;
+				pmBase->UpdatePpuBankWindows();
+			}
 		}
 
 		/**
@@ -399,7 +438,10 @@ namespace lsn {
 			ptTramp->aaOriginalFuncs.pfReader( ptTramp->aaOriginalFuncs.pvReaderParm0,
 				ptTramp->aaOriginalFuncs.ui16ReaderParm1,
 				_pui8Data, _ui8Ret );
-			pmBase->m_ui8Latch0 = 0xFE;
+			if ( pmBase->m_ui8Latch0 != 0xFE ) {
+				pmBase->m_ui8Latch0 = 0xFE;
+				pmBase->UpdatePpuBankWindows();
+			}
 		}
 
 		/**
@@ -416,7 +458,10 @@ namespace lsn {
 			ptTramp->aaOriginalFuncs.pfReader( ptTramp->aaOriginalFuncs.pvReaderParm0,
 				ptTramp->aaOriginalFuncs.ui16ReaderParm1,
 				_pui8Data, _ui8Ret );
-			pmBase->m_ui8Latch1 = 0xFD;
+			if ( pmBase->m_ui8Latch1 != 0xFD ) {
+				pmBase->m_ui8Latch1 = 0xFD;
+				pmBase->UpdatePpuBankWindows();
+			}
 		}
 
 		/**
@@ -433,9 +478,81 @@ namespace lsn {
 			ptTramp->aaOriginalFuncs.pfReader( ptTramp->aaOriginalFuncs.pvReaderParm0,
 				ptTramp->aaOriginalFuncs.ui16ReaderParm1,
 				_pui8Data, _ui8Ret );
-			pmBase->m_ui8Latch1 = 0xFE;
+			if ( pmBase->m_ui8Latch1 != 0xFE ) {
+				pmBase->m_ui8Latch1 = 0xFE;
+				pmBase->UpdatePpuBankWindows();
+			}
 		}
 
+		/**
+		 * Gets the function that resolves the memory read by a read accessor.
+		 *
+		 * \param _pfFunc The read function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory read.
+		 */
+		virtual PfBankPtrFunc							GetReadPtrFunc( CCpuBus::PfReadFunc _pfFunc ) const {
+			if ( _pfFunc == &Mapper009PgmRamRead ) { return &PgmRamPtr; }
+			if ( _pfFunc == &Mapper009ChrBankRead_0000_0FFF ) { return &ChrBankPtr_0000_0FFF; }
+			if ( _pfFunc == &Mapper009ChrBankRead_1000_1FFF ) { return &ChrBankPtr_1000_1FFF; }
+			return CMapperBase::GetReadPtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Gets the function that resolves the memory written by a write accessor.
+		 *
+		 * \param _pfFunc The write function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory write.
+		 */
+		virtual PfBankPtrFunc							GetWritePtrFunc( CCpuBus::PfWriteFunc _pfFunc ) const {
+			if ( _pfFunc == &Mapper009PgmRamWrite ) { return &PgmRamPtr; }
+			return CMapperBase::GetWritePtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Resolves a PGM RAM address.
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into PGM RAM.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM RAM byte.
+		 */
+		static uint8_t *								PgmRamPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			return &static_cast<CMapper009 *>(_pmbThis)->m_ui8PgmRam[_ui16Parm1];
+		}
+
+		/**
+		 * Resolves a CHR ROM address in $0000-$0FFF under the current latch.  Mirrors Mapper009ChrBankRead_0000_0FFF().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the CHR ROM byte or nullptr if the latch is invalid.
+		 */
+		static uint8_t *								ChrBankPtr_0000_0FFF( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper009 * pmThis = static_cast<CMapper009 *>(_pmbThis);
+			switch ( pmThis->m_ui8Latch0 ) {
+				case 0xFD : { return RomPtr( &pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBankLatch0_FD*(4*1024)+_ui16Parm1] ); }
+				case 0xFE : { return RomPtr( &pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBankLatch0_FE*(4*1024)+_ui16Parm1] ); }
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Resolves a CHR ROM address in $1000-$1FFF under the current latch.  Mirrors Mapper009ChrBankRead_1000_1FFF().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the CHR ROM byte or nullptr if the latch is invalid.
+		 */
+		static uint8_t *								ChrBankPtr_1000_1FFF( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper009 * pmThis = static_cast<CMapper009 *>(_pmbThis);
+			switch ( pmThis->m_ui8Latch1 ) {
+				case 0xFD : { return RomPtr( &pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBankLatch1_FD*(4*1024)+_ui16Parm1] ); }
+				case 0xFE : { return RomPtr( &pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBankLatch1_FE*(4*1024)+_ui16Parm1] ); }
+			}
+			return nullptr;
+		}
 	};
 
 }	// namespace lsn
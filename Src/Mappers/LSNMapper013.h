@@ -63,7 +63,7 @@ namespace lsn {
 			else {
 				m_ui8ChrRamBasePtr = m_ui82ndChrRam + ((sBank & 1) * ChrBankSize());
 			}
-			
+			std::memset( m_ui82ndChrRam, 0, sizeof( m_ui82ndChrRam ) );
 		}
 
 		/**
@@ -105,6 +105,40 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Writes the mapper state to a stream.  The CHR RAM pointer is written as the bank it selects.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			_sStream.Write( m_ui82ndChrRam, sizeof( m_ui82ndChrRam ) );
+			uint8_t ui8Bank;
+			if ( m_ui8ChrRamBasePtr >= m_ui82ndChrRam && m_ui8ChrRamBasePtr < m_ui82ndChrRam + sizeof( m_ui82ndChrRam ) ) {
+				ui8Bank = uint8_t( 2 + (m_ui8ChrRamBasePtr - m_ui82ndChrRam) / ChrBankSize() );
+			}
+			else {
+				ui8Bank = uint8_t( (m_ui8ChrRamBasePtr - m_ui8DefaultChrRam) / ChrBankSize() );
+			}
+			return _sStream.WriteUi8( ui8Bank );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( _sStream.Read( m_ui82ndChrRam, sizeof( m_ui82ndChrRam ) ) != sizeof( m_ui82ndChrRam ) ) { return false; }
+			uint8_t ui8Bank;
+			if ( !_sStream.ReadUi8( ui8Bank ) ) { return false; }
+			SelectBank8000_FFFF( this, 0, nullptr, ui8Bank );
+			return true;
+		}
+
 
 	protected :
 		// == Members.
@@ -161,6 +195,40 @@ namespace lsn {
 				pmThis->m_ui8ChrRamBasePtr = pmThis->m_ui82ndChrRam + ((sBank & 1) * ChrBankSize());
 			}
 		}
+
+		/**
+		 * Gets the function that resolves the memory read by a read accessor.
+		 *
+		 * \param _pfFunc The read function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory read.
+		 */
+		virtual PfBankPtrFunc							GetReadPtrFunc( CCpuBus::PfReadFunc _pfFunc ) const {
+			if ( _pfFunc == &ChrBankRead_1000_1FFF ) { return &ChrRamPtr_1000_1FFF; }
+			return CMapperBase::GetReadPtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Gets the function that resolves the memory written by a write accessor.
+		 *
+		 * \param _pfFunc The write function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory write.
+		 */
+		virtual PfBankPtrFunc							GetWritePtrFunc( CCpuBus::PfWriteFunc _pfFunc ) const {
+			if ( _pfFunc == &ChrBankWrite_1000_1FFF ) { return &ChrRamPtr_1000_1FFF; }
+			return CMapperBase::GetWritePtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Resolves a CHR RAM address in the switchable bank.  Mirrors ChrBankRead_1000_1FFF() and ChrBankWrite_1000_1FFF().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the CHR RAM byte.
+		 */
+		static uint8_t *								ChrRamPtr_1000_1FFF( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			return &static_cast<CMapper013 *>(_pmbThis)->m_ui8ChrRamBasePtr[_ui16Parm1];
+		}
 	};
 
 }	// namespace lsn
@@ -115,6 +115,38 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.Write( m_rReg ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg00 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg80 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg01 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg81 ) ) { return false; }
+			return _sStream.WriteUi8( m_ui8Mode );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.Read( m_rReg ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg00 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg80 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg01 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg81 ) ) { return false; }
+			return _sStream.ReadUi8( m_ui8Mode );
+		}
+
 
 	protected :
 		// == Members.
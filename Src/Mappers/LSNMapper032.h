@@ -149,6 +149,28 @@ namespace lsn {
 #undef LSN_MAJOR_BALL_CRC
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			return _sStream.WriteUi8( m_ui8Mode );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			return _sStream.ReadUi8( m_ui8Mode );
+		}
+
 
 	protected :
 		// == Members.
@@ -276,6 +298,61 @@ namespace lsn {
 				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(size_t(pmThis->m_ui8PgmBanks[1])*PgmBankSize())];
 			}
 		}
+
+		/**
+		 * Gets the function that resolves the memory read by a read accessor.
+		 *
+		 * \param _pfFunc The read function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory read.
+		 */
+		virtual PfBankPtrFunc							GetReadPtrFunc( CCpuBus::PfReadFunc _pfFunc ) const {
+			if ( _pfFunc == &PgmBankRead_8000_A000 ) { return &PgmPtr_8000_A000; }
+			if ( _pfFunc == &PgmBankRead_A000_C000 ) { return &PgmPtr_A000_C000; }
+			if ( _pfFunc == &PgmBankRead_C000_E000 ) { return &PgmPtr_C000_E000; }
+			return CMapperBase::GetReadPtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Resolves a PGM ROM address.  Mirrors PgmBankRead_8000_A000().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM ROM byte.
+		 */
+		static uint8_t *								PgmPtr_8000_A000( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper032 * pmThis = static_cast<CMapper032 *>(_pmbThis);
+			size_t sBnk = !pmThis->m_ui8Mode ? size_t(pmThis->m_ui8PgmBanks[0]) : size_t(pmThis->m_ui8Neg2Bank);
+			return RomPtr( &pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(sBnk*PgmBankSize())] );
+		}
+
+		/**
+		 * Resolves a PGM ROM address.  Mirrors PgmBankRead_A000_C000().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM ROM byte.
+		 */
+		static uint8_t *								PgmPtr_A000_C000( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper032 * pmThis = static_cast<CMapper032 *>(_pmbThis);
+			size_t sBnk = !pmThis->m_ui8Mode ? size_t(pmThis->m_ui8PgmBanks[1]) : size_t(pmThis->m_ui8PgmBanks[0]);
+			return RomPtr( &pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(sBnk*PgmBankSize())] );
+		}
+
+		/**
+		 * Resolves a PGM ROM address.  Mirrors PgmBankRead_C000_E000().
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM ROM byte.
+		 */
+		static uint8_t *								PgmPtr_C000_E000( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper032 * pmThis = static_cast<CMapper032 *>(_pmbThis);
+			size_t sBnk = !pmThis->m_ui8Mode ? size_t(pmThis->m_ui8Neg2Bank) : size_t(pmThis->m_ui8PgmBanks[1]);
+			return RomPtr( &pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(sBnk*PgmBankSize())] );
+		}
 	};
 
 }	// namespace lsn
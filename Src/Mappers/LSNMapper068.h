@@ -52,6 +52,8 @@ namespace lsn {
 		virtual void									InitWithRom( LSN_ROM &_rRom, CCpuBase * _pcbCpuBase, CBussable * _pbPpuBus ) {
 			CMapperBase::InitWithRom( _rRom, _pcbCpuBase, _pbPpuBus );
 			SanitizeRegs<PgmBankSize(), ChrBankSize()>();
+
+			std::memset( m_ui8PrgRam, 0, sizeof( m_ui8PrgRam ) );
 		}
 
 		/**
@@ -101,6 +103,30 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			_sStream.Write( m_ui8PrgRam, sizeof( m_ui8PrgRam ) );
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( _sStream.Read( m_ui8PrgRam, sizeof( m_ui8PrgRam ) ) != sizeof( m_ui8PrgRam ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
@@ -120,6 +120,32 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8PgmBank1 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8PgmBank2 ) ) { return false; }
+			return _sStream.WriteUi8( m_ui8ChrBank1 );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8PgmBank1 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8PgmBank2 ) ) { return false; }
+			return _sStream.ReadUi8( m_ui8ChrBank1 );
+		}
+
 
 	protected :
 		// == Members.
@@ -275,6 +301,58 @@ namespace lsn {
 			pmThis->m_ui8ChrBank1 = (pmThis->m_ui8ChrBank1 & 0b10000) | (_ui8Val & 0b01111);
 			pmThis->m_ui8ChrBank1 = (pmThis->m_ui8ChrBank1) % (pmThis->m_prRom->vChrRom.size() / 0x1000);
 		}
+
+		/**
+		 * Gets the function that resolves the memory read by a read accessor.
+		 *
+		 * \param _pfFunc The read function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory read.
+		 */
+		virtual PfBankPtrFunc							GetReadPtrFunc( CCpuBus::PfReadFunc _pfFunc ) const {
+			if ( _pfFunc == &PgmBank1Read_2000 ) { return &PgmBank1Ptr_2000; }
+			if ( _pfFunc == &PgmBank2Read_2000 ) { return &PgmBank2Ptr_2000; }
+			if ( _pfFunc == &ChrBank1Read_1000 ) { return &ChrBank1Ptr_1000; }
+			return CMapperBase::GetReadPtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Resolves a PGM ROM address using m_ui8PgmBank1 to select a bank.
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM ROM byte.
+		 */
+		static uint8_t *								PgmBank1Ptr_2000( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper075 * pmThis = static_cast<CMapper075 *>(_pmbThis);
+			return RomPtr( &pmThis->m_prRom->vPrgRom.data()[_ui16Parm1+(pmThis->m_ui8PgmBank1*0x2000)] );
+		}
+
+		/**
+		 * Resolves a PGM ROM address using m_ui8PgmBank2 to select a bank.
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM ROM byte.
+		 */
+		static uint8_t *								PgmBank2Ptr_2000( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper075 * pmThis = static_cast<CMapper075 *>(_pmbThis);
+			return RomPtr( &pmThis->m_prRom->vPrgRom.data()[_ui16Parm1+(pmThis->m_ui8PgmBank2*0x2000)] );
+		}
+
+		/**
+		 * Resolves a CHR ROM address using m_ui8ChrBank1 to select a bank.
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the CHR ROM byte.
+		 */
+		static uint8_t *								ChrBank1Ptr_1000( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			CMapper075 * pmThis = static_cast<CMapper075 *>(_pmbThis);
+			return RomPtr( &pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBank1*0x1000+_ui16Parm1] );
+		}
 	};
 
 }	// namespace lsn
@@ -38,6 +38,8 @@ namespace lsn {
 		virtual void									InitWithRom( LSN_ROM &_rRom, CCpuBase * _pcbCpuBase, CBussable * _pbPpuBus ) {
 			CMapperBase::InitWithRom( _rRom, _pcbCpuBase, _pbPpuBus );
 			SanitizeRegs<32 * 1024, 2 * 1024>();
+
+			std::memset( m_ui8ChrRam, 0, sizeof( m_ui8ChrRam ) );
 		}
 
 		/**
@@ -80,6 +82,30 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			_sStream.Write( m_ui8ChrRam, sizeof( m_ui8ChrRam ) );
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( _sStream.Read( m_ui8ChrRam, sizeof( m_ui8ChrRam ) ) != sizeof( m_ui8ChrRam ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
@@ -127,6 +153,40 @@ namespace lsn {
 			CMapper077 * pmThis = reinterpret_cast<CMapper077 *>(_pvParm0);
 			pmThis->m_ui8ChrRam[_ui16Parm1] = _ui8Val;
 		}
+
+		/**
+		 * Gets the function that resolves the memory read by a read accessor.
+		 *
+		 * \param _pfFunc The read function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory read.
+		 */
+		virtual PfBankPtrFunc							GetReadPtrFunc( CCpuBus::PfReadFunc _pfFunc ) const {
+			if ( _pfFunc == &ChrRamRead ) { return &ChrRamPtr; }
+			return CMapperBase::GetReadPtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Gets the function that resolves the memory written by a write accessor.
+		 *
+		 * \param _pfFunc The write function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory write.
+		 */
+		virtual PfBankPtrFunc							GetWritePtrFunc( CCpuBus::PfWriteFunc _pfFunc ) const {
+			if ( _pfFunc == &ChrRamWrite ) { return &ChrRamPtr; }
+			return CMapperBase::GetWritePtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Resolves a CHR RAM address.
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into CHR RAM.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the CHR RAM byte.
+		 */
+		static uint8_t *								ChrRamPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			return &static_cast<CMapper077 *>(_pmbThis)->m_ui8ChrRam[_ui16Parm1];
+		}
 	};
 
 }	// namespace lsn
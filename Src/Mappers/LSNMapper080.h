@@ -46,6 +46,8 @@ namespace lsn {
 			CMapperBase::InitWithRom( _rRom, _pcbCpuBase, _pbPpuBus );
 			SanitizeRegs<8 * 1024, 1 * 1024>();
 			m_bRamAllowed = false;
+
+			std::memset( m_ui8ChrRam, 0, sizeof( m_ui8ChrRam ) );
 		}
 
 		/**
@@ -153,6 +155,30 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			_sStream.Write( m_ui8ChrRam, sizeof( m_ui8ChrRam ) );
+			return _sStream.WriteBool( m_bRamAllowed );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( _sStream.Read( m_ui8ChrRam, sizeof( m_ui8ChrRam ) ) != sizeof( m_ui8ChrRam ) ) { return false; }
+			return _sStream.ReadBool( m_bRamAllowed );
+		}
+
 
 	protected :
 		// == Members.
@@ -96,6 +96,28 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			return _sStream.WriteBool( m_bRamEnable );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			return _sStream.ReadBool( m_bRamEnable );
+		}
+
 
 	protected :
 		// == Members.
@@ -149,6 +171,40 @@ namespace lsn {
 				_pui8Data[_ui16Parm1] = _ui8Val;
 			}
 		}
+
+		/**
+		 * Gets the function that resolves the memory read by a read accessor.
+		 *
+		 * \param _pfFunc The read function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory read.
+		 */
+		virtual PfBankPtrFunc							GetReadPtrFunc( CCpuBus::PfReadFunc _pfFunc ) const {
+			if ( _pfFunc == &ChrRamRead ) { return &ChrRamPtr; }
+			return CMapperBase::GetReadPtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Gets the function that resolves the memory written by a write accessor.
+		 *
+		 * \param _pfFunc The write function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory write.
+		 */
+		virtual PfBankPtrFunc							GetWritePtrFunc( CCpuBus::PfWriteFunc _pfFunc ) const {
+			if ( _pfFunc == &ChrRamWrite ) { return &ChrRamPtr; }
+			return CMapperBase::GetWritePtrFunc( _pfFunc );
+		}
+
+		/**
+		 * Resolves a CHR RAM address.
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The PPU address.
+		 * \param _pui8BusMem The PPU bus memory.
+		 * \return Returns a pointer to the CHR RAM byte or nullptr if CHR RAM is disabled.
+		 */
+		static uint8_t *								ChrRamPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * _pui8BusMem ) {
+			return static_cast<CMapper093 *>(_pmbThis)->m_bRamEnable ? &_pui8BusMem[_ui16Parm1] : nullptr;
+		}
 	};
 
 }	// namespace lsn
@@ -108,6 +108,36 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Rrr ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Ppp ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8S ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bIncrMode ) ) { return false; }
+			return _sStream.WriteBool( m_bInvMode );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Rrr ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Ppp ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8S ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bIncrMode ) ) { return false; }
+			return _sStream.ReadBool( m_bInvMode );
+		}
+
 
 	protected :
 		// == Members.
@@ -15,6 +15,11 @@
 #include "../Roms/LSNRom.h"
 #include "../System/LSNBussable.h"
 
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace lsn {
 
 	/**
@@ -30,14 +35,21 @@ namespace lsn {
 			m_pcbCpu( nullptr ),
 			m_pbPpuBus( nullptr ),
 			m_stFixedOffset( 0 ),
-			m_mmMirror( LSN_MM_HORIZONTAL ),
 			m_ui8PgmBank( m_ui8PgmBanks[0] ),
-			m_ui8ChrBank( m_ui8ChrBanks[0] ) {
+			m_ui8ChrBank( m_ui8ChrBanks[0] ),
+			m_mmMirror( LSN_MM_HORIZONTAL ),
+			m_pbWindowCpuBus( nullptr ),
+			m_pbWindowPpuBus( nullptr ) {
 		}
 		virtual ~CMapperBase() {
 		}
 
 
+		// == Types.
+		/** A function that ticks a mapper with the CPU.  See TickFunc(). */
+		typedef void (*									PfTick)( CMapperBase * _pmbMapper );
+
+
 		// == Functions.
 		/**
 		 * Initializes the mapper with the ROM data.  This is usually to allow the mapper to extract information such as the number of banks it has, as well as make copies of any data it needs to run.
@@ -49,6 +61,10 @@ namespace lsn {
 			m_prRom = &_rRom;
 			m_pcbCpu = _pcbCpuBase;
 			m_pbPpuBus = _pbPpuBus;
+
+			std::memset( m_ui8PgmBanks, 0, sizeof( m_ui8PgmBanks ) );
+			std::memset( m_ui8ChrBanks, 0, sizeof( m_ui8ChrBanks ) );
+			std::memset( m_ui8DefaultChrRam, 0, sizeof( m_ui8DefaultChrRam ) );
 		}
 
 		/**
@@ -71,9 +87,113 @@ namespace lsn {
 		}
 
 		/**
-		 * Ticks with the CPU.
+		 * Ticks with the CPU.  Not virtual: a mapper that needs to be ticked declares its own Tick(), which HasTick() detects at compile
+		 *	time, and the CPU calls it through the function returned by TickFunc().  Mappers that do not declare one are never ticked.
+		 */
+		void											Tick() {}
+
+		/**
+		 * Determines whether a mapper class declares its own Tick().
+		 *
+		 * \return Returns true if _tMapper declares its own Tick() rather than inheriting this one.
+		 */
+		template <class _tMapper>
+		static constexpr bool							HasTick() {
+			return !std::is_same_v<decltype( &_tMapper::Tick ), void (CMapperBase:: *)()>;
+		}
+
+		/**
+		 * Gets the function that ticks a mapper of the given class with the CPU.
+		 *
+		 * \return Returns a function that calls _tMapper::Tick() directly, or nullptr if _tMapper does not need to be ticked.
 		 */
-		virtual void									Tick() {}
+		template <class _tMapper>
+		static constexpr PfTick							TickFunc() {
+			if constexpr ( HasTick<_tMapper>() ) { return &TickMapper<_tMapper>; }
+			else { return nullptr; }
+		}
+
+		/**
+		 * Determines whether the mapper raises IRQ's in response to PPU activity.  Such mappers need the PPU to run in lockstep with the
+		 *	CPU, so the system does not let the CPU run ahead of the PPU while one is loaded.
+		 *
+		 * \return Returns true if the mapper sends IRQ's to the CPU based on what the PPU does.
+		 */
+		virtual bool									HasPpuIrq() const { return false; }
+
+		/**
+		 * Finds every bus page whose reads or writes are plain accesses of a PGM/CHR bank or of mapper RAM and publishes direct
+		 *	pointers for them to the busses, so that the CPU and PPU access them with a single indexed load instead of an accessor
+		 *	call.  Pages that hold the mapper's registers are set to call UpdateBankWindows() after each write.  Must be called after
+		 *	ApplyMap().
+		 *
+		 * \param _pbCpuBus A pointer to the CPU bus.
+		 * \param _pbPpuBus A pointer to the PPU bus.
+		 */
+		void											ApplyBankWindows( CCpuBus * _pbCpuBus, CPpuBus * _pbPpuBus ) {
+			m_pbWindowCpuBus = _pbCpuBus;
+			m_pbWindowPpuBus = _pbPpuBus;
+			FindWindowPages( _pbCpuBus, m_vCpuWindows );
+			FindWindowPages( _pbPpuBus, m_vPpuWindows );
+
+			for ( uint32_t I = 0; I < _pbCpuBus->Size(); I += 256 ) {
+				bool bWindow = false;
+				for ( size_t J = m_vCpuWindows.size(); J--; ) {
+					if ( m_vCpuWindows[J].ui16Addr == I && m_vCpuWindows[J].pfWrite ) { bWindow = true; break; }
+				}
+				if ( bWindow ) { continue; }
+				for ( uint32_t J = I; J < I + 256; ++J ) {
+					if ( _pbCpuBus->GetAccessor( uint16_t( J ) ).pvWriterParm0 == this ) {
+						_pbCpuBus->SetWriteNotify( uint16_t( I ), BankWriteNotify, this );
+						break;
+					}
+				}
+			}
+			UpdateBankWindows();
+		}
+
+		/**
+		 * Recomputes the published bank-window pointers from the current bank registers.  Called automatically after every write to
+		 *	a page holding the mapper's registers.  Mappers that switch banks any other way must call it themselves.
+		 */
+		void											UpdateBankWindows() {
+			if ( m_pbWindowCpuBus ) { UpdateWindowPages( m_pbWindowCpuBus, m_vCpuWindows ); }
+			if ( m_pbWindowPpuBus ) { UpdateWindowPages( m_pbWindowPpuBus, m_vPpuWindows ); }
+		}
+
+		/**
+		 * Writes the mapper state to a stream.  Mappers with registers or RAM beyond the common banks override this, call it first,
+		 *	then write their own state.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			_sStream.Write( m_ui8PgmBanks, sizeof( m_ui8PgmBanks ) );
+			_sStream.Write( m_ui8ChrBanks, sizeof( m_ui8ChrBanks ) );
+			_sStream.Write( m_ui8DefaultChrRam, sizeof( m_ui8DefaultChrRam ) );
+			if ( !_sStream.WriteUi64( m_stFixedOffset ) ) { return false; }
+			return _sStream.WriteI8( int8_t( m_mmMirror ) );
+		}
+
+		/**
+		 * Reads the mapper state from a stream.  The caller must call UpdateBankWindows() afterwards.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			uint64_t ui64FixedOffset;
+			int8_t i8Mirror;
+			if ( _sStream.Read( m_ui8PgmBanks, sizeof( m_ui8PgmBanks ) ) != sizeof( m_ui8PgmBanks ) ) { return false; }
+			if ( _sStream.Read( m_ui8ChrBanks, sizeof( m_ui8ChrBanks ) ) != sizeof( m_ui8ChrBanks ) ) { return false; }
+			if ( _sStream.Read( m_ui8DefaultChrRam, sizeof( m_ui8DefaultChrRam ) ) != sizeof( m_ui8DefaultChrRam ) ) { return false; }
+			if ( !_sStream.ReadUi64( ui64FixedOffset ) ) { return false; }
+			if ( !_sStream.ReadI8( i8Mirror ) ) { return false; }
+			m_stFixedOffset = size_t( ui64FixedOffset );
+			m_mmMirror = static_cast<LSN_MIRROR_MODE>(i8Mirror);
+			return true;
+		}
 
 		/**
 		 * Applies a mirroring mode to a PPU bus.
@@ -101,6 +221,21 @@ namespace lsn {
 
 
 	protected :
+		// == Types.
+		/** Returns a pointer to the byte accessed by a read or write accessor given its second parameter and the bus memory, or nullptr if the access does not currently go to memory. */
+		typedef uint8_t * (*							PfBankPtrFunc)( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * _pui8BusMem );
+
+		/** A bus page mapped to a PGM/CHR bank or to mapper RAM. */
+		struct LSN_WINDOW_PAGE {
+			PfBankPtrFunc								pfRead;							/**< Resolves reads from the page, or nullptr to read through the accessors. */
+			PfBankPtrFunc								pfWrite;						/**< Resolves writes to the page, or nullptr to write through the accessors. */
+			uint32_t									ui32Generation;					/**< The bus generation of the page when it was examined. */
+			uint16_t									ui16Addr;						/**< The address of the page. */
+			uint16_t									ui16ReadParm1;					/**< The second parameter of the first reader on the page. */
+			uint16_t									ui16WriteParm1;					/**< The second parameter of the first writer on the page. */
+		};
+
+
 		// == Members.
 		/** The PGM banks. */
 		uint8_t											m_ui8PgmBanks[32];
@@ -122,6 +257,14 @@ namespace lsn {
 		uint8_t &										m_ui8ChrBank;
 		/** The mirroring mode. */
 		LSN_MIRROR_MODE									m_mmMirror;
+		/** The CPU bus to which bank windows are published. */
+		CCpuBus *										m_pbWindowCpuBus;
+		/** The PPU bus to which bank windows are published. */
+		CPpuBus *										m_pbWindowPpuBus;
+		/** CPU pages mapped to banks or RAM. */
+		std::vector<LSN_WINDOW_PAGE>					m_vCpuWindows;
+		/** PPU pages mapped to banks or RAM. */
+		std::vector<LSN_WINDOW_PAGE>					m_vPpuWindows;
 
 
 		// == Functions.
@@ -156,6 +299,16 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Ticks a mapper of the given class by calling its Tick() directly, without virtual dispatch.
+		 *
+		 * \param _pmbMapper The mapper, which must be a _tMapper.
+		 */
+		template <class _tMapper>
+		static void										TickMapper( CMapperBase * _pmbMapper ) {
+			static_cast<_tMapper *>(_pmbMapper)->_tMapper::Tick();
+		}
+
 		/**
 		 * A standard mapper PGM trampoline read function.  Maps an address to a given byte in the ROM's PGM space.
 		 *
@@ -581,6 +734,235 @@ namespace lsn {
 			_pui8Data[MirrorAddress( _ui16Parm1, pmThis->m_mmMirror )] = _ui8Val;
 		}
 
+		/**
+		 * Gets the function that resolves the memory read by a read accessor.  Mappers with their own plain-memory read functions
+		 *	override this to add them and defer to the base class for the rest.
+		 *
+		 * \param _pfFunc The read function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory read.
+		 */
+		virtual PfBankPtrFunc							GetReadPtrFunc( CCpuBus::PfReadFunc _pfFunc ) const {
+			if ( _pfFunc == &PgmBankRead_Fixed ) { return &PgmFixedPtr; }
+			if ( _pfFunc == &StdMapperCpuRead ) { return &StdMapperCpuPtr; }
+			if ( _pfFunc == &PgmBankRead_8000 ) { return &PgmBankPtr<0, 0x8000>; }
+			if ( _pfFunc == &PgmBankRead_4000 ) { return &PgmBankPtr<0, 0x4000>; }
+			if ( _pfFunc == &PgmBankRead_2000 ) { return &PgmBankPtr<0, 0x2000>; }
+			if ( _pfFunc == &ChrBankRead_2000 ) { return &ChrBankPtr<0, 0x2000>; }
+			if ( _pfFunc == &ChrBankRead_1000 ) { return &ChrBankPtr<0, 0x1000>; }
+			if ( _pfFunc == &ChrBankRead_0800 ) { return &ChrBankPtr<0, 0x0800>; }
+			if ( _pfFunc == &DefaultChrRamRead ) { return &DefaultChrRamPtr; }
+			if ( _pfFunc == &Read_ControllableMirror ) { return &ControllableMirrorPtr; }
+
+			using RegSeq = std::make_integer_sequence<unsigned, 8>;
+			PfBankPtrFunc pfRet = nullptr;
+			if ( (pfRet = FindPgmBankPtr<0x2000>( _pfFunc, RegSeq() )) ) { return pfRet; }
+			if ( (pfRet = FindPgmBankPtr<0x4000>( _pfFunc, RegSeq() )) ) { return pfRet; }
+			if ( (pfRet = FindPgmBankPtr<0x8000>( _pfFunc, RegSeq() )) ) { return pfRet; }
+			if ( (pfRet = FindChrBankPtr<0x0400>( _pfFunc, RegSeq() )) ) { return pfRet; }
+			if ( (pfRet = FindChrBankPtr<0x0800>( _pfFunc, RegSeq() )) ) { return pfRet; }
+			if ( (pfRet = FindChrBankPtr<0x1000>( _pfFunc, RegSeq() )) ) { return pfRet; }
+			if ( (pfRet = FindChrBankPtr<0x2000>( _pfFunc, RegSeq() )) ) { return pfRet; }
+			if ( (pfRet = FindChrBankPtr<0x4000>( _pfFunc, RegSeq() )) ) { return pfRet; }
+			return nullptr;
+		}
+
+		/**
+		 * Gets the function that resolves the memory written by a write accessor.  Mappers with their own plain-memory write functions
+		 *	override this to add them and defer to the base class for the rest.
+		 *
+		 * \param _pfFunc The write function assigned to a bus page.
+		 * \return Returns the resolver for _pfFunc or nullptr if _pfFunc is not a plain memory write.
+		 */
+		virtual PfBankPtrFunc							GetWritePtrFunc( CCpuBus::PfWriteFunc _pfFunc ) const {
+			if ( _pfFunc == &DefaultChrRamWrite ) { return &DefaultChrRamPtr; }
+			if ( _pfFunc == &Write_ControllableMirror ) { return &ControllableMirrorPtr; }
+			return nullptr;
+		}
+
+		/**
+		 * Converts a pointer into PGM or CHR ROM to the return type of a PfBankPtrFunc.  ROM resolvers are only returned by
+		 *	GetReadPtrFunc() and the bus only reads through them (see SetPagePointers()), so the ROM is never written.
+		 *
+		 * \param _pui8Rom The pointer into ROM.
+		 * \return Returns _pui8Rom.
+		 */
+		static inline uint8_t *							RomPtr( const uint8_t * _pui8Rom ) { return const_cast<uint8_t *>(_pui8Rom); }
+
+		/**
+		 * Resolves a PGM ROM address in the bank selected by m_ui8PgmBanks[_uReg].
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM ROM byte.
+		 */
+		template <unsigned _uReg, unsigned _uSize>
+		static uint8_t *								PgmBankPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			return RomPtr( _pmbThis->m_prRom->vPrgRom.data() + (size_t( _ui16Parm1 ) + size_t( _pmbThis->m_ui8PgmBanks[_uReg] ) * _uSize) );
+		}
+
+		/**
+		 * Resolves a CHR ROM address in the bank selected by m_ui8ChrBanks[_uReg].
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the CHR ROM byte.
+		 */
+		template <unsigned _uReg, unsigned _uSize>
+		static uint8_t *								ChrBankPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			return RomPtr( _pmbThis->m_prRom->vChrRom.data() + (size_t( _ui16Parm1 ) + size_t( _pmbThis->m_ui8ChrBanks[_uReg] ) * _uSize) );
+		}
+
+		/**
+		 * Resolves a PGM ROM address in the fixed bank.
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into the bank.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM ROM byte.
+		 */
+		static uint8_t *								PgmFixedPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			return RomPtr( _pmbThis->m_prRom->vPrgRom.data() + (size_t( _ui16Parm1 ) + _pmbThis->m_stFixedOffset) );
+		}
+
+		/**
+		 * Resolves an unbanked PGM ROM address.
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into PGM ROM.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the PGM ROM byte.
+		 */
+		static uint8_t *								StdMapperCpuPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			return RomPtr( _pmbThis->m_prRom->vPrgRom.data() + _ui16Parm1 );
+		}
+
+		/**
+		 * Resolves a CHR RAM address.
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The offset into CHR RAM.
+		 * \param _pui8BusMem Unused.
+		 * \return Returns a pointer to the CHR RAM byte.
+		 */
+		static uint8_t *								DefaultChrRamPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * /*_pui8BusMem*/ ) {
+			return &_pmbThis->m_ui8DefaultChrRam[_ui16Parm1];
+		}
+
+		/**
+		 * Resolves a nametable address under the current controllable mirroring.
+		 *
+		 * \param _pmbThis The mapper.
+		 * \param _ui16Parm1 The nametable address.
+		 * \param _pui8BusMem The PPU bus memory.
+		 * \return Returns a pointer to the nametable byte.
+		 */
+		static uint8_t *								ControllableMirrorPtr( CMapperBase * _pmbThis, uint16_t _ui16Parm1, uint8_t * _pui8BusMem ) {
+			return &_pui8BusMem[MirrorAddress( _ui16Parm1, _pmbThis->m_mmMirror )];
+		}
+
+		/**
+		 * Recomputes only the PPU bank-window pointers.  Used by mappers whose CHR banks switch on PPU reads.
+		 */
+		void											UpdatePpuBankWindows() {
+			if ( m_pbWindowPpuBus ) { UpdateWindowPages( m_pbWindowPpuBus, m_vPpuWindows ); }
+		}
+
+		/**
+		 * Called by the CPU bus after a write to a page holding the mapper's registers.
+		 *
+		 * \param _pvParm0 The mapper.
+		 */
+		static void LSN_FASTCALL						BankWriteNotify( void * _pvParm0 ) {
+			reinterpret_cast<CMapperBase *>(_pvParm0)->UpdateBankWindows();
+		}
+
+		/**
+		 * Finds the PgmBankPtr() matching a PgmBankRead() instantiation.
+		 *
+		 * \param _pfFunc The read function to match.
+		 * \return Returns the matching resolver or nullptr.
+		 */
+		template <unsigned _uSize, unsigned... _uRegs>
+		static PfBankPtrFunc							FindPgmBankPtr( CCpuBus::PfReadFunc _pfFunc, std::integer_sequence<unsigned, _uRegs...> ) {
+			PfBankPtrFunc pfRet = nullptr;
+			((_pfFunc == &PgmBankRead<_uRegs, _uSize> ? (pfRet = &PgmBankPtr<_uRegs, _uSize>, true) : false) || ...);
+			return pfRet;
+		}
+
+		/**
+		 * Finds the ChrBankPtr() matching a ChrBankRead() instantiation.
+		 *
+		 * \param _pfFunc The read function to match.
+		 * \return Returns the matching resolver or nullptr.
+		 */
+		template <unsigned _uSize, unsigned... _uRegs>
+		static PfBankPtrFunc							FindChrBankPtr( CCpuBus::PfReadFunc _pfFunc, std::integer_sequence<unsigned, _uRegs...> ) {
+			PfBankPtrFunc pfRet = nullptr;
+			((_pfFunc == &ChrBankRead<_uRegs, _uSize> ? (pfRet = &ChrBankPtr<_uRegs, _uSize>, true) : false) || ...);
+			return pfRet;
+		}
+
+		/**
+		 * Examines a bus page and fills in a window page if the mapper can resolve its reads or writes.
+		 *
+		 * \param _pbBus The bus.
+		 * \param _ui16Addr The address of the page.
+		 * \param _wpPage Holds the result.
+		 * \return Returns true if the reads or the writes of the page can be resolved.
+		 */
+		template <typename _tBus>
+		bool											ExamineWindowPage( _tBus * _pbBus, uint16_t _ui16Addr, LSN_WINDOW_PAGE &_wpPage ) const {
+			typename _tBus::LSN_LINEAR_PAGE lpPage;
+			_pbBus->GetLinearPage( _ui16Addr, lpPage );
+			_wpPage.ui16Addr = _ui16Addr;
+			_wpPage.ui32Generation = lpPage.ui32Generation;
+			_wpPage.ui16ReadParm1 = lpPage.ui16ReaderParm1;
+			_wpPage.ui16WriteParm1 = lpPage.ui16WriterParm1;
+			_wpPage.pfRead = (lpPage.pfReader && lpPage.pvReaderParm0 == this) ? GetReadPtrFunc( lpPage.pfReader ) : nullptr;
+			_wpPage.pfWrite = (lpPage.pfWriter && lpPage.pvWriterParm0 == this) ? GetWritePtrFunc( lpPage.pfWriter ) : nullptr;
+			return _wpPage.pfRead || _wpPage.pfWrite;
+		}
+
+		/**
+		 * Collects the window pages of a bus.
+		 *
+		 * \param _pbBus The bus.
+		 * \param _vPages Holds the pages.
+		 */
+		template <typename _tBus>
+		void											FindWindowPages( _tBus * _pbBus, std::vector<LSN_WINDOW_PAGE> &_vPages ) const {
+			_vPages.clear();
+			for ( uint32_t I = 0; I < _pbBus->Size(); I += 256 ) {
+				LSN_WINDOW_PAGE wpPage;
+				if ( ExamineWindowPage( _pbBus, uint16_t( I ), wpPage ) ) {
+					_vPages.push_back( wpPage );
+				}
+			}
+		}
+
+		/**
+		 * Publishes the current pointers of a set of window pages to a bus.  Pages whose accessors were replaced since they were
+		 *	examined are examined again first.
+		 *
+		 * \param _pbBus The bus.
+		 * \param _vPages The pages.
+		 */
+		template <typename _tBus>
+		void											UpdateWindowPages( _tBus * _pbBus, std::vector<LSN_WINDOW_PAGE> &_vPages ) {
+			uint8_t * pui8Mem = _pbBus->Memory();
+			for ( size_t I = 0; I < _vPages.size(); ++I ) {
+				LSN_WINDOW_PAGE & wpPage = _vPages[I];
+				if LSN_UNLIKELY( _pbBus->PageGeneration( wpPage.ui16Addr ) != wpPage.ui32Generation ) {
+					if ( !ExamineWindowPage( _pbBus, wpPage.ui16Addr, wpPage ) ) { continue; }
+				}
+				_pbBus->SetPagePointers( wpPage.ui16Addr,
+					wpPage.pfRead ? wpPage.pfRead( this, wpPage.ui16ReadParm1, pui8Mem ) : nullptr,
+					wpPage.pfWrite ? wpPage.pfWrite( this, wpPage.ui16WriteParm1, pui8Mem ) : nullptr );
+			}
+		}
+
 	};
 
 }	// namespace lsn
@@ -12,11 +12,14 @@
 #include <vector>
 #include <bitset>
 #include <array>
+#include <cstring>
 #include <string>
 #if defined( _MSC_VER )
 #include <intrin.h>
 #elif defined( __i386__ ) || defined( __x86_64__ )
 #include <cpuid.h>
+// Provides _xgetbv().  Declaring it here instead would conflict with any file that includes <immintrin.h>.
+#include <immintrin.h>
 #else
 //#include <x86intrin.h>
 #endif  // #if defined( __i386__ ) || defined( __x86_64__ )
@@ -25,7 +28,12 @@
 #if defined( __i386__ ) || defined( __x86_64__ ) || defined( _MSC_VER )
 #ifdef __GNUC__
 
-void __cpuid( int * _piCpuInfo, int _iInfo ) {
+#ifdef __cpuid
+// <cpuid.h> provides a 5-argument __cpuid() macro; replace it with the MSVC-style function used below.
+#undef __cpuid
+#endif	// #ifdef __cpuid
+
+inline void __cpuid( int * _piCpuInfo, int _iInfo ) {
 	__asm__ __volatile__(
 		"xchg %%ebx, %%edi;"
 		"cpuid;"
@@ -35,20 +43,12 @@ void __cpuid( int * _piCpuInfo, int _iInfo ) {
 	);
 }
 
-unsigned long long _xgetbv( unsigned int _uiIndex ) {
-	unsigned int eax, edx;
-	__asm__ __volatile__(
-		"xgetbv;"
-		: "=a" (eax), "=d"(edx)
-		: "c" (_uiIndex)
-	);
-	return ((unsigned long long)edx << 32) | eax;
-}
-
-void __cpuidex( int * _piCpuInfo, int _iInfo, int _iSubFunc ) {
+#if defined( __clang__ ) || __GNUC__ < 11	// GCC 11 and later provide __cpuidex() in <cpuid.h>.
+inline void __cpuidex( int * _piCpuInfo, int _iInfo, int _iSubFunc ) {
     // _iInfo is the leaf, and _iSubFunc is the sub-leaf.
     __cpuid_count( _iInfo, _iSubFunc, _piCpuInfo[0], _piCpuInfo[1], _piCpuInfo[2], _piCpuInfo[3] );
 }
+#endif	// #if defined( __clang__ ) || __GNUC__ < 11
 
 #endif	// #ifdef __GNUC__
 #endif	// #if defined( __i386__ ) || defined( __x86_64__ )
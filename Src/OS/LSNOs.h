@@ -15,8 +15,16 @@
 
 #include <pthread.h>
 #else
+#include "LSNPosix.h"
+
+#include <pthread.h>
+#include <sched.h>
 #endif  // #if defined( _WIN32 ) || defined( _WIN64 )
 
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
 #ifndef LSN_FASTCALL
 #define LSN_FASTCALL
 #endif	// LSN_FASTCALL
@@ -32,6 +40,7 @@
     #define LSN_LIKELY( x )						( x ) [[likely]]
     #define LSN_UNLIKELY( x )					( x ) [[unlikely]]
 	#define LSN_STDCALL							__stdcall
+	#define LSN_NO_OPTIMIZE
 #elif defined( __GNUC__ ) || defined( __clang__ )
     // GNU Compiler Collection (GCC) or Clang
     #define LSN_ALIGN( n ) 						__attribute__( (aligned( n )) )
@@ -43,12 +52,65 @@
     #define LSN_UNLIKELY( x )					( __builtin_expect( !!(x), 0 ) )
     #define __assume( x )
 	#define LSN_STDCALL
+	#if defined( __clang__ )
+	#define LSN_NO_OPTIMIZE						__attribute__( (optnone) )
+	#else
+	#define LSN_NO_OPTIMIZE						__attribute__( (optimize( "O0" )) )
+	#endif	// #if defined( __clang__ )
 #else
 	#define LSN_FORCEINLINE						inline
     #error "Unsupported compiler"
 #endif
 
 
+#if !defined( _MSC_VER )
+/**
+ * Portable replacement for the MSVC _umul128() intrinsic.  Multiplies 2 64-bit numbers into a 128-bit result.
+ *
+ * \param _ui64Multiplier The multiplier.
+ * \param _ui64Multiplicand The multiplicand.
+ * \param _pui64ProductHi Holds the high 64 bits of the product.
+ * \return Returns the low 64 bits of the product.
+ */
+inline uint64_t _umul128( uint64_t _ui64Multiplier, uint64_t _ui64Multiplicand,
+	uint64_t * _pui64ProductHi ) {
+	__uint128_t ui128Tmp = static_cast<__uint128_t>(_ui64Multiplier) * static_cast<__uint128_t>(_ui64Multiplicand);
+	(*_pui64ProductHi) = static_cast<uint64_t>(ui128Tmp >> 64);
+	return static_cast<uint64_t>(ui128Tmp);
+}
+
+/**
+ * Portable replacement for the MSVC _udiv128() intrinsic.  Divides a 128-bit number by a 64-bit number.
+ *
+ * \param _ui64High The high 64 bits of the dividend.
+ * \param _ui64Low The low 64 bits of the dividend.
+ * \param _ui64Divisor The divisor.
+ * \param _pui64Remainder Optional pointer to the remainder.
+ * \return Returns the 64-bit quotient.
+ */
+inline uint64_t _udiv128( uint64_t _ui64High, uint64_t _ui64Low, uint64_t _ui64Divisor, uint64_t * _pui64Remainder ) {
+	if ( _ui64Divisor == 0 ) {
+		throw std::overflow_error( "Division by zero is not allowed." );
+	}
+
+	if ( _ui64High >= _ui64Divisor ) {
+		throw std::overflow_error( "The division would overflow the 64-bit quotient." );
+	}
+
+	if ( _ui64High == 0 ) {
+		if ( _pui64Remainder ) { (*_pui64Remainder) = _ui64Low % _ui64Divisor; }
+		return _ui64Low / _ui64Divisor;
+	}
+	
+	// Combine the high and low parts into a single __uint128_t value.
+	__uint128_t ui128Dividend = static_cast<__uint128_t>(_ui64High) << 64 | _ui64Low;
+	
+	if ( _pui64Remainder ) { (*_pui64Remainder) = static_cast<uint64_t>(ui128Dividend % _ui64Divisor); }
+	return static_cast<uint64_t>(ui128Dividend / _ui64Divisor);
+}
+#endif	// #if !defined( _MSC_VER )
+
+
 #ifdef LSN_WINDOWS
 inline void SetThreadHighPriority() {
     ::SetThreadPriority( ::GetCurrentThread(), THREAD_PRIORITY_HIGHEST );
@@ -62,7 +124,7 @@ inline void SetThreadHighPriority() {
     spSchParms.sched_priority = ::sched_get_priority_max( SCHED_FIFO );
     ::pthread_setschedparam( ::pthread_self(), SCHED_FIFO, &spSchParms );
 }
-void SetThreadNormalPriority() {
+inline void SetThreadNormalPriority() {
     sched_param spSchParms;
     spSchParms.sched_priority = 0;  // Normal priority
     ::pthread_setschedparam( ::pthread_self(), SCHED_OTHER, &spSchParms );
@@ -0,0 +1,25 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Linux/POSIX macros and header.  Used for headless builds that have neither Win32 nor Apple frameworks available.
+ */
+
+#pragma once
+
+#if !defined( _WIN32 ) && !defined( _WIN64 ) && !defined( __APPLE__ )
+
+#include <stdexcept>
+
+#define LSN_POSIX
+
+#ifdef __linux__
+#define LSN_LINUX
+#endif	// #ifdef __linux__
+
+#ifdef __GNUC__
+#include <math.h>
+#endif	// #ifdef __GNUC__
+
+#endif  // #if !defined( _WIN32 ) && !defined( _WIN64 ) && !defined( __APPLE__ )
@@ -84,15 +84,7 @@ void LSN_FASTCALL								Cycle_0__68x0_76x0_84x0_92x0_100x0_108x0_116x0_124x0_13
 	Pixel_Evaluation_Sprite<false, false>();
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -118,15 +110,7 @@ void LSN_FASTCALL								Cycle_0__66x0_74x0_82x0_90x0_98x0_106x0_114x0_122x0_130
 	Pixel_Evaluation_Sprite<false, false>();
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -152,15 +136,7 @@ void LSN_FASTCALL								Cycle_0__70x0_78x0_86x0_94x0_102x0_110x0_118x0_126x0_13
 	Pixel_Evaluation_Sprite<false, false>();
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -186,15 +162,7 @@ void LSN_FASTCALL								Cycle_0__256x0_256x1_256x2_256x3_256x4_256x5_256x6_256x
 	Pixel_Evaluation_Sprite<false, false>();
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -226,15 +194,7 @@ void LSN_FASTCALL								Cycle_0__72x0_80x0_88x0_96x0_104x0_112x0_120x0_128x0_13
 	Pixel_Evaluation_Sprite<false, false>();
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -263,15 +223,7 @@ void LSN_FASTCALL								Cycle_0__73x0_81x0_89x0_97x0_105x0_113x0_121x0_129x0_13
 	Pixel_Evaluation_Sprite<false, true>();
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -304,15 +256,7 @@ void LSN_FASTCALL								Cycle_0__67x0_75x0_83x0_91x0_99x0_107x0_115x0_123x0_131
 	Pixel_Evaluation_Sprite<false, true>();
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -346,15 +290,7 @@ void LSN_FASTCALL								Cycle_0__69x0_77x0_85x0_93x0_101x0_109x0_117x0_125x0_13
 	Pixel_Evaluation_Sprite<false, true>();
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -384,15 +320,7 @@ void LSN_FASTCALL								Cycle_0__71x0_79x0_87x0_95x0_103x0_111x0_119x0_127x0_13
 	Pixel_Evaluation_Sprite<false, true>();
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -422,15 +350,7 @@ void LSN_FASTCALL								Cycle_0__65x0_65x1_65x2_65x3_65x4_65x5_65x6_65x7_65x8_6
 	Pixel_Evaluation_Sprite<true, true>();
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -1486,6 +1406,8 @@ void LSN_FASTCALL								Cycle_0__280x261_285x261_286x261_287x261_288x261_293x26
 
 		m_ui8OamAddr = 0;
 
+		WatchA12( PreRenderSpritePatternAddr() );
+
 		m_paPpuAddrV.s.ui16FineY = m_paPpuAddrT.s.ui16FineY;
 		m_paPpuAddrV.s.ui16NametableY = m_paPpuAddrT.s.ui16NametableY;
 		m_paPpuAddrV.s.ui16CourseY = m_paPpuAddrT.s.ui16CourseY;
@@ -1546,6 +1468,8 @@ void LSN_FASTCALL								Cycle_0__261x261_262x261_263x261_264x261_269x261_270x26
 	if (m_bRendering) {
 
 		m_ui8OamAddr = 0;
+
+		WatchA12( PreRenderSpritePatternAddr() );
 	}
 
 	++m_stCurCycle;
@@ -1581,15 +1505,7 @@ void LSN_FASTCALL								Cycle_0__4x0_12x0_20x0_28x0_36x0_44x0_52x0_60x0_4x1_12x
 	m_soSecondaryOam.ui8Bytes[m_ui8Oam2ClearIdx++] = m_ui8OamLatch; m_ui8Oam2ClearIdx %= sizeof(m_soSecondaryOam.ui8Bytes);
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -1615,15 +1531,7 @@ void LSN_FASTCALL								Cycle_0__2x0_10x0_18x0_26x0_34x0_42x0_50x0_58x0_2x1_10x
 	m_soSecondaryOam.ui8Bytes[m_ui8Oam2ClearIdx++] = m_ui8OamLatch; m_ui8Oam2ClearIdx %= sizeof(m_soSecondaryOam.ui8Bytes);
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -1649,15 +1557,7 @@ void LSN_FASTCALL								Cycle_0__6x0_14x0_22x0_30x0_38x0_46x0_54x0_62x0_6x1_14x
 	m_soSecondaryOam.ui8Bytes[m_ui8Oam2ClearIdx++] = m_ui8OamLatch; m_ui8Oam2ClearIdx %= sizeof(m_soSecondaryOam.ui8Bytes);
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -1683,15 +1583,7 @@ void LSN_FASTCALL								Cycle_0__8x0_16x0_24x0_32x0_40x0_48x0_56x0_64x0_8x1_16x
 	m_soSecondaryOam.ui8Bytes[m_ui8Oam2ClearIdx++] = m_ui8OamLatch; m_ui8Oam2ClearIdx %= sizeof(m_soSecondaryOam.ui8Bytes);
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -1720,15 +1612,7 @@ void LSN_FASTCALL								Cycle_0__9x0_17x0_25x0_33x0_41x0_49x0_57x0_9x1_17x1_25x
 	m_ui8OamLatch = ReadOam(m_ui8OamAddr);
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -1761,15 +1645,7 @@ void LSN_FASTCALL								Cycle_0__3x0_11x0_19x0_27x0_35x0_43x0_51x0_59x0_3x1_11x
 	m_ui8OamLatch = ReadOam(m_ui8OamAddr);
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -1803,15 +1679,7 @@ void LSN_FASTCALL								Cycle_0__5x0_13x0_21x0_29x0_37x0_45x0_53x0_61x0_5x1_13x
 	m_ui8OamLatch = ReadOam(m_ui8OamAddr);
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -1841,15 +1709,7 @@ void LSN_FASTCALL								Cycle_0__7x0_15x0_23x0_31x0_39x0_47x0_55x0_63x0_7x1_15x
 	m_ui8OamLatch = ReadOam(m_ui8OamAddr);
 
 	if (m_bRendering) {
-		for (uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
-			if (m_asActiveSprites.ui8X[I]) {
-				--m_asActiveSprites.ui8X[I];
-			}
-			else {
-				m_asActiveSprites.ui8ShiftLo[I] <<= 1;
-				m_asActiveSprites.ui8ShiftHi[I] <<= 1;
-			}
-		}
+		ShiftSprites();
 	}
 
 	if (m_bRendering) {
@@ -1936,6 +1796,7 @@ void LSN_FASTCALL								Cycle_0__1x0() {
 
 void LSN_FASTCALL								Cycle_0__0x240() {
 
+	FlushSpriteLine();
 	m_ui8ThisLineSpriteCount = 0;
 
 
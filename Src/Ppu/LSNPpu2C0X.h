@@ -65,6 +65,7 @@ namespace lsn {
 			m_ui16ShiftPatternHi( 0 ),
 			m_ui16ShiftAttribLo( 0 ),
 			m_ui16ShiftAttribHi( 0 ),
+			m_ui16SpriteTicks( 0 ),
 			m_ui8ThisLineSpriteCount( 0 ),
 			m_ui8NtAtBuffer( 0 ),
 			m_ui8NextTileId( 0 ),
@@ -79,7 +80,10 @@ namespace lsn {
 			m_ui8Oam2SpriteCpyCnt( 0 ),
 			m_dvLeftRedgreenDelay( nullptr, this ),
 			m_dvPpuMaskDelay( MaskCallback, this ),
-			m_bAddresLatch( false ) {
+			m_ui16LineBatchY( 0 ),
+			m_bAddresLatch( false ),
+			m_bSpriteLine( false ) {
+			std::memset( m_ui8PaletteRam, 0, sizeof( m_ui8PaletteRam ) );
 
 #ifdef LSN_INT_OAM_DECAY
 			for ( auto I = LSN_ELEMENTS( m_ui64OamDecay ); I--; ) {
@@ -98,11 +102,7 @@ namespace lsn {
 #ifdef LSN_GEN_PPU
 			GenerateCycleFuncs();
 #else
-#include "LSNCreateCycleTableNtsc.inl"
-#include "LSNCreateCycleTablePal.inl"
-#include "LSNCreateCycleTableDendy.inl"
-#include "LSNCreateCycleTablePalM.inl"
-#include "LSNCreateCycleTablePalN.inl"
+			CreateCycleTable();
 #endif	// #ifdef LSN_GEN_PPU
 		}
 		~CPpu2C0X() {
@@ -166,6 +166,7 @@ namespace lsn {
 					}
 					else {
 						m_paPpuAddrV.ui16Addr = m_ui16VAddrCopy;
+						WatchA12( m_paPpuAddrV.ui16Addr );		// Outside of rendering, V is on the bus.
 					}
 
 					m_paPpuAddrT.ui16Addr = m_paPpuAddrV.ui16Addr;
@@ -221,6 +222,7 @@ namespace lsn {
 					}
 					else {
 						m_paPpuAddrV.ui16Addr = m_ui16VAddrCopy;
+						WatchA12( m_paPpuAddrV.ui16Addr );		// Outside of rendering, V is on the bus.
 					}
 
 					m_paPpuAddrT.ui16Addr = m_paPpuAddrV.ui16Addr;
@@ -291,6 +293,151 @@ namespace lsn {
 			m_bUpdateVramAddr = false;
 		}
 
+		/**
+		 * Writes the PPU state, including its bus, to a stream.  The cycle function is written as its index into the cycle table.
+		 *	The render target is owned by the display host and is not written.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		bool											SaveState( CStream &_sStream ) const {
+#ifdef LSN_INT_OAM_DECAY
+			_sStream.Write( reinterpret_cast<const uint8_t *>(m_ui64OamDecay), sizeof( m_ui64OamDecay ) );
+#else
+			_sStream.Write( reinterpret_cast<const uint8_t *>(m_vOamDecay.data()), m_vOamDecay.size() * sizeof( float ) );
+#endif	// #ifdef LSN_INT_OAM_DECAY
+			if ( !_sStream.WriteUi64( m_ui64Frame ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_ui64Cycle ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_ui64RenderStartCycle ) ) { return false; }
+			if ( !_sStream.WriteUi32( uint32_t( m_stCurCycle ) ) ) { return false; }
+			_sStream.Write( m_ui8PaletteRam, sizeof( m_ui8PaletteRam ) );
+			if ( !m_bBus.SaveState( _sStream ) ) { return false; }
+			LSN_ACTIVE_SPRITE asSprites = m_asActiveSprites;
+			if ( m_bSpriteLine ) {
+				ApplySpriteTicks( asSprites, m_ui8ThisLineSpriteCount, m_ui16SpriteTicks );
+			}
+			if ( !_sStream.Write( asSprites ) ) { return false; }
+			if ( !_sStream.Write( m_oOam ) ) { return false; }
+			if ( !_sStream.Write( m_soSecondaryOam ) ) { return false; }
+			if ( !_sStream.Write( m_paPpuAddrT ) ) { return false; }
+			if ( !_sStream.Write( m_paPpuAddrV ) ) { return false; }
+			if ( !_sStream.Write( m_pcPpuCtrl ) ) { return false; }
+			if ( !_sStream.Write( m_psPpuStatus ) ) { return false; }
+			if ( !_sStream.Write( m_sesStage ) ) { return false; }
+			if ( !m_dvLeftRedgreenDelay.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvPpuMaskDelay.SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16CurX ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16CurY ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16ShiftPatternLo ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16ShiftPatternHi ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16ShiftAttribLo ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16ShiftAttribHi ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16SpritePatternTmp ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16VAddrCopy ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8IoBusLatch ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8DataBuffer ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8FineScrollX ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8NtAtBuffer ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8OamAddr ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8OamLatch ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Oam2ClearIdx ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Oam2WriteIdx ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Oam2SpriteCpyCnt ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8SpriteN ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8SpriteM ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8SpriteAttrib ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8SpriteX ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8SpriteCount ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8NextTileId ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8NextTileAttribute ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8NextTileLsb ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8NextTileMsb ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ThisLineSpriteCount ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8VAddrUpdateCounter ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bVAddrPending ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bRendering ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bShowBg ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bShowSprites ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bAddresLatch ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bSprite0IsInSecondary ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bSprite0IsInSecondaryThisLine ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bSuppressNmi ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bA12High ) ) { return false; }
+			return _sStream.WriteBool( m_bUpdateVramAddr );
+		}
+
+		/**
+		 * Reads the PPU state, including its bus, from a stream.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		bool											LoadState( CStream &_sStream ) {
+#ifdef LSN_INT_OAM_DECAY
+			if ( _sStream.Read( reinterpret_cast<uint8_t *>(m_ui64OamDecay), sizeof( m_ui64OamDecay ) ) != sizeof( m_ui64OamDecay ) ) { return false; }
+#else
+			if ( _sStream.Read( reinterpret_cast<uint8_t *>(m_vOamDecay.data()), m_vOamDecay.size() * sizeof( float ) ) != m_vOamDecay.size() * sizeof( float ) ) { return false; }
+#endif	// #ifdef LSN_INT_OAM_DECAY
+			uint32_t ui32Cycle;
+			if ( !_sStream.ReadUi64( m_ui64Frame ) ) { return false; }
+			if ( !_sStream.ReadUi64( m_ui64Cycle ) ) { return false; }
+			if ( !_sStream.ReadUi64( m_ui64RenderStartCycle ) ) { return false; }
+			if ( !_sStream.ReadUi32( ui32Cycle ) || ui32Cycle >= LSN_ELEMENTS( m_cCycle ) ) { return false; }
+			m_stCurCycle = ui32Cycle;
+			if ( _sStream.Read( m_ui8PaletteRam, sizeof( m_ui8PaletteRam ) ) != sizeof( m_ui8PaletteRam ) ) { return false; }
+			if ( !m_bBus.LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.Read( m_asActiveSprites ) ) { return false; }
+			m_ui16SpriteTicks = 0;
+			m_bSpriteLine = false;
+			if ( !_sStream.Read( m_oOam ) ) { return false; }
+			if ( !_sStream.Read( m_soSecondaryOam ) ) { return false; }
+			if ( !_sStream.Read( m_paPpuAddrT ) ) { return false; }
+			if ( !_sStream.Read( m_paPpuAddrV ) ) { return false; }
+			if ( !_sStream.Read( m_pcPpuCtrl ) ) { return false; }
+			if ( !_sStream.Read( m_psPpuStatus ) ) { return false; }
+			if ( !_sStream.Read( m_sesStage ) ) { return false; }
+			if ( !m_dvLeftRedgreenDelay.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvPpuMaskDelay.LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16CurX ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16CurY ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16ShiftPatternLo ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16ShiftPatternHi ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16ShiftAttribLo ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16ShiftAttribHi ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16SpritePatternTmp ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16VAddrCopy ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8IoBusLatch ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8DataBuffer ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8FineScrollX ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8NtAtBuffer ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8OamAddr ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8OamLatch ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Oam2ClearIdx ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Oam2WriteIdx ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Oam2SpriteCpyCnt ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8SpriteN ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8SpriteM ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8SpriteAttrib ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8SpriteX ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8SpriteCount ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8NextTileId ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8NextTileAttribute ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8NextTileLsb ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8NextTileMsb ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ThisLineSpriteCount ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8VAddrUpdateCounter ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bVAddrPending ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bRendering ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bShowBg ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bShowSprites ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bAddresLatch ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bSprite0IsInSecondary ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bSprite0IsInSecondaryThisLine ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bSuppressNmi ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bA12High ) ) { return false; }
+			return _sStream.ReadBool( m_bUpdateVramAddr );
+		}
+
 		/**
 		 * Applies the PPU's memory mapping t the bus.
 		 */
@@ -448,6 +595,78 @@ namespace lsn {
 		 */
 		inline uint16_t									GetCurrentScanline() const { return uint16_t( m_stCurCycle / _tDotWidth ); }
 
+		/**
+		 * Gets the number of calls to Tick() that can be made before the call that sets or clears v-blank, which is the only time the
+		 *	PPU changes the NMI line on its own.  The count assumes the next frame skips its first dot, so it may be 1 too low.
+		 *
+		 * \return Returns the number of Tick() calls that can safely be made before the NMI line may change.
+		 */
+		inline size_t									TicksToNmiEdge() const {
+			constexpr size_t sSet = (_tPreRender + _tRender + _tPostRender) * _tDotWidth + 1;
+			constexpr size_t sClear = (_tDotHeight - 1) * _tDotWidth + 2;
+			if ( m_stCurCycle <= sSet ) { return sSet - m_stCurCycle; }
+			if ( m_stCurCycle <= sClear ) { return sClear - m_stCurCycle; }
+			return (_tDotWidth * _tDotHeight) - m_stCurCycle + sSet - 1;
+		}
+
+		/**
+		 * Gets the number of calls to Tick() that can be made before the call that ends the current frame.
+		 *
+		 * \return Returns the number of Tick() calls before the one that increases FrameCount().
+		 */
+		inline size_t									TicksToFrameEnd() const {
+			return (_tDotWidth * _tDotHeight) - 1 - m_stCurCycle;
+		}
+
+		/**
+		 * Gets the number of Tick() calls that TickScanline() replaces.
+		 *
+		 * \return Returns the number of dots in a scanline.
+		 */
+		static constexpr size_t							ScanlineTicks() { return _tDotWidth; }
+
+		/**
+		 * Determines whether TickScanline() can be used for the next scanline.  The PPU must be at dot 0 of a rendered scanline with no
+		 *	$2001 write still moving through the mask delays, no T-to-V copy waiting to happen, and no $2007 address increment pending.
+		 *	The caller must also make sure that nothing writes to the PPU or the mapper until the scanline is done.
+		 *
+		 * \return Returns true if the next _tDotWidth calls to Tick() can be replaced with a single call to TickScanline().
+		 */
+		inline bool										CanTickScanline() const {
+#ifdef LSN_USE_PHI2
+			return false;
+#else
+			return (m_stCurCycle % _tDotWidth) == 0 && GetCurrentScanline() < (_tPreRender + _tRender) &&
+				!m_bVAddrPending && !m_bUpdateVramAddr &&
+				m_dvLeftRedgreenDelay.Settled() && m_dvPpuMaskDelay.Settled();
+#endif	// #ifdef LSN_USE_PHI2
+		}
+
+		/**
+		 * Runs a whole scanline.  The result is the same as calling Tick() _tDotWidth times.  While rendering is on, dots 0-256 are run by
+		 *	RenderLine() in passes over the whole line rather than dot by dot, and the rest of the line runs through the cycle table.
+		 *	Only call when CanTickScanline() returns true.
+		 */
+		void											TickScanline() {
+			m_ui16CurY = GetCurrentScanline();
+			uint16_t ui16Dot = 0;
+			// RenderLine() reads sprites from the line buffer starting at its first entry, or expects no sprites on the line.
+			if ( m_bRendering && (m_bSpriteLine ? m_ui16SpriteTicks == 0 : m_ui8ThisLineSpriteCount == 0) ) {
+				RenderLine();
+				ui16Dot = _tRenderW + 1;
+			}
+			for ( ; ui16Dot < _tDotWidth; ++ui16Dot ) {
+				m_ui16CurX = ui16Dot;
+#ifndef LSN_INT_OAM_DECAY
+				if ( (m_ui64Cycle & (OamDecayRate() - 1)) == 0 ) {
+					DecayOam();
+				}
+#endif	// #ifndef LSN_INT_OAM_DECAY
+				(this->*m_cCycle[m_stCurCycle])();
+				++m_ui64Cycle;
+			}
+		}
+
 		/**
 		 * Gets the PPU bus.
 		 *
@@ -661,6 +880,10 @@ namespace lsn {
 		 */
 		template <unsigned _uSpriteIdx, unsigned _uStage>
 		inline void LSN_FASTCALL						Pixel_Fetch_Sprite() {
+			if constexpr ( _uSpriteIdx == 0 && _uStage == 0 ) {
+				// The shifters are about to be reloaded, so bring them up to date first.
+				FlushSpriteLine();
+			}
 			if ( !m_bRendering ) { return; }
 			// 1-4: Read the Y-coordinate, tile number, attributes, and X-coordinate of the selected sprite from secondary OAM
 			// ========================
@@ -766,6 +989,8 @@ namespace lsn {
 				}
 				else {
 					m_asActiveSprites.ui8ShiftLo[_uSpriteIdx] = 0;
+					// Empty slots still fetch tile $FF, which mappers watching A12 can see.
+					WatchA12( DummySpritePatternAddr() );
 				}
 			}
 			if constexpr ( _uStage == 5 ) {
@@ -786,10 +1011,71 @@ namespace lsn {
 				}
 				else {
 					m_asActiveSprites.ui8ShiftHi[_uSpriteIdx] = 0;
+					WatchA12( DummySpritePatternAddr() );
 				}
 			}
 			if constexpr ( _uStage == 7 ) {
 				m_asActiveSprites.ui8X[_uSpriteIdx] = m_ui8SpriteX;
+				if constexpr ( _uSpriteIdx == 7 ) {
+					BuildSpriteLine();
+				}
+			}
+		}
+
+		/**
+		 * Advances the sprite shifters by 1 dot.  While the sprite line buffer is valid this only counts the dot, and the shifters are
+		 *	brought up to date by FlushSpriteLine() when something needs them.
+		 */
+		inline void										ShiftSprites() {
+			if LSN_LIKELY( m_bSpriteLine ) {
+				++m_ui16SpriteTicks;
+				return;
+			}
+			for ( uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
+				if ( m_asActiveSprites.ui8X[I] ) {
+					--m_asActiveSprites.ui8X[I];
+				}
+				else {
+					m_asActiveSprites.ui8ShiftLo[I] <<= 1;
+					m_asActiveSprites.ui8ShiftHi[I] <<= 1;
+				}
+			}
+		}
+
+		/**
+		 * Composes the sprite pixels for the next scanline from the freshly fetched sprite shifters.  Entry N of m_ui8SpriteLine holds
+		 *	what RenderPixel() would get from the shifters after they have been advanced N times, so the line buffer stays correct
+		 *	even when rendering is switched off for part of the scanline and some shifts are skipped.
+		 */
+		void											BuildSpriteLine() {
+			std::memset( m_ui8SpriteLine, 0, sizeof( m_ui8SpriteLine ) );
+			// Lower sprite indices have priority, so they are drawn last.
+			for ( uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {
+				uint8_t ui8Attr = uint8_t( (m_asActiveSprites.ui8Latch[I] & 0x03) << 2 ) |
+					uint8_t( ((m_asActiveSprites.ui8Latch[I] & 0x20) == 0) << 4 ) |
+					uint8_t( (I == 0) << 5 );
+				for ( uint16_t J = 0; J < 8; ++J ) {
+					uint16_t ui16Tick = m_asActiveSprites.ui8X[I] + J;
+					if ( ui16Tick >= LSN_ELEMENTS( m_ui8SpriteLine ) ) { break; }
+					uint8_t ui8Pixel = uint8_t( (((m_asActiveSprites.ui8ShiftHi[I] << J) & 0x80) >> 6) |
+						(((m_asActiveSprites.ui8ShiftLo[I] << J) & 0x80) >> 7) );
+					if ( ui8Pixel ) {
+						m_ui8SpriteLine[ui16Tick] = ui8Pixel | ui8Attr;
+					}
+				}
+			}
+			m_ui16SpriteTicks = 0;
+			m_bSpriteLine = true;
+		}
+
+		/**
+		 * Applies the shifts counted while the sprite line buffer was valid to the sprite shifters and stops using the line buffer.
+		 */
+		inline void										FlushSpriteLine() {
+			if ( m_bSpriteLine ) {
+				ApplySpriteTicks( m_asActiveSprites, m_ui8ThisLineSpriteCount, m_ui16SpriteTicks );
+				m_ui16SpriteTicks = 0;
+				m_bSpriteLine = false;
 			}
 		}
 
@@ -1259,6 +1545,8 @@ namespace lsn {
 		uint64_t										m_ui64Frame;									/**< The frame counter. */
 		uint64_t										m_ui64Cycle;									/**< The cycle counter. */
 		LSN_ACTIVE_SPRITE								m_asActiveSprites;								/**< The active sprites. */
+		uint8_t											m_ui8SpriteLine[256];							/**< The sprite pixel (bits 0-1), palette (2-3), front priority (4), and sprite-0 flag (5) after each number of shifts. */
+		uint16_t										m_ui16SpriteTicks;								/**< The number of sprite shifts not yet applied to m_asActiveSprites while m_bSpriteLine is set. */
 		CCpuBus *										m_pbBus;										/**< Pointer to the bus. */
 		CInterruptable *								m_pnNmiTarget;									/**< The target object of NMI notifications. */
 		uint8_t											m_ui8PaletteRam[LSN_PPU_PALETTE_MEMORY_SIZE];	/**< Dedicated palette RAM. */
@@ -1287,6 +1575,8 @@ namespace lsn {
 		uint16_t										m_ui16ShiftAttribHi;							/**< The 16-bit shifter for the attribute high bits. */
 		uint16_t										m_ui16SpritePatternTmp;							/**< A temporary used during sprite fetches. */
 		uint16_t										m_ui16VAddrCopy;								/**< The copy of T that will get written to V after 3 cycles. */
+		uint16_t										m_ui16LineBatch[_tRenderW];						/**< The pixels of the line being run by RenderLine(). */
+		uint16_t										m_ui16LineBatchY;								/**< The render-target row of the line being run by RenderLine(). */
 		uint8_t											m_ui8IoBusLatch;								/**< The I/O bus floater. */
 		uint8_t											m_ui8DataBuffer;								/**< The $2007 (PPUDATA) buffer. */
 		uint8_t											m_ui8FineScrollX;								/**< The fine X scroll position. */
@@ -1322,11 +1612,34 @@ namespace lsn {
 
 		bool											m_bSuppressNmi;									/**< If true, NMI can't be generated. */
 		bool											m_bUpdateVramAddr;								/**< If true, the VRAM address is updated at the end of the cycle. */
+		bool											m_bSpriteLine;									/**< If true, m_ui8SpriteLine and m_ui16SpriteTicks stand in for the sprite shifters. */
 
 		//bool g_bDoDebugPrint									= false;
 
 
 		// == Functions.
+		/**
+		 * Advances sprite shifters by a number of dots at once.  The result is the same as that many calls to ShiftSprites() with the
+		 *	line buffer off.
+		 *
+		 * \param _asSprites The sprite shifters to advance.
+		 * \param _ui8Total The number of sprites in _asSprites to advance.
+		 * \param _ui16Ticks The number of dots by which to advance.
+		 */
+		static void										ApplySpriteTicks( LSN_ACTIVE_SPRITE &_asSprites, uint8_t _ui8Total, uint16_t _ui16Ticks ) {
+			for ( uint8_t I = _ui8Total; I--; ) {
+				if ( _ui16Ticks <= _asSprites.ui8X[I] ) {
+					_asSprites.ui8X[I] -= uint8_t( _ui16Ticks );
+				}
+				else {
+					uint16_t ui16Shift = _ui16Ticks - _asSprites.ui8X[I];
+					_asSprites.ui8X[I] = 0;
+					_asSprites.ui8ShiftLo[I] = ui16Shift >= 8 ? 0 : uint8_t( _asSprites.ui8ShiftLo[I] << ui16Shift );
+					_asSprites.ui8ShiftHi[I] = ui16Shift >= 8 ? 0 : uint8_t( _asSprites.ui8ShiftHi[I] << ui16Shift );
+				}
+			}
+		}
+
 		/**
 		 * Unless NMI is suppressed, this sets the VBL flag and triggers NMI.
 		 */
@@ -1358,6 +1671,7 @@ namespace lsn {
 
 			if ( (i16AdjustedY >= (_tPreRender + _tRender) && i16AdjustedY != (_tDotHeight - 1) ) || !m_bRendering ) {
 				m_paPpuAddrV.ui16Addr = (m_paPpuAddrV.ui16Addr + (m_pcPpuCtrl.s.ui8IncrementMode ? 32 : 1)) & (0x7FFF);
+				WatchA12( m_paPpuAddrV.ui16Addr );
 			}
 			else {
 				IncHorizontal();
@@ -1365,6 +1679,27 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Gets the address of the pattern fetch made for an empty sprite slot, which always fetches tile $FF.  Only A12 is exact; the
+		 *	row is not tracked since nothing is read.
+		 *
+		 * \return Returns the address of tile $FF in the sprite pattern table, or in the $1000 table for 8-by-16 sprites.
+		 */
+		inline uint16_t									DummySpritePatternAddr() const {
+			return m_pcPpuCtrl.s.ui8SpriteSize ? uint16_t( 0x1FF0 ) : uint16_t( (m_pcPpuCtrl.s.ui8SpriteTileSelect << 12) | 0x0FF0 );
+		}
+
+		/**
+		 * Gets the pattern table of the sprite fetch being made on the pre-render line, where the fetches are made (and can be seen
+		 *	by mappers watching A12) but not used.  Only the table (A12) is exact.
+		 *
+		 * \return Returns the base address of the pattern table of the current sprite fetch.
+		 */
+		inline uint16_t									PreRenderSpritePatternAddr() const {
+			if ( !m_pcPpuCtrl.s.ui8SpriteSize ) { return uint16_t( m_pcPpuCtrl.s.ui8SpriteTileSelect << 12 ); }
+			return uint16_t( (m_soSecondaryOam.s[((m_ui16CurX - (_tRenderW + 1)) >> 3) & 7].ui8Id & 0x01) << 12 );
+		}
+
 		/**
 		 * Increases V.horizontal.
 		 */
@@ -1431,6 +1766,7 @@ namespace lsn {
 				if ( _ui16Addr >= LSN_PPU_PALETTE_MEMORY ) {
 					return ReadPalette( _ui16Addr );
 				}
+				WatchA12( _ui16Addr );
 				return m_bBus.Read( _ui16Addr );
 			}
 			if constexpr ( _bDebug ) { m_ui16LastBusAddr = m_paPpuAddrV.ui16Addr; }
@@ -1733,7 +2069,14 @@ namespace lsn {
 					uint8_t ui8ForegroundPalette = 0;
 					uint8_t ui8ForegroundPriority = 0;
 					bool bIsRenderingSprite0 = false;
-					if ( m_bShowSprites && (m_dvLeftRedgreenDelay.Value().s.ui8LeftSprites || ui16X >= 8) ) {
+					if ( m_bShowSprites && (m_dvLeftRedgreenDelay.Value().s.ui8LeftSprites || ui16X >= 8) && m_bSpriteLine ) {
+						uint8_t ui8Sprite = m_ui8SpriteLine[m_ui16SpriteTicks];
+						ui8ForegroundPixel = ui8Sprite & 0x03;
+						ui8ForegroundPalette = ((ui8Sprite >> 2) & 0x03) + 4;
+						ui8ForegroundPriority = (ui8Sprite >> 4) & 0x01;
+						bIsRenderingSprite0 = (ui8Sprite & 0x20) != 0;
+					}
+					else if ( m_bShowSprites && (m_dvLeftRedgreenDelay.Value().s.ui8LeftSprites || ui16X >= 8) ) {
 						for ( uint8_t I = 0; I < m_ui8ThisLineSpriteCount; ++I ) {
 							if ( m_asActiveSprites.ui8X[I] == 0 ) {
 								ui8ForegroundPixel = (((m_asActiveSprites.ui8ShiftHi[I] & 0x80) > 0) << 1) |
@@ -1892,6 +2235,223 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Runs dots 0-256 of a scanline with rendering on for TickScanline().  The state afterwards is the same as after running those
+		 *	dots through the cycle table, but the work is done in passes over the whole line: sprite evaluation, the 32 background tile
+		 *	fetches (in the same order, so mappers see the same reads), then the background and sprite lines are composed into
+		 *	m_ui16LineBatch and written to the render target.  Sprites come from m_ui8SpriteLine, which must start at its first entry.
+		 */
+		void											RenderLine() {
+			const uint64_t ui64Start = m_ui64Cycle;
+
+			// == Sprite evaluation.
+			// Dot by dot, since OAM can decay along the way.
+			for ( uint16_t I = 0; I <= _tRenderW; ++I ) {
+				m_ui16CurX = I;
+#ifndef LSN_INT_OAM_DECAY
+				if ( (m_ui64Cycle & (OamDecayRate() - 1)) == 0 ) {
+					DecayOam();
+				}
+#endif	// #ifndef LSN_INT_OAM_DECAY
+				if ( I == 0 ) {}
+				else if ( I < 65 ) {
+					// Secondary OAM clear (1-64).
+					if ( I & 1 ) {
+						m_ui8OamLatch = ReadOam( m_ui8OamAddr );
+					}
+					else {
+						m_soSecondaryOam.ui8Bytes[m_ui8Oam2ClearIdx++] = m_ui8OamLatch;
+						m_ui8Oam2ClearIdx %= sizeof( m_soSecondaryOam.ui8Bytes );
+					}
+				}
+				else if ( I == 65 ) { Pixel_Evaluation_Sprite<true, true>(); }
+				else if ( I & 1 ) { Pixel_Evaluation_Sprite<false, true>(); }
+				else { Pixel_Evaluation_Sprite<false, false>(); }
+				++m_ui64Cycle;
+			}
+			if ( m_ui16CurY == 0 ) {
+				m_ui64RenderStartCycle = ui64Start + 1;
+			}
+
+
+			// == Background fetches.
+			// The pixels of the line are a stream of bytes, the first 2 of which are in the shifters after the shift and reload on dot 1.
+			//	Each of the 32 fetches adds another byte.  Pixel N is bit N + fine X of the stream.
+			uint8_t ui8PatLo[34], ui8PatHi[34], ui8AttrLo[34], ui8AttrHi[34];
+			ui8PatLo[0] = uint8_t( m_ui16ShiftPatternLo >> 7 );
+			ui8PatHi[0] = uint8_t( m_ui16ShiftPatternHi >> 7 );
+			ui8AttrLo[0] = uint8_t( m_ui16ShiftAttribLo >> 7 );
+			ui8AttrHi[0] = uint8_t( m_ui16ShiftAttribHi >> 7 );
+			ui8PatLo[1] = m_ui8NextTileLsb;
+			ui8PatHi[1] = m_ui8NextTileMsb;
+			ui8AttrLo[1] = (m_ui8NextTileAttribute & 0b01) ? 0xFF : 0x00;
+			ui8AttrHi[1] = (m_ui8NextTileAttribute & 0b10) ? 0xFF : 0x00;
+			const uint16_t ui16BgTable = uint16_t( m_pcPpuCtrl.s.ui8BackgroundTileSelect << 12 );
+			for ( size_t I = 2; I < LSN_ELEMENTS( ui8PatLo ); ++I ) {
+				// LSN_PPU_NAMETABLES = 0x2000.
+				m_ui8NextTileId = Read( LSN_PPU_NAMETABLES | (m_paPpuAddrV.ui16Addr & 0x0FFF) );
+				// LSN_PPU_ATTRIBUTE_TABLE_OFFSET = 0x03C0.
+				uint8_t ui8Attr = Read( (LSN_PPU_NAMETABLES + LSN_PPU_ATTRIBUTE_TABLE_OFFSET) | (m_paPpuAddrV.s.ui16NametableY << 11) |
+					(m_paPpuAddrV.s.ui16NametableX << 10) |
+					((m_paPpuAddrV.s.ui16CourseY >> 2) << 3) |
+					(m_paPpuAddrV.s.ui16CourseX >> 2) );
+				if ( m_paPpuAddrV.s.ui16CourseY & 0x2 ) { ui8Attr >>= 4; }
+				if ( m_paPpuAddrV.s.ui16CourseX & 0x2 ) { ui8Attr >>= 2; }
+				m_ui8NextTileAttribute = ui8Attr & 0x3;
+				// LSN_PPU_PATTERN_TABLES = 0x0000.
+				uint16_t ui16Pattern = LSN_PPU_PATTERN_TABLES | (ui16BgTable + (static_cast<uint16_t>(m_ui8NextTileId) << 4) + m_paPpuAddrV.s.ui16FineY);
+				ui8PatLo[I] = Read( ui16Pattern );
+				ui8PatHi[I] = Read( ui16Pattern + 8 );
+				ui8AttrLo[I] = (m_ui8NextTileAttribute & 0b01) ? 0xFF : 0x00;
+				ui8AttrHi[I] = (m_ui8NextTileAttribute & 0b10) ? 0xFF : 0x00;
+				IncHorizontal();
+			}
+			IncVertical();
+			// The last fetch is queued for the next line, and the shifters have been shifted 7 times since the last reload on dot 249.
+			m_ui8NextTileLsb = ui8PatLo[33];
+			m_ui8NtAtBuffer = m_ui8NextTileMsb = ui8PatHi[33];
+			m_ui16ShiftPatternLo = uint16_t( ((ui8PatLo[31] << 8) | ui8PatLo[32]) << 7 );
+			m_ui16ShiftPatternHi = uint16_t( ((ui8PatHi[31] << 8) | ui8PatHi[32]) << 7 );
+			m_ui16ShiftAttribLo = uint16_t( ((ui8AttrLo[31] << 8) | ui8AttrLo[32]) << 7 );
+			m_ui16ShiftAttribHi = uint16_t( ((ui8AttrHi[31] << 8) | ui8AttrHi[32]) << 7 );
+			if ( m_bSpriteLine ) {
+				m_ui16SpriteTicks += _tRenderW - 1;	// Sprites shift on dots 2-256.
+			}
+			m_stCurCycle += _tRenderW + 1;
+
+
+			// == Composition.
+			if ( !m_pui8RenderTarget ) { return; }
+			m_ui16LineBatchY = m_bFlipOutput ? ((_tPreRender + _tRender - 1) - m_ui16CurY) : m_ui16CurY;
+			if ( (m_bFlipOutput && m_ui16LineBatchY >= _tRender) || (!m_bFlipOutput && m_ui16LineBatchY < _tPreRender) ) {						// Black pre-render scanline on PAL.
+				for ( size_t I = 0; I < _tRenderW; ++I ) { m_ui16LineBatch[I] = 0x0F; }
+				FlushLineBatch();
+				return;
+			}
+
+			// Background: pixel in bits 0-1, palette in bits 2-3.
+			uint8_t ui8Bg[_tRenderW];
+			if ( m_bShowBg ) {
+				for ( size_t I = 0; I < _tRenderW; ++I ) {
+					size_t stBit = I + m_ui8FineScrollX;
+					size_t stByte = stBit >> 3;
+					uint8_t ui8Shift = uint8_t( 7 - (stBit & 7) );
+					ui8Bg[I] = uint8_t( ((ui8PatLo[stByte] >> ui8Shift) & 1) | (((ui8PatHi[stByte] >> ui8Shift) & 1) << 1) |
+						(((ui8AttrLo[stByte] >> ui8Shift) & 1) << 2) | (((ui8AttrHi[stByte] >> ui8Shift) & 1) << 3) );
+				}
+				if ( !m_dvLeftRedgreenDelay.Value().s.ui8LeftBackground ) {
+					std::memset( ui8Bg, 0, 8 );
+				}
+			}
+			else {
+				std::memset( ui8Bg, 0, sizeof( ui8Bg ) );
+			}
+
+			// Sprites: the line buffer, with the same bits as m_ui8SpriteLine.
+			uint8_t ui8Spr[_tRenderW];
+			if ( m_bShowSprites && m_bSpriteLine ) {
+				std::memcpy( ui8Spr, m_ui8SpriteLine, sizeof( ui8Spr ) );
+				if ( !m_dvLeftRedgreenDelay.Value().s.ui8LeftSprites ) {
+					std::memset( ui8Spr, 0, 8 );
+				}
+			}
+			else {
+				std::memset( ui8Spr, 0, sizeof( ui8Spr ) );
+			}
+
+			// Sprite 0 hit never happens on x=255, or on x=0 to x=7 if both sides of the left-side clipping window are enabled.
+			if ( m_bSprite0IsInSecondaryThisLine ) {
+				size_t stFirst = (m_dvLeftRedgreenDelay.Value().s.ui8LeftBackground | m_dvLeftRedgreenDelay.Value().s.ui8LeftSprites) ? 0 : 8;
+				for ( size_t I = stFirst; I < _tRenderW - 1; ++I ) {
+					if ( (ui8Bg[I] & 0x03) && (ui8Spr[I] & 0x03) && (ui8Spr[I] & 0x20) ) {
+						m_psPpuStatus.s.ui8Sprite0Hit = 1;
+						break;
+					}
+				}
+			}
+
+			// Every final color for the line, by palette address.  Entries divisible by 4 read the backdrop while rendering, so a
+			//	transparent background pixel needs no special case.
+			uint16_t ui16Colors[32];
+			const uint8_t ui8Grey = m_dvPpuMaskDelay.MostRecentValue().s.ui8Greyscale ? 0x30 : 0x3F;
+			uint16_t ui16Emph;
+			if constexpr ( _tRegCode == LSN_PM_NTSC ) {
+				ui16Emph = uint16_t( (m_dvLeftRedgreenDelay.Value().s.ui8RedEmph << 6) | (m_dvLeftRedgreenDelay.Value().s.ui8GreenEmph << 7) );
+			}
+			else {
+				ui16Emph = uint16_t( (m_dvLeftRedgreenDelay.Value().s.ui8RedEmph << 7) | (m_dvLeftRedgreenDelay.Value().s.ui8GreenEmph << 6) );
+			}
+			ui16Emph |= uint16_t( m_dvPpuMaskDelay.MostRecentValue().s.ui8BlueEmph << 8 );
+			for ( size_t I = 0; I < LSN_ELEMENTS( ui16Colors ); ++I ) {
+				ui16Colors[I] = uint16_t( (ReadPalette( uint16_t( I ) ) & 0x3F & ui8Grey) | ui16Emph );
+			}
+
+			for ( size_t I = 0; I < _tRenderW; ++I ) {
+				uint8_t ui8B = ui8Bg[I], ui8S = ui8Spr[I];
+				bool bSprite = (ui8S & 0x03) && (!(ui8B & 0x03) || (ui8S & 0x10));
+				m_ui16LineBatch[I] = ui16Colors[bSprite ? ((ui8S & 0x0F) | 0x10) : ui8B];
+			}
+			FlushLineBatch();
+		}
+
+		/**
+		 * Writes the pixels gathered by RenderLine() to the render target.  Each output format gets its own loop
+		 *	over the line, with the black PAL border handled outside of the loops.
+		 */
+		void											FlushLineBatch() {
+			constexpr uint16_t ui16Left = _tBorderW, ui16Right = _tRenderW - _tBorderW;
+			uint8_t * pui8Row = &m_pui8RenderTarget[m_ui16LineBatchY*m_stRenderTargetStride];
+			switch ( m_pofOutFormat ) {
+				case LSN_POF_6BIT_PALETTE : {
+					for ( uint16_t I = 0; I < ui16Left; ++I ) { pui8Row[I] = 0x0F; }
+					for ( uint16_t I = ui16Left; I < ui16Right; ++I ) {
+						pui8Row[I] = uint8_t( m_ui16LineBatch[I] ) & 0b111111;
+					}
+					for ( uint16_t I = ui16Right; I < _tRenderW; ++I ) { pui8Row[I] = 0x0F; }
+					break;
+				}
+				case LSN_POF_9BIT_PALETTE : {
+					uint16_t * pui16Row = reinterpret_cast<uint16_t *>(pui8Row);
+					for ( uint16_t I = 0; I < ui16Left; ++I ) { pui16Row[I] = 0x0F; }
+					for ( uint16_t I = ui16Left; I < ui16Right; ++I ) {
+						pui16Row[I] = m_ui16LineBatch[I];
+					}
+					for ( uint16_t I = ui16Right; I < _tRenderW; ++I ) { pui16Row[I] = 0x0F; }
+					break;
+				}
+				case LSN_POF_RGB32 : {
+					for ( uint16_t I = 0; I < _tRenderW; ++I ) {
+						uint8_t * pui8RenderPixel = &pui8Row[I*4];
+						if ( I < ui16Left || I >= ui16Right ) {
+							pui8RenderPixel[0] = pui8RenderPixel[1] = pui8RenderPixel[2] = 0;
+						}
+						else {
+							const uint8_t * pui8Rgb = m_pPalette.uVals[m_ui16LineBatch[I]].ui8Rgb;
+							pui8RenderPixel[0] = pui8Rgb[0];
+							pui8RenderPixel[1] = pui8Rgb[1];
+							pui8RenderPixel[2] = pui8Rgb[2];
+						}
+						pui8RenderPixel[3] = 0xFF;
+					}
+					break;
+				}
+				default : {
+					for ( uint16_t I = 0; I < _tRenderW; ++I ) {
+						uint8_t * pui8RenderPixel = &pui8Row[I*3];
+						if ( I < ui16Left || I >= ui16Right ) {
+							pui8RenderPixel[0] = pui8RenderPixel[1] = pui8RenderPixel[2] = 0;
+						}
+						else {
+							const uint8_t * pui8Rgb = m_pPalette.uVals[m_ui16LineBatch[I]].ui8Rgb;
+							pui8RenderPixel[0] = pui8Rgb[0];
+							pui8RenderPixel[1] = pui8Rgb[1];
+							pui8RenderPixel[2] = pui8Rgb[2];
+						}
+					}
+				}
+			}
+		}
+
 #ifdef LSN_GEN_PPU
 		/**
 		 * Executing a single PPU cycle.
@@ -1976,20 +2536,13 @@ namespace lsn {
 				if ( (_uX >= (LSN_LEFT + 1) && _uX < LSN_RIGHT) ) {
 					sRet += "\r\n"
 					"if ( m_bRendering ) {\r\n"
-					"	for ( uint8_t I = m_ui8ThisLineSpriteCount; I--; ) {\r\n"
-					"		if ( m_asActiveSprites.ui8X[I] ) {\r\n"
-					"			--m_asActiveSprites.ui8X[I];\r\n"
-					"		}\r\n"
-					"		else {\r\n"
-					"			m_asActiveSprites.ui8ShiftLo[I] <<= 1;\r\n"
-					"			m_asActiveSprites.ui8ShiftHi[I] <<= 1;\r\n"
-					"		}\r\n"
-					"	}\r\n"
+					"	ShiftSprites();\r\n"
 					"}\r\n";
 				}
 			}
 			if ( _uY == ui61RenderHeight && _uX == 0 ) {
 				sRet += "\r\n"
+				"FlushSpriteLine();\r\n"
 				"m_ui8ThisLineSpriteCount = 0;\r\n";
 			}
 
@@ -2132,6 +2685,11 @@ namespace lsn {
 						sRet += "\r\n"
 						"m_ui8OamAddr = 0;\r\n";
 					}
+					// The pre-render line fetches sprite patterns too.  Nothing is kept, but mappers watching A12 see the fetches.
+					if ( _uY == _tDotHeight - 1 && (_uX - LSN_LEFT) % 8 >= 4 ) {
+						sRet += "\r\n"
+						"WatchA12( PreRenderSpritePatternAddr() );\r\n";
+					}
 				}
 			}
 
@@ -2345,6 +2903,18 @@ namespace lsn {
 				::OutputDebugStringA( sTmp.c_str() );
 			}
 		}
+#else
+		/**
+		 * Fills m_cCycle with the generated cycle functions.  The generated table is tens of thousands of stores that run once, so
+		 *	it is kept out of the optimizer, which otherwise spends minutes on it per region.
+		 */
+		LSN_NO_OPTIMIZE void							CreateCycleTable() {
+#include "LSNCreateCycleTableNtsc.inl"
+#include "LSNCreateCycleTablePal.inl"
+#include "LSNCreateCycleTableDendy.inl"
+#include "LSNCreateCycleTablePalM.inl"
+#include "LSNCreateCycleTablePalN.inl"
+		}
 #endif	// #ifdef LSN_GEN_PPU
 
 #include "LSNGenFuncsNtsc.inl"
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include "LSNRomBuffer.h"
 #include "LSNRomInfo.h"
 #include <vector>
 
@@ -24,8 +25,8 @@ namespace lsn {
 	struct LSN_ROM {
 		LSN_ROM_INFO								riInfo;													/**< The ROM information. */
 
-		std::vector<uint8_t>						vPrgRom;												/**< The program ROM data. */
-		std::vector<uint8_t>						vChrRom;												/**< The character ROM data. */
+		CRomBuffer									vPrgRom;												/**< The program ROM data.  Points into the mapped file or the loaded image. */
+		CRomBuffer									vChrRom;												/**< The character ROM data.  Points into the mapped file or the loaded image. */
 		std::vector<uint8_t>						vTrainerData;											/**< Trainer data. */
 		std::vector<std::vector<uint8_t>>			vFdsDiskData;											/**< FDS Disk data. */
 		std::vector<std::vector<uint8_t>>			vFdsDiskHeaders;										/**< FDS disk headers. */
@@ -0,0 +1,158 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A read-only run of ROM bytes that either points into a memory-mapped file or shares an owned buffer.
+ */
+
+#include "LSNRomBuffer.h"
+#include "../File/LSNFileMap.h"
+#include "../File/LSNZipFile.h"
+
+
+namespace lsn {
+
+	// == Functions.
+	/**
+	 * Copies bytes into a new owned buffer.
+	 *
+	 * \param _pui8Data The bytes to copy.
+	 * \param _sSize The number of bytes to copy.
+	 * \return Returns true if the buffer was allocated.
+	 */
+	bool CRomBuffer::Copy( const uint8_t * _pui8Data, size_t _sSize ) {
+		try {
+			std::vector<uint8_t> vData( _pui8Data, _pui8Data + _sSize );
+			return Take( std::move( vData ) );
+		}
+		catch ( ... ) {
+			Reset();
+			return false;
+		}
+	}
+
+	/**
+	 * Takes ownership of a buffer without copying it.
+	 *
+	 * \param _vData The buffer to take.  It is left empty.
+	 * \return Returns true if the buffer was taken.
+	 */
+	bool CRomBuffer::Take( std::vector<uint8_t> &&_vData ) {
+		Reset();
+		try {
+			auto aOwned = std::make_shared<std::vector<uint8_t>>( std::move( _vData ) );
+			m_pui8Data = aOwned->size() ? aOwned->data() : nullptr;
+			m_sSize = aOwned->size();
+			m_spStorage = std::move( aOwned );
+		}
+		catch ( ... ) {
+			Reset();
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Maps a file.
+	 *
+	 * \param _pcPath The path to the file to map.
+	 * \return Returns true if the file was mapped.
+	 */
+	bool CRomBuffer::MapFile( const char16_t * _pcPath ) {
+		Reset();
+		try {
+			auto aMap = std::make_shared<CFileMap>();
+			if ( !aMap->Open( _pcPath ) ) { return false; }
+			if ( aMap->Size() == 0 ) { return true; }
+			if ( aMap->Size() > SIZE_MAX ) { return false; }
+			const uint8_t * pui8Data = aMap->Data();
+			if ( !pui8Data ) { return false; }
+			m_pui8Data = pui8Data;
+			m_sSize = size_t( aMap->Size() );
+			m_spStorage = std::move( aMap );
+			m_bMapped = true;
+		}
+		catch ( ... ) {
+			Reset();
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Maps a file inside a ZIP archive.  A file stored without compression is mapped in place and any other file is extracted
+	 *	into an owned buffer.
+	 *
+	 * \param _pcZip The path to the ZIP archive.
+	 * \param _s16File The name of the file inside the archive.
+	 * \return Returns true if the file was mapped or extracted.
+	 */
+	bool CRomBuffer::MapZipFile( const char16_t * _pcZip, const std::u16string &_s16File ) {
+		Reset();
+		uint64_t ui64Offset, ui64Size;
+		std::vector<uint8_t> vExtracted;
+		{
+			CZipFile zfFile;
+			if ( !zfFile.Open( _pcZip ) ) { return false; }
+			if ( !zfFile.FindStoredFile( _s16File, ui64Offset, ui64Size ) ) {
+				if ( !zfFile.ExtractToMemory( _s16File, vExtracted ) ) { return false; }
+				return Take( std::move( vExtracted ) );
+			}
+		}
+		CRomBuffer rbZip;
+		if ( !rbZip.MapFile( _pcZip ) ) { return false; }
+		if ( ui64Offset + ui64Size > rbZip.size() ) { return false; }
+		(*this) = rbZip.Sub( size_t( ui64Offset ), size_t( ui64Size ) );
+		return true;
+	}
+
+	/**
+	 * Gets a range of the bytes that shares this buffer's storage.
+	 *
+	 * \param _sOffset The offset of the range.
+	 * \param _sSize The size of the range.  It is clamped to the end of the buffer.
+	 * \return Returns the range.
+	 */
+	CRomBuffer CRomBuffer::Sub( size_t _sOffset, size_t _sSize ) const {
+		CRomBuffer rbRet;
+		if ( _sOffset >= m_sSize ) { return rbRet; }
+		rbRet.m_spStorage = m_spStorage;
+		rbRet.m_pui8Data = m_pui8Data + _sOffset;
+		rbRet.m_sSize = std::min( _sSize, m_sSize - _sOffset );
+		rbRet.m_bMapped = m_bMapped;
+		return rbRet;
+	}
+
+	/**
+	 * Changes the size of the buffer.  Shortening only changes the size.  Lengthening copies the bytes into a new owned buffer
+	 *	padded with zeros.
+	 *
+	 * \param _sSize The new size.
+	 * \return Returns true if the buffer was resized.
+	 */
+	bool CRomBuffer::Resize( size_t _sSize ) {
+		if ( _sSize <= m_sSize ) {
+			m_sSize = _sSize;
+			if ( !m_sSize ) { Reset(); }
+			return true;
+		}
+		try {
+			std::vector<uint8_t> vData( _sSize );
+			if ( m_sSize ) { std::memcpy( vData.data(), m_pui8Data, m_sSize ); }
+			return Take( std::move( vData ) );
+		}
+		catch ( ... ) { return false; }
+	}
+
+	/**
+	 * Releases the bytes.
+	 */
+	void CRomBuffer::Reset() {
+		m_spStorage.reset();
+		m_pui8Data = nullptr;
+		m_sSize = 0;
+		m_bMapped = false;
+	}
+
+}	// namespace lsn
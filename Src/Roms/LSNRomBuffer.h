@@ -0,0 +1,127 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A read-only run of ROM bytes that either points into a memory-mapped file or shares an owned buffer.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CRomBuffer
+	 * \brief A read-only run of ROM bytes that either points into a memory-mapped file or shares an owned buffer.
+	 *
+	 * Description: A read-only run of ROM bytes that either points into a memory-mapped file or shares an owned buffer.
+	 * A .NES file (or a ZIP entry stored without compression) is mapped and PRG and CHR ROM point straight into the mapping.  Only
+	 *	compressed or patched images are held in an owned buffer, and PRG and CHR ROM then point into that buffer.  Copies and
+	 *	sub-ranges share the mapping or buffer, which stays alive until the last one is destroyed.
+	 * data() and size() are named after std::vector's so that mappers can read ROM the same way regardless of where it lives.
+	 */
+	class CRomBuffer {
+	public :
+		// == Functions.
+		/**
+		 * Copies bytes into a new owned buffer.
+		 *
+		 * \param _pui8Data The bytes to copy.
+		 * \param _sSize The number of bytes to copy.
+		 * \return Returns true if the buffer was allocated.
+		 */
+		bool												Copy( const uint8_t * _pui8Data, size_t _sSize );
+
+		/**
+		 * Takes ownership of a buffer without copying it.
+		 *
+		 * \param _vData The buffer to take.  It is left empty.
+		 * \return Returns true if the buffer was taken.
+		 */
+		bool												Take( std::vector<uint8_t> &&_vData );
+
+		/**
+		 * Maps a file.
+		 *
+		 * \param _pcPath The path to the file to map.
+		 * \return Returns true if the file was mapped.
+		 */
+		bool												MapFile( const char16_t * _pcPath );
+
+		/**
+		 * Maps a file inside a ZIP archive.  A file stored without compression is mapped in place and any other file is extracted
+		 *	into an owned buffer.
+		 *
+		 * \param _pcZip The path to the ZIP archive.
+		 * \param _s16File The name of the file inside the archive.
+		 * \return Returns true if the file was mapped or extracted.
+		 */
+		bool												MapZipFile( const char16_t * _pcZip, const std::u16string &_s16File );
+
+		/**
+		 * Gets a range of the bytes that shares this buffer's storage.
+		 *
+		 * \param _sOffset The offset of the range.
+		 * \param _sSize The size of the range.  It is clamped to the end of the buffer.
+		 * \return Returns the range.
+		 */
+		CRomBuffer											Sub( size_t _sOffset, size_t _sSize ) const;
+
+		/**
+		 * Changes the size of the buffer.  Shortening only changes the size.  Lengthening copies the bytes into a new owned buffer
+		 *	padded with zeros.
+		 *
+		 * \param _sSize The new size.
+		 * \return Returns true if the buffer was resized.
+		 */
+		bool												Resize( size_t _sSize );
+
+		/**
+		 * Releases the bytes.
+		 */
+		void												Reset();
+
+		/**
+		 * Determines whether the bytes are in a memory-mapped file rather than an owned buffer.
+		 *
+		 * \return Returns true if the bytes are mapped.
+		 */
+		inline bool											IsMapped() const { return m_bMapped; }
+
+		/**
+		 * Gets the bytes.
+		 *
+		 * \return Returns a pointer to the bytes, or nullptr if the buffer is empty.
+		 */
+		inline const uint8_t *								data() const { return m_pui8Data; }
+
+		/**
+		 * Gets the number of bytes.
+		 *
+		 * \return Returns the number of bytes.
+		 */
+		inline size_t										size() const { return m_sSize; }
+
+
+	protected :
+		// == Members.
+		/** Keeps the mapping or owned buffer alive. */
+		std::shared_ptr<const void>							m_spStorage;
+		/** The bytes. */
+		const uint8_t *										m_pui8Data = nullptr;
+		/** The number of bytes. */
+		size_t												m_sSize = 0;
+		/** If true, m_spStorage is a mapped file. */
+		bool												m_bMapped = false;
+	};
+
+}	// namespace lsn
@@ -0,0 +1,270 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: An index of a ROM library.  Scans folders and ZIP archives for ROMs on the job pool and remembers the size, time,
+ *	CRC, mapper, and region of each one, so that later scans only need to open the files that changed.
+ */
+
+#include "LSNRomIndex.h"
+#include "../File/LSNStdFile.h"
+#include "../File/LSNZipFile.h"
+#include "../System/LSNSystemBase.h"
+#include "../Utilities/LSNJobPool.h"
+#include "../Utilities/LSNStream.h"
+#include "../Utilities/LSNUtilities.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+
+#define LSN_ROM_INDEX_MAGIC								0x584E494C			/**< "LINX" as a little-endian uint32_t. */
+#define LSN_ROM_INDEX_VERSION							0
+
+
+namespace lsn {
+
+	// == Functions.
+	/**
+	 * Scans folders for .nes and .zip files, recursively.  Files whose size and last-write time match the index keep their entries
+	 *	and the rest are opened and parsed across the job pool.  Entries for files that are no longer found are removed.
+	 *
+	 * \param _vFolders The folders to scan.  Paths to individual files are also accepted.
+	 * \param _pssStats If not nullptr, holds the results of the scan.
+	 * \return Returns true if the scan finished.  False indicates a memory failure, in which case the index is unchanged.
+	 */
+	bool CRomIndex::Scan( const std::vector<std::u16string> &_vFolders, LSN_SCAN_STATS * _pssStats ) {
+		LSN_SCAN_STATS ssStats;
+		std::vector<LSN_FILE> vFiles;
+		std::vector<LSN_ENTRY> vEntries;
+		try {
+			// Gather the files.  Only the directory walk and a stat per file happen here; nothing is opened yet.
+			auto AddFile = [&]( const std::filesystem::path &_pPath ) {
+				std::u16string u16Ext = CUtilities::ToLower( _pPath.extension().u16string() );
+				if ( u16Ext != u".nes" && u16Ext != u".zip" ) { return; }
+				std::error_code ecErr;
+				uint64_t ui64Size = std::filesystem::file_size( _pPath, ecErr );
+				if ( ecErr ) { return; }
+				auto aTime = std::filesystem::last_write_time( _pPath, ecErr );
+				if ( ecErr ) { return; }
+				vFiles.push_back( { _pPath.u16string(), ui64Size, int64_t( aTime.time_since_epoch().count() ) } );
+			};
+			for ( size_t I = 0; I < _vFolders.size(); ++I ) {
+				std::filesystem::path pRoot( _vFolders[I] );
+				std::error_code ecErr;
+				if ( std::filesystem::is_regular_file( pRoot, ecErr ) ) {
+					AddFile( pRoot );
+					continue;
+				}
+				for ( std::filesystem::recursive_directory_iterator rdiIt( pRoot, std::filesystem::directory_options::skip_permission_denied, ecErr ), rdiEnd;
+					!ecErr && rdiIt != rdiEnd; rdiIt.increment( ecErr ) ) {
+					std::error_code ecType;
+					if ( rdiIt->is_regular_file( ecType ) ) { AddFile( rdiIt->path() ); }
+				}
+			}
+			std::sort( vFiles.begin(), vFiles.end(), []( const LSN_FILE &_fA, const LSN_FILE &_fB ) { return _fA.u16File < _fB.u16File; } );
+			vFiles.erase( std::unique( vFiles.begin(), vFiles.end(), []( const LSN_FILE &_fA, const LSN_FILE &_fB ) { return _fA.u16File == _fB.u16File; } ), vFiles.end() );
+			ssStats.sFiles = vFiles.size();
+
+			// Keep the entries of unchanged files and queue the rest.
+			std::map<std::u16string, std::vector<const LSN_ENTRY *>> mOld;
+			for ( size_t I = 0; I < m_vEntries.size(); ++I ) {
+				mOld[m_vEntries[I].u16File].push_back( &m_vEntries[I] );
+			}
+			std::vector<LSN_FILE *> vOpen;
+			for ( size_t I = 0; I < vFiles.size(); ++I ) {
+				auto aOld = mOld.find( vFiles[I].u16File );
+				if ( aOld != mOld.end() ) {
+					const LSN_ENTRY * peFirst = aOld->second[0];
+					if ( peFirst->ui64Size == vFiles[I].ui64Size && peFirst->i64Time == vFiles[I].i64Time ) {
+						for ( size_t J = 0; J < aOld->second.size(); ++J ) {
+							vFiles[I].vEntries.push_back( (*aOld->second[J]) );
+						}
+					}
+					else {
+						vOpen.push_back( &vFiles[I] );
+					}
+					mOld.erase( aOld );
+				}
+				else {
+					vOpen.push_back( &vFiles[I] );
+				}
+			}
+			// Whatever was not matched belongs to files that are gone.
+			for ( auto & aGone : mOld ) {
+				ssStats.sRemoved += aGone.second.size();
+			}
+			ssStats.sOpened = vOpen.size();
+
+			// Each changed file is opened, decompressed, and hashed on its own job.
+			CJobPool::Get().ParallelFor( ParseFile, &vOpen, vOpen.size() );
+
+			for ( size_t I = 0; I < vFiles.size(); ++I ) {
+				for ( size_t J = 0; J < vFiles[I].vEntries.size(); ++J ) {
+					if ( vFiles[I].vEntries[J].bRom ) { ++ssStats.sRoms; }
+					vEntries.push_back( std::move( vFiles[I].vEntries[J] ) );
+				}
+			}
+			std::sort( vEntries.begin(), vEntries.end(), []( const LSN_ENTRY &_eA, const LSN_ENTRY &_eB ) { return _eA.u16Path < _eB.u16Path; } );
+		}
+		catch ( ... ) { return false; }
+
+		m_vEntries.swap( vEntries );
+		if ( _pssStats ) { (*_pssStats) = ssStats; }
+		return true;
+	}
+
+	/**
+	 * Loads an index previously written by Save().
+	 *
+	 * \param _pcPath The path to the index file.
+	 * \return Returns true if the index was loaded.  On failure the index is empty.
+	 */
+	bool CRomIndex::Load( const char16_t * _pcPath ) {
+		m_vEntries.clear();
+		std::vector<uint8_t> vFile;
+		if ( !CStdFile::LoadToMemory( _pcPath, vFile ) ) { return false; }
+		CStream sStream( vFile );
+		uint32_t ui32Magic, ui32Version, ui32Total;
+		if ( !sStream.ReadUi32( ui32Magic ) || ui32Magic != LSN_ROM_INDEX_MAGIC ) { return false; }
+		if ( !sStream.ReadUi32( ui32Version ) || ui32Version != LSN_ROM_INDEX_VERSION ) { return false; }
+		if ( !sStream.ReadUi32( ui32Total ) || ui32Total > vFile.size() ) { return false; }
+		try {
+			std::vector<LSN_ENTRY> vEntries;
+			vEntries.resize( ui32Total );
+			for ( uint32_t I = 0; I < ui32Total; ++I ) {
+				LSN_ENTRY & eEntry = vEntries[I];
+				uint16_t ui16Region;
+				if ( !sStream.ReadStringU16( eEntry.u16Path ) ||
+					!sStream.ReadStringU16( eEntry.u16File ) ||
+					!sStream.ReadUi64( eEntry.ui64Size ) ||
+					!sStream.ReadI64( eEntry.i64Time ) ||
+					!sStream.ReadUi32( eEntry.ui32Crc ) ||
+					!sStream.ReadUi16( eEntry.ui16Mapper ) ||
+					!sStream.ReadUi16( ui16Region ) ||
+					!sStream.ReadBool( eEntry.bRom ) ) { return false; }
+				eEntry.pmRegion = LSN_PPU_METRICS( ui16Region );
+			}
+			std::sort( vEntries.begin(), vEntries.end(), []( const LSN_ENTRY &_eA, const LSN_ENTRY &_eB ) { return _eA.u16Path < _eB.u16Path; } );
+			m_vEntries.swap( vEntries );
+		}
+		catch ( ... ) { return false; }
+		return true;
+	}
+
+	/**
+	 * Writes the index to a file.
+	 *
+	 * \param _pcPath The path to the index file.
+	 * \return Returns true if the index was written.
+	 */
+	bool CRomIndex::Save( const char16_t * _pcPath ) const {
+		std::vector<uint8_t> vFile;
+		try {
+			CStream sStream( vFile );
+			if ( !sStream.WriteUi32( LSN_ROM_INDEX_MAGIC ) ) { return false; }
+			if ( !sStream.WriteUi32( LSN_ROM_INDEX_VERSION ) ) { return false; }
+			if ( !sStream.WriteUi32( uint32_t( m_vEntries.size() ) ) ) { return false; }
+			for ( size_t I = 0; I < m_vEntries.size(); ++I ) {
+				const LSN_ENTRY & eEntry = m_vEntries[I];
+				if ( !sStream.WriteStringU16( eEntry.u16Path ) ||
+					!sStream.WriteStringU16( eEntry.u16File ) ||
+					!sStream.WriteUi64( eEntry.ui64Size ) ||
+					!sStream.WriteI64( eEntry.i64Time ) ||
+					!sStream.WriteUi32( eEntry.ui32Crc ) ||
+					!sStream.WriteUi16( eEntry.ui16Mapper ) ||
+					!sStream.WriteUi16( uint16_t( eEntry.pmRegion ) ) ||
+					!sStream.WriteBool( eEntry.bRom ) ) { return false; }
+			}
+		}
+		catch ( ... ) { return false; }
+		CStdFile sfFile;
+		if ( !sfFile.Create( _pcPath ) ) { return false; }
+		return sfFile.WriteToFile( vFile );
+	}
+
+	/**
+	 * Finds the entry for a ROM path.
+	 *
+	 * \param _u16Path The ROM path to find.
+	 * \return Returns the entry or nullptr if the path is not in the index.
+	 */
+	const CRomIndex::LSN_ENTRY * CRomIndex::Find( const std::u16string &_u16Path ) const {
+		auto aFound = std::lower_bound( m_vEntries.begin(), m_vEntries.end(), _u16Path, []( const LSN_ENTRY &_eEntry, const std::u16string &_u16Find ) { return _eEntry.u16Path < _u16Find; } );
+		if ( aFound == m_vEntries.end() || aFound->u16Path != _u16Path ) { return nullptr; }
+		return &(*aFound);
+	}
+
+	/**
+	 * Opens and parses a file found by a scan.  Runs on the job pool.
+	 *
+	 * \param _pvParm A pointer to the std::vector<LSN_FILE *> of files to open.
+	 * \param _sIdx The index of the file to open.
+	 */
+	void CRomIndex::ParseFile( void * _pvParm, size_t _sIdx ) {
+		LSN_FILE & fFile = *(*static_cast<std::vector<LSN_FILE *> *>(_pvParm))[_sIdx];
+		try {
+			std::vector<uint8_t> vData;
+			if ( CStdFile::LoadToMemory( fFile.u16File.c_str(), vData ) ) {
+				if ( CUtilities::ToLower( CUtilities::GetFileExtension( fFile.u16File ) ) == u"zip" ) {
+					CZipFile zfFile;
+					if ( zfFile.OpenMemory( vData.data(), vData.size() ) ) {
+						std::vector<std::u16string> vNames;
+						std::vector<std::vector<uint8_t>> vRoms;
+						zfFile.ExtractToMemory( vNames, vRoms, u".nes" );
+						for ( size_t I = 0; I < vNames.size() && I < vRoms.size(); ++I ) {
+							LSN_ENTRY eEntry;
+							if ( ParseRom( vRoms[I], fFile.u16File + u"{" + vNames[I] + u"}", fFile, eEntry ) ) {
+								fFile.vEntries.push_back( std::move( eEntry ) );
+							}
+						}
+					}
+				}
+				else {
+					LSN_ENTRY eEntry;
+					if ( ParseRom( vData, fFile.u16File, fFile, eEntry ) ) {
+						fFile.vEntries.push_back( std::move( eEntry ) );
+					}
+				}
+			}
+			if ( fFile.vEntries.empty() ) {
+				// Remember that there is nothing here so that the file is not opened again until it changes.
+				LSN_ENTRY eEntry;
+				eEntry.u16Path = fFile.u16File;
+				eEntry.u16File = fFile.u16File;
+				eEntry.ui64Size = fFile.ui64Size;
+				eEntry.i64Time = fFile.i64Time;
+				fFile.vEntries.push_back( std::move( eEntry ) );
+			}
+		}
+		catch ( ... ) {
+			// Out of memory.  Leave the file out of the index so that it is opened again on the next scan.
+			fFile.vEntries.clear();
+		}
+	}
+
+	/**
+	 * Parses an in-memory ROM image into an entry.
+	 *
+	 * \param _vRom The ROM image.
+	 * \param _u16Path The ROM path.
+	 * \param _fFile The file that holds the ROM.
+	 * \param _eEntry Holds the parsed entry.
+	 * \return Returns true if the image is a ROM that could be loaded.
+	 */
+	bool CRomIndex::ParseRom( const std::vector<uint8_t> &_vRom, const std::u16string &_u16Path, const LSN_FILE &_fFile, LSN_ENTRY &_eEntry ) {
+		LSN_ROM rRom;
+		if ( !CSystemBase::LoadRom( _vRom, rRom, _u16Path ) ) { return false; }
+		_eEntry.u16Path = _u16Path;
+		_eEntry.u16File = _fFile.u16File;
+		_eEntry.ui64Size = _fFile.ui64Size;
+		_eEntry.i64Time = _fFile.i64Time;
+		_eEntry.ui32Crc = rRom.riInfo.ui32Crc;
+		_eEntry.ui16Mapper = rRom.riInfo.ui16Mapper;
+		_eEntry.pmRegion = rRom.riInfo.pmConsoleRegion;
+		_eEntry.bRom = true;
+		return true;
+	}
+
+}	// namespace lsn
@@ -0,0 +1,135 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: An index of a ROM library.  Scans folders and ZIP archives for ROMs on the job pool and remembers the size, time,
+ *	CRC, mapper, and region of each one, so that later scans only need to open the files that changed.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+
+#include <string>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CRomIndex
+	 * \brief An index of a ROM library.
+	 *
+	 * Description: An index of a ROM library.  Scans folders and ZIP archives for ROMs on the job pool and remembers the size, time,
+	 *	CRC, mapper, and region of each one, so that later scans only need to open the files that changed.
+	 * ROMs inside ZIP archives are indexed under the same "archive.zip{rom.nes}" paths the main window uses when loading from an
+	 *	archive.  A file that holds no ROMs is still indexed (with bRom cleared) so that it is not opened again until it changes.
+	 * CDatabase::Init() must be called before scanning, since the CRC and the overrides come from CSystemBase::LoadRom().
+	 */
+	class CRomIndex {
+	public :
+		// == Types.
+		/** An indexed ROM. */
+		struct LSN_ENTRY {
+			std::u16string									u16Path;											/**< The ROM path.  ROMs in archives use "archive.zip{rom.nes}". */
+			std::u16string									u16File;											/**< The file on disk that holds the ROM. */
+			uint64_t										ui64Size = 0;										/**< The size of u16File when it was scanned. */
+			int64_t											i64Time = 0;										/**< The last-write time of u16File when it was scanned. */
+			uint32_t										ui32Crc = 0;										/**< The PRG ROM CRC (the database key). */
+			uint16_t										ui16Mapper = 0;										/**< The mapper, after database overrides. */
+			LSN_PPU_METRICS									pmRegion = LSN_PM_UNKNOWN;							/**< The region, after database overrides. */
+			bool											bRom = false;										/**< If false, u16File holds no ROM that could be loaded. */
+		};
+
+		/** The results of a scan. */
+		struct LSN_SCAN_STATS {
+			size_t											sFiles = 0;											/**< The number of .nes and .zip files found. */
+			size_t											sOpened = 0;										/**< The number of files that were new or changed and had to be opened. */
+			size_t											sRemoved = 0;										/**< The number of entries removed because their files are gone. */
+			size_t											sRoms = 0;											/**< The number of ROMs in the index after the scan. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Scans folders for .nes and .zip files, recursively.  Files whose size and last-write time match the index keep their entries
+		 *	and the rest are opened and parsed across the job pool.  Entries for files that are no longer found are removed.
+		 *
+		 * \param _vFolders The folders to scan.  Paths to individual files are also accepted.
+		 * \param _pssStats If not nullptr, holds the results of the scan.
+		 * \return Returns true if the scan finished.  False indicates a memory failure, in which case the index is unchanged.
+		 */
+		bool												Scan( const std::vector<std::u16string> &_vFolders, LSN_SCAN_STATS * _pssStats = nullptr );
+
+		/**
+		 * Loads an index previously written by Save().
+		 *
+		 * \param _pcPath The path to the index file.
+		 * \return Returns true if the index was loaded.  On failure the index is empty.
+		 */
+		bool												Load( const char16_t * _pcPath );
+
+		/**
+		 * Writes the index to a file.
+		 *
+		 * \param _pcPath The path to the index file.
+		 * \return Returns true if the index was written.
+		 */
+		bool												Save( const char16_t * _pcPath ) const;
+
+		/**
+		 * Gets the entries, sorted by path.
+		 *
+		 * \return Returns the entries.
+		 */
+		inline const std::vector<LSN_ENTRY> &				Entries() const { return m_vEntries; }
+
+		/**
+		 * Finds the entry for a ROM path.
+		 *
+		 * \param _u16Path The ROM path to find.
+		 * \return Returns the entry or nullptr if the path is not in the index.
+		 */
+		const LSN_ENTRY *									Find( const std::u16string &_u16Path ) const;
+
+
+	protected :
+		// == Types.
+		/** A file found by a scan. */
+		struct LSN_FILE {
+			std::u16string									u16File;											/**< The path to the file. */
+			uint64_t										ui64Size;											/**< The size of the file. */
+			int64_t											i64Time;											/**< The last-write time of the file. */
+			std::vector<LSN_ENTRY>							vEntries;											/**< The entries of the file once it has been parsed. */
+		};
+
+
+		// == Members.
+		/** The entries, sorted by path. */
+		std::vector<LSN_ENTRY>								m_vEntries;
+
+
+		// == Functions.
+		/**
+		 * Opens and parses a file found by a scan.  Runs on the job pool.
+		 *
+		 * \param _pvParm A pointer to the std::vector<LSN_FILE *> of files to open.
+		 * \param _sIdx The index of the file to open.
+		 */
+		static void											ParseFile( void * _pvParm, size_t _sIdx );
+
+		/**
+		 * Parses an in-memory ROM image into an entry.
+		 *
+		 * \param _vRom The ROM image.
+		 * \param _u16Path The ROM path.
+		 * \param _fFile The file that holds the ROM.
+		 * \param _eEntry Holds the parsed entry.
+		 * \return Returns true if the image is a ROM that could be loaded.
+		 */
+		static bool											ParseRom( const std::vector<uint8_t> &_vRom, const std::u16string &_u16Path, const LSN_FILE &_fFile, LSN_ENTRY &_eEntry );
+	};
+
+}	// namespace lsn
@@ -21,15 +21,54 @@ namespace lsn {
 	 */
 	class CBussable {
 	public :
+		// == Types.
+		/** A function called when address line A12 changes.  _bHigh is the new state of the line. */
+		typedef void (LSN_FASTCALL *						PfA12Func)( void * _pvParm0, bool _bHigh );
+
+
 		// == Functions.
 		/**
 		 * Gets the last bus address.
 		 */
 		virtual uint16_t									LastBusAddress() const { return m_ui16LastBusAddr; }
 
+		/**
+		 * Sets the function to call each time address line A12 rises or falls.  Mappers that count scanlines by watching A12 (MMC3,
+		 *	MMC6) register here instead of being ticked on every cycle.  The line is assumed to be low when the function is set.
+		 *
+		 * \param _pfFunc The function to call, or nullptr to stop watching A12.
+		 * \param _pvParm0 The pointer to pass to _pfFunc.
+		 */
+		void												SetA12Notify( PfA12Func _pfFunc, void * _pvParm0 ) {
+			m_pfA12Func = _pfFunc;
+			m_pvA12Parm0 = _pvParm0;
+			m_bA12High = false;
+		}
+
 	protected :
 		// == Members.
 		uint16_t											m_ui16LastBusAddr = 0;
+		PfA12Func											m_pfA12Func = nullptr;					/**< The function to call when A12 changes. */
+		void *												m_pvA12Parm0 = nullptr;					/**< The pointer passed to m_pfA12Func. */
+		bool												m_bA12High = false;						/**< The last state of A12 passed to m_pfA12Func. */
+
+
+		// == Functions.
+		/**
+		 * Informs the A12 watcher of an address placed on the bus.  Does nothing unless a watcher is set and A12 differs from the
+		 *	last address passed.
+		 *
+		 * \param _ui16Addr The address on the bus.
+		 */
+		inline void											WatchA12( uint16_t _ui16Addr ) {
+			if LSN_UNLIKELY( m_pfA12Func ) {
+				bool bHigh = (_ui16Addr & 0x1000) != 0;
+				if ( bHigh != m_bA12High ) {
+					m_bA12High = bHigh;
+					m_pfA12Func( m_pvA12Parm0, bHigh );
+				}
+			}
+		}
 	};
 
 }	// namespace lsn
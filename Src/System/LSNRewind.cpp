@@ -0,0 +1,264 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A rewind buffer.  Keeps a ring of per-frame machine states within a fixed memory budget.  Every Nth state is stored as
+ *	a key frame and the states in between are stored as the run-length-encoded XOR of themselves against their key frame.
+ */
+
+#include "LSNRewind.h"
+#include "../MiniZ/miniz.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace lsn {
+
+	CRewind::CRewind( size_t _sBudget, uint32_t _ui32KeyFrameInterval, bool _bCompressKeyFrames ) :
+		m_sHead( 0 ),
+		m_sCount( 0 ),
+		m_sSize( 0 ),
+		m_sBudget( _sBudget ),
+		m_ui32KeyFrameInterval( std::max<uint32_t>( _ui32KeyFrameInterval, 1 ) ),
+		m_ui32SinceKeyFrame( 0 ),
+		m_bCompressKeyFrames( _bCompressKeyFrames ) {
+	}
+	CRewind::~CRewind() {
+	}
+
+	// == Functions.
+	/**
+	 * Captures the current state of the given system.  If the buffer goes over its memory budget, the oldest key frame and the
+	 *	frames that depend on it are discarded.
+	 *
+	 * \param _sbSystem The system whose state is to be captured.
+	 * \return Returns true if the state was captured.
+	 */
+	bool CRewind::Capture( const CSystemBase &_sbSystem ) {
+		try {
+			m_vState.clear();
+			CStream sStream( m_vState );
+			if ( !_sbSystem.SaveState( sStream ) ) { return false; }
+
+			bool bKeyFrame = m_sCount == 0 || m_ui32SinceKeyFrame >= m_ui32KeyFrameInterval || m_vKeyFrame.size() != m_vState.size();
+			if ( bKeyFrame ) {
+				if ( m_bCompressKeyFrames ) {
+					mz_ulong ulSize = ::mz_compressBound( mz_ulong( m_vState.size() ) );
+					m_vEncoded.resize( ulSize );
+					if ( ::mz_compress2( m_vEncoded.data(), &ulSize, m_vState.data(), mz_ulong( m_vState.size() ), MZ_BEST_SPEED ) != MZ_OK ) { return false; }
+					m_vEncoded.resize( ulSize );
+				}
+				else {
+					m_vEncoded = m_vState;
+				}
+				m_vKeyFrame.swap( m_vState );
+				m_ui32SinceKeyFrame = 0;
+			}
+			else {
+				EncodeDelta( m_vState.data(), m_vKeyFrame.data(), m_vState.size(), m_vEncoded );
+			}
+
+			LSN_FRAME & fFrame = PushFrame();
+			fFrame.vData.assign( m_vEncoded.begin(), m_vEncoded.end() );
+			fFrame.sRawSize = m_vKeyFrame.size();
+			fFrame.bKeyFrame = bKeyFrame;
+			m_sSize += fFrame.vData.size();
+			++m_ui32SinceKeyFrame;
+		}
+		catch ( ... ) { return false; }
+
+		while ( m_sSize > m_sBudget ) {
+			if ( !PopKeyFrame() ) { break; }
+		}
+		return true;
+	}
+
+	/**
+	 * Loads a captured state into the given system and discards every capture made after it.  The loaded state remains in the buffer
+	 *	as the most recent capture.
+	 *
+	 * \param _sbSystem The system into which to load the state.  Must be the system that made the captures.
+	 * \param _sFrames The number of captures to go back.  0 reloads the most recent capture.
+	 * \return Returns true if there were enough captures and the state was loaded.
+	 */
+	bool CRewind::Rewind( CSystemBase &_sbSystem, size_t _sFrames ) {
+		if ( _sFrames >= m_sCount ) { return false; }
+		size_t sIdx = m_sCount - 1 - _sFrames;
+		size_t sKey = sIdx;
+		while ( !Frame( sKey ).bKeyFrame ) {
+			if ( !sKey ) { return false; }
+			--sKey;
+		}
+
+		// Until the key frame is known to be decoded, the next capture must be a key frame.
+		m_ui32SinceKeyFrame = m_ui32KeyFrameInterval;
+		try {
+			if ( !DecodeKeyFrame( Frame( sKey ), m_vKeyFrame ) ) { return false; }
+			m_vState = m_vKeyFrame;
+		}
+		catch ( ... ) { return false; }
+		if ( sIdx != sKey ) {
+			if ( !DecodeDelta( Frame( sIdx ).vData, m_vState.data(), m_vState.size() ) ) { return false; }
+		}
+
+		CStream sStream( m_vState );
+		if ( !_sbSystem.LoadState( sStream ) ) { return false; }
+
+		while ( m_sCount > sIdx + 1 ) {
+			PopBackFrame();
+		}
+		m_ui32SinceKeyFrame = uint32_t( sIdx - sKey + 1 );
+		return true;
+	}
+
+	/**
+	 * Discards all captures.
+	 */
+	void CRewind::Reset() {
+		m_vFrames = std::vector<LSN_FRAME>();
+		m_vKeyFrame = std::vector<uint8_t>();
+		m_sHead = 0;
+		m_sCount = 0;
+		m_sSize = 0;
+		m_ui32SinceKeyFrame = 0;
+	}
+
+	/**
+	 * Adds an empty capture after the most recent one, growing the ring if it is full.
+	 *
+	 * \return Returns the new capture.
+	 */
+	CRewind::LSN_FRAME & CRewind::PushFrame() {
+		if ( m_sCount == m_vFrames.size() ) {
+			// Unwrap the ring so that the new capture can go on the end.
+			std::rotate( m_vFrames.begin(), m_vFrames.begin() + m_sHead, m_vFrames.end() );
+			m_sHead = 0;
+			m_vFrames.emplace_back();
+		}
+		return Frame( m_sCount++ );
+	}
+
+	/**
+	 * Discards the oldest key frame and every delta that depends on it.  The key frame of the most recent capture is never discarded.
+	 *
+	 * \return Returns true if a key frame was discarded.
+	 */
+	bool CRewind::PopKeyFrame() {
+		size_t sNextKey = 1;
+		while ( sNextKey < m_sCount && !Frame( sNextKey ).bKeyFrame ) { ++sNextKey; }
+		if ( sNextKey >= m_sCount ) { return false; }
+
+		for ( size_t I = 0; I < sNextKey; ++I ) {
+			LSN_FRAME & fFrame = Frame( 0 );
+			m_sSize -= fFrame.vData.size();
+			fFrame.vData = std::vector<uint8_t>();
+			m_sHead = (m_sHead + 1) % m_vFrames.size();
+			--m_sCount;
+		}
+		return true;
+	}
+
+	/**
+	 * Discards the most recent capture.
+	 */
+	void CRewind::PopBackFrame() {
+		LSN_FRAME & fFrame = Frame( --m_sCount );
+		m_sSize -= fFrame.vData.size();
+		fFrame.vData = std::vector<uint8_t>();
+	}
+
+	/**
+	 * Decodes a key frame.
+	 *
+	 * \param _fFrame The key frame to decode.
+	 * \param _vDst Holds the decoded state.
+	 * \return Returns true if the key frame was decoded.
+	 */
+	bool CRewind::DecodeKeyFrame( const LSN_FRAME &_fFrame, std::vector<uint8_t> &_vDst ) const {
+		if ( !m_bCompressKeyFrames ) {
+			_vDst = _fFrame.vData;
+			return true;
+		}
+		_vDst.resize( _fFrame.sRawSize );
+		mz_ulong ulSize = mz_ulong( _vDst.size() );
+		if ( ::mz_uncompress( _vDst.data(), &ulSize, _fFrame.vData.data(), mz_ulong( _fFrame.vData.size() ) ) != MZ_OK ) { return false; }
+		return ulSize == _vDst.size();
+	}
+
+	/**
+	 * Encodes the XOR of a state against its key frame as alternating runs of unchanged and changed bytes.  Each run is written as the
+	 *	number of bytes to skip and the number of XOR'ed bytes that follow, both as variable-length integers, followed by the XOR'ed
+	 *	bytes.
+	 *
+	 * \param _pui8State The state to encode.
+	 * \param _pui8Key The key frame.  Must be the same size as _pui8State.
+	 * \param _sSize The size of the state and key frame.
+	 * \param _vDst Holds the encoded delta.
+	 */
+	void CRewind::EncodeDelta( const uint8_t * _pui8State, const uint8_t * _pui8Key, size_t _sSize, std::vector<uint8_t> &_vDst ) {
+		// A changed run only ends once this many unchanged bytes follow it; shorter gaps cost less to XOR than to start a new run.
+		constexpr size_t sMinSkip = sizeof( uint64_t );
+		_vDst.clear();
+		size_t I = 0;
+		while ( I < _sSize ) {
+			size_t sSkipStart = I;
+			// Most of the state is unchanged, so skip it a word at a time.
+			while ( I + sizeof( uint64_t ) <= _sSize ) {
+				uint64_t ui64State, ui64Key;
+				std::memcpy( &ui64State, _pui8State + I, sizeof( uint64_t ) );
+				std::memcpy( &ui64Key, _pui8Key + I, sizeof( uint64_t ) );
+				if ( ui64State != ui64Key ) { break; }
+				I += sizeof( uint64_t );
+			}
+			while ( I < _sSize && _pui8State[I] == _pui8Key[I] ) { ++I; }
+			if ( I == _sSize ) { break; }
+
+			size_t sRunStart = I, sRunEnd = I, sSame = 0;
+			for ( ; I < _sSize; ++I ) {
+				if ( _pui8State[I] != _pui8Key[I] ) {
+					sSame = 0;
+					sRunEnd = I + 1;
+				}
+				else if ( ++sSame == sMinSkip ) { break; }
+			}
+			I = sRunEnd;
+
+			WriteVarInt( sRunStart - sSkipStart, _vDst );
+			WriteVarInt( sRunEnd - sRunStart, _vDst );
+			size_t sOffset = _vDst.size();
+			_vDst.resize( sOffset + (sRunEnd - sRunStart) );
+			for ( size_t J = sRunStart; J < sRunEnd; ++J ) {
+				_vDst[sOffset++] = _pui8State[J] ^ _pui8Key[J];
+			}
+		}
+	}
+
+	/**
+	 * Applies a delta created by EncodeDelta() in-place to a copy of its key frame.
+	 *
+	 * \param _vDelta The delta.
+	 * \param _pui8State The key frame to turn into the encoded state.
+	 * \param _sSize The size of the state.
+	 * \return Returns false if the delta is corrupt.
+	 */
+	bool CRewind::DecodeDelta( const std::vector<uint8_t> &_vDelta, uint8_t * _pui8State, size_t _sSize ) {
+		const uint8_t * pui8Src = _vDelta.data();
+		const uint8_t * pui8End = pui8Src + _vDelta.size();
+		size_t sPos = 0;
+		while ( pui8Src < pui8End ) {
+			uint64_t ui64Skip, ui64Len;
+			if ( !ReadVarInt( pui8Src, pui8End, ui64Skip ) ) { return false; }
+			if ( !ReadVarInt( pui8Src, pui8End, ui64Len ) ) { return false; }
+			if ( ui64Skip > _sSize - sPos ) { return false; }
+			sPos += size_t( ui64Skip );
+			if ( ui64Len > _sSize - sPos || ui64Len > size_t( pui8End - pui8Src ) ) { return false; }
+			for ( size_t I = 0; I < ui64Len; ++I ) {
+				_pui8State[sPos++] ^= (*pui8Src++);
+			}
+		}
+		return true;
+	}
+
+}	// namespace lsn
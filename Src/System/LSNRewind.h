@@ -0,0 +1,197 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A rewind buffer.  Keeps a ring of per-frame machine states within a fixed memory budget.  Every Nth state is stored as
+ *	a key frame and the states in between are stored as the run-length-encoded XOR of themselves against their key frame.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "LSNSystemBase.h"
+
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CRewind
+	 * \brief A rewind buffer.
+	 *
+	 * Description: A rewind buffer.  Keeps a ring of per-frame machine states within a fixed memory budget.  Every Nth state is stored as
+	 *	a key frame and the states in between are stored as the run-length-encoded XOR of themselves against their key frame.
+	 */
+	class CRewind {
+	public :
+		CRewind( size_t _sBudget = 32 * 1024 * 1024, uint32_t _ui32KeyFrameInterval = 60, bool _bCompressKeyFrames = false );
+		~CRewind();
+
+
+		// == Functions.
+		/**
+		 * Captures the current state of the given system.  If the buffer goes over its memory budget, the oldest key frame and the
+		 *	frames that depend on it are discarded.
+		 *
+		 * \param _sbSystem The system whose state is to be captured.
+		 * \return Returns true if the state was captured.
+		 */
+		bool											Capture( const CSystemBase &_sbSystem );
+
+		/**
+		 * Loads a captured state into the given system and discards every capture made after it.  The loaded state remains in the buffer
+		 *	as the most recent capture.
+		 *
+		 * \param _sbSystem The system into which to load the state.  Must be the system that made the captures.
+		 * \param _sFrames The number of captures to go back.  0 reloads the most recent capture.
+		 * \return Returns true if there were enough captures and the state was loaded.
+		 */
+		bool											Rewind( CSystemBase &_sbSystem, size_t _sFrames );
+
+		/**
+		 * Discards all captures.
+		 */
+		void											Reset();
+
+		/**
+		 * Gets the number of captures in the buffer.
+		 *
+		 * \return Returns the number of frames that can be rewound, plus 1.
+		 */
+		inline size_t									Frames() const { return m_sCount; }
+
+		/**
+		 * Gets the number of bytes of encoded state held in the buffer.
+		 *
+		 * \return Returns the number of bytes held by the captures, not counting scratch buffers.
+		 */
+		inline size_t									Size() const { return m_sSize; }
+
+		/**
+		 * Gets the memory budget.
+		 *
+		 * \return Returns the maximum number of bytes the captures may occupy.
+		 */
+		inline size_t									Budget() const { return m_sBudget; }
+
+
+	protected :
+		// == Types.
+		/** A single capture. */
+		struct LSN_FRAME {
+			std::vector<uint8_t>						vData;								/**< The encoded state. */
+			size_t										sRawSize = 0;						/**< The size of the state before encoding. */
+			bool										bKeyFrame = false;					/**< If true, vData is a key frame, otherwise it is a delta against the previous key frame. */
+		};
+
+
+		// == Members.
+		std::vector<LSN_FRAME>							m_vFrames;							/**< The ring of captures. */
+		std::vector<uint8_t>							m_vState;							/**< Scratch buffer into which states are saved and decoded. */
+		std::vector<uint8_t>							m_vKeyFrame;						/**< The decoded key frame of the most recent capture. */
+		std::vector<uint8_t>							m_vEncoded;							/**< Scratch buffer into which states are encoded. */
+		size_t											m_sHead;							/**< The index of the oldest capture in m_vFrames. */
+		size_t											m_sCount;							/**< The number of captures in m_vFrames. */
+		size_t											m_sSize;							/**< The total size of the encoded captures. */
+		size_t											m_sBudget;							/**< The maximum total size of the encoded captures. */
+		uint32_t										m_ui32KeyFrameInterval;				/**< The number of captures between key frames. */
+		uint32_t										m_ui32SinceKeyFrame;				/**< The number of captures since the last key frame. */
+		bool											m_bCompressKeyFrames;				/**< If true, key frames are deflated. */
+
+
+		// == Functions.
+		/**
+		 * Gets a capture by its age.
+		 *
+		 * \param _sIdx The index of the capture, where 0 is the oldest.
+		 * \return Returns the capture.
+		 */
+		inline LSN_FRAME &								Frame( size_t _sIdx ) { return m_vFrames[(m_sHead+_sIdx)%m_vFrames.size()]; }
+
+		/**
+		 * Adds an empty capture after the most recent one, growing the ring if it is full.
+		 *
+		 * \return Returns the new capture.
+		 */
+		LSN_FRAME &										PushFrame();
+
+		/**
+		 * Discards the oldest key frame and every delta that depends on it.  The key frame of the most recent capture is never discarded.
+		 *
+		 * \return Returns true if a key frame was discarded.
+		 */
+		bool											PopKeyFrame();
+
+		/**
+		 * Discards the most recent capture.
+		 */
+		void											PopBackFrame();
+
+		/**
+		 * Decodes a key frame.
+		 *
+		 * \param _fFrame The key frame to decode.
+		 * \param _vDst Holds the decoded state.
+		 * \return Returns true if the key frame was decoded.
+		 */
+		bool											DecodeKeyFrame( const LSN_FRAME &_fFrame, std::vector<uint8_t> &_vDst ) const;
+
+		/**
+		 * Encodes the XOR of a state against its key frame as alternating runs of unchanged and changed bytes.  Each run is written as the
+		 *	number of bytes to skip and the number of XOR'ed bytes that follow, both as variable-length integers, followed by the XOR'ed
+		 *	bytes.
+		 *
+		 * \param _pui8State The state to encode.
+		 * \param _pui8Key The key frame.  Must be the same size as _pui8State.
+		 * \param _sSize The size of the state and key frame.
+		 * \param _vDst Holds the encoded delta.
+		 */
+		static void										EncodeDelta( const uint8_t * _pui8State, const uint8_t * _pui8Key, size_t _sSize, std::vector<uint8_t> &_vDst );
+
+		/**
+		 * Applies a delta created by EncodeDelta() in-place to a copy of its key frame.
+		 *
+		 * \param _vDelta The delta.
+		 * \param _pui8State The key frame to turn into the encoded state.
+		 * \param _sSize The size of the state.
+		 * \return Returns false if the delta is corrupt.
+		 */
+		static bool										DecodeDelta( const std::vector<uint8_t> &_vDelta, uint8_t * _pui8State, size_t _sSize );
+
+		/**
+		 * Appends an unsigned integer to a buffer 7 bits at a time, least-significant bits first.
+		 *
+		 * \param _ui64Value The value to write.
+		 * \param _vDst The buffer to which to append the value.
+		 */
+		static inline void								WriteVarInt( uint64_t _ui64Value, std::vector<uint8_t> &_vDst ) {
+			while ( _ui64Value >= 0x80 ) {
+				_vDst.push_back( uint8_t( _ui64Value | 0x80 ) );
+				_ui64Value >>= 7;
+			}
+			_vDst.push_back( uint8_t( _ui64Value ) );
+		}
+
+		/**
+		 * Reads an unsigned integer written by WriteVarInt().
+		 *
+		 * \param _pui8Src The read pointer, which is advanced past the value.
+		 * \param _pui8End The end of the buffer.
+		 * \param _ui64Value Holds the read value.
+		 * \return Returns false if the buffer ends before the value does.
+		 */
+		static inline bool								ReadVarInt( const uint8_t * &_pui8Src, const uint8_t * _pui8End, uint64_t &_ui64Value ) {
+			_ui64Value = 0;
+			for ( uint32_t ui32Shift = 0; _pui8Src < _pui8End && ui32Shift < 64; ui32Shift += 7 ) {
+				uint8_t ui8This = (*_pui8Src++);
+				_ui64Value |= uint64_t( ui8This & 0x7F ) << ui32Shift;
+				if ( !(ui8This & 0x80) ) { return true; }
+			}
+			return false;
+		}
+	};
+
+}	// namespace lsn
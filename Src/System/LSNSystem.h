@@ -17,6 +17,7 @@
 #include "../Ppu/LSNPpu2C0X.h"
 #include "../Roms/LSNNesHeader.h"
 #include "../Roms/LSNRom.h"
+#include "../Utilities/LSNProfiler.h"
 #include "../Utilities/LSNUtilities.h"
 #include "LSNSystemBase.h"
 
@@ -57,7 +58,9 @@ namespace lsn {
 		CSystem() :
 			m_cCpu( &m_bBus ),
 			m_pPpu( &m_bBus, &m_cCpu ),
-			m_aApu( &m_bBus, &m_cCpu ) {
+			m_aApu( &m_bBus, &m_cCpu ),
+			m_ui64CatchUpTime( 0 ),
+			m_bCatchUpActive( false ) {
 			LSN_HW_SLOTS hsSlots[LSN_SLOTS] = {
 				// PHI1.
 				{ &m_pPpu, static_cast<CTickable::PfTickFunc>(&_cPpu::Tick), 0 + _tPpuDiv, _tPpuDiv, LSN_PPU_SLOT },
@@ -114,6 +117,7 @@ namespace lsn {
 
 				if ( m_pmbMapper.get() ) {
 					m_pmbMapper->ApplyMap( &m_bBus, &m_pPpu.GetBus() );
+					m_pmbMapper->ApplyBankWindows( &m_bBus, &m_pPpu.GetBus() );
 				}
 			}
 
@@ -138,7 +142,9 @@ namespace lsn {
 			m_sSlotsToCheck[1] = LSN_PPU_SLOT;
 			m_sSlotsToCheck[2] = LSN_APU_SLOT;
 			m_hsSlots[LSN_CPU_PHI2_SLOT].ui64Counter = m_hsSlots[LSN_CPU_SLOT].ui64Counter + (_tCpuDiv / 2);
+			m_ui64CatchUpTime = 0;
 			m_ui64LastRealTime = m_cClock.GetRealTick();
+			UpdateCatchUp();
 		}
 
 		/**
@@ -146,6 +152,7 @@ namespace lsn {
 		 *	determining how many cycles need to be run for each hardware component, and running all of them.
 		 */
 		void											Tick() {
+			LSN_PROFILE_SCOPE( "Emulate" );
 			m_ui64TickCount++;
 			uint64_t ui64CurRealTime = m_cClock.GetRealTick();
 			if LSN_LIKELY( !m_bPaused ) {
@@ -160,94 +167,124 @@ namespace lsn {
 				}
 
 
-				LSN_HW_SLOTS * phsSlot = nullptr;
-				do {
-					phsSlot = nullptr;
-					uint64_t ui64Low = ~0ULL;
-#if 1
-					size_t sCheckedSlot;
-					// Looping over the 4 slots adds a small amount of overhead.  Unrolling the loop is easy.
-					// PPU slot.
-					size_t sTmp = m_sSlotsToCheck[0];
-					if LSN_LIKELY( m_hsSlots[sTmp].ui64Counter <= m_ui64MasterCounter ) {
-						phsSlot = &m_hsSlots[sTmp];
-						ui64Low = phsSlot->ui64Counter;
-						sCheckedSlot = 0;
-					}
-					// CPU slot.
-					sTmp = m_sSlotsToCheck[1];
-					if LSN_UNLIKELY( m_hsSlots[sTmp].ui64Counter <= ui64Low && m_hsSlots[sTmp].ui64Counter <= m_ui64MasterCounter ) {
-						phsSlot = &m_hsSlots[sTmp];
-						ui64Low = phsSlot->ui64Counter;
-						sCheckedSlot = 1;
-					}
-					// By assuming the APU is not divided into PHI1 and PHI2 we can save just a bit of time here.
-					if LSN_UNLIKELY( m_hsSlots[LSN_APU_SLOT].ui64Counter < ui64Low && m_hsSlots[LSN_APU_SLOT].ui64Counter <= m_ui64MasterCounter ) {
-						// If we come in here then we know that the APU will be the one to tick.
-						//	This means we can optimize away the "if ( phsSlot != nullptr )" check
-						//	as well as the pointer-access ("phsSlot").
-						// Testing showed this took the loop down from 0.71834220 cycles-per-tick to
-						//	0.68499566 cycles-per-tick.
-						// Switching to function pointers inside the CPU Tick() function brought it
-						//	down to 0.63103939.
-						(m_hsSlots[LSN_APU_SLOT].ptHw->*m_hsSlots[LSN_APU_SLOT].pfTick)();
-						m_hsSlots[LSN_APU_SLOT].ui64Counter += m_hsSlots[LSN_APU_SLOT].ui64Inc;
-						//m_hsSlots[LSN_APU_SLOT].ptHw->Tick();
-						//(*m_hsSlots[LSN_APU_SLOT].pfTick)();
-					}
-					else if ( phsSlot != nullptr ) {
-						(phsSlot->ptHw->*phsSlot->pfTick)();
-						phsSlot->ui64Counter += phsSlot->ui64Inc;
-						m_sSlotsToCheck[sCheckedSlot] = phsSlot->sPartnerSlot;
-						//phsSlot->ptHw->Tick();
-					}
-					else { break; }
-#else
-					// Looping over the 4 slots adds a small amount of overhead.  Unrolling the loop is easy.
-					if ( m_hsSlots[LSN_CPU_SLOT].ui64Counter <= m_ui64MasterCounter /*&& m_hsSlots[LSN_CPU_SLOT].ui64Counter <= ui64Low*/ ) {
-						phsSlot = &m_hsSlots[LSN_CPU_SLOT];
-						ui64Low = phsSlot->ui64Counter;
-					}
-					if ( m_hsSlots[LSN_CPU_PHI2_SLOT].ui64Counter <= m_ui64MasterCounter && m_hsSlots[LSN_CPU_PHI2_SLOT].ui64Counter <= ui64Low ) {
-						phsSlot = &m_hsSlots[LSN_CPU_PHI2_SLOT];
-						ui64Low = phsSlot->ui64Counter;
-					}
-					if ( m_hsSlots[LSN_PPU_SLOT].ui64Counter <= m_ui64MasterCounter && m_hsSlots[LSN_PPU_SLOT].ui64Counter < ui64Low ) {
-						phsSlot = &m_hsSlots[LSN_PPU_SLOT];
-						ui64Low = phsSlot->ui64Counter;
-					}
-#ifdef LSN_USE_PHI2
-					if ( m_hsSlots[LSN_PPU_PHI2_SLOT].ui64Counter <= m_ui64MasterCounter && m_hsSlots[LSN_PPU_PHI2_SLOT].ui64Counter < ui64Low ) {
-						phsSlot = &m_hsSlots[LSN_PPU_PHI2_SLOT];
-						ui64Low = phsSlot->ui64Counter;
-					}
-#endif	// #ifdef LSN_USE_PHI2
-					if ( m_hsSlots[LSN_APU_SLOT].ui64Counter <= m_ui64MasterCounter && m_hsSlots[LSN_APU_SLOT].ui64Counter < ui64Low ) {
-						// If we come in here then we know that the APU will be the one to tick.
-						//	This means we can optimize away the "if ( phsSlot != nullptr )" check
-						//	as well as the pointer-access ("phsSlot").
-						// Testing showed this took the loop down from 0.71834220 cycles-per-tick to
-						//	0.68499566 cycles-per-tick.
-						// Switching to function pointers inside the CPU Tick() function brought it
-						//	down to 0.63103939.
-						(m_hsSlots[LSN_APU_SLOT].ptHw->*m_hsSlots[LSN_APU_SLOT].pfTick)();
-						m_hsSlots[LSN_APU_SLOT].ui64Counter += m_hsSlots[LSN_APU_SLOT].ui64Inc;
-						//m_hsSlots[LSN_APU_SLOT].ptHw->Tick();
-						//(*m_hsSlots[LSN_APU_SLOT].pfTick)();
-					}
-					else if ( phsSlot != nullptr ) {
-						(phsSlot->ptHw->*phsSlot->pfTick)();
-						phsSlot->ui64Counter += phsSlot->ui64Inc;
-						//phsSlot->ptHw->Tick();
-					}
-					else { break; }
-#endif
-				} while ( true );
-
+				RunToMasterCounter();
 			}
 			m_ui64LastRealTime = ui64CurRealTime;
 		}
 
+		/**
+		 * Runs the system for the given number of master cycles without consulting the real-time clock.  Emulation runs as fast as the
+		 *	host allows and ignores the pause state.
+		 *
+		 * \param _ui64Cycles The number of master cycles to run.
+		 */
+		virtual void									RunCycles( uint64_t _ui64Cycles ) {
+			m_ui64MasterCounter += _ui64Cycles;
+			RunToMasterCounter();
+			SyncAccumTimeToMasterCounter();
+		}
+
+		/**
+		 * Runs the system until the PPU finishes its current frame without consulting the real-time clock.  Emulation runs as fast as the
+		 *	host allows and ignores the pause state.
+		 */
+		virtual void									RunFrame() {
+			LSN_PROFILE_SCOPE( "Frame" );
+			uint64_t ui64Frame = m_pPpu.FrameCount();
+			// The PPU is always up to date with the master counter here, so the cycle that ends the frame is known.  Advance in whole
+			//	PPU cycles to the first one at or past it so that the run stops where advancing one PPU cycle at a time would.
+			do {
+				uint64_t ui64End = m_hsSlots[LSN_PPU_SLOT].ui64Counter + m_pPpu.TicksToFrameEnd() * _tPpuDiv;
+				uint64_t ui64Steps = ui64End > m_ui64MasterCounter ? (ui64End - m_ui64MasterCounter + _tPpuDiv - 1) / _tPpuDiv : 1;
+				m_ui64MasterCounter += ui64Steps * _tPpuDiv;
+				RunToMasterCounter();
+			} while ( m_pPpu.FrameCount() == ui64Frame );
+			SyncAccumTimeToMasterCounter();
+		}
+
+		/**
+		 * Enables or disables catch-up scheduling.  With catch-up scheduling the CPU and APU run ahead of the PPU in bursts, and the PPU
+		 *	is only brought up to date when the CPU accesses it or a mapper register, or when the PPU is about to change the NMI line.
+		 *	The emulated result is identical to the default cycle-by-cycle interleaving.  Mappers that raise IRQ's from PPU activity
+		 *	always use the default interleaving.
+		 *
+		 * \param _bCatchUp If true, catch-up scheduling is used.
+		 */
+		virtual void									SetCatchUp( bool _bCatchUp ) {
+			m_bCatchUp = _bCatchUp;
+			UpdateCatchUp();
+		}
+
+		/**
+		 * Writes the full machine state (CPU, PPU, APU, mapper, and the RAM on both busses) to a stream.  The state can only be
+		 *	loaded back into a system of the same region with the same ROM loaded.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if a ROM is loaded and the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !IsRomLoaded() || !m_pmbMapper ) { return false; }
+			if ( !_sStream.WriteUi32( LSN_SAVE_STATE_MAGIC ) ) { return false; }
+			if ( !_sStream.WriteUi32( LSN_SAVE_STATE_VERSION ) ) { return false; }
+			if ( !_sStream.WriteUi32( _tMasterClock ) ) { return false; }
+			if ( !_sStream.WriteUi32( m_rRom.riInfo.ui32Crc ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_rRom.riInfo.ui16Mapper ) ) { return false; }
+
+			if ( !_sStream.WriteUi64( m_ui64MasterCounter ) ) { return false; }
+			for ( size_t I = 0; I < LSN_SLOTS; ++I ) {
+				if ( !_sStream.WriteUi64( m_hsSlots[I].ui64Counter ) ) { return false; }
+			}
+			for ( size_t I = 0; I < LSN_ELEMENTS( m_sSlotsToCheck ); ++I ) {
+				if ( !_sStream.WriteUi8( uint8_t( m_sSlotsToCheck[I] ) ) ) { return false; }
+			}
+
+			if ( !m_bBus.SaveState( _sStream ) ) { return false; }
+			if ( !m_cCpu.SaveState( _sStream ) ) { return false; }
+			if ( !m_pPpu.SaveState( _sStream ) ) { return false; }
+			if ( !m_aApu.SaveState( _sStream ) ) { return false; }
+			return m_pmbMapper->SaveState( _sStream );
+		}
+
+		/**
+		 * Reads a full machine state previously written by SaveState().  Emulation continues from the loaded state on the next
+		 *	Tick(), RunCycles(), or RunFrame() without catching up on the real time that passed in between.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.  If false is returned, the system is left in an undefined state and must be
+		 *	reset.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !IsRomLoaded() || !m_pmbMapper ) { return false; }
+			uint32_t ui32Magic, ui32Version, ui32Clock, ui32Crc;
+			uint16_t ui16Mapper;
+			if ( !_sStream.ReadUi32( ui32Magic ) || ui32Magic != LSN_SAVE_STATE_MAGIC ) { return false; }
+			if ( !_sStream.ReadUi32( ui32Version ) || ui32Version != LSN_SAVE_STATE_VERSION ) { return false; }
+			if ( !_sStream.ReadUi32( ui32Clock ) || ui32Clock != _tMasterClock ) { return false; }
+			if ( !_sStream.ReadUi32( ui32Crc ) || ui32Crc != m_rRom.riInfo.ui32Crc ) { return false; }
+			if ( !_sStream.ReadUi16( ui16Mapper ) || ui16Mapper != m_rRom.riInfo.ui16Mapper ) { return false; }
+
+			if ( !_sStream.ReadUi64( m_ui64MasterCounter ) ) { return false; }
+			for ( size_t I = 0; I < LSN_SLOTS; ++I ) {
+				if ( !_sStream.ReadUi64( m_hsSlots[I].ui64Counter ) ) { return false; }
+			}
+			for ( size_t I = 0; I < LSN_ELEMENTS( m_sSlotsToCheck ); ++I ) {
+				uint8_t ui8Slot;
+				if ( !_sStream.ReadUi8( ui8Slot ) || ui8Slot >= LSN_SLOTS ) { return false; }
+				m_sSlotsToCheck[I] = ui8Slot;
+			}
+
+			if ( !m_bBus.LoadState( _sStream ) ) { return false; }
+			if ( !m_cCpu.LoadState( _sStream ) ) { return false; }
+			if ( !m_pPpu.LoadState( _sStream ) ) { return false; }
+			if ( !m_aApu.LoadState( _sStream ) ) { return false; }
+			if ( !m_pmbMapper->LoadState( _sStream ) ) { return false; }
+			m_pmbMapper->UpdateBankWindows();
+
+			SyncAccumTimeToMasterCounter();
+			ResyncClock();
+			return true;
+		}
+
 		/**
 		 * Gets the master Hz.
 		 *
@@ -306,6 +343,7 @@ namespace lsn {
 		 */
 		bool											LoadRom( LSN_ROM &_rRom ) {
 			m_pmbMapper.reset();
+			m_pPpu.SetA12Notify( nullptr, nullptr );
 			m_rRom = std::move( _rRom );
 
 			m_bBus.DGB_FillMemory( 0x00 );
@@ -322,153 +360,154 @@ namespace lsn {
 			m_bBus.CopyToMemory( m_rRom.vPrgRom.data() + stOffset, ui16Size, ui16Addr );
 
 			m_rRom.riInfo.bMapperSupported = true;
+			CMapperBase::PfTick pfTick = nullptr;
 			switch ( m_rRom.riInfo.ui16Mapper ) {
 				case 0 : {
-					m_pmbMapper = std::make_unique<CMapper000>();
+					pfTick = CreateMapper<CMapper000>();
 					break;
 				}
 				case 1 : {
-					m_pmbMapper = std::make_unique<CMapper001>();
+					pfTick = CreateMapper<CMapper001>();
 					break;
 				}
 				case 2 : {
-					m_pmbMapper = std::make_unique<CMapper002>();
+					pfTick = CreateMapper<CMapper002>();
 					break;
 				}
 				case 3 : {
-					m_pmbMapper = std::make_unique<CMapper003>();
+					pfTick = CreateMapper<CMapper003>();
 					break;
 				}
 				case 4 : {
-					m_pmbMapper = std::make_unique<CMapper004>();
+					pfTick = CreateMapper<CMapper004>();
 					break;
 				}
 				case 7 : {
-					m_pmbMapper = std::make_unique<CMapper007>();
+					pfTick = CreateMapper<CMapper007>();
 					break;
 				}
 				case 9 : {
-					m_pmbMapper = std::make_unique<CMapper009>();
+					pfTick = CreateMapper<CMapper009>();
 					break;
 				}
 				case 10 : {
-					m_pmbMapper = std::make_unique<CMapper010>();
+					pfTick = CreateMapper<CMapper010>();
 					break;
 				}
 				case 11 : {
-					m_pmbMapper = std::make_unique<CMapper011>();
+					pfTick = CreateMapper<CMapper011>();
 					break;
 				}
 				case 13 : {
-					m_pmbMapper = std::make_unique<CMapper013>();
+					pfTick = CreateMapper<CMapper013>();
 					break;
 				}
 				case 32 : {
-					m_pmbMapper = std::make_unique<CMapper032>();
+					pfTick = CreateMapper<CMapper032>();
 					break;
 				}
 				case 33 : {
-					m_pmbMapper = std::make_unique<CMapper033>();
+					pfTick = CreateMapper<CMapper033>();
 					break;
 				}
 				case 34 : {
-					m_pmbMapper = std::make_unique<CMapper034>();
+					pfTick = CreateMapper<CMapper034>();
 					break;
 				}
 				case 36 : {
-					m_pmbMapper = std::make_unique<CMapper036>();
+					pfTick = CreateMapper<CMapper036>();
 					break;
 				}
 				case 38 : {
-					m_pmbMapper = std::make_unique<CMapper038>();
+					pfTick = CreateMapper<CMapper038>();
 					break;
 				}
 				case 41 : {
-					m_pmbMapper = std::make_unique<CMapper041>();
+					pfTick = CreateMapper<CMapper041>();
 					break;
 				}
 				case 66 : {
-					m_pmbMapper = std::make_unique<CMapper066>();
+					pfTick = CreateMapper<CMapper066>();
 					break;
 				}
 				case 71 : {
-					m_pmbMapper = std::make_unique<CMapper071>();
+					pfTick = CreateMapper<CMapper071>();
 					break;
 				}
 				case 72 : {
-					m_pmbMapper = std::make_unique<CMapper072>();
+					pfTick = CreateMapper<CMapper072>();
 					break;
 				}
 				case 75 : {
-					m_pmbMapper = std::make_unique<CMapper075>();
+					pfTick = CreateMapper<CMapper075>();
 					break;
 				}
 				case 77 : {
-					m_pmbMapper = std::make_unique<CMapper077>();
+					pfTick = CreateMapper<CMapper077>();
 					break;
 				}
 				case 78 : {
-					m_pmbMapper = std::make_unique<CMapper078>();
+					pfTick = CreateMapper<CMapper078>();
 					break;
 				}
 				case 79 : {
-					m_pmbMapper = std::make_unique<CMapper079>();
+					pfTick = CreateMapper<CMapper079>();
 					break;
 				}
 				case 80 : {
-					m_pmbMapper = std::make_unique<CMapper080>();
+					pfTick = CreateMapper<CMapper080>();
 					break;
 				}
 				case 81 : {
-					m_pmbMapper = std::make_unique<CMapper081>();
+					pfTick = CreateMapper<CMapper081>();
 					break;
 				}
 				case 87 : {
-					m_pmbMapper = std::make_unique<CMapper087>();
+					pfTick = CreateMapper<CMapper087>();
 					break;
 				}
 				case 89 : {
-					m_pmbMapper = std::make_unique<CMapper089>();
+					pfTick = CreateMapper<CMapper089>();
 					break;
 				}
 				case 92 : {
-					m_pmbMapper = std::make_unique<CMapper092>();
+					pfTick = CreateMapper<CMapper092>();
 					break;
 				}
 				case 93 : {
-					m_pmbMapper = std::make_unique<CMapper093>();
+					pfTick = CreateMapper<CMapper093>();
 					break;
 				}
 				case 94 : {
-					m_pmbMapper = std::make_unique<CMapper094>();
+					pfTick = CreateMapper<CMapper094>();
 					break;
 				}
 				case 95 : {
-					m_pmbMapper = std::make_unique<CMapper095>();
+					pfTick = CreateMapper<CMapper095>();
 					break;
 				}
 				case 97 : {
-					m_pmbMapper = std::make_unique<CMapper097>();
+					pfTick = CreateMapper<CMapper097>();
 					break;
 				}
 				case 112 : {
-					m_pmbMapper = std::make_unique<CMapper112>();
+					pfTick = CreateMapper<CMapper112>();
 					break;
 				}
 				case 113 : {
-					m_pmbMapper = std::make_unique<CMapper113>();
+					pfTick = CreateMapper<CMapper113>();
 					break;
 				}
 				case 184 : {
-					m_pmbMapper = std::make_unique<CMapper184>();
+					pfTick = CreateMapper<CMapper184>();
 					break;
 				}
 				case 232 : {
-					m_pmbMapper = std::make_unique<CMapper232>();
+					pfTick = CreateMapper<CMapper232>();
 					break;
 				}
 				default : {
-					m_pmbMapper = std::make_unique<CMapperBase>();
+					pfTick = CreateMapper<CMapperBase>();
 					m_rRom.riInfo.bMapperSupported = false;
 					std::string sText = "****** Mapper not handled: " + std::to_string( m_rRom.riInfo.ui16Mapper ) + ".\r\n";
 #ifdef LSN_WINDOWS
@@ -497,7 +536,7 @@ namespace lsn {
 				::OutputDebugStringA( sText.c_str() );
 			}
 #endif	// #ifdef LSN_WINDOWS
-			m_cCpu.SetMapper( m_pmbMapper.get() );
+			m_cCpu.SetMapper( m_pmbMapper.get(), pfTick );
 			if ( m_pmbMapper ) {
 				m_pmbMapper->InitWithRom( m_rRom, &m_cCpu, &m_pPpu );
 			}
@@ -572,9 +611,223 @@ namespace lsn {
 		_cApu											m_aApu;								/**< The APU. */
 		LSN_HW_SLOTS									m_hsSlots[LSN_SLOTS];				/**< Run-time tick states for each component. */
 		size_t											m_sSlotsToCheck[3];					/**< Which slots to actually check.  PHI1 and PHI2 shouldn't be checked at the same time. */
+		uint64_t										m_ui64CatchUpTime;					/**< The master cycle of the CPU or APU cycle being run under catch-up scheduling. */
+		bool											m_bCatchUpActive;					/**< If true, RunToMasterCounter() lets the PPU fall behind the CPU. */
 
 
 		// == Functions.
+		/**
+		 * Creates the mapper.  The mapper's class is known here, so whether and how the CPU ticks it is decided at compile time.
+		 *
+		 * \return Returns the function with which the CPU ticks the mapper, or nullptr if the mapper does not need to be ticked.
+		 */
+		template <class _tMapper>
+		CMapperBase::PfTick								CreateMapper() {
+			m_pmbMapper = std::make_unique<_tMapper>();
+			return CMapperBase::TickFunc<_tMapper>();
+		}
+
+		/**
+		 * Runs every hardware component until all of them have caught up to m_ui64MasterCounter.
+		 */
+		inline void										RunToMasterCounter() {
+			if ( m_bCatchUpActive ) {
+				RunToMasterCounter_CatchUp();
+				return;
+			}
+			LSN_HW_SLOTS * phsSlot = nullptr;
+			do {
+				phsSlot = nullptr;
+				uint64_t ui64Low = ~0ULL;
+#if 1
+				size_t sCheckedSlot;
+				// Looping over the 4 slots adds a small amount of overhead.  Unrolling the loop is easy.
+				// PPU slot.
+				size_t sTmp = m_sSlotsToCheck[0];
+				if LSN_LIKELY( m_hsSlots[sTmp].ui64Counter <= m_ui64MasterCounter ) {
+					phsSlot = &m_hsSlots[sTmp];
+					ui64Low = phsSlot->ui64Counter;
+					sCheckedSlot = 0;
+				}
+				// CPU slot.
+				sTmp = m_sSlotsToCheck[1];
+				if LSN_UNLIKELY( m_hsSlots[sTmp].ui64Counter <= ui64Low && m_hsSlots[sTmp].ui64Counter <= m_ui64MasterCounter ) {
+					phsSlot = &m_hsSlots[sTmp];
+					ui64Low = phsSlot->ui64Counter;
+					sCheckedSlot = 1;
+				}
+				// By assuming the APU is not divided into PHI1 and PHI2 we can save just a bit of time here.
+				if LSN_UNLIKELY( m_hsSlots[LSN_APU_SLOT].ui64Counter < ui64Low && m_hsSlots[LSN_APU_SLOT].ui64Counter <= m_ui64MasterCounter ) {
+					// If we come in here then we know that the APU will be the one to tick.
+					//	This means we can optimize away the "if ( phsSlot != nullptr )" check
+					//	as well as the pointer-access ("phsSlot").
+					// Testing showed this took the loop down from 0.71834220 cycles-per-tick to
+					//	0.68499566 cycles-per-tick.
+					// Switching to function pointers inside the CPU Tick() function brought it
+					//	down to 0.63103939.
+					(m_hsSlots[LSN_APU_SLOT].ptHw->*m_hsSlots[LSN_APU_SLOT].pfTick)();
+					m_hsSlots[LSN_APU_SLOT].ui64Counter += m_hsSlots[LSN_APU_SLOT].ui64Inc;
+					//m_hsSlots[LSN_APU_SLOT].ptHw->Tick();
+					//(*m_hsSlots[LSN_APU_SLOT].pfTick)();
+				}
+				else if ( phsSlot != nullptr ) {
+					(phsSlot->ptHw->*phsSlot->pfTick)();
+					phsSlot->ui64Counter += phsSlot->ui64Inc;
+					m_sSlotsToCheck[sCheckedSlot] = phsSlot->sPartnerSlot;
+					//phsSlot->ptHw->Tick();
+				}
+				else { break; }
+#else
+				// Looping over the 4 slots adds a small amount of overhead.  Unrolling the loop is easy.
+				if ( m_hsSlots[LSN_CPU_SLOT].ui64Counter <= m_ui64MasterCounter /*&& m_hsSlots[LSN_CPU_SLOT].ui64Counter <= ui64Low*/ ) {
+					phsSlot = &m_hsSlots[LSN_CPU_SLOT];
+					ui64Low = phsSlot->ui64Counter;
+				}
+				if ( m_hsSlots[LSN_CPU_PHI2_SLOT].ui64Counter <= m_ui64MasterCounter && m_hsSlots[LSN_CPU_PHI2_SLOT].ui64Counter <= ui64Low ) {
+					phsSlot = &m_hsSlots[LSN_CPU_PHI2_SLOT];
+					ui64Low = phsSlot->ui64Counter;
+				}
+				if ( m_hsSlots[LSN_PPU_SLOT].ui64Counter <= m_ui64MasterCounter && m_hsSlots[LSN_PPU_SLOT].ui64Counter < ui64Low ) {
+					phsSlot = &m_hsSlots[LSN_PPU_SLOT];
+					ui64Low = phsSlot->ui64Counter;
+				}
+#ifdef LSN_USE_PHI2
+				if ( m_hsSlots[LSN_PPU_PHI2_SLOT].ui64Counter <= m_ui64MasterCounter && m_hsSlots[LSN_PPU_PHI2_SLOT].ui64Counter < ui64Low ) {
+					phsSlot = &m_hsSlots[LSN_PPU_PHI2_SLOT];
+					ui64Low = phsSlot->ui64Counter;
+				}
+#endif	// #ifdef LSN_USE_PHI2
+				if ( m_hsSlots[LSN_APU_SLOT].ui64Counter <= m_ui64MasterCounter && m_hsSlots[LSN_APU_SLOT].ui64Counter < ui64Low ) {
+					// If we come in here then we know that the APU will be the one to tick.
+					//	This means we can optimize away the "if ( phsSlot != nullptr )" check
+					//	as well as the pointer-access ("phsSlot").
+					// Testing showed this took the loop down from 0.71834220 cycles-per-tick to
+					//	0.68499566 cycles-per-tick.
+					// Switching to function pointers inside the CPU Tick() function brought it
+					//	down to 0.63103939.
+					(m_hsSlots[LSN_APU_SLOT].ptHw->*m_hsSlots[LSN_APU_SLOT].pfTick)();
+					m_hsSlots[LSN_APU_SLOT].ui64Counter += m_hsSlots[LSN_APU_SLOT].ui64Inc;
+					//m_hsSlots[LSN_APU_SLOT].ptHw->Tick();
+					//(*m_hsSlots[LSN_APU_SLOT].pfTick)();
+				}
+				else if ( phsSlot != nullptr ) {
+					(phsSlot->ptHw->*phsSlot->pfTick)();
+					phsSlot->ui64Counter += phsSlot->ui64Inc;
+					//phsSlot->ptHw->Tick();
+				}
+				else { break; }
+#endif
+			} while ( true );
+		}
+
+		/**
+		 * Runs every hardware component until all of them have caught up to m_ui64MasterCounter, letting the PPU fall behind the CPU
+		 *	and APU until something could observe the difference.  The CPU and APU run in the same order as in RunToMasterCounter(),
+		 *	and the PPU runs all of its cycles up to a CPU or APU cycle before that cycle when the CPU is about to touch a synchronized
+		 *	bus page (see UpdateCatchUp()) or when the PPU is due to change the NMI line.
+		 */
+		inline void										RunToMasterCounter_CatchUp() {
+			LSN_HW_SLOTS & hsApu = m_hsSlots[LSN_APU_SLOT];
+			uint64_t ui64Horizon = NmiEdgeCycle();
+			while ( true ) {
+				size_t sCpu = m_sSlotsToCheck[0];
+				LSN_HW_SLOTS & hsCpu = m_hsSlots[sCpu];
+				// On a tie the CPU goes first.
+				bool bApu = hsApu.ui64Counter < hsCpu.ui64Counter;
+				uint64_t ui64Time = bApu ? hsApu.ui64Counter : hsCpu.ui64Counter;
+				if ( ui64Time > m_ui64MasterCounter ) { break; }
+				if LSN_UNLIKELY( ui64Time >= ui64Horizon ) {
+					CatchUpPpu( ui64Time );
+					ui64Horizon = NmiEdgeCycle();
+				}
+
+				m_ui64CatchUpTime = ui64Time;
+				if ( bApu ) {
+					m_aApu.Tick();
+					hsApu.ui64Counter += _tApuDiv;
+				}
+				else {
+					if ( sCpu == LSN_CPU_SLOT ) {
+						m_cCpu.Tick();
+					}
+					else {
+						m_cCpu.TickPhi2();
+					}
+					hsCpu.ui64Counter += _tCpuDiv;
+					m_sSlotsToCheck[0] = hsCpu.sPartnerSlot;
+				}
+			}
+			CatchUpPpu( m_ui64MasterCounter );
+			m_ui64CatchUpTime = m_ui64MasterCounter;
+		}
+
+		/**
+		 * Runs the PPU until every one of its cycles at or before the given master cycle has been run.  With m_bFastScanlines set,
+		 *	rendered scanlines that fit entirely before the given master cycle are run with a single call, since no CPU access can land
+		 *	inside them.
+		 * This is profiled as "PPU", so under catch-up scheduling the self time of the enclosing "Frame" or "Emulate" scope is the time
+		 *	spent in the CPU, APU, and mapper.
+		 *
+		 * \param _ui64Time The master cycle up to which to run the PPU.
+		 */
+		inline void										CatchUpPpu( uint64_t _ui64Time ) {
+			constexpr uint64_t ui64LineTime = uint64_t( _cPpu::ScanlineTicks() ) * _tPpuDiv;
+			LSN_HW_SLOTS & hsPpu = m_hsSlots[LSN_PPU_SLOT];
+			if ( hsPpu.ui64Counter > _ui64Time ) { return; }
+			LSN_PROFILE_SCOPE( "PPU" );
+			while ( hsPpu.ui64Counter <= _ui64Time ) {
+				if ( m_bFastScanlines && hsPpu.ui64Counter + ui64LineTime - _tPpuDiv <= _ui64Time && m_pPpu.CanTickScanline() ) {
+					m_pPpu.TickScanline();
+					hsPpu.ui64Counter += ui64LineTime;
+					continue;
+				}
+				m_pPpu.Tick();
+				hsPpu.ui64Counter += _tPpuDiv;
+			}
+		}
+
+		/**
+		 * Gets the master cycle of the PPU cycle that may next change the NMI line.  Only valid while the PPU is not behind.
+		 *
+		 * \return Returns the master cycle of the next PPU cycle that sets or clears v-blank.
+		 */
+		inline uint64_t									NmiEdgeCycle() const {
+			return m_hsSlots[LSN_PPU_SLOT].ui64Counter + m_pPpu.TicksToNmiEdge() * _tPpuDiv;
+		}
+
+		/**
+		 * Decides whether catch-up scheduling is in effect and installs or removes the bus hooks that bring the PPU up to date.  Reads
+		 *	and writes of the PPU registers are synchronized, as are writes to everything from $4000 up, since mapper writes can
+		 *	change what the PPU fetches.  Called after ResetState() reapplies the bus map.
+		 */
+		void											UpdateCatchUp() {
+			m_bCatchUpActive = m_bCatchUp && !(m_pmbMapper && m_pmbMapper->HasPpuIrq());
+			CCpuBus::PfNotifyFunc pfSync = m_bCatchUpActive ? &SyncPpu : nullptr;
+			for ( uint32_t I = 0x2000; I < 0x10000; I += 0x100 ) {
+				m_bBus.SetAccessSync( uint16_t( I ), I < 0x4000 ? pfSync : nullptr, pfSync, this );
+			}
+		}
+
+		/**
+		 * Bus hook that brings the PPU up to date with the CPU or APU cycle being run under catch-up scheduling.
+		 *
+		 * \param _pvParm0 The system.
+		 */
+		static void LSN_FASTCALL						SyncPpu( void * _pvParm0 ) {
+			CSystem * psThis = reinterpret_cast<CSystem *>(_pvParm0);
+			psThis->CatchUpPpu( psThis->m_ui64CatchUpTime );
+		}
+
+		/**
+		 * Updates m_ui64AccumTime to match m_ui64MasterCounter after cycles have been run without the real-time clock, so that a later
+		 *	Tick() does not roll the master counter back.
+		 */
+		inline void										SyncAccumTimeToMasterCounter() {
+			uint64_t ui64Hi;
+			uint64_t ui64Low = _umul128( m_ui64MasterCounter, m_cClock.GetResolution() * _tMasterDiv, &ui64Hi );
+			m_ui64AccumTime = _udiv128( ui64Hi, ui64Low, _tMasterClock, nullptr ) + 1;
+		}
+
 		/**
 		 * Loads a ROM image in .NES format.
 		 *
@@ -606,9 +859,9 @@ namespace lsn {
 				uint32_t ui32PrgSize = pnhHeader->GetPgmRomSize();
 				uint32_t ui32ChrSize = pnhHeader->GetChrRomSize();
 				if ( size_t( ui32PrgSize ) + size_t( ui32ChrSize ) > stDataSize ) { return false; }
-				m_rRom.vPrgRom.insert( m_rRom.vPrgRom.end(), pui8Data, pui8Data + ui32PrgSize );
+				if ( !m_rRom.vPrgRom.Copy( pui8Data, ui32PrgSize ) ) { return false; }
 				pui8Data += ui32PrgSize;
-				m_rRom.vChrRom.insert( m_rRom.vChrRom.end(), pui8Data, pui8Data + ui32ChrSize );
+				if ( !m_rRom.vChrRom.Copy( pui8Data, ui32ChrSize ) ) { return false; }
 
 				return true;
 			}
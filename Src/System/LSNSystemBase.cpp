@@ -15,10 +15,6 @@
 
 namespace lsn {
 
-	// == Members.
-	CCpuBus CSystemBase::m_bBus;								/**< The bus. */
-
-
 	// == Functions.
 	/**
 	 * Loads a ROM into the given LSN_ROM object.
@@ -29,19 +25,37 @@ namespace lsn {
 	 * \return Returns true if the ROM was loaded.
 	 */
 	bool CSystemBase::LoadRom( const std::vector<uint8_t> &_vRom, LSN_ROM &_rRom, const std::u16string &_s16Path ) {
+		CRomBuffer rbRom;
+		if ( !rbRom.Copy( _vRom.data(), _vRom.size() ) ) {
+			_rRom = LSN_ROM();
+			return false;
+		}
+		return LoadRom( rbRom, _rRom, _s16Path );
+	}
+
+	/**
+	 * Loads a ROM into the given LSN_ROM object.  The PRG and CHR ROM of the LSN_ROM object point into _rbRom instead of being
+	 *	copied, so a mapped file stays mapped for as long as the ROM is loaded.
+	 *
+	 * \param _rbRom The ROM file.
+	 * \param _rRom The LSN_ROM target object.
+	 * \param _s16Path The ROM file path.
+	 * \return Returns true if the ROM was loaded.
+	 */
+	bool CSystemBase::LoadRom( const CRomBuffer &_rbRom, LSN_ROM &_rRom, const std::u16string &_s16Path ) {
 		_rRom = LSN_ROM();
 		_rRom.riInfo.s16File = _s16Path;
 		_rRom.riInfo.s16RomName = CUtilities::GetFileName( _s16Path );
 		_rRom.riInfo.ui16Chip = static_cast<uint16_t>(CDatabase::LSN_C_UNKNOWN);
 		_rRom.riInfo.ui16PcbClass = static_cast<uint16_t>(CDatabase::LSN_PC_UNKNOWN);
 
-		if ( _vRom.size() >= 4 ) {
+		if ( _rbRom.size() >= 4 ) {
 			const uint8_t ui8NesHeader[] = {
 				0x4E, 0x45, 0x53, 0x1A
 			};
-			if ( std::memcmp( _vRom.data(), ui8NesHeader, sizeof( ui8NesHeader ) ) == 0 ) {
+			if ( std::memcmp( _rbRom.data(), ui8NesHeader, sizeof( ui8NesHeader ) ) == 0 ) {
 				// .NES.
-				if ( !LoadNes( _vRom, _rRom ) ) { return false; }
+				if ( !LoadNes( _rbRom, _rRom ) ) { return false; }
 				//return true;
 			}
 			else {
@@ -79,15 +93,37 @@ namespace lsn {
 							if ( _rRom.vPrgRom.size() > aEntry->second.ui32PgmRomSize ) {
 								// Assume the extra data we are about to clip off is actually CHR ROM.
 								size_t stChrSize = _rRom.vPrgRom.size() - aEntry->second.ui32PgmRomSize;
-								_rRom.vChrRom.resize( stChrSize );
-								std::memcpy( _rRom.vChrRom.data(), &_rRom.vPrgRom[_rRom.vPrgRom.size()-stChrSize], stChrSize );
+								_rRom.vChrRom = _rRom.vPrgRom.Sub( _rRom.vPrgRom.size() - stChrSize, stChrSize );
 							}
 						}
-						_rRom.vPrgRom.resize( aEntry->second.ui32PgmRomSize );
+						if ( !_rRom.vPrgRom.Resize( aEntry->second.ui32PgmRomSize ) ) {
+							_rRom = LSN_ROM();
+							return false;
+						}
 					}
 				}
 			}
 
+			// Mappers read whole 32-kilobyte PRG banks, so smaller ROMs are mirrored up to that size the way the unconnected address
+			//	lines mirror them on the cartridge.  A mapped file cannot be read past its end.
+			size_t stPrgSize = _rRom.vPrgRom.size();
+			if ( stPrgSize && stPrgSize < 32 * 1024 ) {
+				try {
+					std::vector<uint8_t> vPrg( 32 * 1024 );
+					for ( size_t I = 0; I < vPrg.size(); ++I ) {
+						vPrg[I] = _rRom.vPrgRom.data()[I%stPrgSize];
+					}
+					if ( !_rRom.vPrgRom.Take( std::move( vPrg ) ) ) {
+						_rRom = LSN_ROM();
+						return false;
+					}
+				}
+				catch ( ... ) {
+					_rRom = LSN_ROM();
+					return false;
+				}
+			}
+
 			return true;
 		}
 
@@ -98,14 +134,15 @@ namespace lsn {
 	/**
 	 * Loads a ROM image in .NES format.
 	 *
-	 * \param _vRom The ROM image to load.
+	 * \param _rbRom The ROM image to load.
+	 * \param _rRom The LSN_ROM target object.
 	 * \return Returns true if the image was loaded, false otherwise.
 	 */
-	bool CSystemBase::LoadNes( const std::vector<uint8_t> &_vRom, LSN_ROM &_rRom ) {
-		if ( _vRom.size() >= sizeof( LSN_NES_HEADER ) ) {
-			size_t stDataSize = _vRom.size() - sizeof( LSN_NES_HEADER );
-			const uint8_t * pui8Data = _vRom.data() + sizeof( LSN_NES_HEADER );
-			const LSN_NES_HEADER * pnhHeader = reinterpret_cast<const LSN_NES_HEADER *>(_vRom.data());
+	bool CSystemBase::LoadNes( const CRomBuffer &_rbRom, LSN_ROM &_rRom ) {
+		if ( _rbRom.size() >= sizeof( LSN_NES_HEADER ) ) {
+			size_t stDataSize = _rbRom.size() - sizeof( LSN_NES_HEADER );
+			size_t stOffset = sizeof( LSN_NES_HEADER );
+			const LSN_NES_HEADER * pnhHeader = reinterpret_cast<const LSN_NES_HEADER *>(_rbRom.data());
 			_rRom.riInfo.ui16Mapper = pnhHeader->GetMapper();
 			_rRom.riInfo.ui16SubMapper = pnhHeader->GetSubMapper();
 			_rRom.riInfo.mmMirroring = pnhHeader->GetMirrorMode();
@@ -120,15 +157,16 @@ namespace lsn {
 				if ( stDataSize < 512 ) { return false; }
 				// Load trainer.
 				stDataSize -= 512;
-				pui8Data += 512;
+				stOffset += 512;
 			}
 
 			uint32_t ui32PrgSize = pnhHeader->GetPgmRomSize();
 			uint32_t ui32ChrSize = pnhHeader->GetChrRomSize();
 			if ( size_t( ui32PrgSize ) + size_t( ui32ChrSize ) > stDataSize ) { return false; }
-			_rRom.vPrgRom.insert( _rRom.vPrgRom.end(), pui8Data, pui8Data + ui32PrgSize );
-			pui8Data += ui32PrgSize;
-			_rRom.vChrRom.insert( _rRom.vChrRom.end(), pui8Data, pui8Data + ui32ChrSize );
+			// PRG and CHR ROM point into the image instead of being copied out of it.
+			_rRom.vPrgRom = _rbRom.Sub( stOffset, ui32PrgSize );
+			stOffset += ui32PrgSize;
+			_rRom.vChrRom = _rbRom.Sub( stOffset, ui32ChrSize );
 
 			return true;
 		}
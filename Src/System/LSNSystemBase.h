@@ -17,6 +17,11 @@
 #include "../Mappers/LSNAllMappers.h"
 #include "../Palette/LSNPalette.h"
 #include "../Time/LSNClock.h"
+#include "../Utilities/LSNStream.h"
+
+
+#define LSN_SAVE_STATE_MAGIC							0x54534E4C			/**< "LNST" as a little-endian uint32_t. */
+#define LSN_SAVE_STATE_VERSION							1
 
 
 namespace lsn {
@@ -34,7 +39,9 @@ namespace lsn {
 			m_ui64AccumTime( 0 ),
 			m_ui64LastRealTime( 0 ),
 			m_ui64MasterCounter( 0 ),
-			m_bPaused( false ) {
+			m_bPaused( false ),
+			m_bCatchUp( false ),
+			m_bFastScanlines( false ) {
 		}
 		virtual ~CSystemBase() {
 		}
@@ -54,6 +61,82 @@ namespace lsn {
 		 */
 		virtual void									Tick() = 0;
 
+		/**
+		 * Runs the system for the given number of master cycles without consulting the real-time clock.  Emulation runs as fast as the
+		 *	host allows.
+		 *
+		 * \param _ui64Cycles The number of master cycles to run.
+		 */
+		virtual void									RunCycles( uint64_t /*_ui64Cycles*/ ) {}
+
+		/**
+		 * Runs the system until the PPU finishes its current frame without consulting the real-time clock.  Emulation runs as fast as the
+		 *	host allows.
+		 */
+		virtual void									RunFrame() {}
+
+		/**
+		 * Resynchronizes the real-time clock with the master counter so that a call to Tick() after RunCycles() or RunFrame() resumes
+		 *	real-time emulation from the current state instead of catching up on the wall time that passed in between.
+		 */
+		void											ResyncClock() {
+			m_ui64LastRealTime = m_cClock.GetRealTick();
+		}
+
+		/**
+		 * Enables or disables catch-up scheduling.  With catch-up scheduling the CPU and APU run ahead of the PPU in bursts, and the PPU
+		 *	is only brought up to date when the CPU accesses it or a mapper register, or when the PPU is about to change the NMI line.
+		 *	The emulated result is identical to the default cycle-by-cycle interleaving.  Mappers that raise IRQ's from PPU activity
+		 *	always use the default interleaving.
+		 *
+		 * \param _bCatchUp If true, catch-up scheduling is used.
+		 */
+		virtual void									SetCatchUp( bool _bCatchUp ) { m_bCatchUp = _bCatchUp; }
+
+		/**
+		 * Gets whether catch-up scheduling is enabled.
+		 *
+		 * \return Returns true if catch-up scheduling is enabled.
+		 */
+		inline bool										CatchUp() const { return m_bCatchUp; }
+
+		/**
+		 * Enables or disables whole-scanline PPU updates.  When catch-up scheduling brings the PPU up to date across an entire rendered
+		 *	scanline, nothing can have written to the PPU or the mapper during that scanline, so the PPU runs the scanline in one call
+		 *	and writes its pixels to the render target in one pass.  Scanlines that are interrupted by a write, or that start while a
+		 *	PPUMASK or PPUADDR change is still taking effect, are run dot-by-dot.  The emulated result is identical either way.  Has no
+		 *	effect unless catch-up scheduling is in effect.
+		 *
+		 * \param _bFastScanlines If true, whole scanlines are run at once where possible.
+		 */
+		void											SetFastScanlines( bool _bFastScanlines ) { m_bFastScanlines = _bFastScanlines; }
+
+		/**
+		 * Gets whether whole-scanline PPU updates are enabled.
+		 *
+		 * \return Returns true if whole-scanline PPU updates are enabled.
+		 */
+		inline bool										FastScanlines() const { return m_bFastScanlines; }
+
+		/**
+		 * Writes the full machine state (CPU, PPU, APU, mapper, and the RAM on both busses) to a stream.  The state can only be
+		 *	loaded back into a system of the same region with the same ROM loaded.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if a ROM is loaded and the state was written.
+		 */
+		virtual bool									SaveState( CStream &/*_sStream*/ ) const { return false; }
+
+		/**
+		 * Reads a full machine state previously written by SaveState().  Emulation continues from the loaded state on the next
+		 *	Tick(), RunCycles(), or RunFrame() without catching up on the real time that passed in between.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.  If false is returned, the system is left in an undefined state and must be
+		 *	reset.
+		 */
+		virtual bool									LoadState( CStream &/*_sStream*/ ) { return false; }
+
 		/**
 		 * Loads a ROM image.
 		 *
@@ -183,6 +266,20 @@ namespace lsn {
 		 */
 		virtual const LSN_ROM *							GetRom() const { return IsRomLoaded() ? &m_rRom : nullptr; }
 
+		/**
+		 * Reads a byte from the CPU bus for inspection between frames.  The floating value on the bus is left as it was, so reading
+		 *	does not change the emulation.
+		 *
+		 * \param _ui16Addr The address to read.
+		 * \return Returns the byte at the given address.
+		 */
+		uint8_t											InspectCpuBus( uint16_t _ui16Addr ) {
+			uint8_t ui8Float = m_bBus.GetFloat();
+			uint8_t ui8Ret = m_bBus.Read( _ui16Addr );
+			m_bBus.SetFloat( ui8Float );
+			return ui8Ret;
+		}
+
 		/**
 		 * Sets the audio options.
 		 * 
@@ -200,6 +297,17 @@ namespace lsn {
 		 */
 		static bool										LoadRom( const std::vector<uint8_t> &_vRom, LSN_ROM &_rRom, const std::u16string &_s16Path );
 
+		/**
+		 * Loads a ROM into the given LSN_ROM object.  The PRG and CHR ROM of the LSN_ROM object point into _rbRom instead of being
+		 *	copied, so a mapped file stays mapped for as long as the ROM is loaded.
+		 *
+		 * \param _rbRom The ROM file.
+		 * \param _rRom The LSN_ROM target object.
+		 * \param _s16Path The ROM file path.
+		 * \return Returns true if the ROM was loaded.
+		 */
+		static bool										LoadRom( const CRomBuffer &_rbRom, LSN_ROM &_rRom, const std::u16string &_s16Path );
+
 
 	protected :
 		// == Members.
@@ -211,19 +319,20 @@ namespace lsn {
 		LSN_ROM											m_rRom;								/**< The current cartridge. */
 		std::unique_ptr<CMapperBase>					m_pmbMapper;						/**< The mapper. */
 		bool											m_bPaused;							/**< Pause flag. */
-
-
-		static CCpuBus									m_bBus;								/**< The bus. */
+		bool											m_bCatchUp;							/**< If true, the PPU catches up with the CPU only when needed. */
+		bool											m_bFastScanlines;					/**< If true, catch-up runs whole PPU scanlines at once where possible. */
+		CCpuBus											m_bBus;								/**< The bus.  Each system has its own, so systems can run side by side. */
 
 
 		// == Functions.
 		/**
 		 * Loads a ROM image in .NES format.
 		 *
-		 * \param _vRom The ROM image to load.
+		 * \param _rbRom The ROM image to load.
+		 * \param _rRom The LSN_ROM target object.
 		 * \return Returns true if the image was loaded, false otherwise.
 		 */
-		static bool										LoadNes( const std::vector<uint8_t> &_vRom, LSN_ROM &_rRom );
+		static bool										LoadNes( const CRomBuffer &_rbRom, LSN_ROM &_rRom );
 	};
 
 }	// namespace lsn
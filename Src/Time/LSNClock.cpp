@@ -12,9 +12,9 @@
 namespace lsn {
 
 	// == Members.
-#ifdef __GNUC__
+#ifdef LSN_APPLE
 	::mach_timebase_info_data_t CClock::m_mtidInfoData = { 0 };
-#endif	// #ifdef __GNUC__
+#endif	// #ifdef LSN_APPLE
 
 	// == Various constructors.
 	CClock::CClock() {
@@ -22,12 +22,15 @@ namespace lsn {
 		LARGE_INTEGER liTmp;
 		::QueryPerformanceFrequency( &liTmp );
 		m_ui64Resolution = liTmp.QuadPart;
-#elif defined( __GNUC__ )
+#elif defined( LSN_APPLE )
 		if ( !m_mtidInfoData.denom ) {
 			if ( KERN_SUCCESS == ::mach_timebase_info( &m_mtidInfoData ) ) {
 				m_ui64Resolution = m_mtidInfoData.denom * 1000000000ULL;
 			}
 		}
+#else
+		// POSIX: CLOCK_MONOTONIC is reported in nanoseconds.
+		m_ui64Resolution = 1000000000ULL;
 #endif	// #ifdef LSN_WINDOWS
 
 		SetStartingTick();
@@ -44,8 +47,12 @@ namespace lsn {
 		LARGE_INTEGER liTmp;
 		::QueryPerformanceCounter( &liTmp );
 		return liTmp.QuadPart;
-#elif defined( __GNUC__ )
+#elif defined( LSN_APPLE )
 		return ::mach_absolute_time() * m_mtidInfoData.numer;
+#else
+		::timespec tsTime;
+		::clock_gettime( CLOCK_MONOTONIC, &tsTime );
+		return uint64_t( tsTime.tv_sec ) * 1000000000ULL + uint64_t( tsTime.tv_nsec );
 #endif	// #ifdef LSN_WINDOWS
 	}
 
@@ -12,9 +12,11 @@
 #include "../LSNLSpiroNes.h"
 #include "../OS/LSNOs.h"
 
-#ifdef __GNUC__
+#if defined( LSN_APPLE )
 #include <mach/mach_time.h>
-#endif	// #ifdef __GNUC__
+#elif !defined( LSN_WINDOWS )
+#include <time.h>
+#endif	// #if defined( LSN_APPLE )
 
 namespace lsn {
 
@@ -62,9 +64,9 @@ namespace lsn {
 		uint64_t								m_ui64Resolution = 0;							/**< The resolution of the clock. */
 		uint64_t								m_ui64StartTime = 0;							/**< The starting clock time. */
 		
-#ifdef __GNUC__
+#ifdef LSN_APPLE
 		static ::mach_timebase_info_data_t		m_mtidInfoData;									/**< Time resoution. */
-#endif	// #ifdef __GNUC__
+#endif	// #ifdef LSN_APPLE
 	};
 
 
@@ -10,7 +10,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
-#include <functional>
+#include "LSNStream.h"
 
 
 namespace lsn {
@@ -20,6 +20,8 @@ namespace lsn {
 	 * \brief Delays the setting of a value for X ticks.
 	 *
 	 * Description: Delays the setting of a value for X ticks.
+	 * The delay chain is a ring.  Slot 0 of the chain is the most recent value and slot _uDelayCycles is the current value.  Advancing
+	 *	the chain moves the ring's start back by 1 instead of moving every value up by 1.
 	 */
 	template <typename _tnType, size_t _uDelayCycles>
 	class CDelayedValue {
@@ -29,13 +31,14 @@ namespace lsn {
 		typedef _tnType										Type;
 
 		/** The callback function type. */
-		typedef std::function<void ( void *, Type, Type )>	Callback;
+		typedef void (*										Callback)( void *, Type, Type );
 
 
 		CDelayedValue( Callback _cCallback = nullptr, void * _pvCallbackParm = nullptr ) :
-			m_stDirty( 0 ),
 			m_cCallback( _cCallback ),
-			m_pvCallbackParm( _pvCallbackParm ) {
+			m_pvCallbackParm( _pvCallbackParm ),
+			m_stHead( 0 ),
+			m_stDirty( 0 ) {
 			std::memset( m_bIsWrite, 0, sizeof( m_bIsWrite ) );
 		}
 
@@ -71,8 +74,9 @@ namespace lsn {
 				}
 			}
 			// Shove the new value into the bottom of the stack.
-			m_tBuffer[_uDelayCycles-_stManualDelay] = _tnValue;
-			m_bIsWrite[_uDelayCycles-_stManualDelay] = true;
+			size_t stSlot = Slot( _uDelayCycles - _stManualDelay );
+			m_tBuffer[stSlot] = _tnValue;
+			m_bIsWrite[stSlot] = true;
 			m_stDirty = _uDelayCycles;
 
 			return _tnValue;
@@ -81,24 +85,33 @@ namespace lsn {
 		/**
 		 * Advances values toward the top.
 		 */
-		void												Tick() {
+		inline void											Tick() {
 			if constexpr ( _uDelayCycles != 0 ) {
 				if ( m_stDirty ) {
 					--m_stDirty;
-					if ( m_cCallback && m_bIsWrite[ArraySize<_uDelayCycles>()-2] ) {
-						m_cCallback( m_pvCallbackParm, m_tBuffer[ArraySize<_uDelayCycles>()-2], Value() );
-					}
-					if constexpr ( _uDelayCycles >= 1 ) {
-						for ( size_t I = ArraySize<_uDelayCycles>() - 1; I--; ) {
-							m_tBuffer[I+1] = m_tBuffer[I];
-							m_bIsWrite[I+1] = m_bIsWrite[I];
-						}
-						m_bIsWrite[0] = false;
+					size_t stNext = Slot( _uDelayCycles - 1 );
+					if ( m_cCallback && m_bIsWrite[stNext] ) {
+						m_cCallback( m_pvCallbackParm, m_tBuffer[stNext], Value() );
 					}
+					// The old top drops out and its slot becomes the new bottom, which keeps the most recent value.
+					size_t stBottom = m_stHead;
+					m_stHead = Slot( _uDelayCycles );
+					m_tBuffer[m_stHead] = m_tBuffer[stBottom];
+					m_bIsWrite[m_stHead] = false;
 				}
 			}
 		}
 
+		/**
+		 * Determines whether any value is still moving through the delay.  While settled, Tick() does nothing and Value() does not
+		 *	change.
+		 *
+		 * \return Returns true if no written value is waiting to reach the top.
+		 */
+		inline bool											Settled() const {
+			return m_stDirty == 0;
+		}
+
 		/**
 		 * Sets the current value immediately without going through the delay.
 		 *
@@ -127,7 +140,7 @@ namespace lsn {
 		 * \return Returns the current value by constant reference.
 		 */
 		const _tnType &										Value() const {
-			return m_tBuffer[ArraySize<_uDelayCycles>()-1];
+			return m_tBuffer[Slot( _uDelayCycles )];
 		}
 
 		/**
@@ -136,7 +149,40 @@ namespace lsn {
 		 * \return Returns the most recent value assigned by constant reference.
 		 */
 		const _tnType &										MostRecentValue() const {
-			return m_tBuffer[0];
+			return m_tBuffer[m_stHead];
+		}
+
+		/**
+		 * Writes the values in the delay pipeline to a stream, from the most recent value to the current value.  The callback is part
+		 *	of the wiring, not the state, and is not written.
+		 *
+		 * \param _sStream The stream to which to write the state.
+		 * \return Returns true if the state was written.
+		 */
+		bool												SaveState( CStream &_sStream ) const {
+			for ( size_t I = 0; I < ArraySize<_uDelayCycles>(); ++I ) {
+				if ( !_sStream.Write( m_tBuffer[Slot( I )] ) ) { return false; }
+				if ( !_sStream.WriteBool( m_bIsWrite[Slot( I )] ) ) { return false; }
+			}
+			return _sStream.WriteUi8( uint8_t( m_stDirty ) );
+		}
+
+		/**
+		 * Reads the values in the delay pipeline from a stream.  The callback is not triggered.
+		 *
+		 * \param _sStream The stream from which to read the state.
+		 * \return Returns true if the state was read.
+		 */
+		bool												LoadState( CStream &_sStream ) {
+			m_stHead = 0;
+			for ( size_t I = 0; I < ArraySize<_uDelayCycles>(); ++I ) {
+				if ( !_sStream.Read( m_tBuffer[I] ) ) { return false; }
+				if ( !_sStream.ReadBool( m_bIsWrite[I] ) ) { return false; }
+			}
+			uint8_t ui8Dirty;
+			if ( !_sStream.ReadUi8( ui8Dirty ) ) { return false; }
+			m_stDirty = ui8Dirty;
+			return true;
 		}
 
 	protected :
@@ -145,12 +191,27 @@ namespace lsn {
 		Callback											m_cCallback;
 		/** The first parameter to pass to the callback. */
 		void *												m_pvCallbackParm;
-		/** The array of values through which changes must pass to reach the final value. */
+		/** The ring of values through which changes must pass to reach the final value. */
 		_tnType												m_tBuffer[ArraySize<_uDelayCycles>()];
-		/** A companion array that allows us to track values through the delay to know when to trigger the callback.  The callback must only be triggered on actual writes to the target value. */
+		/** A companion ring that allows us to track values through the delay to know when to trigger the callback.  The callback must only be triggered on actual writes to the target value. */
 		bool												m_bIsWrite[ArraySize<_uDelayCycles>()];
+		/** The index in the rings of slot 0 (the most recent value). */
+		size_t												m_stHead;
 		/** If non-zero, there is a value in the pipeline and the object should be updated each cycle until it reaches the top. */
 		size_t												m_stDirty;
+
+
+		// == Functions.
+		/**
+		 * Gets the index in the rings of a slot in the delay chain.
+		 *
+		 * \param _stSlot The slot in the delay chain, where 0 is the most recent value and _uDelayCycles is the current value.
+		 * \return Returns the index of the slot in m_tBuffer and m_bIsWrite.
+		 */
+		inline size_t										Slot( size_t _stSlot ) const {
+			size_t stIdx = m_stHead + _stSlot;
+			return stIdx >= ArraySize<_uDelayCycles>() ? stIdx - ArraySize<_uDelayCycles>() : stIdx;
+		}
 	};
 
 }	// namespace lsn
@@ -0,0 +1,180 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A process-wide work-stealing thread pool.  Filters and post-processes split their frames into bands of scanlines and
+ *	submit each band as a job.  The pool has one worker per additional core and the thread that waits on a group of jobs runs jobs
+ *	itself while it waits, so the filter chain uses every core without each filter creating its own threads.
+ */
+
+#include "LSNJobPool.h"
+#include "LSNProfiler.h"
+
+
+namespace lsn {
+
+	CJobPool::CJobPool() :
+		m_sQueued( 0 ),
+		m_sNextQueue( 0 ),
+		m_bRun( true ) {
+		size_t sCores = std::thread::hardware_concurrency();
+		size_t sWorkers = sCores > 1 ? sCores - 1 : 0;
+		try {
+			for ( size_t I = 0; I < sWorkers; ++I ) {
+				m_vQueues.push_back( std::make_unique<LSN_QUEUE>() );
+			}
+			for ( size_t I = 0; I < sWorkers; ++I ) {
+				m_vWorkers.emplace_back( WorkerThread, this, I );
+			}
+		}
+		catch ( ... ) {
+			// Run with however many workers started.  With none, jobs run on the submitting thread.
+			m_vQueues.resize( m_vWorkers.size() );
+		}
+	}
+	CJobPool::~CJobPool() {
+		{
+			std::lock_guard<std::mutex> lgLock( m_mWorkLock );
+			m_bRun = false;
+		}
+		m_cvWork.notify_all();
+		for ( auto & tThread : m_vWorkers ) {
+			tThread.join();
+		}
+	}
+
+
+	// == Functions.
+	/**
+	 * Gets the process-wide pool.  The pool is created on the first call.
+	 *
+	 * \return Returns the process-wide pool.
+	 */
+	CJobPool & CJobPool::Get() {
+		static CJobPool jpPool;
+		return jpPool;
+	}
+
+	/**
+	 * Adds jobs to the pool.  The jobs are called as _pfJob( _pvParm, 0 ) through _pfJob( _pvParm, _sTotal - 1 ) in any order and on
+	 *	any threads.  If the pool has no workers the jobs are run before returning.
+	 *
+	 * \param _jgGroup The group to which to add the jobs.  It must stay alive until Wait() returns.
+	 * \param _pfJob The job function.
+	 * \param _pvParm The parameter passed to the job function.
+	 * \param _sTotal The number of jobs to add.
+	 */
+	void CJobPool::Submit( LSN_JOB_GROUP &_jgGroup, PfJob _pfJob, void * _pvParm, size_t _sTotal ) {
+		if ( !_sTotal ) { return; }
+		if ( m_vQueues.empty() ) {
+			for ( size_t I = 0; I < _sTotal; ++I ) {
+				LSN_PROFILE_SCOPE( "Job" );
+				_pfJob( _pvParm, I );
+			}
+			return;
+		}
+
+		_jgGroup.sRemaining.fetch_add( _sTotal, std::memory_order_relaxed );
+		{
+			// Counted before the jobs are visible so that a worker taking one never pushes the count below 0.
+			std::lock_guard<std::mutex> lgLock( m_mWorkLock );
+			m_sQueued.fetch_add( _sTotal );
+		}
+		size_t sQueue = m_sNextQueue.fetch_add( 1, std::memory_order_relaxed );
+		for ( size_t I = 0; I < _sTotal; ++I ) {
+			LSN_QUEUE & qQueue = (*m_vQueues[(sQueue+I)%m_vQueues.size()]);
+			std::lock_guard<std::mutex> lgLock( qQueue.mLock );
+			qQueue.dJobs.push_back( { _pfJob, _pvParm, I, &_jgGroup } );
+		}
+		m_cvWork.notify_all();
+	}
+
+	/**
+	 * Waits for every job in a group to finish.  The calling thread runs queued jobs while it waits.
+	 *
+	 * \param _jgGroup The group on which to wait.
+	 */
+	void CJobPool::Wait( LSN_JOB_GROUP &_jgGroup ) {
+		LSN_JOB jJob;
+		while ( _jgGroup.sRemaining.load( std::memory_order_acquire ) ) {
+			if ( TakeJob( 0, jJob ) ) {
+				RunJob( jJob );
+				continue;
+			}
+			// Everything left in the group is running on workers.
+			std::unique_lock<std::mutex> ulLock( m_mDoneLock );
+			m_cvDone.wait( ulLock, [&]() { return _jgGroup.sRemaining.load( std::memory_order_acquire ) == 0; } );
+		}
+	}
+
+	/**
+	 * Takes a job from the queues, starting with the front of the given queue and then stealing from the back of the others.
+	 *
+	 * \param _sQueue The queue to check first.
+	 * \param _jJob Holds the job.
+	 * \return Returns true if a job was taken.
+	 */
+	bool CJobPool::TakeJob( size_t _sQueue, LSN_JOB &_jJob ) {
+		if ( !m_sQueued.load( std::memory_order_acquire ) ) { return false; }
+		{
+			LSN_QUEUE & qQueue = (*m_vQueues[_sQueue]);
+			std::lock_guard<std::mutex> lgLock( qQueue.mLock );
+			if ( !qQueue.dJobs.empty() ) {
+				_jJob = qQueue.dJobs.front();
+				qQueue.dJobs.pop_front();
+				m_sQueued.fetch_sub( 1 );
+				return true;
+			}
+		}
+		for ( size_t I = 1; I < m_vQueues.size(); ++I ) {
+			LSN_QUEUE & qQueue = (*m_vQueues[(_sQueue+I)%m_vQueues.size()]);
+			std::lock_guard<std::mutex> lgLock( qQueue.mLock );
+			if ( !qQueue.dJobs.empty() ) {
+				_jJob = qQueue.dJobs.back();
+				qQueue.dJobs.pop_back();
+				m_sQueued.fetch_sub( 1 );
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Runs a job and signals its group if it was the group's last job.
+	 *
+	 * \param _jJob The job to run.
+	 */
+	void CJobPool::RunJob( const LSN_JOB &_jJob ) {
+		{
+			LSN_PROFILE_SCOPE( "Job" );
+			_jJob.pfJob( _jJob.pvParm, _jJob.sIdx );
+		}
+		if ( _jJob.pjgGroup->sRemaining.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+			// The group may be destroyed as soon as its count reaches 0, so only the pool is touched from here.
+			std::lock_guard<std::mutex> lgLock( m_mDoneLock );
+			m_cvDone.notify_all();
+		}
+	}
+
+	/**
+	 * A worker thread.
+	 *
+	 * \param _pjpPool The pool.
+	 * \param _sQueue The index of the worker's queue.
+	 */
+	void CJobPool::WorkerThread( CJobPool * _pjpPool, size_t _sQueue ) {
+		LSN_PROFILE_THREAD_NAME( "Job Worker" );
+		LSN_JOB jJob;
+		while ( true ) {
+			if ( _pjpPool->TakeJob( _sQueue, jJob ) ) {
+				_pjpPool->RunJob( jJob );
+				continue;
+			}
+			std::unique_lock<std::mutex> ulLock( _pjpPool->m_mWorkLock );
+			_pjpPool->m_cvWork.wait( ulLock, [&]() { return !_pjpPool->m_bRun || _pjpPool->m_sQueued.load() != 0; } );
+			if ( !_pjpPool->m_bRun ) { break; }
+		}
+	}
+
+}	// namespace lsn
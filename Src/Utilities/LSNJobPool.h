@@ -0,0 +1,182 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A process-wide work-stealing thread pool.  Filters and post-processes split their frames into bands of scanlines and
+ *	submit each band as a job.  The pool has one worker per additional core and the thread that waits on a group of jobs runs jobs
+ *	itself while it waits, so the filter chain uses every core without each filter creating its own threads.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CJobPool
+	 * \brief A process-wide work-stealing thread pool.
+	 *
+	 * Description: A process-wide work-stealing thread pool.  Filters and post-processes split their frames into bands of scanlines and
+	 *	submit each band as a job.  The pool has one worker per additional core and the thread that waits on a group of jobs runs jobs
+	 *	itself while it waits, so the filter chain uses every core without each filter creating its own threads.
+	 * Each worker has its own queue.  Submitted jobs are dealt out across the queues, each worker takes jobs from the front of its own
+	 *	queue, and a worker with an empty queue steals from the back of the other queues.
+	 */
+	class CJobPool {
+	public :
+		CJobPool();
+		~CJobPool();
+
+
+		// == Types.
+		/** A job.  _pvParm is the pointer passed to Submit() and _sIdx is the index of the job within its submission. */
+		typedef void (*										PfJob)( void * _pvParm, size_t _sIdx );
+
+		/** A group of jobs that can be waited on together. */
+		struct LSN_JOB_GROUP {
+			std::atomic<size_t>								sRemaining { 0 };									/**< The number of jobs in the group that have not finished. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Gets the process-wide pool.  The pool is created on the first call.
+		 *
+		 * \return Returns the process-wide pool.
+		 */
+		static CJobPool &									Get();
+
+		/**
+		 * Adds jobs to the pool.  The jobs are called as _pfJob( _pvParm, 0 ) through _pfJob( _pvParm, _sTotal - 1 ) in any order and on
+		 *	any threads.  If the pool has no workers the jobs are run before returning.
+		 *
+		 * \param _jgGroup The group to which to add the jobs.  It must stay alive until Wait() returns.
+		 * \param _pfJob The job function.
+		 * \param _pvParm The parameter passed to the job function.
+		 * \param _sTotal The number of jobs to add.
+		 */
+		void												Submit( LSN_JOB_GROUP &_jgGroup, PfJob _pfJob, void * _pvParm, size_t _sTotal );
+
+		/**
+		 * Waits for every job in a group to finish.  The calling thread runs queued jobs while it waits.
+		 *
+		 * \param _jgGroup The group on which to wait.
+		 */
+		void												Wait( LSN_JOB_GROUP &_jgGroup );
+
+		/**
+		 * Runs _pfJob( _pvParm, 0 ) through _pfJob( _pvParm, _sTotal - 1 ) across the pool and waits for all of them to finish.
+		 *
+		 * \param _pfJob The job function.
+		 * \param _pvParm The parameter passed to the job function.
+		 * \param _sTotal The number of jobs to run.
+		 */
+		void												ParallelFor( PfJob _pfJob, void * _pvParm, size_t _sTotal ) {
+			LSN_JOB_GROUP jgGroup;
+			Submit( jgGroup, _pfJob, _pvParm, _sTotal );
+			Wait( jgGroup );
+		}
+
+		/**
+		 * Gets the number of threads that run jobs, including the thread that waits.
+		 *
+		 * \return Returns the number of workers plus 1.
+		 */
+		inline size_t										Threads() const { return m_vWorkers.size() + 1; }
+
+		/**
+		 * Gets the number of bands into which to split a given number of items (usually scanlines).  There are a few bands per thread
+		 *	so that threads that finish early can steal from threads that are behind.
+		 *
+		 * \param _sItems The number of items to split.
+		 * \return Returns the number of bands to use, from 1 to _sItems.
+		 */
+		inline size_t										Bands( size_t _sItems ) const {
+			if ( Threads() == 1 ) { return 1; }
+			return std::max<size_t>( 1, std::min<size_t>( _sItems, Threads() * 4 ) );
+		}
+
+		/**
+		 * Gets the range of items in a band.
+		 *
+		 * \param _sBand The index of the band.
+		 * \param _sBands The total number of bands.
+		 * \param _sItems The total number of items.
+		 * \param _sStart Holds the first item in the band.
+		 * \param _sEnd Holds the end of the band (one past the last item).
+		 */
+		static inline void									BandRange( size_t _sBand, size_t _sBands, size_t _sItems, size_t &_sStart, size_t &_sEnd ) {
+			_sStart = _sItems * _sBand / _sBands;
+			_sEnd = _sItems * (_sBand + 1) / _sBands;
+		}
+
+
+	protected :
+		// == Types.
+		/** A queued job. */
+		struct LSN_JOB {
+			PfJob											pfJob;												/**< The job function. */
+			void *											pvParm;												/**< The parameter passed to the job function. */
+			size_t											sIdx;												/**< The index passed to the job function. */
+			LSN_JOB_GROUP *									pjgGroup;											/**< The group to which the job belongs. */
+		};
+
+		/** A worker's queue. */
+		struct LSN_QUEUE {
+			std::mutex										mLock;												/**< Guards dJobs. */
+			std::deque<LSN_JOB>								dJobs;												/**< The jobs. */
+		};
+
+
+		// == Members.
+		std::vector<std::unique_ptr<LSN_QUEUE>>				m_vQueues;											/**< One queue per worker. */
+		std::vector<std::thread>							m_vWorkers;											/**< The worker threads. */
+		std::atomic<size_t>									m_sQueued;											/**< The number of jobs in all queues. */
+		std::atomic<size_t>									m_sNextQueue;										/**< The queue that receives the next submitted job. */
+		std::mutex											m_mWorkLock;										/**< Guards sleeping on m_cvWork. */
+		std::condition_variable								m_cvWork;											/**< Wakes workers when jobs are queued. */
+		std::mutex											m_mDoneLock;										/**< Guards sleeping on m_cvDone. */
+		std::condition_variable								m_cvDone;											/**< Wakes waiting threads when a group finishes. */
+		bool												m_bRun;												/**< Cleared to stop the workers.  Guarded by m_mWorkLock. */
+
+
+		// == Functions.
+		/**
+		 * Takes a job from the queues, starting with the front of the given queue and then stealing from the back of the others.
+		 *
+		 * \param _sQueue The queue to check first.
+		 * \param _jJob Holds the job.
+		 * \return Returns true if a job was taken.
+		 */
+		bool												TakeJob( size_t _sQueue, LSN_JOB &_jJob );
+
+		/**
+		 * Runs a job and signals its group if it was the group's last job.
+		 *
+		 * \param _jJob The job to run.
+		 */
+		void												RunJob( const LSN_JOB &_jJob );
+
+		/**
+		 * A worker thread.
+		 *
+		 * \param _pjpPool The pool.
+		 * \param _sQueue The index of the worker's queue.
+		 */
+		static void											WorkerThread( CJobPool * _pjpPool, size_t _sQueue );
+	};
+
+}	// namespace lsn
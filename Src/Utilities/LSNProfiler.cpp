@@ -0,0 +1,239 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A scoped, nestable profiler.  Each thread records the scopes it runs into its own lock-free ring, one thread collects
+ *	the rings into a timeline, and the timeline can be written as a Chrome trace (chrome://tracing or https://ui.perfetto.dev) or
+ *	summarized per scope.  Scopes are only compiled in when LSN_PROFILE is defined.
+ */
+
+#include "LSNProfiler.h"
+#include "../File/LSNStdFile.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <map>
+
+
+namespace lsn {
+
+	// == Members.
+	/** Set while profiling is on. */
+	std::atomic<bool> CProfiler::m_bEnabled = false;
+
+	/** The clock. */
+	CClock CProfiler::m_cClock;
+
+	/** Guards m_vThreads, m_sEventsPerThread, and the thread names. */
+	std::mutex CProfiler::m_mLock;
+
+	/** Every thread that has recorded anything.  Threads are never removed, so their rings can be collected after they exit. */
+	std::vector<std::unique_ptr<CProfiler::LSN_THREAD>> CProfiler::m_vThreads;
+
+	/** The ring size for threads that have not yet recorded anything. */
+	size_t CProfiler::m_sEventsPerThread = LSN_PROFILE_EVENTS_PER_THREAD;
+
+	/** The collected timeline. */
+	std::vector<CProfiler::LSN_EVENT> CProfiler::m_vEvents;
+
+	/** The calling thread's recording state. */
+	thread_local CProfiler::LSN_THREAD * CProfiler::m_ptThread = nullptr;
+
+
+	// == Functions.
+	/**
+	 * Turns profiling on and discards everything recorded so far.
+	 *
+	 * \param _sEventsPerThread The number of events each thread that has not yet recorded anything can hold between collections.
+	 */
+	void CProfiler::Start( size_t _sEventsPerThread ) {
+		{
+			std::lock_guard<std::mutex> lgLock( m_mLock );
+			m_sEventsPerThread = _sEventsPerThread;
+		}
+		Collect();
+		m_vEvents.clear();
+		{
+			std::lock_guard<std::mutex> lgLock( m_mLock );
+			for ( auto & ptThread : m_vThreads ) {
+				ptThread->aDropped.store( 0, std::memory_order_relaxed );
+			}
+		}
+		m_bEnabled.store( true, std::memory_order_relaxed );
+	}
+
+	/**
+	 * Turns profiling off.  Scopes that are already open are still recorded when they close.
+	 */
+	void CProfiler::Stop() {
+		m_bEnabled.store( false, std::memory_order_relaxed );
+	}
+
+	/**
+	 * Moves every event recorded by every thread into the timeline.  Only one thread may collect at a time.
+	 */
+	void CProfiler::Collect() {
+		std::lock_guard<std::mutex> lgLock( m_mLock );
+		LSN_EVENT eBlock[1024];
+		for ( auto & ptThread : m_vThreads ) {
+			size_t sTotal;
+			while ( (sTotal = ptThread->srEvents.Pop( eBlock, LSN_ELEMENTS( eBlock ) )) != 0 ) {
+				try {
+					m_vEvents.insert( m_vEvents.end(), eBlock, eBlock + sTotal );
+				}
+				catch ( ... ) {
+					ptThread->aDropped.fetch_add( sTotal, std::memory_order_relaxed );
+				}
+			}
+		}
+	}
+
+	/**
+	 * Gets the number of events that were dropped because a thread's ring was full.
+	 *
+	 * \return Returns the total number of dropped events on all threads.
+	 */
+	uint64_t CProfiler::Dropped() {
+		std::lock_guard<std::mutex> lgLock( m_mLock );
+		uint64_t ui64Dropped = 0;
+		for ( auto & ptThread : m_vThreads ) {
+			ui64Dropped += ptThread->aDropped.load( std::memory_order_relaxed );
+		}
+		return ui64Dropped;
+	}
+
+	/**
+	 * Names the calling thread in the trace.
+	 *
+	 * \param _pcName The name of the thread.  Must remain valid for the life of the process.
+	 */
+	void CProfiler::SetThreadName( const char * _pcName ) {
+		LSN_THREAD * ptThread = m_ptThread ? m_ptThread : RegisterThread();
+		if ( !ptThread ) { return; }
+		std::lock_guard<std::mutex> lgLock( m_mLock );
+		ptThread->pcName = _pcName;
+	}
+
+	/**
+	 * Writes the timeline as a Chrome trace (JSON Trace Event Format).
+	 *
+	 * \param _pcPath The path to the file to create.
+	 * \return Returns true if the file was written.
+	 */
+	bool CProfiler::WriteChromeTrace( const char8_t * _pcPath ) {
+		std::vector<uint8_t> vJson;
+		try {
+			char szBuffer[256];
+			auto Append = [&]( int _iLen ) {
+				if ( _iLen > 0 ) { vJson.insert( vJson.end(), szBuffer, szBuffer + std::min<size_t>( size_t( _iLen ), sizeof( szBuffer ) - 1 ) ); }
+			};
+			// Times are in microseconds from the first event.
+			uint64_t ui64Base = ~0ULL;
+			for ( size_t I = 0; I < m_vEvents.size(); ++I ) {
+				ui64Base = std::min( ui64Base, m_vEvents[I].ui64Start );
+			}
+			double dToUs = 1000000.0 / double( m_cClock.GetResolution() );
+
+			Append( std::snprintf( szBuffer, sizeof( szBuffer ), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" ) );
+			bool bFirst = true;
+			{
+				std::lock_guard<std::mutex> lgLock( m_mLock );
+				for ( auto & ptThread : m_vThreads ) {
+					if ( ptThread->pcName ) {
+						Append( std::snprintf( szBuffer, sizeof( szBuffer ), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+							bFirst ? "" : ",\n", ptThread->ui32Index, ptThread->pcName ) );
+						bFirst = false;
+					}
+				}
+			}
+			for ( size_t I = 0; I < m_vEvents.size(); ++I ) {
+				const LSN_EVENT & eEvent = m_vEvents[I];
+				Append( std::snprintf( szBuffer, sizeof( szBuffer ), "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+					bFirst ? "" : ",\n", eEvent.pcName, eEvent.ui32Thread,
+					double( eEvent.ui64Start - ui64Base ) * dToUs, double( eEvent.ui64Dur ) * dToUs ) );
+				bFirst = false;
+			}
+			Append( std::snprintf( szBuffer, sizeof( szBuffer ), "\n]}\n" ) );
+		}
+		catch ( ... ) { return false; }
+
+		CStdFile sfFile;
+		if ( !sfFile.Create( _pcPath ) ) { return false; }
+		return sfFile.WriteToFile( vJson );
+	}
+
+	/**
+	 * Prints the calls, total time, and self time of each scope name in the timeline.
+	 *
+	 * \param _pfFile The stream to which to print.
+	 */
+	void CProfiler::PrintSummary( FILE * _pfFile ) {
+		struct LSN_TOTALS {
+			uint64_t										ui64Calls = 0;
+			uint64_t										ui64Dur = 0;
+			uint64_t										ui64Self = 0;
+		};
+		std::map<std::string, LSN_TOTALS> mTotals;
+		try {
+			for ( size_t I = 0; I < m_vEvents.size(); ++I ) {
+				LSN_TOTALS & tTotals = mTotals[m_vEvents[I].pcName];
+				++tTotals.ui64Calls;
+				tTotals.ui64Dur += m_vEvents[I].ui64Dur;
+				tTotals.ui64Self += m_vEvents[I].ui64Self;
+			}
+		}
+		catch ( ... ) { return; }
+
+		double dToMs = 1000.0 / double( m_cClock.GetResolution() );
+		std::fprintf( _pfFile, "%-24s %12s %14s %14s %12s\n", "Scope", "Calls", "Total ms", "Self ms", "Avg us" );
+		for ( auto & aTotal : mTotals ) {
+			std::fprintf( _pfFile, "%-24s %12" PRIu64 " %14.3f %14.3f %12.3f\n", aTotal.first.c_str(), aTotal.second.ui64Calls,
+				double( aTotal.second.ui64Dur ) * dToMs, double( aTotal.second.ui64Self ) * dToMs,
+				double( aTotal.second.ui64Dur ) * dToMs * 1000.0 / double( aTotal.second.ui64Calls ) );
+		}
+		uint64_t ui64Dropped = Dropped();
+		if ( ui64Dropped ) {
+			std::fprintf( _pfFile, "Dropped events: %" PRIu64 "\n", ui64Dropped );
+		}
+	}
+
+	/**
+	 * Closes the innermost scope on the calling thread and records it.
+	 *
+	 * \param _pcName The scope name.
+	 * \param _ui64Start The value Begin() returned.
+	 */
+	void CProfiler::End( const char * _pcName, uint64_t _ui64Start ) {
+		uint64_t ui64Dur = m_cClock.GetRealTick() - _ui64Start;
+		LSN_THREAD * ptThread = m_ptThread;
+		uint32_t ui32Depth = --ptThread->ui32Depth;
+		uint64_t ui64Child = ui32Depth < LSN_PROFILE_MAX_DEPTH ? ptThread->ui64Child[ui32Depth] : 0;
+		if ( ui32Depth && ui32Depth - 1 < LSN_PROFILE_MAX_DEPTH ) { ptThread->ui64Child[ui32Depth-1] += ui64Dur; }
+
+		LSN_EVENT eEvent = { _pcName, _ui64Start, ui64Dur, ui64Dur - std::min( ui64Dur, ui64Child ), ptThread->ui32Index, ui32Depth };
+		if LSN_UNLIKELY( !ptThread->srEvents.Push( &eEvent, 1 ) ) {
+			ptThread->aDropped.fetch_add( 1, std::memory_order_relaxed );
+		}
+	}
+
+	/**
+	 * Creates the calling thread's recording state.
+	 *
+	 * \return Returns the new state, or nullptr if memory could not be allocated.
+	 */
+	CProfiler::LSN_THREAD * CProfiler::RegisterThread() {
+		std::lock_guard<std::mutex> lgLock( m_mLock );
+		try {
+			std::unique_ptr<LSN_THREAD> ptThread = std::make_unique<LSN_THREAD>();
+			// With no ring every event is counted as dropped, which is still better than not profiling the thread at all.
+			ptThread->srEvents.Resize( m_sEventsPerThread );
+			ptThread->ui32Index = uint32_t( m_vThreads.size() );
+			m_vThreads.push_back( std::move( ptThread ) );
+		}
+		catch ( ... ) { return nullptr; }
+		m_ptThread = m_vThreads.back().get();
+		return m_ptThread;
+	}
+
+}	// namespace lsn
@@ -0,0 +1,228 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A scoped, nestable profiler.  Each thread records the scopes it runs into its own lock-free ring, one thread collects
+ *	the rings into a timeline, and the timeline can be written as a Chrome trace (chrome://tracing or https://ui.perfetto.dev) or
+ *	summarized per scope.  Scopes are only compiled in when LSN_PROFILE is defined.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "../Time/LSNClock.h"
+#include "LSNSpscRing.h"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+#define LSN_PROFILE_EVENTS_PER_THREAD						(64 * 1024)							/**< The default number of events each thread can record between calls to CProfiler::Collect(). */
+#define LSN_PROFILE_MAX_DEPTH								32									/**< The nesting depth up to which self time is tracked. */
+
+#ifdef LSN_PROFILE
+#define LSN_PROFILE_CAT_( A, B )							A ## B
+#define LSN_PROFILE_CAT( A, B )								LSN_PROFILE_CAT_( A, B )
+/** Profiles the rest of the enclosing block under the given name, which must be a string literal. */
+#define LSN_PROFILE_SCOPE( NAME )							::lsn::CProfiler::CScope LSN_PROFILE_CAT( psProfileScope, __LINE__ )( NAME )
+/** Names the calling thread in the trace.  The name must be a string literal. */
+#define LSN_PROFILE_THREAD_NAME( NAME )						::lsn::CProfiler::SetThreadName( NAME )
+#else
+#define LSN_PROFILE_SCOPE( NAME )
+#define LSN_PROFILE_THREAD_NAME( NAME )
+#endif	// #ifdef LSN_PROFILE
+
+
+namespace lsn {
+
+	/**
+	 * Class CProfiler
+	 * \brief A scoped, nestable profiler.
+	 *
+	 * Description: A scoped, nestable profiler.  Each thread records the scopes it runs into its own lock-free ring, one thread collects
+	 *	the rings into a timeline, and the timeline can be written as a Chrome trace (chrome://tracing or https://ui.perfetto.dev) or
+	 *	summarized per scope.  Scopes are only compiled in when LSN_PROFILE is defined.
+	 * A thread's ring is created the first time it enters a scope while profiling is on.  Only that thread pushes to the ring and only
+	 *	the thread that calls Collect() pops from it, so recording a scope takes no locks.  A full ring drops events (they are counted)
+	 *	until the next Collect(), so long runs should collect once per frame.
+	 */
+	class CProfiler {
+	public :
+		// == Types.
+		/** A finished scope. */
+		struct LSN_EVENT {
+			const char *									pcName;												/**< The scope name. */
+			uint64_t										ui64Start;											/**< The clock tick at which the scope began. */
+			uint64_t										ui64Dur;											/**< The clock ticks spent in the scope. */
+			uint64_t										ui64Self;											/**< The clock ticks spent in the scope but not in nested scopes. */
+			uint32_t										ui32Thread;											/**< The index of the thread that ran the scope. */
+			uint32_t										ui32Depth;											/**< The nesting depth of the scope, starting at 0. */
+		};
+
+		/** Profiles the lifetime of the object. */
+		class CScope {
+		public :
+			LSN_FORCEINLINE CScope( const char * _pcName ) :
+				m_pcName( _pcName ),
+				m_ui64Start( CProfiler::Begin() ) {
+			}
+			LSN_FORCEINLINE ~CScope() {
+				if LSN_UNLIKELY( m_ui64Start ) { CProfiler::End( m_pcName, m_ui64Start ); }
+			}
+
+
+		protected :
+			// == Members.
+			/** The scope name. */
+			const char *									m_pcName;
+			/** The clock tick at which the scope began, or 0 if profiling was off. */
+			uint64_t										m_ui64Start;
+		};
+
+
+		// == Functions.
+		/**
+		 * Determines whether scopes are compiled in.
+		 *
+		 * \return Returns true if LSN_PROFILE is defined.
+		 */
+		static constexpr bool								Compiled() {
+#ifdef LSN_PROFILE
+			return true;
+#else
+			return false;
+#endif	// #ifdef LSN_PROFILE
+		}
+
+		/**
+		 * Turns profiling on and discards everything recorded so far.
+		 *
+		 * \param _sEventsPerThread The number of events each thread that has not yet recorded anything can hold between collections.
+		 */
+		static void											Start( size_t _sEventsPerThread = LSN_PROFILE_EVENTS_PER_THREAD );
+
+		/**
+		 * Turns profiling off.  Scopes that are already open are still recorded when they close.
+		 */
+		static void											Stop();
+
+		/**
+		 * Determines whether profiling is on.
+		 *
+		 * \return Returns true between Start() and Stop().
+		 */
+		static inline bool									Enabled() { return m_bEnabled.load( std::memory_order_relaxed ); }
+
+		/**
+		 * Moves every event recorded by every thread into the timeline.  Only one thread may collect at a time.
+		 */
+		static void											Collect();
+
+		/**
+		 * Gets the timeline.  Call Collect() first to add the most recent events.
+		 *
+		 * \return Returns the collected events in the order in which they were collected.
+		 */
+		static inline const std::vector<LSN_EVENT> &		Events() { return m_vEvents; }
+
+		/**
+		 * Gets the number of events that were dropped because a thread's ring was full.
+		 *
+		 * \return Returns the total number of dropped events on all threads.
+		 */
+		static uint64_t										Dropped();
+
+		/**
+		 * Names the calling thread in the trace.
+		 *
+		 * \param _pcName The name of the thread.  Must remain valid for the life of the process.
+		 */
+		static void											SetThreadName( const char * _pcName );
+
+		/**
+		 * Writes the timeline as a Chrome trace (JSON Trace Event Format).
+		 *
+		 * \param _pcPath The path to the file to create.
+		 * \return Returns true if the file was written.
+		 */
+		static bool											WriteChromeTrace( const char8_t * _pcPath );
+
+		/**
+		 * Prints the calls, total time, and self time of each scope name in the timeline.
+		 *
+		 * \param _pfFile The stream to which to print.
+		 */
+		static void											PrintSummary( FILE * _pfFile );
+
+
+	protected :
+		// == Types.
+		/** A thread's recording state.  Written only by the thread that owns it, except for the ring's read position. */
+		struct LSN_THREAD {
+			CSpscRing<LSN_EVENT>							srEvents;											/**< Finished scopes waiting to be collected. */
+			uint64_t										ui64Child[LSN_PROFILE_MAX_DEPTH];					/**< The time spent in nested scopes of each open scope. */
+			uint32_t										ui32Depth = 0;										/**< The number of open scopes. */
+			uint32_t										ui32Index = 0;										/**< The index of the thread in m_vThreads. */
+			std::atomic<uint64_t>							aDropped { 0 };										/**< The number of events that did not fit in srEvents. */
+			const char *									pcName = nullptr;									/**< The name of the thread.  Guarded by m_mLock. */
+		};
+
+
+		// == Members.
+		/** Set while profiling is on. */
+		static std::atomic<bool>							m_bEnabled;
+		/** The clock. */
+		static CClock										m_cClock;
+		/** Guards m_vThreads, m_sEventsPerThread, and the thread names. */
+		static std::mutex									m_mLock;
+		/** Every thread that has recorded anything.  Threads are never removed, so their rings can be collected after they exit. */
+		static std::vector<std::unique_ptr<LSN_THREAD>>		m_vThreads;
+		/** The ring size for threads that have not yet recorded anything. */
+		static size_t										m_sEventsPerThread;
+		/** The collected timeline. */
+		static std::vector<LSN_EVENT>						m_vEvents;
+		/** The calling thread's recording state. */
+		static thread_local LSN_THREAD *					m_ptThread;
+
+
+		// == Functions.
+		/**
+		 * Opens a scope on the calling thread.
+		 *
+		 * \return Returns the clock tick at which the scope began, or 0 if profiling is off.
+		 */
+		static inline uint64_t								Begin() {
+			if LSN_LIKELY( !Enabled() ) { return 0; }
+			LSN_THREAD * ptThread = m_ptThread;
+			if LSN_UNLIKELY( !ptThread ) {
+				ptThread = RegisterThread();
+				if ( !ptThread ) { return 0; }
+			}
+			if ( ptThread->ui32Depth < LSN_PROFILE_MAX_DEPTH ) { ptThread->ui64Child[ptThread->ui32Depth] = 0; }
+			++ptThread->ui32Depth;
+			return m_cClock.GetRealTick();
+		}
+
+		/**
+		 * Closes the innermost scope on the calling thread and records it.
+		 *
+		 * \param _pcName The scope name.
+		 * \param _ui64Start The value Begin() returned.
+		 */
+		static void											End( const char * _pcName, uint64_t _ui64Start );
+
+		/**
+		 * Creates the calling thread's recording state.
+		 *
+		 * \return Returns the new state, or nullptr if memory could not be allocated.
+		 */
+		static LSN_THREAD *									RegisterThread();
+	};
+
+}	// namespace lsn
@@ -0,0 +1,120 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A lock-free single-producer/single-consumer ring buffer.  One thread may push while another thread pops, with no locks.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CSpscRing
+	 * \brief A lock-free single-producer/single-consumer ring buffer.
+	 *
+	 * Description: A lock-free single-producer/single-consumer ring buffer.  One thread may push while another thread pops, with no locks.
+	 *	Pushing is only done by one thread at a time and popping is only done by one thread at a time.  The read and write positions
+	 *	count up forever and are masked into the buffer, so the buffer size is always a power of 2.
+	 */
+	template <typename _tType>
+	class CSpscRing {
+	public :
+		CSpscRing() :
+			m_sMask( 0 ),
+			m_sWrite( 0 ),
+			m_sRead( 0 ) {
+		}
+
+
+		// == Functions.
+		/**
+		 * Allocates the buffer and empties the ring.  Must not be called while another thread is pushing or popping.
+		 *
+		 * \param _sSize The minimum number of items the ring can hold.  Rounded up to a power of 2.
+		 * \return Returns true if the buffer was allocated.
+		 */
+		bool												Resize( size_t _sSize ) {
+			size_t sSize = 1;
+			while ( sSize < _sSize ) { sSize <<= 1; }
+			try {
+				m_vBuffer.resize( sSize );
+			}
+			catch ( ... ) { return false; }
+			m_sMask = sSize - 1;
+			m_sWrite.store( 0, std::memory_order_relaxed );
+			m_sRead.store( 0, std::memory_order_relaxed );
+			return true;
+		}
+
+		/**
+		 * Adds items to the ring.  Called only by the producer.
+		 *
+		 * \param _ptValues The items to add.
+		 * \param _sTotal The number of items to which _ptValues points.
+		 * \return Returns the number of items added, which is less than _sTotal if the ring is full.
+		 */
+		size_t												Push( const _tType * _ptValues, size_t _sTotal ) {
+			size_t sWrite = m_sWrite.load( std::memory_order_relaxed );
+			size_t sRead = m_sRead.load( std::memory_order_acquire );
+			_sTotal = std::min( _sTotal, m_vBuffer.size() - (sWrite - sRead) );
+			for ( size_t I = 0; I < _sTotal; ++I ) {
+				m_vBuffer[(sWrite+I)&m_sMask] = _ptValues[I];
+			}
+			m_sWrite.store( sWrite + _sTotal, std::memory_order_release );
+			return _sTotal;
+		}
+
+		/**
+		 * Removes items from the ring.  Called only by the consumer.
+		 *
+		 * \param _ptValues Holds the removed items.
+		 * \param _sMax The maximum number of items to remove.
+		 * \return Returns the number of items removed, which is 0 if the ring is empty.
+		 */
+		size_t												Pop( _tType * _ptValues, size_t _sMax ) {
+			size_t sRead = m_sRead.load( std::memory_order_relaxed );
+			size_t sWrite = m_sWrite.load( std::memory_order_acquire );
+			_sMax = std::min( _sMax, sWrite - sRead );
+			for ( size_t I = 0; I < _sMax; ++I ) {
+				_ptValues[I] = m_vBuffer[(sRead+I)&m_sMask];
+			}
+			m_sRead.store( sRead + _sMax, std::memory_order_release );
+			return _sMax;
+		}
+
+		/**
+		 * Gets the number of items in the ring.  Exact only when called by the producer or the consumer while the other is idle.
+		 *
+		 * \return Returns the number of items waiting to be popped.
+		 */
+		size_t												Size() const {
+			return m_sWrite.load( std::memory_order_acquire ) - m_sRead.load( std::memory_order_acquire );
+		}
+
+		/**
+		 * Gets the number of items the ring can hold.
+		 *
+		 * \return Returns the size of the buffer.
+		 */
+		inline size_t										Capacity() const { return m_vBuffer.size(); }
+
+
+	protected :
+		// == Members.
+		std::vector<_tType>									m_vBuffer;											/**< The items. */
+		size_t												m_sMask;											/**< The buffer size minus 1. */
+		alignas( 64 ) std::atomic<size_t>					m_sWrite;											/**< The total number of items pushed.  Written only by the producer. */
+		alignas( 64 ) std::atomic<size_t>					m_sRead;											/**< The total number of items popped.  Written only by the consumer. */
+	};
+
+}	// namespace lsn
@@ -10,7 +10,6 @@
 #include "LSNUtilities.h"
 #include "../File/LSNFileBase.h"
 #include "../OS/LSNOs.h"
-#include "EEExpEval.h"
 
 #include <cwctype>
 #include <filesystem>
@@ -111,11 +110,13 @@ namespace lsn {
 		// Visual Studio reports these as deprecated since C++17.
 		if ( _pbErrored != nullptr ) { (*_pbErrored) = false; }
 		try {
-			return std::wstring_convert<std::codecvt_utf8<wchar_t>>{}.to_bytes( reinterpret_cast<const wchar_t *>(_pcString) );
+			// wchar_t is 32 bits outside of Windows, so the conversion must go through char16_t.
+			std::string sTmp = std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>{}.to_bytes( _pcString );
+			return std::u8string( sTmp.begin(), sTmp.end() );
 		}
 		catch ( ... ) { 
 			if ( _pbErrored != nullptr ) { (*_pbErrored) = true; }
-			return std::string();
+			return std::u8string();
 		}
 #endif	// #ifdef LSN_WINDOWS
 	}
@@ -197,17 +198,81 @@ namespace lsn {
 		std::filesystem::create_directories( pDir );
 
 		std::filesystem::path pPreferred = pDir;
-		pPreferred /= std::format( L"{:08X} {}.prs", _ui32Crc, reinterpret_cast<const wchar_t *>(_pu16Name.c_str()) );
+		wchar_t szCrc[16];
+		std::swprintf( szCrc, LSN_ELEMENTS( szCrc ), L"%.8X", _ui32Crc );
+		pPreferred /= std::wstring( szCrc ) + L" " + std::wstring( _pu16Name.begin(), _pu16Name.end() ) + L".prs";
 		if ( std::filesystem::exists( pPreferred ) ) { return pPreferred.generic_u16string(); }
 		
 		std::filesystem::path pSearch = pDir;
-		auto aTmp = std::format( L"{:08X} *.prs", _ui32Crc );
+		auto aTmp = std::wstring( szCrc ) + L" *.prs";
 		std::vector<std::u16string> vRes;
 		CFileBase::FindFiles( pSearch.generic_u16string().c_str(), XStringToU16String( aTmp.c_str(), aTmp.size() ).c_str(), false, vRes );
 		if ( !vRes.size() ) { return pPreferred.generic_u16string(); }
 		return vRes[0];
 	}
 
+	/**
+	 * Encodes bytes as base-64 text.
+	 * 
+	 * \param _pui8Data The bytes to encode.
+	 * \param _sLen The number of bytes to encode.
+	 * \return Returns the base-64 text, padded with '=' to a multiple of 4 characters.
+	 **/
+	std::string CUtilities::Base64Encode( const uint8_t * _pui8Data, size_t _sLen ) {
+		static const char szAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		std::string sRet;
+		sRet.reserve( (_sLen + 2) / 3 * 4 );
+		for ( size_t I = 0; I < _sLen; I += 3 ) {
+			size_t sLeft = _sLen - I;
+			uint32_t ui32Group = uint32_t( _pui8Data[I] ) << 16;
+			if ( sLeft > 1 ) { ui32Group |= uint32_t( _pui8Data[I+1] ) << 8; }
+			if ( sLeft > 2 ) { ui32Group |= uint32_t( _pui8Data[I+2] ); }
+			sRet.push_back( szAlphabet[(ui32Group>>18)&0x3F] );
+			sRet.push_back( szAlphabet[(ui32Group>>12)&0x3F] );
+			sRet.push_back( sLeft > 1 ? szAlphabet[(ui32Group>>6)&0x3F] : '=' );
+			sRet.push_back( sLeft > 2 ? szAlphabet[ui32Group&0x3F] : '=' );
+		}
+		return sRet;
+	}
+
+	/**
+	 * Decodes base-64 text.  White space is skipped.
+	 * 
+	 * \param _sText The text to decode.
+	 * \param _vData Holds the decoded bytes.
+	 * \return Returns true if _sText is valid base-64 text and memory could be allocated for the bytes.
+	 **/
+	bool CUtilities::Base64Decode( const std::string &_sText, std::vector<uint8_t> &_vData ) {
+		_vData.clear();
+		try {
+			_vData.reserve( _sText.size() / 4 * 3 );
+			uint32_t ui32Group = 0;
+			size_t sBits = 0;
+			bool bPadding = false;
+			for ( char cChar : _sText ) {
+				uint32_t ui32Val;
+				if ( cChar >= 'A' && cChar <= 'Z' ) { ui32Val = uint32_t( cChar - 'A' ); }
+				else if ( cChar >= 'a' && cChar <= 'z' ) { ui32Val = uint32_t( cChar - 'a' ) + 26; }
+				else if ( cChar >= '0' && cChar <= '9' ) { ui32Val = uint32_t( cChar - '0' ) + 52; }
+				else if ( cChar == '+' ) { ui32Val = 62; }
+				else if ( cChar == '/' ) { ui32Val = 63; }
+				else if ( cChar == '=' ) { bPadding = true; continue; }
+				else if ( cChar == ' ' || cChar == '\t' || cChar == '\r' || cChar == '\n' ) { continue; }
+				else { return false; }
+				// Nothing but padding may follow padding.
+				if ( bPadding ) { return false; }
+				ui32Group = (ui32Group << 6) | ui32Val;
+				sBits += 6;
+				if ( sBits >= 8 ) {
+					sBits -= 8;
+					_vData.push_back( uint8_t( ui32Group >> sBits ) );
+				}
+			}
+			return true;
+		}
+		catch ( ... ) { return false; }
+	}
+
 	/**
 	 * Deconstructs a ZIP file name formatted as zipfile{name}.  If not a ZIP file, the file name is extracted.
 	 * 
@@ -286,7 +351,7 @@ namespace lsn {
 		return CSTR_EQUAL == ::CompareStringEx( LOCALE_NAME_INVARIANT, NORM_IGNORECASE,
 			reinterpret_cast<LPCWCH>(_u16Str0.c_str()), -1, reinterpret_cast<LPCWCH>(_u16Str1.c_str()), -1,
 			NULL, NULL, NULL );
-#else
+#elif defined( LSN_APPLE )
 		CFStringRef cfStr1 = ::CFStringCreateWithBytes(
 			nullptr,
 			reinterpret_cast<const UInt8 *>(_u16Str0.c_str()),
@@ -311,6 +376,12 @@ namespace lsn {
 		CFRelease( cfStr2 );
 
 		return bResult;
+#else
+		if ( _u16Str0.size() != _u16Str1.size() ) { return false; }
+		for ( size_t I = 0; I < _u16Str0.size(); ++I ) {
+			if ( std::towlower( std::wint_t( _u16Str0[I] ) ) != std::towlower( std::wint_t( _u16Str1[I] ) ) ) { return false; }
+		}
+		return true;
 #endif	// #ifdef LSN_WINDOWS
 	}
 
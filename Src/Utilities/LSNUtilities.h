@@ -287,6 +287,24 @@ namespace lsn {
 		 **/
 		static std::u16string								PerRomSettingsPath( const std::wstring &_pwcPath, uint32_t _ui32Crc, const std::u16string &_pu16Name );
 
+		/**
+		 * Encodes bytes as base-64 text.
+		 * 
+		 * \param _pui8Data The bytes to encode.
+		 * \param _sLen The number of bytes to encode.
+		 * \return Returns the base-64 text, padded with '=' to a multiple of 4 characters.
+		 **/
+		static std::string									Base64Encode( const uint8_t * _pui8Data, size_t _sLen );
+
+		/**
+		 * Decodes base-64 text.  White space is skipped.
+		 * 
+		 * \param _sText The text to decode.
+		 * \param _vData Holds the decoded bytes.
+		 * \return Returns true if _sText is valid base-64 text and memory could be allocated for the bytes.
+		 **/
+		static bool											Base64Decode( const std::string &_sText, std::vector<uint8_t> &_vData );
+
 		/**
 		 * Converts a single double value from sRGB space to linear space.  Performs a conversion according to the standard.
 		 *
@@ -1709,7 +1727,7 @@ namespace lsn {
 		 */
 		template <unsigned _uWidthD, unsigned _uWidthN>
 		static inline float									LanczosXFilterFunc( float _fT, float _fWidth ) {
-			_fT = std::fabsf( _fT );
+			_fT = std::fabs( _fT );
 			constexpr float fW = float( _uWidthD ) / float( _uWidthN );
 			_fT = _fT / _fWidth * fW;
 			if ( _fT <= fW ) {
@@ -1726,7 +1744,7 @@ namespace lsn {
 		 * \return Returns the filtered value.
 		 */
 		static inline float									KaiserFilterFunc( float _fT, float _fWidth ) {
-			_fT = std::fabsf( _fT );
+			_fT = std::fabs( _fT );
 			if ( _fT <= std::ceil( _fWidth ) ) {
 				static const float fAtt = 40.0f;
 				static const double dAlpha = std::exp( std::log( 0.58417 * (fAtt - 20.96) ) * 0.4 ) + 0.07886 * (fAtt - 20.96);
@@ -1743,7 +1761,7 @@ namespace lsn {
 		 * \return Returns the filtered value.
 		 */
 		static inline float									BlackmanFilterFunc( float _fT, float _fWidth ) {
-			_fT = std::fabsf( _fT );
+			_fT = std::fabs( _fT );
 			if ( _fT <= std::ceil( _fWidth ) ) {
 				_fT = float( std::pow( _fT / _fWidth, 16.0 ) * _fWidth );
 				return Clean( Sinc( _fT ) * BlackmanWindow( _fT / double( _fWidth ) ) );
@@ -1759,7 +1777,7 @@ namespace lsn {
 		 * \return Returns the filtered value.
 		 */
 		static inline float									GaussianXFilterFunc( float _fT, float _fWidth ) {
-			_fT = std::fabsf( _fT );
+			_fT = std::fabs( _fT );
 			if ( _fT <= std::ceil( _fWidth ) ) {
 
 				double dSigma = (_fWidth - 1.0 ) / 6.0;
@@ -1802,7 +1820,7 @@ namespace lsn {
 		 * \return Returns the filtered value.
 		 */
 		static inline float									BoxFilterFunc( float _fT, float _fWidth ) {
-			_fT = std::fabsf( _fT );
+			_fT = std::fabs( _fT );
 			return (_fT <= std::ceil( _fWidth )) ? 1.0f : 0.0f;
 		}
 		/**
@@ -1814,7 +1832,7 @@ namespace lsn {
 		 **/
 		template <unsigned _uNotchW, unsigned _uPowTimes100>
 		static inline float									CrtHumpFunc( float _fT, float _fWidth ) {
-			_fT = std::fabsf( _fT );
+			_fT = std::fabs( _fT );
 			constexpr double dNotchW = double( _uNotchW ) / 2.0;
 			if ( _fT <= dNotchW ) { return 1.0f; }
 			double dTmp = _fT - dNotchW;
@@ -269,13 +269,10 @@ namespace lsn {
 						LoadZipRom( fpPath.u16sPath, fpPath.u16sFile );
 					}
 					else {
-						lsn::CStdFile sfFile;
 						std::u16string s16File = m_bnEmulator.RecentFiles()[_wId];
-						if ( sfFile.Open( s16File.c_str() ) ) {
-							std::vector<uint8_t> vExtracted;
-							if ( sfFile.LoadToMemory( vExtracted ) ) {
-								LoadRom( vExtracted, s16File );
-							}
+						lsn::CRomBuffer rbFile;
+						if ( rbFile.MapFile( s16File.c_str() ) ) {
+							LoadRom( rbFile, s16File );
 						}
 					}
 				}
@@ -337,14 +334,11 @@ namespace lsn {
 							return LSW_H_CONTINUE;
 						}
 						else {
-							lsn::CStdFile sfFile;
 							std::u16string s16File = reinterpret_cast<const char16_t *>(ofnOpenFile.lpstrFile);
-							if ( sfFile.Open( s16File.c_str() ) ) {
-								std::vector<uint8_t> vExtracted;
-								if ( sfFile.LoadToMemory( vExtracted ) ) {
-									LoadRom( vExtracted, s16File );
-									return LSW_H_CONTINUE;
-								}
+							lsn::CRomBuffer rbFile;
+							if ( rbFile.MapFile( s16File.c_str() ) ) {
+								LoadRom( rbFile, s16File );
+								return LSW_H_CONTINUE;
 							}
 						}
 					}
@@ -1431,8 +1425,21 @@ namespace lsn {
 	 * \return Returns true if loading of the ROM succeeded.
 	 */
 	bool CMainWindow::LoadRom( const std::vector<uint8_t> &_vRom, const std::u16string &_s16Path ) {
+		CRomBuffer rbRom;
+		if ( !rbRom.Copy( _vRom.data(), _vRom.size() ) ) { return false; }
+		return LoadRom( rbRom, _s16Path );
+	}
+
+	/**
+	 * Loads a ROM given its mapped or owned image and its file name.
+	 *
+	 * \param _rbRom The ROM file.
+	 * \param _s16Path The full path to the ROM.
+	 * \return Returns true if loading of the ROM succeeded.
+	 */
+	bool CMainWindow::LoadRom( const CRomBuffer &_rbRom, const std::u16string &_s16Path ) {
 		StopThread();
-		if ( m_bnEmulator.LoadRom( _vRom, _s16Path, m_bnEmulator.Options().pmRegion ) ) {
+		if ( m_bnEmulator.LoadRom( _rbRom, _s16Path, m_bnEmulator.Options().pmRegion ) ) {
 			UpdatedConsolePointer();
 			if ( m_bnEmulator.GetSystem()->GetRom() ) {
 				std::u16string u16Name = u"BeesNES: " + CUtilities::NoExtension( CUtilities::GetFileName( m_bnEmulator.GetSystem()->GetRom()->riInfo.s16RomName ) );
@@ -1505,13 +1512,15 @@ namespace lsn {
 			if ( zfFile.GatherArchiveFiles( vFiles ) ) {
 				for ( size_t I = 0; I < vFiles.size(); ++I ) {
 					if ( CUtilities::Replace( vFiles[I], u'/', u'\\' ) == _s16File ) {
-						std::vector<uint8_t> vExtracted;
-						zfFile.ExtractToMemory( vFiles[I], vExtracted );
+						zfFile.Close();
+						// Stored entries are mapped in place; compressed ones are extracted.
+						lsn::CRomBuffer rbRom;
+						if ( !rbRom.MapZipFile( _s16ZipPath.c_str(), vFiles[I] ) ) { return false; }
 						std::u16string u16sPath = _s16ZipPath;
 						u16sPath += u"{";
 						u16sPath.append( vFiles[I].c_str() );
 						u16sPath += u"}";
-						return LoadRom( vExtracted, u16sPath );
+						return LoadRom( rbRom, u16sPath );
 					}
 				}
 			}
@@ -356,6 +356,15 @@ namespace lsn {
 		 */
 		bool									LoadRom( const std::vector<uint8_t> &_vRom, const std::u16string &_s16Path );
 
+		/**
+		 * Loads a ROM given its mapped or owned image and its file name.
+		 *
+		 * \param _rbRom The ROM file.
+		 * \param _s16Path The full path to the ROM.
+		 * \return Returns true if loading of the ROM succeeded.
+		 */
+		bool									LoadRom( const CRomBuffer &_rbRom, const std::u16string &_s16Path );
+
 		/**
 		 * Loads a ROM file given a path to a ZIP and a file name inside the ZIP.
 		 * 